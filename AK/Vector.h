@@ -134,6 +134,13 @@ public:
         return m_outline_buffer;
     }
 
+    // NOTE: This is used by the LibJS JIT, which reads the data pointer of vectors without inline capacity directly.
+    static constexpr size_t outline_buffer_offset()
+    requires(inline_capacity == 0)
+    {
+        return __builtin_offsetof(Vector, m_outline_buffer);
+    }
+
     ALWAYS_INLINE VisibleType const& at(size_t i) const
     {
         VERIFY(i < m_size);
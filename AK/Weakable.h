@@ -42,6 +42,9 @@ public:
 
     void revoke() { m_ptr = nullptr; }
 
+    // NOTE: This is used by the LibJS JIT, which follows weak pointers in its inline caches directly.
+    static constexpr size_t ptr_offset() { return __builtin_offsetof(WeakLink, m_ptr); }
+
 private:
     template<typename T>
     explicit WeakLink(T& weakable)
@@ -20,7 +20,7 @@ namespace Ladybird {
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+ImageDecoderClient::Client& ImageCodecPlugin::client()
 {
     if (!m_client) {
 #ifdef AK_OS_ANDROID
@@ -33,24 +33,73 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
             m_client = nullptr;
         };
     }
+    return *m_client;
+}
+
+// FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+static Web::Platform::DecodedImage to_platform_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.frame_count = result.frame_count;
+    decoded_image.image_id = result.image_id;
+    for (auto const& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    return decoded_image;
+}
 
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
         promise->on_resolution = move(on_resolved);
     if (on_rejected)
         promise->on_rejection = move(on_rejected);
 
-    auto image_decoder_promise = m_client->decode_image(
+    auto image_decoder_promise = client().decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto const& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_platform_decoded_image(result));
+            return {};
+        },
+        [promise](auto& error) {
+            promise->reject(Error::copy(error));
+        });
+
+    return promise;
+}
+
+Optional<i64> ImageCodecPlugin::start_progressive_decode(Optional<ByteString> mime_type, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image)
+{
+    return client().start_progressive_decode(move(on_partial_image), move(mime_type));
+}
+
+void ImageCodecPlugin::append_progressive_decode_data(i64 decode_id, ReadonlyBytes bytes)
+{
+    // NOTE: If the decoder went away, finishing the decode will tell.
+    if (m_client)
+        m_client->append_progressive_decode_data(decode_id, bytes);
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::finish_progressive_decode(i64 decode_id, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
+    auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    if (!m_client) {
+        promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
+        return promise;
+    }
+
+    auto image_decoder_promise = m_client->finish_progressive_decode(
+        decode_id,
+        [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+            promise->resolve(to_platform_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
@@ -60,4 +109,31 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     return promise;
 }
 
+void ImageCodecPlugin::cancel_progressive_decode(i64 decode_id)
+{
+    if (m_client)
+        m_client->cancel_progressive_decode(decode_id);
+}
+
+void ImageCodecPlugin::request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, Function<void(u32 start_frame_index, Vector<Web::Platform::Frame>&)> on_decoded)
+{
+    // NOTE: If the decoder went away, so did the state of the animation. We'll just keep showing the frames we have.
+    if (!m_client)
+        return;
+
+    m_client->request_animation_frames(image_id, start_frame_index, count, [on_decoded = move(on_decoded)](u32 start_frame_index, Vector<ImageDecoderClient::Frame>& result) {
+        Vector<Web::Platform::Frame> frames;
+        frames.ensure_capacity(result.size());
+        for (auto& frame : result)
+            frames.empend(move(frame.bitmap), frame.duration);
+        on_decoded(start_frame_index, frames);
+    });
+}
+
+void ImageCodecPlugin::stop_animation_decode(i64 image_id)
+{
+    if (m_client)
+        m_client->stop_animation_decode(image_id);
+}
+
 }
@@ -18,8 +18,16 @@ public:
     virtual ~ImageCodecPlugin() override;
 
     virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual Optional<i64> start_progressive_decode(Optional<ByteString> mime_type, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) override;
+    virtual void append_progressive_decode_data(i64 decode_id, ReadonlyBytes) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> finish_progressive_decode(i64 decode_id, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual void cancel_progressive_decode(i64 decode_id) override;
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, Function<void(u32 start_frame_index, Vector<Web::Platform::Frame>&)>) override;
+    virtual void stop_animation_decode(i64 image_id) override;
 
 private:
+    ImageDecoderClient::Client& client();
+
     RefPtr<ImageDecoderClient::Client> m_client;
 };
 
@@ -103,6 +103,7 @@ set(LANGUAGE_SERVER_DEBUG ON)
 set(LEXER_DEBUG ON)
 set(LIBWEB_CSS_ANIMATION_DEBUG ON)
 set(LIBWEB_CSS_DEBUG ON)
+set(LIBWEB_STYLE_SHARING_DEBUG ON)
 set(LINE_EDITOR_DEBUG ON)
 set(LOCAL_SOCKET_DEBUG ON)
 set(LOCK_DEBUG ON)
@@ -148,6 +149,7 @@ set(PORTABLE_IMAGE_LOADER_DEBUG ON)
 set(PROCESS_DEBUG ON)
 set(PROCFS_DEBUG ON)
 set(PROMISE_DEBUG ON)
+set(PROPERTY_LOOKUP_CACHE_DEBUG ON)
 set(PS2MOUSE_DEBUG ON)
 set(PTHREAD_DEBUG ON)
 set(PTMX_DEBUG ON)
@@ -126,6 +126,101 @@ TEST_CASE(deflate_decompress_zeroes)
     EXPECT(uncompressed == decompressed.value().bytes());
 }
 
+// Writes the header of a final block with dynamic Huffman codes of the given code lengths.
+static ErrorOr<void> write_dynamic_block_header(LittleEndianOutputBitStream& stream, ReadonlyBytes literal_code_lengths, ReadonlyBytes distance_code_lengths)
+{
+    // BFINAL: 1, BTYPE: 2, HLIT, HDIST, HCLEN: 19 - 4
+    TRY(stream.write_bits(1u, 1));
+    TRY(stream.write_bits(2u, 2));
+    TRY(stream.write_bits(literal_code_lengths.size() - 257, 5));
+    TRY(stream.write_bits(distance_code_lengths.size() - 1, 5));
+    TRY(stream.write_bits(15u, 4));
+
+    // The code lengths are written one at a time, with 4-bit codes for the lengths 0 to 15.
+    static constexpr Array<u8, 19> code_length_code_order { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    Array<u8, 19> code_length_code_lengths {};
+    for (size_t i = 0; i < 16; ++i)
+        code_length_code_lengths[i] = 4;
+    for (auto code_length : code_length_code_order)
+        TRY(stream.write_bits(code_length_code_lengths[code_length], 3));
+
+    auto const code_length_code = TRY(Compress::CanonicalCode::from_bytes(code_length_code_lengths));
+    for (auto code_length : literal_code_lengths)
+        TRY(code_length_code.write_symbol(stream, code_length));
+    for (auto code_length : distance_code_lengths)
+        TRY(code_length_code.write_symbol(stream, code_length));
+    return {};
+}
+
+TEST_CASE(deflate_decompress_long_codes)
+{
+    // A literal/length code with codes of every length from 1 to 15 bits. Codes longer than 11 bits can only be
+    // resolved through the second-level lookup tables.
+    Array<u8, 258> literal_code_lengths {};
+    for (u8 i = 0; i < 14; ++i)
+        literal_code_lengths['a' + i] = i + 1;
+    literal_code_lengths[256] = 15; // End of block
+    literal_code_lengths[257] = 15; // Length 3
+    Array<u8, 1> const distance_code_lengths { 1 };
+
+    auto const literal_code = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(literal_code_lengths));
+    auto const distance_code = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(distance_code_lengths));
+
+    AllocatingMemoryStream stream;
+    LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(stream) };
+    TRY_OR_FAIL(write_dynamic_block_header(bit_stream, literal_code_lengths, distance_code_lengths));
+
+    // Every literal follows every other literal, and every literal is repeated with a back reference.
+    ByteBuffer expected;
+    for (u8 first = 'a'; first < 'a' + 14; ++first) {
+        for (u8 second = 'a'; second < 'a' + 14; ++second) {
+            TRY_OR_FAIL(literal_code.write_symbol(bit_stream, first));
+            TRY_OR_FAIL(literal_code.write_symbol(bit_stream, second));
+            expected.append(first);
+            expected.append(second);
+        }
+        TRY_OR_FAIL(literal_code.write_symbol(bit_stream, 257));
+        TRY_OR_FAIL(distance_code.write_symbol(bit_stream, 0));
+        expected.append(Array<u8, 3> { 'n', 'n', 'n' });
+    }
+    TRY_OR_FAIL(literal_code.write_symbol(bit_stream, 256));
+    TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+    TRY_OR_FAIL(bit_stream.flush_buffer_to_stream());
+    auto const compressed = TRY_OR_FAIL(stream.read_until_eof());
+
+    auto const decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), expected.bytes());
+}
+
+TEST_CASE(deflate_decompress_literal_pairs)
+{
+    // With codes this short, two literals can be resolved with a single lookup, unless they don't both fit into the
+    // lookup table's bits or the second symbol isn't a literal.
+    Array<u8, 257> literal_code_lengths {};
+    literal_code_lengths['x'] = 1;
+    literal_code_lengths['y'] = 2;
+    literal_code_lengths['z'] = 3;
+    literal_code_lengths[256] = 3; // End of block
+    Array<u8, 1> const distance_code_lengths { 1 };
+
+    auto const literal_code = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(literal_code_lengths));
+
+    AllocatingMemoryStream stream;
+    LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(stream) };
+    TRY_OR_FAIL(write_dynamic_block_header(bit_stream, literal_code_lengths, distance_code_lengths));
+
+    auto const expected = "xxxyxzyxyyyzzxzyzzx"sv;
+    for (auto literal : expected)
+        TRY_OR_FAIL(literal_code.write_symbol(bit_stream, literal));
+    TRY_OR_FAIL(literal_code.write_symbol(bit_stream, 256));
+    TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+    TRY_OR_FAIL(bit_stream.flush_buffer_to_stream());
+    auto const compressed = TRY_OR_FAIL(stream.read_until_eof());
+
+    auto const decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(StringView { decompressed }, expected);
+}
+
 TEST_CASE(deflate_round_trip_store)
 {
     auto original = ByteBuffer::create_uninitialized(1024).release_value();
@@ -180,3 +275,24 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+BENCHMARK_CASE(deflate_decompress_text)
+{
+    // Text-like data with a skewed distribution of literals, so that the codes have many different lengths.
+    static constexpr Array words { "the"sv, "of"sv, "and"sv, "a"sv, "to"sv, "in"sv, "is"sv, "you"sv, "that"sv, "it"sv, "decompression"sv, "Huffman"sv, "quickly"sv, "zebra"sv, "jukebox"sv, "\n"sv };
+    StringBuilder builder;
+    u32 state = 1;
+    while (builder.length() < 1 * MiB) {
+        state = state * 1103515245 + 12345;
+        auto const random = state >> 16;
+        builder.append(words[min(random % words.size(), (random >> 8) % words.size())]);
+        builder.append(' ');
+    }
+    auto const original = TRY_OR_FAIL(builder.to_byte_buffer());
+    auto const compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+
+    for (size_t i = 0; i < 20; ++i) {
+        auto const decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT_EQ(decompressed.size(), original.size());
+    }
+}
@@ -94,6 +94,24 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_parallel_round_trip)
+{
+    // Repetitive data, so that the chunks refer back into their dictionaries.
+    auto original = ByteBuffer::create_uninitialized(1 * MiB).release_value();
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = (i / 1000) ^ (i % 251);
+
+    for (size_t thread_count : { 1, 3, 16 }) {
+        auto compressed = TRY_OR_FAIL(Compress::ParallelGzipCompressor::compress_all(original, thread_count));
+        auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+    }
+
+    auto compressed = TRY_OR_FAIL(Compress::ParallelGzipCompressor::compress_all({}, 2));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed.is_empty());
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
@@ -7,6 +7,7 @@
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Cipher/AES.h>
+#include <LibCrypto/Cipher/AESNI.h>
 #include <LibTest/TestCase.h>
 #include <cstring>
 
@@ -15,6 +16,26 @@ static ReadonlyBytes operator""_b(char const* string, size_t length)
     return ReadonlyBytes(string, length);
 }
 
+// Makes AES (and the GHASH of GCM) use the table-based code for keys set up until the end of the scope, whatever the CPU supports.
+struct ForceTableBasedAES {
+    ForceTableBasedAES() { Crypto::Cipher::AESNI::set_disabled_for_testing(true); }
+    ~ForceTableBasedAES() { Crypto::Cipher::AESNI::set_disabled_for_testing(false); }
+};
+
+// Defines a test that runs twice: once with whatever the CPU supports, and once with the table-based code.
+#define AES_TEST_CASE(name)                   \
+    static void name##_body();                \
+    TEST_CASE(name)                           \
+    {                                         \
+        name##_body();                        \
+    }                                         \
+    TEST_CASE(name##_table_based)             \
+    {                                         \
+        ForceTableBasedAES force_table_based; \
+        name##_body();                        \
+    }                                         \
+    static void name##_body()
+
 TEST_CASE(test_AES_CBC_name)
 {
     Crypto::Cipher::AESCipher::CBCMode cipher("WellHelloFriends"_b, 128, Crypto::Cipher::Intent::Encryption);
@@ -31,7 +52,7 @@ static auto test_aes_cbc_encrypt = [](auto& cipher, auto& result) {
     EXPECT(memcmp(out_span.data(), result, out_span.size()) == 0);
 };
 
-TEST_CASE(test_AES_CBC_encrypt_with_128bit_key)
+AES_TEST_CASE(test_AES_CBC_encrypt_with_128bit_key)
 {
     u8 result[] {
         0xb8, 0x06, 0x7c, 0xf2, 0xa9, 0x56, 0x63, 0x58, 0x2d, 0x5c, 0xa1, 0x4b, 0xc5, 0xe3, 0x08,
@@ -43,7 +64,7 @@ TEST_CASE(test_AES_CBC_encrypt_with_128bit_key)
     test_aes_cbc_encrypt(cipher, result);
 }
 
-TEST_CASE(test_AES_CBC_encrypt_with_192bit_key)
+AES_TEST_CASE(test_AES_CBC_encrypt_with_192bit_key)
 {
     u8 result[] {
         0xae, 0xd2, 0x70, 0xc4, 0x9c, 0xaa, 0x83, 0x33, 0xd3, 0xd3, 0xac, 0x11, 0x65, 0x35, 0xf7,
@@ -55,7 +76,7 @@ TEST_CASE(test_AES_CBC_encrypt_with_192bit_key)
     test_aes_cbc_encrypt(cipher, result);
 }
 
-TEST_CASE(test_AES_CBC_encrypt_with_256bit_key)
+AES_TEST_CASE(test_AES_CBC_encrypt_with_256bit_key)
 {
     u8 result[] {
         0x0a, 0x44, 0x4d, 0x62, 0x9e, 0x8b, 0xd8, 0x11, 0x80, 0x48, 0x2a, 0x32, 0x53, 0x61, 0xe7,
@@ -67,7 +88,7 @@ TEST_CASE(test_AES_CBC_encrypt_with_256bit_key)
     test_aes_cbc_encrypt(cipher, result);
 }
 
-TEST_CASE(test_AES_CBC_encrypt_with_unsigned_256bit_key)
+AES_TEST_CASE(test_AES_CBC_encrypt_with_unsigned_256bit_key)
 {
     u8 result[] {
         0x18, 0x71, 0x80, 0x4c, 0x28, 0x07, 0x55, 0x3c, 0x05, 0x33, 0x36, 0x3f, 0x19, 0x38, 0x5c,
@@ -93,7 +114,7 @@ static auto test_aes_cbc_decrypt = [](auto& cipher, auto& result, auto result_le
     EXPECT(memcmp(out_span.data(), true_value, strlen(true_value)) == 0);
 };
 
-TEST_CASE(test_AES_CBC_128bit_key_decrypt)
+AES_TEST_CASE(test_AES_CBC_128bit_key_decrypt)
 {
     u8 result[] {
         0xb8, 0x06, 0x7c, 0xf2, 0xa9, 0x56, 0x63, 0x58, 0x2d, 0x5c, 0xa1, 0x4b, 0xc5, 0xe3, 0x08,
@@ -105,7 +126,7 @@ TEST_CASE(test_AES_CBC_128bit_key_decrypt)
     test_aes_cbc_decrypt(cipher, result, 48);
 }
 
-TEST_CASE(test_AES_CBC_192bit_key_decrypt)
+AES_TEST_CASE(test_AES_CBC_192bit_key_decrypt)
 {
     u8 result[] {
         0xae, 0xd2, 0x70, 0xc4, 0x9c, 0xaa, 0x83, 0x33, 0xd3, 0xd3, 0xac, 0x11, 0x65, 0x35, 0xf7,
@@ -117,7 +138,7 @@ TEST_CASE(test_AES_CBC_192bit_key_decrypt)
     test_aes_cbc_decrypt(cipher, result, 48);
 }
 
-TEST_CASE(test_AES_CBC_256bit_key_decrypt)
+AES_TEST_CASE(test_AES_CBC_256bit_key_decrypt)
 {
     u8 result[] {
         0x0a, 0x44, 0x4d, 0x62, 0x9e, 0x8b, 0xd8, 0x11, 0x80, 0x48, 0x2a, 0x32, 0x53, 0x61, 0xe7,
@@ -149,7 +170,7 @@ static auto test_aes_ctr_encrypt = [](auto key, auto ivec, auto in, auto out_exp
     EXPECT(memcmp(out_expected.data(), out_span.data(), out_expected.size()) == 0);
 };
 
-TEST_CASE(test_AES_CTR_128bit_key_encrypt_16bytes)
+AES_TEST_CASE(test_AES_CTR_128bit_key_encrypt_16bytes)
 {
     u8 key[] {
         0xae, 0x68, 0x52, 0xf8, 0x12, 0x10, 0x67, 0xcc, 0x4b, 0xf7, 0xa5, 0x76, 0x55, 0x77, 0xf3, 0x9e
@@ -166,7 +187,7 @@ TEST_CASE(test_AES_CTR_128bit_key_encrypt_16bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_128bit_key_encrypt_32bytes)
+AES_TEST_CASE(test_AES_CTR_128bit_key_encrypt_32bytes)
 {
     u8 key[] {
         0x7e, 0x24, 0x06, 0x78, 0x17, 0xfa, 0xe0, 0xd7, 0x43, 0xd6, 0xce, 0x1f, 0x32, 0x53, 0x91, 0x63
@@ -184,7 +205,7 @@ TEST_CASE(test_AES_CTR_128bit_key_encrypt_32bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_128bit_key_encrypt_36bytes)
+AES_TEST_CASE(test_AES_CTR_128bit_key_encrypt_36bytes)
 {
     u8 ivec[] {
         0x00, 0xe0, 0x01, 0x7b, 0x27, 0x77, 0x7f, 0x3f, 0x4a, 0x17, 0x86, 0xf0, 0x00, 0x00, 0x00, 0x00 + 1 // See CTR.h
@@ -201,7 +222,7 @@ TEST_CASE(test_AES_CTR_128bit_key_encrypt_36bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_192bit_key_encrypt_32bytes)
+AES_TEST_CASE(test_AES_CTR_192bit_key_encrypt_32bytes)
 {
     u8 key[] {
         0x7c, 0x5c, 0xb2, 0x40, 0x1b, 0x3d, 0xc3, 0x3c, 0x19, 0xe7, 0x34, 0x08, 0x19, 0xe0, 0xf6, 0x9c, 0x67, 0x8c, 0x3d, 0xb8, 0xe6, 0xf6, 0xa9, 0x1a
@@ -218,7 +239,7 @@ TEST_CASE(test_AES_CTR_192bit_key_encrypt_32bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_192bit_key_encrypt_36bytes)
+AES_TEST_CASE(test_AES_CTR_192bit_key_encrypt_36bytes)
 {
     u8 key[] {
         0x02, 0xbf, 0x39, 0x1e, 0xe8, 0xec, 0xb1, 0x59, 0xb9, 0x59, 0x61, 0x7b, 0x09, 0x65, 0x27, 0x9b, 0xf5, 0x9b, 0x60, 0xa7, 0x86, 0xd3, 0xe0, 0xfe
@@ -235,7 +256,7 @@ TEST_CASE(test_AES_CTR_192bit_key_encrypt_36bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_256bit_encrypt_16bytes)
+AES_TEST_CASE(test_AES_CTR_256bit_encrypt_16bytes)
 {
     u8 key[] {
         0x77, 0x6b, 0xef, 0xf2, 0x85, 0x1d, 0xb0, 0x6f, 0x4c, 0x8a, 0x05, 0x42, 0xc8, 0x69, 0x6f, 0x6c, 0x6a, 0x81, 0xaf, 0x1e, 0xec, 0x96, 0xb4, 0xd3, 0x7f, 0xc1, 0xd6, 0x89, 0xe6, 0xc1, 0xc1, 0x04
@@ -252,7 +273,7 @@ TEST_CASE(test_AES_CTR_256bit_encrypt_16bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_256bit_encrypt_32bytes)
+AES_TEST_CASE(test_AES_CTR_256bit_encrypt_32bytes)
 {
     u8 key[] {
         0xf6, 0xd6, 0x6d, 0x6b, 0xd5, 0x2d, 0x59, 0xbb, 0x07, 0x96, 0x36, 0x58, 0x79, 0xef, 0xf8, 0x86, 0xc6, 0x6d, 0xd5, 0x1a, 0x5b, 0x6a, 0x99, 0x74, 0x4b, 0x50, 0x59, 0x0c, 0x87, 0xa2, 0x38, 0x84
@@ -269,7 +290,7 @@ TEST_CASE(test_AES_CTR_256bit_encrypt_32bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes)
+AES_TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes)
 {
     u8 key[] {
         0xff, 0x7a, 0x61, 0x7c, 0xe6, 0x91, 0x48, 0xe4, 0xf1, 0x72, 0x6e, 0x2f, 0x43, 0x58, 0x1d, 0xe2, 0xaa, 0x62, 0xd9, 0xf8, 0x05, 0x53, 0x2e, 0xdf, 0xf1, 0xee, 0xd6, 0x87, 0xfb, 0x54, 0x15, 0x3d
@@ -286,7 +307,7 @@ TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
-TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes_with_high_counter)
+AES_TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes_with_high_counter)
 {
     // This test checks whether counter overflow crashes.
     u8 key[] {
@@ -317,7 +338,7 @@ static auto test_aes_ctr_decrypt = [](auto key, auto ivec, auto in, auto out_exp
 };
 
 // From RFC 3686, Section 6
-TEST_CASE(test_AES_CTR_128bit_decrypt_16bytes)
+AES_TEST_CASE(test_AES_CTR_128bit_decrypt_16bytes)
 {
     // This test checks whether counter overflow crashes.
     u8 key[] {
@@ -353,7 +374,7 @@ TEST_CASE(test_AES_GCM_name)
     EXPECT_EQ(cipher.class_name(), "AES_GCM");
 }
 
-TEST_CASE(test_AES_GCM_128bit_encrypt_empty)
+AES_TEST_CASE(test_AES_GCM_128bit_encrypt_empty)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 result_tag[] { 0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61, 0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a };
@@ -363,7 +384,7 @@ TEST_CASE(test_AES_GCM_128bit_encrypt_empty)
     EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_encrypt_zeros)
+AES_TEST_CASE(test_AES_GCM_128bit_encrypt_zeros)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 result_tag[] { 0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
@@ -376,7 +397,7 @@ TEST_CASE(test_AES_GCM_128bit_encrypt_zeros)
     EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_encrypt_multiple_blocks_with_iv)
+AES_TEST_CASE(test_AES_GCM_128bit_encrypt_multiple_blocks_with_iv)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 result_tag[] { 0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6, 0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4 };
@@ -394,7 +415,7 @@ TEST_CASE(test_AES_GCM_128bit_encrypt_multiple_blocks_with_iv)
     EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_encrypt_with_aad)
+AES_TEST_CASE(test_AES_GCM_128bit_encrypt_with_aad)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 result_tag[] { 0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6, 0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4 };
@@ -412,7 +433,33 @@ TEST_CASE(test_AES_GCM_128bit_encrypt_with_aad)
     EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_decrypt_empty)
+AES_TEST_CASE(test_AES_GCM_128bit_encrypt_and_decrypt_long_message)
+{
+    // Long enough to go through several eight-block iterations, a single block and a partial block.
+    Crypto::Cipher::AESCipher::GCMMode cipher("\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"_b, 128, Crypto::Cipher::Intent::Encryption);
+    u8 result_tag[] { 0x94, 0x14, 0x00, 0x7c, 0xc3, 0x4f, 0x89, 0xca, 0xed, 0x85, 0xc7, 0xa3, 0xf2, 0xcf, 0xda, 0xb6 };
+    u8 plaintext[200];
+    for (size_t i = 0; i < sizeof(plaintext); ++i)
+        plaintext[i] = i;
+    auto iv = "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88\x00\x00\x00\x00"_b;
+    auto aad = "\xde\xad\xbe\xef\xfa\xaf\x11\xcc"_b;
+
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    auto ciphertext = ByteBuffer::create_uninitialized(sizeof(plaintext)).release_value();
+    cipher.encrypt({ plaintext, sizeof(plaintext) }, ciphertext.bytes(), iv, aad, tag);
+    EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
+
+    auto out = ByteBuffer::create_uninitialized(sizeof(plaintext)).release_value();
+    auto consistency = cipher.decrypt(ciphertext, out.bytes(), iv, aad, tag);
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
+    EXPECT(memcmp(plaintext, out.data(), out.size()) == 0);
+
+    ciphertext[150] ^= 1;
+    consistency = cipher.decrypt(ciphertext, out.bytes(), iv, aad, tag);
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Inconsistent);
+}
+
+AES_TEST_CASE(test_AES_GCM_128bit_decrypt_empty)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 input_tag[] { 0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61, 0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a };
@@ -422,7 +469,7 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_empty)
     EXPECT_EQ(out.size(), 0u);
 }
 
-TEST_CASE(test_AES_GCM_128bit_decrypt_zeros)
+AES_TEST_CASE(test_AES_GCM_128bit_decrypt_zeros)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 input_tag[] { 0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
@@ -435,7 +482,7 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_zeros)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_iv)
+AES_TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_iv)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 input_tag[] { 0xab, 0x6e, 0x47, 0xd4, 0x2c, 0xec, 0x13, 0xbd, 0xf5, 0x3a, 0x67, 0xb2, 0x12, 0x57, 0xbd, 0xdf };
@@ -448,7 +495,7 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_iv)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
 }
 
-TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
+AES_TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"_b, 128, Crypto::Cipher::Intent::Encryption);
     u8 input_tag[] { 0x93, 0xae, 0x16, 0x97, 0x49, 0xa3, 0xbf, 0x39, 0x4f, 0x61, 0xb7, 0xc1, 0xb1, 0x2, 0x4f, 0x60 };
@@ -465,3 +512,132 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
     EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
 }
+
+static ByteBuffer test_bytes(size_t length, u8 seed)
+{
+    auto buffer = ByteBuffer::create_uninitialized(length).release_value();
+    for (size_t i = 0; i < length; ++i)
+        buffer[i] = i * 7 + seed;
+    return buffer;
+}
+
+// The low 64 bits of the counter wrap around within the first few blocks, which has to carry into the high 64 bits.
+static constexpr u8 iv_about_to_carry[] { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd };
+
+TEST_CASE(test_AES_GCM_matches_table_based_code)
+{
+    // All lengths up to a few times the eight blocks the AES-NI code processes at once, with all key sizes.
+    for (size_t length = 0; length <= 300; ++length) {
+        auto key_bits = 128 + 64 * (length % 3);
+        auto key = test_bytes(key_bits / 8, length);
+        auto plaintext = test_bytes(length, 3);
+        auto aad = test_bytes(length % 37, 5);
+        auto iv = length % 2 ? ByteBuffer::copy(iv_about_to_carry, sizeof(iv_about_to_carry)).release_value() : test_bytes(16, length);
+
+        Crypto::Cipher::AESCipher::GCMMode cipher(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        auto table_based_cipher = [&] {
+            ForceTableBasedAES force_table_based;
+            return Crypto::Cipher::AESCipher::GCMMode(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        }();
+
+        auto ciphertext = ByteBuffer::create_uninitialized(length).release_value();
+        auto tag = ByteBuffer::create_uninitialized(16).release_value();
+        cipher.encrypt(plaintext, ciphertext.bytes(), iv, aad, tag);
+
+        auto table_based_ciphertext = ByteBuffer::create_uninitialized(length).release_value();
+        auto table_based_tag = ByteBuffer::create_uninitialized(16).release_value();
+        table_based_cipher.encrypt(plaintext, table_based_ciphertext.bytes(), iv, aad, table_based_tag);
+        EXPECT_EQ(ciphertext, table_based_ciphertext);
+        EXPECT_EQ(tag, table_based_tag);
+
+        // In place, in both directions.
+        auto buffer = plaintext;
+        auto in_place_tag = ByteBuffer::create_uninitialized(16).release_value();
+        cipher.encrypt(buffer, buffer.bytes(), iv, aad, in_place_tag);
+        EXPECT_EQ(buffer, ciphertext);
+        EXPECT_EQ(in_place_tag, tag);
+
+        EXPECT_EQ(cipher.decrypt(buffer, buffer.bytes(), iv, aad, tag), Crypto::VerificationConsistency::Consistent);
+        EXPECT_EQ(buffer, plaintext);
+
+        auto decrypted = ByteBuffer::create_zeroed(length).release_value();
+        EXPECT_EQ(table_based_cipher.decrypt(ciphertext, decrypted.bytes(), iv, aad, tag), Crypto::VerificationConsistency::Consistent);
+        EXPECT_EQ(decrypted, plaintext);
+
+        if (length > 0) {
+            ciphertext[length / 2] ^= 0x80;
+            EXPECT_EQ(cipher.decrypt(ciphertext, decrypted.bytes(), iv, aad, tag), Crypto::VerificationConsistency::Inconsistent);
+        }
+    }
+}
+
+TEST_CASE(test_AES_CTR_matches_table_based_code)
+{
+    for (size_t length = 0; length <= 300; ++length) {
+        auto key_bits = 128 + 64 * (length % 3);
+        auto key = test_bytes(key_bits / 8, length);
+        auto plaintext = test_bytes(length, 3);
+        ReadonlyBytes iv { iv_about_to_carry, sizeof(iv_about_to_carry) };
+
+        Crypto::Cipher::AESCipher::CTRMode cipher(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        auto table_based_cipher = [&] {
+            ForceTableBasedAES force_table_based;
+            return Crypto::Cipher::AESCipher::CTRMode(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        }();
+
+        auto ciphertext = ByteBuffer::create_zeroed(length).release_value();
+        auto ciphertext_span = ciphertext.bytes();
+        cipher.encrypt(plaintext, ciphertext_span, iv);
+
+        auto table_based_ciphertext = ByteBuffer::create_zeroed(length).release_value();
+        auto table_based_ciphertext_span = table_based_ciphertext.bytes();
+        table_based_cipher.encrypt(plaintext, table_based_ciphertext_span, iv);
+        EXPECT_EQ(ciphertext, table_based_ciphertext);
+
+        auto buffer = plaintext;
+        auto buffer_span = buffer.bytes();
+        cipher.encrypt(buffer, buffer_span, iv);
+        EXPECT_EQ(buffer, ciphertext);
+    }
+}
+
+TEST_CASE(test_AES_CBC_matches_table_based_code)
+{
+    for (size_t length = 0; length <= 300; ++length) {
+        auto key_bits = 128 + 64 * (length % 3);
+        auto key = test_bytes(key_bits / 8, length);
+        auto plaintext = test_bytes(length, 3);
+        auto iv = test_bytes(16, length);
+
+        Crypto::Cipher::AESCipher::CBCMode cipher(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        auto table_based_cipher = [&] {
+            ForceTableBasedAES force_table_based;
+            return Crypto::Cipher::AESCipher::CBCMode(key.bytes(), key_bits, Crypto::Cipher::Intent::Encryption);
+        }();
+
+        auto ciphertext = cipher.create_aligned_buffer(length).release_value();
+        auto ciphertext_span = ciphertext.bytes();
+        cipher.encrypt(plaintext, ciphertext_span, iv);
+
+        auto table_based_ciphertext = table_based_cipher.create_aligned_buffer(length).release_value();
+        auto table_based_ciphertext_span = table_based_ciphertext.bytes();
+        table_based_cipher.encrypt(plaintext, table_based_ciphertext_span, iv);
+        EXPECT_EQ(ciphertext_span, table_based_ciphertext_span);
+
+        Crypto::Cipher::AESCipher::CBCMode decipher(key.bytes(), key_bits, Crypto::Cipher::Intent::Decryption);
+        auto table_based_decipher = [&] {
+            ForceTableBasedAES force_table_based;
+            return Crypto::Cipher::AESCipher::CBCMode(key.bytes(), key_bits, Crypto::Cipher::Intent::Decryption);
+        }();
+
+        auto decrypted = decipher.create_aligned_buffer(ciphertext_span.size()).release_value();
+        auto decrypted_span = decrypted.bytes();
+        decipher.decrypt(ciphertext_span, decrypted_span, iv);
+        EXPECT_EQ(decrypted_span, plaintext.bytes());
+
+        auto table_based_decrypted = table_based_decipher.create_aligned_buffer(ciphertext_span.size()).release_value();
+        auto table_based_decrypted_span = table_based_decrypted.bytes();
+        table_based_decipher.decrypt(ciphertext_span, table_based_decrypted_span, iv);
+        EXPECT_EQ(table_based_decrypted_span, plaintext.bytes());
+    }
+}
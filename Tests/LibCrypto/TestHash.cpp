@@ -10,6 +10,8 @@
 #include <LibCrypto/Hash/MD5.h>
 #include <LibCrypto/Hash/SHA1.h>
 #include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/Hash/SHAMultiBuffer.h>
+#include <LibCrypto/Hash/SHANI.h>
 #include <LibTest/TestCase.h>
 #include <cstring>
 
@@ -241,6 +243,184 @@ TEST_CASE(test_SHA256_hash_split_into_blocks)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
 }
 
+TEST_CASE(test_SHA256_hash_successive_updates)
+{
+    u8 result[] {
+        0x13, 0x98, 0xe3, 0x42, 0x20, 0x15, 0x58, 0xec, 0xc8, 0x53, 0xff, 0x9a, 0x87, 0x3d, 0x56, 0xdb, 0x3c, 0x5b, 0x95, 0xac, 0xd5, 0xf3, 0xeb, 0x33, 0x08, 0xa8, 0x36, 0x11, 0x87, 0x7b, 0x35, 0x5c
+    };
+    auto hasher = Crypto::Hash::SHA256 {};
+    hasher.update("aaaaaaaaaaaaaaa"sv);
+    hasher.update("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"sv);
+    hasher.update("aaaaaaaaaaaaaaa"sv);
+    hasher.update("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"sv);
+    hasher.update("aaaaaaaaa"sv);
+    auto digest = hasher.digest();
+    EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
+}
+
+// Makes SHA-1 and SHA-256 use their scalar code until the end of the scope, whatever the CPU supports.
+struct ForceScalarSHA {
+    ForceScalarSHA()
+    {
+        Crypto::Hash::SHANI::set_disabled_for_testing(true);
+        Crypto::Hash::SHAMultiBuffer::set_disabled_for_testing(true);
+    }
+
+    ~ForceScalarSHA()
+    {
+        Crypto::Hash::SHANI::set_disabled_for_testing(false);
+        Crypto::Hash::SHAMultiBuffer::set_disabled_for_testing(false);
+    }
+};
+
+template<typename Hash>
+static void test_scalar_transform()
+{
+    // Messages of all lengths up to a few blocks, hashed at once and in pieces that aren't aligned to blocks.
+    for (size_t length = 0; length < 300; ++length) {
+        auto buffer = ByteBuffer::create_uninitialized(length).release_value();
+        for (size_t i = 0; i < length; ++i)
+            buffer[i] = i * 7 + length;
+        auto digest = Hash::hash(buffer);
+
+        ForceScalarSHA force_scalar;
+        EXPECT_EQ(Hash::hash(buffer), digest);
+
+        Hash hasher;
+        for (size_t offset = 0; offset < length; offset += 37)
+            hasher.update(buffer.bytes().slice(offset, min<size_t>(37, length - offset)));
+        EXPECT_EQ(hasher.digest(), digest);
+    }
+}
+
+TEST_CASE(test_SHA1_scalar_transform)
+{
+    test_scalar_transform<Crypto::Hash::SHA1>();
+}
+
+TEST_CASE(test_SHA256_scalar_transform)
+{
+    test_scalar_transform<Crypto::Hash::SHA256>();
+}
+
+template<typename Hash>
+static void test_hash_many(auto multi_buffer_hash)
+{
+    // Messages of all lengths up to a few blocks, so that the lanes of the multi-buffer implementation finish at different times.
+    Vector<ByteBuffer> buffers;
+    Vector<ReadonlyBytes> messages;
+    for (size_t length = 0; length < 300; ++length) {
+        auto buffer = ByteBuffer::create_uninitialized(length).release_value();
+        for (size_t i = 0; i < length; ++i)
+            buffer[i] = i * 7 + length;
+        buffers.append(move(buffer));
+    }
+    for (auto const& buffer : buffers)
+        messages.append(buffer.bytes());
+
+    Vector<typename Hash::DigestType> digests;
+    digests.resize(messages.size());
+    Hash::hash_many(messages, digests);
+    for (size_t i = 0; i < messages.size(); ++i)
+        EXPECT_EQ(digests[i], Hash::hash(messages[i].data(), messages[i].size()));
+
+    {
+        ForceScalarSHA force_scalar;
+        Vector<typename Hash::DigestType> scalar_digests;
+        scalar_digests.resize(messages.size());
+        Hash::hash_many(messages, scalar_digests);
+        EXPECT_EQ(scalar_digests, digests);
+    }
+
+    if (!Crypto::Hash::SHAMultiBuffer::is_supported())
+        return;
+    digests.clear();
+    digests.resize(messages.size());
+    multi_buffer_hash(messages, digests);
+    for (size_t i = 0; i < messages.size(); ++i)
+        EXPECT_EQ(digests[i], Hash::hash(messages[i].data(), messages[i].size()));
+}
+
+TEST_CASE(test_SHA1_hash_many)
+{
+    test_hash_many<Crypto::Hash::SHA1>(Crypto::Hash::SHAMultiBuffer::sha1_hash);
+}
+
+TEST_CASE(test_SHA256_hash_many)
+{
+    test_hash_many<Crypto::Hash::SHA256>(Crypto::Hash::SHAMultiBuffer::sha256_hash);
+}
+
+template<typename Hash>
+static void benchmark_hash()
+{
+    auto data = ByteBuffer::create_zeroed(16 * MiB).release_value();
+    for (size_t i = 0; i < 10; ++i) {
+        auto digest = Hash::hash(data);
+        AK::taint_for_optimizer(digest);
+    }
+}
+
+template<typename Hash>
+static void benchmark_hash_many()
+{
+    // Lots of small messages, like the subresources of a page that need an integrity check.
+    auto data = ByteBuffer::create_zeroed(16 * MiB).release_value();
+    Vector<ReadonlyBytes> messages;
+    for (size_t offset = 0; offset < data.size(); offset += 1 * KiB)
+        messages.append(data.bytes().slice(offset, 1 * KiB));
+    Vector<typename Hash::DigestType> digests;
+    digests.resize(messages.size());
+    for (size_t i = 0; i < 10; ++i) {
+        Hash::hash_many(messages, digests);
+        AK::taint_for_optimizer(digests);
+    }
+}
+
+BENCHMARK_CASE(SHA1)
+{
+    benchmark_hash<Crypto::Hash::SHA1>();
+}
+
+BENCHMARK_CASE(SHA1_hash_many)
+{
+    benchmark_hash_many<Crypto::Hash::SHA1>();
+}
+
+BENCHMARK_CASE(SHA256)
+{
+    benchmark_hash<Crypto::Hash::SHA256>();
+}
+
+BENCHMARK_CASE(SHA256_hash_many)
+{
+    benchmark_hash_many<Crypto::Hash::SHA256>();
+}
+
+BENCHMARK_CASE(SHA1_scalar)
+{
+    ForceScalarSHA force_scalar;
+    benchmark_hash<Crypto::Hash::SHA1>();
+}
+
+BENCHMARK_CASE(SHA1_hash_many_scalar)
+{
+    ForceScalarSHA force_scalar;
+    benchmark_hash_many<Crypto::Hash::SHA1>();
+}
+
+BENCHMARK_CASE(SHA256_scalar)
+{
+    ForceScalarSHA force_scalar;
+    benchmark_hash<Crypto::Hash::SHA256>();
+}
+
+BENCHMARK_CASE(SHA256_hash_many_scalar)
+{
+    ForceScalarSHA force_scalar;
+    benchmark_hash_many<Crypto::Hash::SHA256>();
+}
+
 TEST_CASE(test_SHA384_name)
 {
     Crypto::Hash::SHA384 sha;
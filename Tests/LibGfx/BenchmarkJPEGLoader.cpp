@@ -18,6 +18,9 @@ auto small_image = Core::File::open(TEST_INPUT("jpg/rgb24.jpg"sv), Core::File::O
 auto big_image = Core::File::open(TEST_INPUT("jpg/big_image.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto rgb_image = Core::File::open(TEST_INPUT("jpg/rgb_components.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto several_scans = Core::File::open(TEST_INPUT("jpg/several_scans.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+auto progressive_image = Core::File::open(TEST_INPUT("jpg/successive_approximation.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+auto grayscale_image = Core::File::open(TEST_INPUT("jpg/grayscale_mcu.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+auto ycck_image = Core::File::open(TEST_INPUT("jpg/ycck-2111.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 
 BENCHMARK_CASE(small_image)
 {
@@ -42,3 +45,65 @@ BENCHMARK_CASE(several_scans)
     auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(several_scans));
     MUST(plugin_decoder->frame(0));
 }
+
+BENCHMARK_CASE(progressive_image)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(progressive_image));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(grayscale_image)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(grayscale_image));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(ycck_image)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(ycck_image));
+    MUST(plugin_decoder->frame(0));
+}
+
+// The same images, decoded with the scalar code that targets without vector registers use.
+
+BENCHMARK_CASE(small_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(small_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(big_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(big_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(rgb_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(rgb_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(several_scans_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(several_scans, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(progressive_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(progressive_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(grayscale_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(grayscale_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(ycck_image_scalar)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(ycck_image, { .use_simd = false }));
+    MUST(plugin_decoder->frame(0));
+}
@@ -508,6 +508,70 @@ TEST_CASE(test_jpeg_sof2_successive_aproximation)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 600, 800 }));
 }
 
+TEST_CASE(test_jpeg_partial_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb24.jpg"sv)));
+    auto full_frame = TRY_OR_FAIL(TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()))->frame(0));
+
+    // Cut the data off in the middle of the scan.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes().trim(1500)));
+    auto partial_frame = TRY_OR_FAIL(plugin_decoder->partial_frame());
+    EXPECT_EQ(partial_frame.image->size(), full_frame.image->size());
+
+    for (int x = 0; x < full_frame.image->width(); ++x)
+        EXPECT_EQ(partial_frame.image->get_pixel(x, 0), full_frame.image->get_pixel(x, 0));
+    EXPECT_EQ(partial_frame.image->get_pixel(0, partial_frame.image->height() - 1).alpha(), 0);
+}
+
+TEST_CASE(test_jpeg_scaled_decoding)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto full_frame = TRY_OR_FAIL(TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()))->frame(0));
+    EXPECT_EQ(full_frame.image->size(), Gfx::IntSize(592, 800));
+
+    // The decoder picks the smallest of 1/8, 1/4 and 1/2 scale that still covers the ideal size.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto scaled_frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 74, 100 }));
+    EXPECT_EQ(scaled_frame.image->size(), Gfx::IntSize(74, 100));
+    EXPECT(scaled_frame.image->get_pixel(40, 40).distance_squared_to(full_frame.image->get_pixel(324, 324)) < 0.01f);
+
+    scaled_frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 75, 100 }));
+    EXPECT_EQ(scaled_frame.image->size(), Gfx::IntSize(148, 200));
+
+    // Asking for the full size again has to decode the image again.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+    EXPECT_EQ(frame.image->get_pixel(324, 324), full_frame.image->get_pixel(324, 324));
+
+    // But a bitmap that is larger than the ideal size is good enough.
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 74, 100 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
+TEST_CASE(test_jpeg_scalar_and_simd_decoding_match)
+{
+    Array test_inputs = {
+        TEST_INPUT("jpg/rgb24.jpg"sv),
+        TEST_INPUT("jpg/several_scans.jpg"sv),
+        TEST_INPUT("jpg/successive_approximation.jpg"sv),
+        TEST_INPUT("jpg/grayscale_mcu.jpg"sv),
+        TEST_INPUT("jpg/ycck-2111.jpg"sv),
+        TEST_INPUT("jpg/12-bit.jpg"sv),
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+        auto simd_frame = TRY_OR_FAIL(TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file->bytes(), { .use_simd = true }))->frame(0));
+        auto scalar_frame = TRY_OR_FAIL(TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file->bytes(), { .use_simd = false }))->frame(0));
+        EXPECT_EQ(simd_frame.image->size(), scalar_frame.image->size());
+
+        for (int y = 0; y < simd_frame.image->height(); ++y) {
+            for (int x = 0; x < simd_frame.image->width(); ++x)
+                EXPECT_EQ(simd_frame.image->get_pixel(x, y), scalar_frame.image->get_pixel(x, y));
+        }
+    }
+}
+
 TEST_CASE(test_jpeg_sof1_12bits)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/12-bit.jpg"sv)));
@@ -769,6 +833,21 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_partial_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto full_frame = TRY_OR_FAIL(TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()))->frame(0));
+
+    // Cut the data off in the middle of the (only) image data chunk.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() / 2)));
+    auto partial_frame = TRY_OR_FAIL(plugin_decoder->partial_frame());
+    EXPECT_EQ(partial_frame.image->size(), full_frame.image->size());
+
+    for (int x = 0; x < full_frame.image->width(); ++x)
+        EXPECT_EQ(partial_frame.image->get_pixel(x, 0), full_frame.image->get_pixel(x, 0));
+    EXPECT_EQ(partial_frame.image->get_pixel(0, partial_frame.image->height() - 1).alpha(), 0);
+}
+
 TEST_CASE(test_exif)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/exif.png"sv)));
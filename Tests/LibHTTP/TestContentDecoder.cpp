@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/AllOf.h>
+#include <AK/BitStream.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibHTTP/ContentDecoder.h>
+
+// The encoded content is written in pieces of these sizes, in turn, so that it gets split at odd places: inside
+// headers, inside bit fields and across blocks.
+static constexpr Array small_and_odd_pieces { 1uz, 2uz, 3uz, 5uz, 7uz, 11uz, 4093uz };
+static constexpr Array page_sized_pieces { 4093uz };
+static constexpr Array large_pieces { 65537uz };
+static constexpr Array large_and_tiny_pieces { 65537uz, 1uz };
+static constexpr Array<ReadonlySpan<size_t>, 4> piece_size_patterns {
+    small_and_odd_pieces.span(),
+    page_sized_pieces.span(),
+    large_pieces.span(),
+    large_and_tiny_pieces.span(),
+};
+
+static ByteBuffer make_content()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20'000; ++i)
+        builder.appendff("{} bottles of beer on the wall, {} bottles of beer. ", i * 7919 % 1000, i % 13);
+    return MUST(builder.to_byte_buffer());
+}
+
+struct DecodeResult {
+    ByteBuffer decoded_before_finish;
+    ByteBuffer decoded;
+};
+
+// Reads decoded content until the decoder needs more input, or until it is done.
+static ErrorOr<void> read_decoded_content(HTTP::ContentDecoder& decoder, ByteBuffer& decoded)
+{
+    while (true) {
+        auto decoded_content = TRY(decoder.read());
+        if (decoded_content.is_empty())
+            return {};
+        EXPECT(decoded_content.size() <= HTTP::ContentDecoder::max_buffered_decoded_size);
+        TRY(decoded.try_append(decoded_content));
+    }
+}
+
+static ErrorOr<DecodeResult> decode_in_pieces(HTTP::ContentDecoder::Encoding encoding, ReadonlyBytes encoded, ReadonlySpan<size_t> piece_sizes)
+{
+    auto decoder = TRY(HTTP::ContentDecoder::create(encoding));
+    DecodeResult result;
+    for (size_t offset = 0, i = 0; offset < encoded.size(); ++i) {
+        auto piece = encoded.slice(offset, min(piece_sizes[i % piece_sizes.size()], encoded.size() - offset));
+        TRY(decoder->write(piece));
+        TRY(read_decoded_content(*decoder, result.decoded_before_finish));
+        offset += piece.size();
+    }
+    result.decoded = result.decoded_before_finish;
+    decoder->finish();
+    TRY(read_decoded_content(*decoder, result.decoded));
+    EXPECT(decoder->is_done());
+    return result;
+}
+
+static void expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding encoding, ReadonlyBytes encoded, ReadonlyBytes expected)
+{
+    for (auto piece_sizes : piece_size_patterns) {
+        auto result = TRY_OR_FAIL(decode_in_pieces(encoding, encoded, piece_sizes));
+        EXPECT_EQ(result.decoded.bytes(), expected);
+
+        // Content should be handed out as it arrives, not only once everything has been received.
+        EXPECT(result.decoded_before_finish.size() > expected.size() / 2);
+    }
+}
+
+TEST_CASE(gzip)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Gzip, encoded, content);
+}
+
+TEST_CASE(gzip_with_large_header_fields)
+{
+    auto content = make_content();
+    auto member = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+
+    // Replace the plain 10-byte header with one that has a maximum size FEXTRA field and a long FNAME field.
+    static constexpr u8 flag_extra = 1 << 2;
+    static constexpr u8 flag_name = 1 << 3;
+    AllocatingMemoryStream stream;
+    TRY_OR_FAIL(stream.write_until_depleted(member.bytes().trim(3)));
+    TRY_OR_FAIL(stream.write_value<u8>(flag_extra | flag_name));
+    TRY_OR_FAIL(stream.write_until_depleted(member.bytes().slice(4, 6)));
+    TRY_OR_FAIL(stream.write_value<LittleEndian<u16>>(0xffff));
+    TRY_OR_FAIL(stream.write_value<LittleEndian<u16>>(u16('X') | u16('X') << 8));
+    TRY_OR_FAIL(stream.write_value<LittleEndian<u16>>(0xffff - 4));
+    for (size_t i = 0; i < 0xffff - 4; ++i)
+        TRY_OR_FAIL(stream.write_value<u8>('x'));
+    for (size_t i = 0; i < 100 * KiB; ++i)
+        TRY_OR_FAIL(stream.write_value<u8>('n'));
+    TRY_OR_FAIL(stream.write_value<u8>(0));
+    TRY_OR_FAIL(stream.write_until_depleted(member.bytes().slice(10)));
+
+    // Two members, to cross a member boundary as well.
+    TRY_OR_FAIL(stream.write_until_depleted(member));
+    auto encoded = TRY_OR_FAIL(stream.read_until_eof());
+
+    auto expected = TRY_OR_FAIL(ByteBuffer::copy(content));
+    TRY_OR_FAIL(expected.try_append(content));
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Gzip, encoded, expected);
+}
+
+TEST_CASE(deflate_with_zlib_wrapper)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(content));
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Deflate, encoded, content);
+}
+
+TEST_CASE(deflate_without_zlib_wrapper)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(content));
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Deflate, encoded, content);
+}
+
+TEST_CASE(deflate_with_stored_blocks)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(content, Compress::DeflateCompressor::CompressionLevel::STORE));
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Deflate, encoded, content);
+}
+
+TEST_CASE(brotli_with_large_metadata_block)
+{
+    auto content = make_content();
+
+    // LibCompress can't compress brotli, so this builds a stream by hand: a metadata block that is larger than any
+    // fixed lookahead would be, followed by the content in uncompressed meta-blocks, and an empty last meta-block.
+    AllocatingMemoryStream stream;
+    LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(stream) };
+
+    // WBITS: 16
+    TRY_OR_FAIL(bit_stream.write_bits(0u, 1));
+
+    // ISLAST: 0, MNIBBLES: 0 (metadata), reserved: 0, MSKIPBYTES: 3, MSKIPLEN - 1
+    static constexpr u32 metadata_size = 200 * KiB;
+    TRY_OR_FAIL(bit_stream.write_bits(0u, 1));
+    TRY_OR_FAIL(bit_stream.write_bits(3u, 2));
+    TRY_OR_FAIL(bit_stream.write_bits(0u, 1));
+    TRY_OR_FAIL(bit_stream.write_bits(3u, 2));
+    TRY_OR_FAIL(bit_stream.write_bits(metadata_size - 1, 24));
+    TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+    for (size_t i = 0; i < metadata_size; ++i)
+        TRY_OR_FAIL(bit_stream.write_value<u8>('m'));
+
+    for (size_t offset = 0; offset < content.size(); offset += 64 * KiB) {
+        auto block = content.bytes().slice(offset, min(64 * KiB, content.size() - offset));
+
+        // ISLAST: 0, MNIBBLES: 4, MLEN - 1, ISUNCOMPRESSED: 1
+        TRY_OR_FAIL(bit_stream.write_bits(0u, 1));
+        TRY_OR_FAIL(bit_stream.write_bits(0u, 2));
+        TRY_OR_FAIL(bit_stream.write_bits(block.size() - 1, 16));
+        TRY_OR_FAIL(bit_stream.write_bits(1u, 1));
+        TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+        TRY_OR_FAIL(bit_stream.write_until_depleted(block));
+    }
+
+    // ISLAST: 1, ISLASTEMPTY: 1
+    TRY_OR_FAIL(bit_stream.write_bits(1u, 1));
+    TRY_OR_FAIL(bit_stream.write_bits(1u, 1));
+    TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+    TRY_OR_FAIL(bit_stream.flush_buffer_to_stream());
+    auto encoded = TRY_OR_FAIL(stream.read_until_eof());
+
+    expect_decodes_in_pieces(HTTP::ContentDecoder::Encoding::Brotli, encoded, content);
+}
+
+TEST_CASE(truncated_content)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+    auto truncated = encoded.bytes().trim(encoded.size() / 2);
+    EXPECT(decode_in_pieces(HTTP::ContentDecoder::Encoding::Gzip, truncated, small_and_odd_pieces).is_error());
+}
+
+TEST_CASE(invalid_content)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+    encoded[0] = 'x';
+
+    auto decoder = TRY_OR_FAIL(HTTP::ContentDecoder::create(HTTP::ContentDecoder::Encoding::Gzip));
+    TRY_OR_FAIL(decoder->write(encoded.bytes().trim(100)));
+    EXPECT(decoder->read().is_error());
+
+    // The decoder stays failed.
+    EXPECT(decoder->write(encoded.bytes().slice(100)).is_error());
+    EXPECT(decoder->read().is_error());
+}
+
+TEST_CASE(content_that_decodes_to_much_more_than_it_encodes)
+{
+    // 64 MiB of zeroes compress to less than 100 KiB, so all of it arrives long before the client has read much.
+    static constexpr size_t content_size = 64 * MiB;
+    auto content = TRY_OR_FAIL(ByteBuffer::create_zeroed(content_size));
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+    content.clear();
+
+    auto decoder = TRY_OR_FAIL(HTTP::ContentDecoder::create(HTTP::ContentDecoder::Encoding::Gzip));
+    TRY_OR_FAIL(decoder->write(encoded));
+    decoder->finish();
+
+    size_t decoded_size = 0;
+    while (!decoder->is_done()) {
+        auto decoded_content = TRY_OR_FAIL(decoder->read());
+        EXPECT(decoded_content.size() <= HTTP::ContentDecoder::max_buffered_decoded_size);
+        EXPECT(all_of(decoded_content.bytes(), [](u8 byte) { return byte == 0; }));
+        decoded_size += decoded_content.size();
+    }
+    EXPECT_EQ(decoded_size, content_size);
+
+    // The decoder must never have gotten further ahead of the client than one read's worth.
+    EXPECT(decoder->peak_buffered_decoded_size() <= HTTP::ContentDecoder::max_buffered_decoded_size);
+}
+
+TEST_CASE(destroyed_while_waiting_for_input)
+{
+    auto content = make_content();
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+
+    auto decoder = TRY_OR_FAIL(HTTP::ContentDecoder::create(HTTP::ContentDecoder::Encoding::Gzip));
+    TRY_OR_FAIL(decoder->write(encoded.bytes().trim(encoded.size() / 2)));
+}
+
+TEST_CASE(destroyed_while_waiting_for_output_to_be_read)
+{
+    auto content = TRY_OR_FAIL(ByteBuffer::create_zeroed(16 * MiB));
+    auto encoded = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(content));
+
+    auto decoder = TRY_OR_FAIL(HTTP::ContentDecoder::create(HTTP::ContentDecoder::Encoding::Gzip));
+    TRY_OR_FAIL(decoder->write(encoded));
+    EXPECT_EQ(TRY_OR_FAIL(decoder->read()).size(), HTTP::ContentDecoder::max_buffered_decoded_size);
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/FixedArray.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Heap/CellAllocator.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/WorkStealingDeque.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+namespace {
+
+struct TestVM {
+    TestVM()
+        : vm(MUST(JS::VM::create()))
+        , execution_context(JS::create_simple_execution_context<JS::GlobalObject>(*vm))
+    {
+    }
+
+    JS::Value run(StringView source)
+    {
+        auto script = JS::Script::parse(source, *execution_context->realm);
+        VERIFY(!script.is_error());
+        auto result = vm->bytecode_interpreter().run(script.value());
+        VERIFY(!result.is_error());
+        return result.value();
+    }
+
+    bool is_young(StringView expression) { return run(expression).as_object().is_young(); }
+    bool is_remembered(StringView expression) { return run(expression).as_object().is_remembered(); }
+
+    JS::Heap& heap() { return vm->heap(); }
+
+    NonnullRefPtr<JS::VM> vm;
+    NonnullOwnPtr<JS::ExecutionContext> execution_context;
+};
+
+class DestructionCounter final : public JS::Cell {
+    JS_CELL(DestructionCounter, JS::Cell);
+    JS_DECLARE_ALLOCATOR(DestructionCounter);
+
+public:
+    static inline size_t destroyed_count = 0;
+
+    virtual ~DestructionCounter() override { ++destroyed_count; }
+
+private:
+    DestructionCounter() = default;
+};
+
+JS_DEFINE_ALLOCATOR(DestructionCounter);
+
+NEVER_INLINE void allocate_garbage(JS::Heap& heap, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        (void)heap.allocate_without_realm<DestructionCounter>();
+}
+
+}
+
+TEST_CASE(incremental_marking_keeps_cells_stored_between_slices)
+{
+    TestVM test;
+    test.run(R"~~~(
+        function makeBox() {
+            let value = null;
+            return { set(v) { value = v; }, get() { return value; } };
+        }
+        var ballast = [];
+        for (let i = 0; i < 20000; ++i)
+            ballast.push({ i });
+        var boxes = [];
+        var maps = [];
+        var pending = [];
+        for (let i = 0; i < 200; ++i) {
+            boxes.push(makeBox());
+            maps.push(new Map());
+            pending.push({ payload: i });
+        }
+        var refs = [];
+    )~~~"sv);
+
+    test.heap().start_incremental_marking();
+    while (test.heap().is_incremental_marking_in_progress()) {
+        // Move cells that may not have been marked yet into an environment and a map that may already have been,
+        // and drop every other reference to them.
+        test.run(R"~~~(
+            if (pending.length > 1) {
+                let value = pending.pop();
+                boxes[pending.length].set(value);
+                refs.push(new WeakRef(value));
+                value = pending.pop();
+                maps[pending.length].set("key", value);
+                refs.push(new WeakRef(value));
+            }
+        )~~~"sv);
+        // NOTE: WeakRefs only hold on to their target for the rest of the job that created them.
+        test.vm->finish_execution_generation();
+        test.heap().perform_incremental_marking_slice(Duration::zero());
+    }
+
+    EXPECT(test.heap().incremental_marking_slices().size() > 1);
+    EXPECT(test.run("refs.length > 0 && refs.every(ref => ref.deref() !== undefined)"sv).as_bool());
+}
+
+TEST_CASE(incremental_marking_final_pause_does_not_retrace_the_heap)
+{
+    TestVM test;
+    test.run(R"~~~(
+        var closures = [];
+        for (let i = 0; i < 20000; ++i) {
+            let captured = { i };
+            closures.push(() => captured);
+        }
+    )~~~"sv);
+
+    test.heap().start_incremental_marking();
+    while (test.heap().is_incremental_marking_in_progress())
+        test.heap().perform_incremental_marking_slice(Duration::from_milliseconds(1));
+
+    size_t cells_marked_in_slices = 0;
+    for (auto const& slice : test.heap().incremental_marking_slices())
+        cells_marked_in_slices += slice.marked_cells;
+
+    // Objects, functions and their environments are all behind write barriers, so only what's left (the realm and the
+    // like) has to be traced again in the final pause.
+    auto const& final_pause = test.heap().incremental_marking_final_pause();
+    dbgln("Incremental marking: {} cells in {} slices, final pause traced {} cells in {} us",
+        cells_marked_in_slices, test.heap().incremental_marking_slices().size(), final_pause.marked_cells, final_pause.time_spent.to_microseconds());
+    EXPECT(cells_marked_in_slices > 60000);
+    EXPECT(final_pause.marked_cells < cells_marked_in_slices / 4);
+}
+
+TEST_CASE(young_collection_keeps_cells_reachable_only_from_old_cells)
+{
+    TestVM test;
+    test.heap().set_generational_collection_enabled(true);
+    test.run(R"~~~(
+        function makeBox() {
+            let value = null;
+            return { set(v) { value = v; }, get() { return value; } };
+        }
+        var old = {};
+        var box = makeBox();
+        var map = new Map();
+        var unreachable = {};
+        var unreachableRef = new WeakRef(unreachable);
+    )~~~"sv);
+
+    // NOTE: A full collection promotes every cell that survives it, and fills in the remembered set.
+    test.vm->finish_execution_generation();
+    test.heap().collect_garbage();
+    EXPECT(!test.is_young("old"sv));
+    EXPECT(!test.is_remembered("old"sv));
+
+    test.run(R"~~~(
+        unreachable = null;
+        old.child = { payload: 1 };
+        box.set({ payload: 2 });
+        map.set("key", { payload: 3 });
+        var refs = [new WeakRef(old.child), new WeakRef(box.get()), new WeakRef(map.get("key"))];
+    )~~~"sv);
+    EXPECT(test.is_young("old.child"sv));
+    EXPECT(test.is_remembered("old"sv));
+    EXPECT(test.is_remembered("map"sv));
+
+    test.vm->finish_execution_generation();
+    test.heap().collect_garbage(JS::Heap::CollectionType::CollectYoungGeneration);
+
+    // The young cells were only reachable through old cells, and have been promoted.
+    EXPECT(test.run("refs.every(ref => ref.deref() !== undefined)"sv).as_bool());
+    EXPECT(!test.is_young("old.child"sv));
+    EXPECT(!test.is_young("box.get()"sv));
+    EXPECT(!test.is_young("map.get('key')"sv));
+
+    // Old cells with write barriers are forgotten again once they no longer point to young cells.
+    EXPECT(!test.is_remembered("old"sv));
+    EXPECT(!test.is_remembered("map"sv));
+
+    // A young collection leaves old cells alone, even if they are unreachable.
+    EXPECT(test.run("unreachableRef.deref() !== undefined"sv).as_bool());
+
+    test.vm->finish_execution_generation();
+    test.heap().collect_garbage();
+    EXPECT(test.run("unreachableRef.deref() === undefined"sv).as_bool());
+    EXPECT(test.run("old.child.payload === 1 && box.get().payload === 2 && map.get('key').payload === 3"sv).as_bool());
+}
+
+TEST_CASE(work_stealing_deque)
+{
+    JS::WorkStealingDeque<int, 4> deque;
+    int values[5] = { 0, 1, 2, 3, 4 };
+
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT(deque.push(&values[i]));
+    EXPECT(!deque.push(&values[4]));
+
+    // The owner works at the bottom, thieves take from the top.
+    EXPECT_EQ(deque.pop(), &values[3]);
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.steal(), &values[1]);
+    EXPECT_EQ(deque.pop(), &values[2]);
+    EXPECT(deque.is_empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+}
+
+TEST_CASE(work_stealing_deque_hands_out_each_value_once)
+{
+    static constexpr size_t value_count = 100000;
+    static constexpr size_t thief_count = 3;
+
+    JS::WorkStealingDeque<size_t, 256> deque;
+    Vector<size_t> values;
+    for (size_t i = 0; i < value_count; ++i)
+        values.append(i);
+    auto taken_count = MUST(FixedArray<Atomic<size_t>>::create(value_count));
+    Atomic<bool> done { false };
+
+    Vector<NonnullRefPtr<Threading::Thread>> thieves;
+    for (size_t i = 0; i < thief_count; ++i) {
+        thieves.append(Threading::Thread::construct([&] {
+            while (!done.load()) {
+                if (auto* value = deque.steal())
+                    ++taken_count[*value];
+            }
+            return 0;
+        }));
+        thieves.last()->start();
+    }
+
+    for (size_t i = 0; i < value_count;) {
+        if (!deque.push(&values[i])) {
+            if (auto* value = deque.pop())
+                ++taken_count[*value];
+            continue;
+        }
+        if (++i % 3 == 0) {
+            if (auto* value = deque.pop())
+                ++taken_count[*value];
+        }
+    }
+    while (auto* value = deque.pop())
+        ++taken_count[*value];
+
+    done = true;
+    for (auto& thief : thieves)
+        (void)thief->join();
+
+    for (size_t i = 0; i < value_count; ++i)
+        EXPECT_EQ(taken_count[i].load(), 1u);
+}
+
+TEST_CASE(parallel_marking_marks_every_live_cell)
+{
+    TestVM test;
+    test.heap().set_parallel_marking_enabled(true, 4);
+    EXPECT(test.heap().parallel_marking_enabled());
+
+    test.run(R"~~~(
+        function makeTree(depth) {
+            if (depth === 0)
+                return { leaf: true };
+            let left = makeTree(depth - 1);
+            let right = makeTree(depth - 1);
+            return { left, get right() { return right; } };
+        }
+        var kept = [];
+        var dropped = [];
+        var keptRefs = [];
+        var droppedRefs = [];
+        for (let i = 0; i < 40; ++i) {
+            let tree = makeTree(8);
+            let leaf = tree;
+            while (!leaf.leaf)
+                leaf = i % 2 ? leaf.left : leaf.right;
+            if (i % 4) {
+                kept.push(tree);
+                keptRefs.push(new WeakRef(leaf));
+            } else {
+                dropped.push(tree);
+                droppedRefs.push(new WeakRef(leaf));
+            }
+        }
+        dropped = null;
+    )~~~"sv);
+
+    test.vm->finish_execution_generation();
+    test.heap().collect_garbage();
+
+    EXPECT(test.run("keptRefs.every(ref => ref.deref() !== undefined)"sv).as_bool());
+    EXPECT(test.run("kept.every(tree => tree.left.right.left !== undefined)"sv).as_bool());
+    // NOTE: A stale pointer on the stack may keep the odd dropped cell alive, since the stack is scanned conservatively.
+    EXPECT(test.run("droppedRefs.filter(ref => ref.deref() !== undefined).length <= 1"sv).as_bool());
+}
+
+TEST_CASE(lazy_sweep_finishes_when_idle_or_on_the_next_collection)
+{
+    TestVM test;
+    auto& heap = test.heap();
+    heap.collect_garbage();
+    heap.perform_lazy_sweep_slice(Duration::from_seconds(10));
+
+    // Dead cells are only found dead by the collection itself, and destroyed when their blocks are swept.
+    DestructionCounter::destroyed_count = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage();
+    EXPECT(heap.has_blocks_pending_sweep());
+    EXPECT_EQ(DestructionCounter::destroyed_count, 0u);
+
+    heap.perform_lazy_sweep_slice(Duration::from_seconds(10));
+    EXPECT(!heap.has_blocks_pending_sweep());
+    EXPECT(DestructionCounter::destroyed_count > 900);
+
+    // Without an idle period, the next collection sweeps what the previous one left behind.
+    DestructionCounter::destroyed_count = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage();
+    EXPECT_EQ(DestructionCounter::destroyed_count, 0u);
+    heap.collect_garbage();
+    EXPECT(DestructionCounter::destroyed_count > 900);
+
+    // That goes for young generation collections as well.
+    heap.set_generational_collection_enabled(true);
+    heap.collect_garbage();
+    DestructionCounter::destroyed_count = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage();
+    EXPECT_EQ(DestructionCounter::destroyed_count, 0u);
+    heap.collect_garbage(JS::Heap::CollectionType::CollectYoungGeneration);
+    EXPECT(DestructionCounter::destroyed_count > 900);
+}
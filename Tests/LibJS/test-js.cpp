@@ -6,7 +6,9 @@
  */
 
 #include <LibCore/Environment.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Script.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <stdlib.h>
 #include <time.h>
@@ -28,6 +30,15 @@ TESTJS_GLOBAL_FUNCTION(can_parse_source, canParseSource)
     return JS::Value(!parser.has_errors());
 }
 
+TESTJS_GLOBAL_FUNCTION(evaluate_script, evaluateScript)
+{
+    auto source = TRY(vm.argument(0).to_byte_string(vm));
+    auto script_or_errors = JS::Script::parse(source, *vm.current_realm());
+    if (script_or_errors.is_error())
+        return vm.throw_completion<JS::SyntaxError>(script_or_errors.error()[0].to_string());
+    return vm.bytecode_interpreter().run(*script_or_errors.value());
+}
+
 TESTJS_GLOBAL_FUNCTION(run_queued_promise_jobs, runQueuedPromiseJobs)
 {
     vm.run_queued_promise_jobs();
@@ -111,6 +122,13 @@ TESTJS_GLOBAL_FUNCTION(set_time_zone, setTimeZone)
     return current_time_zone;
 }
 
+TESTJS_GLOBAL_FUNCTION(set_jit_enabled, setJITEnabled)
+{
+    auto was_enabled = JS::JIT::g_jit_enabled;
+    JS::JIT::g_jit_enabled = vm.argument(0).to_boolean();
+    return JS::Value(was_enabled);
+}
+
 TESTJS_RUN_FILE_FUNCTION(ByteString const& test_file, JS::Realm& realm, JS::ExecutionContext&)
 {
     if (!test262_parser_tests)
@@ -316,6 +316,15 @@ TEST_CASE(select_with_where)
     for (auto& row : result) {
         EXPECT(row.row[1].to_int<i32>().value() > 44);
     }
+
+    // The operands of AND are type checked even when one of them is false for every row.
+    auto select_result = try_execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (IntColumn = 999) AND TextColumn;");
+    EXPECT(select_result.is_error());
+    EXPECT_EQ(select_result.error().error(), SQL::SQLErrorCode::BooleanOperatorTypeMismatch);
+
+    select_result = try_execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (IntColumn = 999) AND ((IntColumn + TextColumn) < 5);");
+    EXPECT(select_result.is_error());
+    EXPECT_EQ(select_result.error().error(), SQL::SQLErrorCode::NumericOperatorTypeMismatch);
 }
 
 TEST_CASE(select_cross_join)
@@ -384,6 +393,77 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_filters)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database, "CREATE TABLE TestSchema.TestTable3 ( TextColumn3 text, IntColumn3 integer );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 42 ), "
+        "( 'Test_4', 50 ), "
+        "( 'Test_5', 44 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 42 ), "
+        "( 'Test_11', 43 ), "
+        "( 'Test_12', 42 ), "
+        "( 'Test_13', 51 ), "
+        "( 'Test_14', 44 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable3 ( TextColumn3, IntColumn3 ) VALUES "
+        "( 'Test_10', 1 ), "
+        "( 'Test_12', 2 ), "
+        "( 'Test_14', 3 );");
+    EXPECT(result.size() == 3);
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn2 != 'Test_12') "
+        "ORDER BY TextColumn1;");
+    EXPECT_EQ(result.size(), 4u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_2");
+    EXPECT_EQ(result[1].row[1].to_byte_string(), "Test_11");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[2].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[3].row[0].to_byte_string(), "Test_5");
+    EXPECT_EQ(result[3].row[1].to_byte_string(), "Test_14");
+
+    result = execute(database,
+        "SELECT TextColumn1, IntColumn3 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2, TestSchema.TestTable3 "
+        "WHERE (TextColumn2 = TextColumn3) AND (TestTable2.IntColumn = TestTable1.IntColumn) AND (IntColumn3 > 1) AND (TextColumn1 != 'Test_3') "
+        "ORDER BY TextColumn1;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_int<i32>(), 2);
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_5");
+    EXPECT_EQ(result[1].row[1].to_int<i32>(), 3);
+
+    auto select_result = try_execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND TextColumn1;");
+    EXPECT(select_result.is_error());
+    EXPECT_EQ(select_result.error().error(), SQL::SQLErrorCode::BooleanOperatorTypeMismatch);
+
+    // The filter on TestTable1 rejects all of its rows, so the join is never evaluated on a single row.
+    select_result = try_execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = 999) AND ((TextColumn1 + TestTable2.IntColumn) < 5);");
+    EXPECT(select_result.is_error());
+    EXPECT_EQ(select_result.error().error(), SQL::SQLErrorCode::NumericOperatorTypeMismatch);
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
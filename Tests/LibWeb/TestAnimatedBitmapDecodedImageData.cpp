@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Bitmap.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
+#include <unistd.h>
+
+namespace {
+
+// Decodes frames of animations with `frame_count` frames, but only when told to, so that tests can control when (and
+// whether) replies to requests for frames arrive.
+class FakeImageCodecPlugin final : public Web::Platform::ImageCodecPlugin {
+public:
+    static constexpr u32 frame_count = 200;
+
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)>, Function<void(Error&)>) override { VERIFY_NOT_REACHED(); }
+    virtual Optional<i64> start_progressive_decode(Optional<ByteString>, Function<void(NonnullRefPtr<Gfx::Bitmap>)>) override { return {}; }
+    virtual void append_progressive_decode_data(i64, ReadonlyBytes) override { VERIFY_NOT_REACHED(); }
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> finish_progressive_decode(i64, Function<ErrorOr<void>(Web::Platform::DecodedImage&)>, Function<void(Error&)>) override { VERIFY_NOT_REACHED(); }
+    virtual void cancel_progressive_decode(i64) override { VERIFY_NOT_REACHED(); }
+
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, Function<void(u32, Vector<Web::Platform::Frame>&)> on_decoded) override
+    {
+        m_requests.append({ image_id, start_frame_index, count, move(on_decoded) });
+    }
+
+    virtual void stop_animation_decode(i64 image_id) override { m_stopped_image_ids.append(image_id); }
+
+    struct Request {
+        i64 image_id { 0 };
+        u32 start_frame_index { 0 };
+        u32 count { 0 };
+        Function<void(u32, Vector<Web::Platform::Frame>&)> on_decoded;
+    };
+
+    Vector<Request>& requests() { return m_requests; }
+    Vector<i64>& stopped_image_ids() { return m_stopped_image_ids; }
+
+    NonnullRefPtr<Gfx::Bitmap> bitmap_of_frame(u32 frame_index)
+    {
+        return m_frame_bitmaps.ensure(frame_index, [] { return MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 1, 1 })); });
+    }
+
+    // Replies to every request for frames, including the ones made in response to the replies.
+    void decode_requested_frames()
+    {
+        while (!m_requests.is_empty()) {
+            auto request = m_requests.take_first();
+            Vector<Web::Platform::Frame> frames;
+            for (u32 i = 0; i < request.count; ++i) {
+                auto frame_index = (request.start_frame_index + i) % frame_count;
+                frames.append({ bitmap_of_frame(frame_index), frame_index + 1 });
+            }
+            request.on_decoded(request.start_frame_index, frames);
+        }
+    }
+
+    // Replies to the oldest request the way the decoder does when it fails to decode the frames.
+    void fail_to_decode_oldest_request()
+    {
+        auto request = m_requests.take_first();
+        Vector<Web::Platform::Frame> no_frames;
+        request.on_decoded(request.start_frame_index, no_frames);
+    }
+
+private:
+    Vector<Request> m_requests;
+    Vector<i64> m_stopped_image_ids;
+    HashMap<u32, NonnullRefPtr<Gfx::Bitmap>> m_frame_bitmaps;
+};
+
+struct TestEnvironment {
+    TestEnvironment()
+        : vm(MUST(JS::VM::create()))
+        , execution_context(JS::create_simple_execution_context<JS::GlobalObject>(*vm))
+    {
+        static bool s_initialized = false;
+        if (!s_initialized) {
+            s_plugin = new FakeImageCodecPlugin;
+            Web::Platform::ImageCodecPlugin::install(*s_plugin);
+            s_initialized = true;
+        }
+        plugin().requests().clear();
+        plugin().stopped_image_ids().clear();
+    }
+
+    FakeImageCodecPlugin& plugin() { return *s_plugin; }
+    JS::Realm& realm() { return *execution_context->realm; }
+
+    // Creates image data the way SharedImageRequest does for long animations: with only the first few frames decoded.
+    JS::NonnullGCPtr<Web::HTML::AnimatedBitmapDecodedImageData> create_image_data(i64 image_id)
+    {
+        Vector<Web::HTML::AnimatedBitmapDecodedImageData::Frame> frames;
+        for (u32 i = 0; i < 8; ++i)
+            frames.append({ Gfx::ImmutableBitmap::create(plugin().bitmap_of_frame(i)), static_cast<int>(i + 1) });
+        return MUST(Web::HTML::AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(realm(), move(frames), FakeImageCodecPlugin::frame_count, 0, image_id));
+    }
+
+    bool shows_frame(Web::HTML::AnimatedBitmapDecodedImageData const& image_data, u32 frame_index)
+    {
+        auto bitmap = image_data.bitmap(frame_index);
+        return bitmap && &bitmap->bitmap() == plugin().bitmap_of_frame(frame_index).ptr();
+    }
+
+    size_t resident_frame_count(Web::HTML::AnimatedBitmapDecodedImageData const& image_data)
+    {
+        size_t count = 0;
+        for (u32 i = 0; i < FakeImageCodecPlugin::frame_count; ++i) {
+            if (shows_frame(image_data, i))
+                ++count;
+        }
+        return count;
+    }
+
+    NonnullRefPtr<JS::VM> vm;
+    NonnullOwnPtr<JS::ExecutionContext> execution_context;
+    static inline FakeImageCodecPlugin* s_plugin { nullptr };
+};
+
+NEVER_INLINE void create_unreachable_image_data(TestEnvironment& environment, i64 first_image_id, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        (void)environment.create_image_data(first_image_id + i);
+}
+
+}
+
+TEST_CASE(only_frames_around_the_one_being_shown_stay_resident)
+{
+    TestEnvironment environment;
+    auto image_data = environment.create_image_data(1);
+    int consumer = 0;
+
+    // Twice around the animation, so that frames that were dropped have to be decoded again.
+    for (u32 i = 0; i < FakeImageCodecPlugin::frame_count * 2; ++i) {
+        auto frame_index = i % FakeImageCodecPlugin::frame_count;
+        image_data->did_advance_to_frame(&consumer, frame_index);
+        environment.plugin().decode_requested_frames();
+
+        EXPECT(environment.shows_frame(image_data, frame_index));
+        EXPECT_EQ(image_data->frame_duration(frame_index), static_cast<int>(frame_index + 1));
+
+        // No more than two batches of frames ahead of the one being shown, and the one before it.
+        EXPECT(environment.resident_frame_count(image_data) <= 17u);
+    }
+}
+
+TEST_CASE(unreachable_image_data_stops_its_animation_decode)
+{
+    TestEnvironment environment;
+    auto& heap = environment.vm->heap();
+
+    auto kept_image_data = environment.create_image_data(100);
+    create_unreachable_image_data(environment, 101, 10);
+    heap.collect_garbage();
+    heap.perform_lazy_sweep_slice(Duration::from_seconds(10));
+
+    // NOTE: A stale pointer on the stack may keep the odd dropped cell alive, since the stack is scanned conservatively.
+    auto& stopped_image_ids = environment.plugin().stopped_image_ids();
+    EXPECT(stopped_image_ids.size() >= 9);
+    EXPECT(!stopped_image_ids.contains_slow(100));
+    for (auto image_id : stopped_image_ids)
+        EXPECT(image_id > 100 && image_id <= 110);
+}
+
+TEST_CASE(consumer_joining_mid_animation_gets_its_own_frames)
+{
+    TestEnvironment environment;
+    auto image_data = environment.create_image_data(2);
+    int first_consumer = 0;
+    int second_consumer = 0;
+
+    for (u32 frame_index = 0; frame_index <= 100; ++frame_index) {
+        image_data->did_advance_to_frame(&first_consumer, frame_index);
+        environment.plugin().decode_requested_frames();
+    }
+    EXPECT(!environment.shows_frame(image_data, 50));
+
+    // The frame the new consumer is on is the one needed the soonest.
+    image_data->did_advance_to_frame(&second_consumer, 50);
+    EXPECT_EQ(environment.plugin().requests().size(), 1u);
+    EXPECT_EQ(environment.plugin().requests().first().start_frame_index, 50u);
+    environment.plugin().decode_requested_frames();
+
+    // Both consumers keep their frames.
+    for (u32 i = 0; i < 8; ++i) {
+        EXPECT(environment.shows_frame(image_data, 50 + i));
+        EXPECT(environment.shows_frame(image_data, 100 + i));
+    }
+
+    // Frames are still decoded ahead of each of them.
+    for (u32 i = 1; i <= 20; ++i) {
+        image_data->did_advance_to_frame(&first_consumer, 100 + i);
+        image_data->did_advance_to_frame(&second_consumer, 50 + i);
+        environment.plugin().decode_requested_frames();
+        EXPECT(environment.shows_frame(image_data, 100 + i));
+        EXPECT(environment.shows_frame(image_data, 50 + i));
+    }
+}
+
+TEST_CASE(unanswered_frame_requests_are_given_up_on)
+{
+    TestEnvironment environment;
+    auto image_data = environment.create_image_data(3);
+    int consumer = 0;
+
+    image_data->did_advance_to_frame(&consumer, 1);
+    EXPECT_EQ(environment.plugin().requests().size(), 1u);
+    EXPECT_EQ(environment.plugin().requests().first().start_frame_index, 8u);
+
+    // A failed decode leaves the request pending, and only one request is in flight at a time.
+    environment.plugin().fail_to_decode_oldest_request();
+    image_data->did_advance_to_frame(&consumer, 2);
+    EXPECT(environment.plugin().requests().is_empty());
+
+    // While waiting for frames, the closest one before that has been decoded is shown instead.
+    image_data->did_advance_to_frame(&consumer, 8);
+    EXPECT(environment.plugin().requests().is_empty());
+    EXPECT(!environment.shows_frame(image_data, 8));
+    EXPECT(environment.shows_frame(image_data, 7));
+    EXPECT_EQ(&image_data->bitmap(8)->bitmap(), environment.plugin().bitmap_of_frame(7).ptr());
+
+    // Two seconds later, we ask again.
+    usleep(2'100'000);
+    image_data->did_advance_to_frame(&consumer, 8);
+    EXPECT_EQ(environment.plugin().requests().size(), 1u);
+    EXPECT_EQ(environment.plugin().requests().first().start_frame_index, 8u);
+    environment.plugin().decode_requested_frames();
+    EXPECT(environment.shows_frame(image_data, 8));
+}
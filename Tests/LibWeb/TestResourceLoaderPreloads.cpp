@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibCore/EventLoop.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Platform/EventLoopPluginSerenity.h>
+#include <LibWeb/WebSockets/WebSocket.h>
+
+namespace {
+
+class FakeRequest final : public Web::ResourceLoaderConnectorRequest {
+public:
+    static NonnullRefPtr<FakeRequest> create() { return adopt_ref(*new FakeRequest); }
+
+    virtual void set_buffered_request_finished_callback(Protocol::Request::BufferedRequestFinished on_finished) override { m_on_buffered_request_finished = move(on_finished); }
+
+    virtual void set_unbuffered_request_callbacks(Protocol::Request::HeadersReceived on_headers_received, Protocol::Request::DataReceived on_data_received, Protocol::Request::RequestFinished on_finished) override
+    {
+        m_on_headers_received = move(on_headers_received);
+        m_on_data_received = move(on_data_received);
+        m_on_finished = move(on_finished);
+    }
+
+    virtual bool stop() override { return true; }
+
+    void respond(StringView body)
+    {
+        HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> response_headers;
+        response_headers.set("Content-Type", "text/plain");
+        if (m_on_buffered_request_finished) {
+            m_on_buffered_request_finished(true, body.length(), response_headers, 200u, body.bytes());
+            return;
+        }
+        m_on_headers_received(response_headers, 200u);
+        m_on_data_received(body.bytes());
+        m_on_finished(true, body.length());
+    }
+
+private:
+    FakeRequest() = default;
+
+    Protocol::Request::BufferedRequestFinished m_on_buffered_request_finished;
+    Protocol::Request::HeadersReceived m_on_headers_received;
+    Protocol::Request::DataReceived m_on_data_received;
+    Protocol::Request::RequestFinished m_on_finished;
+};
+
+class FakeConnector final : public Web::ResourceLoaderConnector {
+public:
+    static NonnullRefPtr<FakeConnector> create() { return adopt_ref(*new FakeConnector); }
+
+    virtual void prefetch_dns(URL::URL const&) override { }
+    virtual void preconnect(URL::URL const&) override { }
+
+    virtual RefPtr<Web::ResourceLoaderConnectorRequest> start_request(ByteString const&, URL::URL const&, HashMap<ByteString, ByteString> const& = {}, ReadonlyBytes = {}, Core::ProxyData const& = {}) override
+    {
+        auto request = FakeRequest::create();
+        m_requests.append(request);
+        return request;
+    }
+
+    virtual RefPtr<Web::WebSockets::WebSocketClientSocket> websocket_connect(const URL::URL&, ByteString const&, Vector<ByteString> const&) override { return nullptr; }
+
+    Vector<NonnullRefPtr<FakeRequest>>& requests() { return m_requests; }
+
+private:
+    FakeConnector() = default;
+
+    Vector<NonnullRefPtr<FakeRequest>> m_requests;
+};
+
+struct TestEnvironment {
+    TestEnvironment()
+    {
+        static bool s_initialized = false;
+        if (!s_initialized) {
+            Web::Platform::EventLoopPlugin::install(*new Web::Platform::EventLoopPluginSerenity);
+            s_connector = FakeConnector::create();
+            Web::ResourceLoader::initialize(s_connector);
+            s_initialized = true;
+        }
+        s_connector->requests().clear();
+        Web::ResourceLoader::the().clear_cache();
+        Web::ResourceLoader::the().set_preloaded_response_lifetime(Duration::from_seconds(30));
+    }
+
+    ~TestEnvironment()
+    {
+        Web::ResourceLoader::the().clear_cache();
+    }
+
+    FakeConnector& connector() { return *s_connector; }
+
+    void run_pending_tasks()
+    {
+        event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    }
+
+    Core::EventLoop event_loop;
+    static inline RefPtr<FakeConnector> s_connector;
+};
+
+Web::LoadRequest make_request(StringView url, StringView accept)
+{
+    Web::LoadRequest request;
+    request.set_url(URL::URL(url));
+    request.set_header("Accept", accept);
+    return request;
+}
+
+}
+
+TEST_CASE(preloaded_responses_are_reused)
+{
+    TestEnvironment environment;
+
+    auto script_request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    auto style_sheet_request = make_request("https://example.com/style.css"sv, "text/css,*/*;q=0.1"sv);
+    Web::ResourceLoader::the().preload(script_request);
+    Web::ResourceLoader::the().preload(style_sheet_request);
+    EXPECT_EQ(environment.connector().requests().size(), 2u);
+
+    // The script arrives before anybody asks for it, the style sheet afterwards.
+    environment.connector().requests()[0]->respond("script"sv);
+
+    ByteString script_body;
+    ByteString style_sheet_body;
+    Web::ResourceLoader::the().load(script_request, [&](auto data, auto&, auto) { script_body = ByteString(data); });
+    Web::ResourceLoader::the().load(style_sheet_request, [&](auto data, auto&, auto) { style_sheet_body = ByteString(data); });
+    EXPECT_EQ(environment.connector().requests().size(), 2u);
+
+    environment.connector().requests()[1]->respond("style sheet"sv);
+    environment.run_pending_tasks();
+    EXPECT_EQ(script_body, "script"sv);
+    EXPECT_EQ(style_sheet_body, "style sheet"sv);
+
+    // A preload is only handed out once.
+    Web::ResourceLoader::the().load(script_request, [](auto, auto&, auto) {});
+    EXPECT_EQ(environment.connector().requests().size(), 3u);
+}
+
+TEST_CASE(mismatched_requests_are_not_served_from_preloads)
+{
+    TestEnvironment environment;
+
+    auto preload_request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    Web::ResourceLoader::the().preload(preload_request);
+    environment.connector().requests()[0]->respond("script"sv);
+
+    auto post_request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    post_request.set_method("POST");
+    Web::ResourceLoader::the().load(post_request, [](auto, auto&, auto) {});
+    EXPECT_EQ(environment.connector().requests().size(), 2u);
+
+    // A fetch with a different credentials mode sends different cookies.
+    auto credentialed_request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    credentialed_request.set_header("Cookie", "session=1");
+    Web::ResourceLoader::the().load(credentialed_request, [](auto, auto&, auto) {});
+    EXPECT_EQ(environment.connector().requests().size(), 3u);
+
+    auto other_destination_request = make_request("https://example.com/script.js"sv, "text/css,*/*;q=0.1"sv);
+    Web::ResourceLoader::the().load(other_destination_request, [](auto, auto&, auto) {});
+    EXPECT_EQ(environment.connector().requests().size(), 4u);
+
+    // The preload is still there for the request that it was made for.
+    Web::ResourceLoader::the().load(preload_request, [](auto, auto&, auto) {});
+    EXPECT_EQ(environment.connector().requests().size(), 4u);
+    environment.run_pending_tasks();
+}
+
+TEST_CASE(expired_preloads_are_not_served)
+{
+    TestEnvironment environment;
+    Web::ResourceLoader::the().set_preloaded_response_lifetime(Duration::zero());
+
+    auto request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    Web::ResourceLoader::the().preload(request);
+    environment.connector().requests()[0]->respond("preloaded"sv);
+
+    ByteString body;
+    Web::ResourceLoader::the().load(request, [&](auto data, auto&, auto) { body = ByteString(data); });
+    EXPECT_EQ(environment.connector().requests().size(), 2u);
+    environment.connector().requests()[1]->respond("fetched"sv);
+    EXPECT_EQ(body, "fetched"sv);
+}
+
+TEST_CASE(expired_preloads_are_not_served_to_unbuffered_loads)
+{
+    TestEnvironment environment;
+    Web::ResourceLoader::the().set_preloaded_response_lifetime(Duration::zero());
+
+    auto request = make_request("https://example.com/script.js"sv, "*/*"sv);
+    Web::ResourceLoader::the().preload(request);
+
+    Optional<u32> status_code;
+    ByteString body;
+    bool completed = false;
+    Web::ResourceLoader::the().load_unbuffered(
+        request,
+        [&](auto&, auto code) { status_code = code; },
+        [&](auto data) { body = ByteString(data); },
+        [&](bool success, auto) { completed = success; });
+    EXPECT_EQ(environment.connector().requests().size(), 2u);
+
+    // NOTE: The load must have gone out with its callbacks intact.
+    environment.connector().requests()[1]->respond("fetched"sv);
+    EXPECT_EQ(status_code, 200u);
+    EXPECT_EQ(body, "fetched"sv);
+    EXPECT(completed);
+}
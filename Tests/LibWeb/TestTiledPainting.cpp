@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibWeb/Painting/CommandExecutorCPU.h>
+#include <LibWeb/Painting/CommandList.h>
+
+using namespace Web::Painting;
+
+static NonnullRefPtr<Gfx::Bitmap> create_bitmap()
+{
+    // NOTE: Not a multiple of the tile size, so that there are partial tiles at the edges.
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 1100, 700 }));
+    bitmap->fill(Color::White);
+    return bitmap;
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& a, Gfx::Bitmap const& b)
+{
+    size_t differing_pixel_count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            if (a.get_pixel(x, y) != b.get_pixel(x, y))
+                ++differing_pixel_count;
+        }
+    }
+    EXPECT_EQ(differing_pixel_count, 0u);
+}
+
+static PushStackingContext translated_stacking_context(Gfx::IntRect source_paintable_rect, Gfx::FloatPoint translation, float opacity = 1.0f)
+{
+    return PushStackingContext {
+        .opacity = opacity,
+        .is_fixed_position = false,
+        .source_paintable_rect = source_paintable_rect,
+        .post_transform_translation = {},
+        .image_rendering = Web::CSS::ImageRendering::Auto,
+        .transform = {
+            .origin = source_paintable_rect.center().to_type<float>(),
+            .matrix = Gfx::translation_matrix(Gfx::FloatVector3 { translation.x(), translation.y(), 0 }),
+        },
+    };
+}
+
+static void append_fill(CommandList& command_list, Gfx::IntRect rect, Color color)
+{
+    command_list.append(FillRect { .rect = rect, .color = color, .clip_paths = {} }, {});
+}
+
+static CommandList create_command_list()
+{
+    CommandList command_list;
+
+    // Spans all tiles.
+    append_fill(command_list, { 10, 10, 1080, 680 }, Color::from_rgb(0xe0e0e0));
+    append_fill(command_list, { 500, 500, 30, 30 }, Color::Red);
+
+    // Nested translations, with the innermost rect landing in a different tile than the outer ones.
+    command_list.append(translated_stacking_context({ 0, 0, 200, 200 }, { 300, 20 }), {});
+    append_fill(command_list, { 0, 0, 100, 100 }, Color::Green);
+    command_list.append(translated_stacking_context({ 0, 0, 200, 200 }, { 400, 450 }), {});
+    append_fill(command_list, { 0, 0, 120, 60 }, Color::Blue);
+    command_list.append(PopStackingContext {}, {});
+    command_list.append(PopStackingContext {}, {});
+
+    // Semi-transparent layers: one within a single tile, one straddling the corner of four tiles, and one nested in another.
+    command_list.append(translated_stacking_context({ 50, 50, 100, 100 }, {}, 0.5f), {});
+    append_fill(command_list, { 50, 50, 100, 100 }, Color::Magenta);
+    command_list.append(PopStackingContext {}, {});
+
+    command_list.append(translated_stacking_context({ 450, 450, 120, 120 }, { 3, 5 }, 0.5f), {});
+    append_fill(command_list, { 450, 450, 120, 120 }, Color::Cyan);
+    command_list.append(translated_stacking_context({ 470, 470, 60, 60 }, { 10, 0 }, 0.5f), {});
+    append_fill(command_list, { 470, 470, 60, 60 }, Color::Yellow);
+    command_list.append(PopStackingContext {}, {});
+    command_list.append(PopStackingContext {}, {});
+
+    // A fixed position layer, nested in a translation.
+    command_list.append(translated_stacking_context({ 0, 0, 10, 10 }, { 700, 100 }), {});
+    auto fixed_position_stacking_context = translated_stacking_context({ 980, 490, 80, 80 }, {}, 0.75f);
+    fixed_position_stacking_context.is_fixed_position = true;
+    command_list.append(move(fixed_position_stacking_context), {});
+    append_fill(command_list, { 980, 490, 80, 80 }, Color::Black);
+    command_list.append(PopStackingContext {}, {});
+    command_list.append(PopStackingContext {}, {});
+
+    // A masked layer across the boundary of two tiles.
+    auto mask = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 64, 64 }));
+    for (int y = 0; y < mask->height(); ++y) {
+        for (int x = 0; x < mask->width(); ++x)
+            mask->set_pixel(x, y, Color(0, 0, 0, x * 4));
+    }
+    auto masked_stacking_context = translated_stacking_context({ 490, 200, 64, 64 }, {});
+    masked_stacking_context.mask = StackingContextMask { .mask_bitmap = move(mask), .mask_kind = Gfx::Bitmap::MaskKind::Alpha };
+    command_list.append(move(masked_stacking_context), {});
+    append_fill(command_list, { 490, 200, 64, 64 }, Color::Red);
+    command_list.append(PopStackingContext {}, {});
+
+    return command_list;
+}
+
+TEST_CASE(tiled_painting_matches_serial_painting)
+{
+    auto command_list = create_command_list();
+
+    auto serially_painted_bitmap = create_bitmap();
+    CommandExecutorCPU executor(*serially_painted_bitmap);
+    command_list.execute(executor);
+
+    auto tiled_bitmap = create_bitmap();
+    execute_command_list_in_tiles(command_list, *tiled_bitmap);
+    expect_same_pixels(*serially_painted_bitmap, *tiled_bitmap);
+
+    // Repainting a damaged rect on top of a stale bitmap fixes up exactly that rect.
+    auto partially_repainted_bitmap = create_bitmap();
+    execute_command_list_in_tiles(command_list, *partially_repainted_bitmap);
+    partially_repainted_bitmap->fill(Color::White);
+    execute_command_list_in_tiles(command_list, *partially_repainted_bitmap, Gfx::IntRect { 400, 400, 300, 200 });
+    for (int y = 0; y < partially_repainted_bitmap->height(); ++y) {
+        for (int x = 0; x < partially_repainted_bitmap->width(); ++x) {
+            auto expected_color = Gfx::IntRect { 400, 400, 300, 200 }.contains(x, y) ? serially_painted_bitmap->get_pixel(x, y) : Color(Color::White);
+            if (partially_repainted_bitmap->get_pixel(x, y) != expected_color) {
+                FAIL(ByteString::formatted("Pixel at {},{} is {} instead of {}", x, y, partially_repainted_bitmap->get_pixel(x, y), expected_color));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(empty_damage_rect_paints_nothing)
+{
+    auto command_list = create_command_list();
+    auto bitmap = create_bitmap();
+    execute_command_list_in_tiles(command_list, *bitmap, Gfx::IntRect {});
+    execute_command_list_in_tiles(command_list, *bitmap, Gfx::IntRect { 2000, 2000, 10, 10 });
+    expect_same_pixels(*bitmap, *create_bitmap());
+}
+
+TEST_CASE(stacking_contexts_outside_of_a_tile_are_skipped)
+{
+    CommandList command_list;
+    command_list.append(translated_stacking_context({ 0, 0, 100, 100 }, { 600, 0 }, 0.5f), {});
+    append_fill(command_list, { 0, 0, 100, 100 }, Color::Red);
+    command_list.append(PopStackingContext {}, {});
+    command_list.append(translated_stacking_context({ 0, 0, 100, 100 }, { 600, 0 }), {});
+    append_fill(command_list, { 0, 0, 100, 100 }, Color::Red);
+    command_list.append(PopStackingContext {}, {});
+
+    // The layer isn't even pushed, while the translation is kept for the (culled) commands within it.
+    auto command_indices = command_list.commands_affecting_rect({ 0, 0, 512, 512 });
+    EXPECT_EQ(command_indices.size(), 2u);
+    EXPECT_EQ(command_indices[0], 3u);
+    EXPECT_EQ(command_indices[1], 5u);
+
+    EXPECT_EQ(command_list.commands_affecting_rect({ 512, 0, 512, 512 }).size(), 6u);
+}
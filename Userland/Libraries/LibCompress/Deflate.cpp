@@ -9,6 +9,7 @@
 #include <AK/Assertions.h>
 #include <AK/BinarySearch.h>
 #include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
@@ -22,31 +23,16 @@ static constexpr u8 deflate_special_code_length_long_zeros = 18;
 
 static constexpr int EndOfBlock = 256;
 
+// NOTE: These are initialized on first use in a thread-safe manner, as they may be used by several compressors at once.
 CanonicalCode const& CanonicalCode::fixed_literal_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
-    initialized = true;
-
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
     return code;
 }
 
 CanonicalCode const& CanonicalCode::fixed_distance_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
-    initialized = true;
-
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
     return code;
 }
 
@@ -64,9 +50,15 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
-        code.m_prefix_table[1] = code.m_prefix_table[0];
-        code.m_max_prefixed_code_length = 1;
+        TRY(code.m_lookup_table.try_append({ static_cast<u16>(last_non_zero), 1, 0 }));
+        TRY(code.m_lookup_table.try_append({ static_cast<u16>(last_non_zero), 1, 0 }));
+        code.m_lookup_table_bits = 1;
+        code.m_max_code_length = 1;
+
+        code.m_symbol_codes.append(0b10);
+        code.m_symbol_values.append(last_non_zero);
+        code.m_symbol_codes.append(0b11);
+        code.m_symbol_values.append(last_non_zero);
 
         if (code.m_bit_codes.size() < static_cast<size_t>(last_non_zero + 1)) {
             TRY(code.m_bit_codes.try_resize(last_non_zero + 1));
@@ -78,16 +70,8 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return code;
     }
 
-    struct PrefixCode {
-        u16 symbol_code { 0 };
-        u16 symbol_value { 0 };
-        u16 code_length { 0 };
-    };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
-
     auto next_code = 0;
-    for (size_t code_length = 1; code_length <= 15; ++code_length) {
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length) {
         next_code <<= 1;
         auto start_bit = 1 << code_length;
 
@@ -98,20 +82,9 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            } else {
-                code.m_symbol_codes.append(start_bit | next_code);
-                code.m_symbol_values.append(symbol);
-            }
+            code.m_symbol_codes.append(start_bit | next_code);
+            code.m_symbol_values.append(symbol);
+            code.m_max_code_length = code_length;
 
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
@@ -124,69 +97,290 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         }
     }
 
-    if (next_code != (1 << 15))
+    if (next_code != (1 << max_code_length))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+    code.m_lookup_table_bits = min(code.m_max_code_length, max_lookup_table_bits);
+    size_t const lookup_table_size = 1u << code.m_lookup_table_bits;
+    u16 const lookup_table_mask = lookup_table_size - 1;
+    TRY(code.m_lookup_table.try_resize(lookup_table_size));
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
+    // Every prefix of codes that are too long for the first-level table gets a second-level table that is large enough
+    // for the longest of these codes.
+    if (code.m_max_code_length > code.m_lookup_table_bits) {
+        for (size_t symbol = 0; symbol < code.m_bit_code_lengths.size(); ++symbol) {
+            if (code.m_bit_code_lengths[symbol] <= code.m_lookup_table_bits)
+                continue;
+            auto& entry = code.m_lookup_table[code.m_bit_codes[symbol] & lookup_table_mask];
+            entry.sub_table_bits = max<u8>(entry.sub_table_bits, code.m_bit_code_lengths[symbol] - code.m_lookup_table_bits);
+        }
 
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+        for (size_t prefix = 0; prefix < lookup_table_size; ++prefix) {
+            auto& entry = code.m_lookup_table[prefix];
+            if (entry.sub_table_bits == 0)
+                continue;
+            entry.symbol_value = code.m_lookup_table.size();
+            entry.code_length = code.m_lookup_table_bits;
+            TRY(code.m_lookup_table.try_resize(code.m_lookup_table.size() + (1u << entry.sub_table_bits)));
         }
     }
 
+    for (size_t symbol = 0; symbol < code.m_bit_code_lengths.size(); ++symbol) {
+        u8 const code_length = code.m_bit_code_lengths[symbol];
+        if (code_length == 0)
+            continue;
+
+        LookupTableEntry const symbol_entry { static_cast<u16>(symbol), code_length, 0 };
+        auto const bit_code = code.m_bit_codes[symbol];
+
+        // Codes are read lsb-first, so every table index that starts with the code's bits resolves to the symbol.
+        if (code_length <= code.m_lookup_table_bits) {
+            for (size_t index = bit_code; index < lookup_table_size; index += 1u << code_length)
+                code.m_lookup_table[index] = symbol_entry;
+            continue;
+        }
+
+        auto const sub_table = code.m_lookup_table[bit_code & lookup_table_mask];
+        for (size_t index = bit_code >> code.m_lookup_table_bits; index < (1u << sub_table.sub_table_bits); index += 1u << (code_length - code.m_lookup_table_bits))
+            code.m_lookup_table[sub_table.symbol_value + index] = symbol_entry;
+    }
+
     return code;
 }
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+    auto maybe_bits = stream.peek_bits<u32>(m_max_code_length);
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
-    }
+    // Close to the end of the input, there might not be as many bits left as the longest code has.
+    if (maybe_bits.is_error()) [[unlikely]]
+        return read_symbol_bit_by_bit(stream);
+
+    auto const bits = maybe_bits.value();
+    auto entry = m_lookup_table[bits & ((1u << m_lookup_table_bits) - 1)];
+    if (entry.sub_table_bits != 0)
+        entry = m_lookup_table[entry.symbol_value + ((bits >> m_lookup_table_bits) & ((1u << entry.sub_table_bits) - 1))];
+
+    if (entry.code_length == 0)
+        return Error::from_string_literal("Symbol exceeds maximum symbol number");
+
+    stream.discard_previously_peeked_bits(entry.code_length);
+    return entry.symbol_value;
+}
+
+ErrorOr<u32> CanonicalCode::read_symbol_bit_by_bit(LittleEndianInputBitStream& stream) const
+{
+    u16 code_bits = 1;
 
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
-    code_bits |= 1 << m_max_prefixed_code_length;
+    for (size_t i = 0; i < m_max_code_length; ++i) {
+        code_bits = code_bits << 1 | TRY(stream.read_bit());
 
-    for (size_t i = m_max_prefixed_code_length; i < 16; ++i) {
         size_t index;
         if (binary_search(m_symbol_codes.span(), code_bits, &index))
             return m_symbol_values[index];
-
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
     }
 
     return Error::from_string_literal("Symbol exceeds maximum symbol number");
 }
 
+// Copies a back-reference to the output, which points into a buffer that holds all output that may be referred to.
+static ALWAYS_INLINE ErrorOr<void> copy_back_reference(u8 const* buffer, u8*& output, size_t distance, size_t length)
+{
+    if (distance > static_cast<size_t>(output - buffer))
+        return Error::from_string_literal("Tried a seekback copy beyond the seekback limit");
+
+    u8* destination = output;
+    u8 const* source = destination - distance;
+    output += length;
+
+    if (distance >= sizeof(u64)) {
+        // Each chunk only reads bytes that were written before it, so we can copy in whole words even if the source
+        // and destination overlap. The last chunk may write past the end of the copy, which the caller leaves room for.
+        for (size_t i = 0; i < length; i += sizeof(u64))
+            __builtin_memcpy(destination + i, source + i, sizeof(u64));
+        return {};
+    }
+
+    if (distance == 1) {
+        __builtin_memset(destination, *source, length);
+        return {};
+    }
+
+    for (size_t i = 0; i < length; ++i)
+        destination[i] = source[i];
+    return {};
+}
+
 DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes)
     : m_decompressor(decompressor)
-    , m_literal_codes(literal_codes)
-    , m_distance_codes(distance_codes)
+    , m_literal_codes(move(literal_codes))
+    , m_distance_codes(move(distance_codes))
 {
 }
 
-ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
+ErrorOr<void> DeflateDecompressor::CompressedBlock::build_lookup_tables()
+{
+    auto const& literal_table = m_literal_codes.m_lookup_table;
+    size_t const literal_table_bits = m_literal_codes.m_lookup_table_bits;
+    size_t const literal_table_size = 1u << literal_table_bits;
+
+    TRY(m_literal_length_table.try_resize(literal_table_size));
+    for (size_t index = 0; index < literal_table_size; ++index) {
+        auto const& entry = literal_table[index];
+        auto& result = m_literal_length_table[index];
+        result.code_length = entry.code_length;
+
+        if (entry.sub_table_bits != 0) {
+            result.type = LiteralLengthEntry::Type::LongCode;
+        } else if (entry.symbol_value < EndOfBlock) {
+            result.type = LiteralLengthEntry::Type::Literal;
+            result.value = entry.symbol_value;
+
+            // If the bits after this literal are enough to resolve another literal, we can output both at once.
+            auto const& next_entry = literal_table[index >> entry.code_length];
+            if (next_entry.sub_table_bits == 0 && next_entry.symbol_value < EndOfBlock && entry.code_length + next_entry.code_length <= literal_table_bits) {
+                result.type = LiteralLengthEntry::Type::LiteralPair;
+                result.code_length += next_entry.code_length;
+                result.second_literal = next_entry.symbol_value;
+            }
+        } else if (entry.symbol_value == EndOfBlock) {
+            result.type = LiteralLengthEntry::Type::EndOfBlock;
+        } else if (entry.symbol_value < 286) {
+            auto const& length_symbol = packed_length_symbols[entry.symbol_value - 257];
+            result.type = LiteralLengthEntry::Type::Length;
+            result.value = length_symbol.base_length;
+            result.extra_bits = length_symbol.extra_bits;
+        }
+    }
+
+    if (!m_distance_codes.has_value())
+        return {};
+
+    auto const& distance_table = m_distance_codes->m_lookup_table;
+    size_t const distance_table_size = 1u << m_distance_codes->m_lookup_table_bits;
+
+    TRY(m_distance_table.try_resize(distance_table_size));
+    for (size_t index = 0; index < distance_table_size; ++index) {
+        auto const& entry = distance_table[index];
+        auto& result = m_distance_table[index];
+        result.code_length = entry.code_length;
+
+        if (entry.sub_table_bits != 0) {
+            result.type = DistanceEntry::Type::LongCode;
+        } else if (entry.symbol_value < 30) {
+            result.type = DistanceEntry::Type::Distance;
+            result.base_distance = packed_distances[entry.symbol_value].base_distance;
+            result.extra_bits = packed_distances[entry.symbol_value].extra_bits;
+        }
+    }
+    return {};
+}
+
+ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more(size_t requested_size)
 {
     if (m_eof == true)
         return false;
 
+    auto& input = *m_decompressor.m_input_stream;
+
+    // Keep the output position in a local, as the compiler can't know that writing the output doesn't change our members.
+    u8* const buffer = m_decompressor.m_output_buffer.data();
+    u8* output = buffer + m_decompressor.m_output_write_offset;
+    u8 const* const output_end = output + min(requested_size, m_decompressor.output_buffer_free_space() - max_output_per_symbol);
+    ScopeGuard update_write_offset = [&] { m_decompressor.m_output_write_offset = output - buffer; };
+
+    auto decode_single_symbol = [&]() -> ErrorOr<bool> {
+        m_decompressor.m_output_write_offset = output - buffer;
+        auto result = TRY(this->decode_single_symbol());
+        output = buffer + m_decompressor.m_output_write_offset;
+        return result;
+    };
+
+    u32 const literal_length_mask = m_literal_length_table.size() - 1;
+    u32 const distance_mask = m_distance_table.size() - 1;
+
+    while (output < output_end) {
+        // A length symbol and its extra bits are at most 15 + 5 bits long, a distance symbol and its extra bits at most 15 + 13.
+        // Peeking at that many bits at once lets the bit stream refill its 64-bit buffer in larger steps.
+        auto maybe_bits = input.peek_bits<u32>(CanonicalCode::max_code_length + 5);
+        if (maybe_bits.is_error()) [[unlikely]] {
+            if (!TRY(decode_single_symbol()))
+                return false;
+            continue;
+        }
+
+        auto bits = maybe_bits.value();
+        auto const& entry = m_literal_length_table[bits & literal_length_mask];
+
+        switch (entry.type) {
+        case LiteralLengthEntry::Type::Literal:
+            *output++ = entry.value;
+            input.discard_previously_peeked_bits(entry.code_length);
+            continue;
+        case LiteralLengthEntry::Type::LiteralPair:
+            *output++ = entry.value;
+            *output++ = entry.second_literal;
+            input.discard_previously_peeked_bits(entry.code_length);
+            continue;
+        case LiteralLengthEntry::Type::EndOfBlock:
+            input.discard_previously_peeked_bits(entry.code_length);
+            m_eof = true;
+            return false;
+        case LiteralLengthEntry::Type::LongCode:
+            if (!TRY(decode_single_symbol()))
+                return false;
+            continue;
+        case LiteralLengthEntry::Type::Invalid:
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+        case LiteralLengthEntry::Type::Length:
+            break;
+        }
+
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
+
+        auto const length = entry.value + ((bits >> entry.code_length) & ((1u << entry.extra_bits) - 1));
+        input.discard_previously_peeked_bits(entry.code_length + entry.extra_bits);
+
+        u32 distance;
+        maybe_bits = input.peek_bits<u32>(CanonicalCode::max_code_length + 13);
+        if (maybe_bits.is_error()) [[unlikely]] {
+            auto const distance_symbol = TRY(m_distance_codes->read_symbol(input));
+            if (distance_symbol >= 30)
+                return Error::from_string_literal("Invalid deflate distance symbol");
+            distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        } else {
+            bits = maybe_bits.value();
+            auto const& distance_entry = m_distance_table[bits & distance_mask];
+
+            if (distance_entry.type == DistanceEntry::Type::Distance) {
+                distance = distance_entry.base_distance + ((bits >> distance_entry.code_length) & ((1u << distance_entry.extra_bits) - 1));
+                input.discard_previously_peeked_bits(distance_entry.code_length + distance_entry.extra_bits);
+            } else if (distance_entry.type == DistanceEntry::Type::LongCode) {
+                auto const distance_symbol = TRY(m_distance_codes->read_symbol(input));
+                if (distance_symbol >= 30)
+                    return Error::from_string_literal("Invalid deflate distance symbol");
+                distance = TRY(m_decompressor.decode_distance(distance_symbol));
+            } else {
+                return Error::from_string_literal("Invalid deflate distance symbol");
+            }
+        }
+
+        TRY(copy_back_reference(buffer, output, distance, length));
+    }
+
+    return true;
+}
+
+ErrorOr<bool> DeflateDecompressor::CompressedBlock::decode_single_symbol()
+{
     auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
 
     if (symbol >= 286)
         return Error::from_string_literal("Invalid deflate literal/length symbol");
 
     if (symbol < EndOfBlock) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
+        m_decompressor.m_output_buffer[m_decompressor.m_output_write_offset++] = symbol;
         return true;
     }
 
@@ -205,11 +399,9 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
 
     auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
-
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
-
+    u8* output = m_decompressor.m_output_buffer.data() + m_decompressor.m_output_write_offset;
+    TRY(copy_back_reference(m_decompressor.m_output_buffer.data(), output, distance, length));
+    m_decompressor.m_output_write_offset = output - m_decompressor.m_output_buffer.data();
     return true;
 }
 
@@ -219,7 +411,7 @@ DeflateDecompressor::UncompressedBlock::UncompressedBlock(DeflateDecompressor& d
 {
 }
 
-ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
+ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more(size_t requested_size)
 {
     if (m_bytes_remaining == 0)
         return false;
@@ -227,23 +419,22 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
     if (m_decompressor.m_input_stream->is_eof())
         return Error::from_string_literal("Input data ends in the middle of an uncompressed DEFLATE block");
 
-    Array<u8, 4096> temporary_buffer;
-    auto readable_bytes = temporary_buffer.span().trim(min(m_bytes_remaining, m_decompressor.m_output_buffer.empty_space()));
+    auto readable_bytes = m_decompressor.m_output_buffer.bytes().slice(m_decompressor.m_output_write_offset).trim(min(m_bytes_remaining, requested_size));
     auto read_bytes = TRY(m_decompressor.m_input_stream->read_some(readable_bytes));
-    auto written_bytes = m_decompressor.m_output_buffer.write(read_bytes);
-    VERIFY(read_bytes.size() == written_bytes);
 
-    m_bytes_remaining -= written_bytes;
+    m_decompressor.m_output_write_offset += read_bytes.size();
+    m_bytes_remaining -= read_bytes.size();
     return true;
 }
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
-    auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
+    // Besides the window that back-references can refer to, leave enough room to decode large reads in one go.
+    auto output_buffer = TRY(ByteBuffer::create_uninitialized(max_back_reference_distance + 64 * KiB));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
-DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer output_buffer)
+DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, ByteBuffer output_buffer)
     : m_input_stream(move(stream))
     , m_output_buffer(move(output_buffer))
 {
@@ -261,7 +452,9 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
 {
     size_t total_read = 0;
     while (total_read < bytes.size()) {
-        auto slice = bytes.slice(total_read);
+        total_read += read_from_output_buffer(bytes.slice(total_read));
+        if (total_read == bytes.size())
+            break;
 
         if (m_state == State::Idle) {
             if (m_read_final_block)
@@ -288,6 +481,7 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
             if (block_type == 0b01) {
                 m_state = State::ReadingCompressedBlock;
                 new (&m_compressed_block) CompressedBlock(*this, CanonicalCode::fixed_literal_codes(), CanonicalCode::fixed_distance_codes());
+                TRY(m_compressed_block.build_lookup_tables());
 
                 continue;
             }
@@ -298,7 +492,8 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
                 TRY(decode_codes(literal_codes, distance_codes));
 
                 m_state = State::ReadingCompressedBlock;
-                new (&m_compressed_block) CompressedBlock(*this, literal_codes, distance_codes);
+                new (&m_compressed_block) CompressedBlock(*this, move(literal_codes), move(distance_codes));
+                TRY(m_compressed_block.build_lookup_tables());
 
                 continue;
             }
@@ -306,16 +501,12 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
             return Error::from_string_literal("Unhandled block type for Idle state");
         }
 
-        if (m_state == State::ReadingCompressedBlock) {
-            auto nread = m_output_buffer.read(slice).size();
-
-            while (nread < slice.size() && TRY(m_compressed_block.try_read_more())) {
-                nread += m_output_buffer.read(slice.slice(nread)).size();
-            }
+        // All output that was decoded so far has been read at this point, so we are free to move the window.
+        discard_unreachable_output();
 
-            total_read += nread;
-            if (nread == slice.size())
-                break;
+        if (m_state == State::ReadingCompressedBlock) {
+            if (TRY(m_compressed_block.try_read_more(bytes.size() - total_read)))
+                continue;
 
             m_compressed_block.~CompressedBlock();
             m_state = State::Idle;
@@ -324,15 +515,8 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
         }
 
         if (m_state == State::ReadingUncompressedBlock) {
-            auto nread = m_output_buffer.read(slice).size();
-
-            while (nread < slice.size() && TRY(m_uncompressed_block.try_read_more())) {
-                nread += m_output_buffer.read(slice.slice(nread)).size();
-            }
-
-            total_read += nread;
-            if (nread == slice.size())
-                break;
+            if (TRY(m_uncompressed_block.try_read_more(bytes.size() - total_read)))
+                continue;
 
             m_uncompressed_block.~UncompressedBlock();
             m_state = State::Idle;
@@ -346,6 +530,28 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
     return bytes.slice(0, total_read);
 }
 
+size_t DeflateDecompressor::read_from_output_buffer(Bytes bytes)
+{
+    auto const count = min(bytes.size(), m_output_write_offset - m_output_read_offset);
+    m_output_buffer.bytes().slice(m_output_read_offset, count).copy_to(bytes);
+    m_output_read_offset += count;
+    return count;
+}
+
+void DeflateDecompressor::discard_unreachable_output()
+{
+    VERIFY(m_output_read_offset == m_output_write_offset);
+
+    if (output_buffer_free_space() >= max_back_reference_distance)
+        return;
+
+    // Only the last 32 KiB of output can still be referred to, so move them to the start of the buffer.
+    auto const discarded_size = m_output_write_offset - max_back_reference_distance;
+    memmove(m_output_buffer.data(), m_output_buffer.data() + discarded_size, max_back_reference_distance);
+    m_output_read_offset -= discarded_size;
+    m_output_write_offset -= discarded_size;
+}
+
 bool DeflateDecompressor::is_eof() const { return m_state == State::Idle && m_read_final_block; }
 
 ErrorOr<size_t> DeflateDecompressor::write_some(ReadonlyBytes)
@@ -569,7 +775,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_match_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -631,6 +837,11 @@ void DeflateCompressor::lz77_compress_block()
 
     // our block starts at block_size and is m_pending_block_size in length
     auto block_end = block_size + m_pending_block_size;
+
+    // make the data before our block available for back references
+    for (size_t position = block_size - m_history_size; position < min(block_size, block_end - min_match_length + 1); position++) {
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+    }
     size_t current_position;
     for (current_position = block_size; current_position < block_end - min_match_length + 1; current_position++) {
         auto hash = hash_sequence(&m_rolling_window[current_position]);
@@ -946,6 +1157,8 @@ ErrorOr<void> DeflateCompressor::flush()
     m_distance_frequencies.fill(0);
     // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
     pending_block().copy_trimmed_to({ m_rolling_window, block_size });
+    // FIXME: Searching the previous block for back references improves the compression ratio, but it is also quite a bit slower.
+    m_history_size = 0;
 
     return {};
 }
@@ -959,6 +1172,30 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::final_sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+    m_finished = true;
+
+    // empty uncompressed block, which isn't marked as the final one
+    TRY(m_output_stream->write_bits(0b000u, 3));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(m_pending_block_size == 0 && m_history_size == 0);
+
+    m_history_size = min(dictionary.size(), block_size);
+    dictionary.slice(dictionary.size() - m_history_size).copy_to({ m_rolling_window + block_size - m_history_size, m_history_size });
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -31,19 +31,28 @@ public:
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    friend class DeflateDecompressor;
 
-    struct PrefixTableEntry {
-        u16 symbol_value { 0 };
-        u16 code_length { 0 };
+    static constexpr size_t max_code_length = 15;
+    static constexpr size_t max_lookup_table_bits = 11;
+
+    // Codes of up to m_lookup_table_bits bits are resolved with a single lookup of that many input bits. The entries for
+    // the prefixes of longer codes point to a second-level table that is indexed by the remaining bits of the code.
+    struct LookupTableEntry {
+        u16 symbol_value { 0 }; // Or the offset of the second-level table.
+        u8 code_length { 0 };
+        u8 sub_table_bits { 0 };
     };
 
-    // Decompression - indexed by code
+    ErrorOr<u32> read_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
+
+    // Decompression - indexed by code, used to read symbols bit by bit at the end of the input
     Vector<u16, 286> m_symbol_codes;
     Vector<u16, 286> m_symbol_values;
 
-    Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
-    size_t m_max_prefixed_code_length { 0 };
+    Vector<LookupTableEntry> m_lookup_table;
+    u8 m_lookup_table_bits { 0 };
+    u8 m_max_code_length { 0 };
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -66,21 +75,61 @@ private:
     public:
         CompressedBlock(DeflateDecompressor&, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes);
 
-        ErrorOr<bool> try_read_more();
+        // Must be called before reading from the block.
+        ErrorOr<void> build_lookup_tables();
+
+        ErrorOr<bool> try_read_more(size_t requested_size);
 
     private:
+        // Resolves a literal, two consecutive literals, or a length symbol (together with its base length and number of
+        // extra bits) with a single lookup of the next bits of input.
+        struct LiteralLengthEntry {
+            enum class Type : u8 {
+                Literal,
+                LiteralPair,
+                Length,
+                EndOfBlock,
+                LongCode,
+                Invalid,
+            };
+
+            Type type { Type::Invalid };
+            u8 code_length { 0 };
+            u8 extra_bits { 0 };
+            u8 second_literal { 0 };
+            u16 value { 0 }; // The (first) literal or the base length.
+        };
+
+        struct DistanceEntry {
+            enum class Type : u8 {
+                Distance,
+                LongCode,
+                Invalid,
+            };
+
+            Type type { Type::Invalid };
+            u8 code_length { 0 };
+            u8 extra_bits { 0 };
+            u16 base_distance { 0 };
+        };
+
+        ErrorOr<bool> decode_single_symbol();
+
         bool m_eof { false };
 
         DeflateDecompressor& m_decompressor;
         CanonicalCode m_literal_codes;
         Optional<CanonicalCode> m_distance_codes;
+
+        Vector<LiteralLengthEntry> m_literal_length_table;
+        Vector<DistanceEntry> m_distance_table;
     };
 
     class UncompressedBlock {
     public:
         UncompressedBlock(DeflateDecompressor&, size_t);
 
-        ErrorOr<bool> try_read_more();
+        ErrorOr<bool> try_read_more(size_t requested_size);
 
     private:
         DeflateDecompressor& m_decompressor;
@@ -109,13 +158,21 @@ public:
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
 private:
-    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
+    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, ByteBuffer buffer);
 
     ErrorOr<u32> decode_length(u32);
     ErrorOr<u32> decode_distance(u32);
     ErrorOr<void> decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code);
 
+    size_t read_from_output_buffer(Bytes);
+    void discard_unreachable_output();
+    size_t output_buffer_free_space() const { return m_output_buffer.size() - m_output_write_offset; }
+
     static constexpr u16 max_back_reference_length = 258;
+    static constexpr size_t max_back_reference_distance = 32 * KiB;
+
+    // Back-references are copied 8 bytes at a time, and may therefore write up to 7 bytes past their end.
+    static constexpr size_t max_output_per_symbol = max_back_reference_length + 7;
 
     bool m_read_final_block { false };
 
@@ -126,7 +183,12 @@ private:
     };
 
     MaybeOwned<LittleEndianInputBitStream> m_input_stream;
-    CircularBuffer m_output_buffer;
+
+    // The output is decoded into a flat buffer, so that back-references can be copied without wrapping around.
+    // It holds the last 32 KiB of output that back-references may refer to, followed by output that hasn't been read yet.
+    ByteBuffer m_output_buffer;
+    size_t m_output_read_offset { 0 };
+    size_t m_output_write_offset { 0 };
 };
 
 class DeflateCompressor final : public Stream {
@@ -138,6 +200,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_match_distance = 32 * KiB;
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -174,6 +237,14 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Like final_flush(), but instead of marking the end of the deflate stream, this ends the output at a byte boundary
+    // with an empty uncompressed block. The output of another compressor can then be appended to it.
+    ErrorOr<void> final_sync_flush();
+
+    // Makes (up to the last 32 KiB of) the given data available for back-references, as if it had been compressed
+    // right before the data that will be written. Must be called before writing any data.
+    void set_dictionary(ReadonlyBytes);
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
 private:
@@ -211,6 +282,7 @@ private:
 
     u8 m_rolling_window[window_size];
     size_t m_pending_block_size { 0 };
+    size_t m_history_size { 0 }; // the number of bytes before the pending block that can be referred back to
 
     struct [[gnu::packed]] {
         u16 distance; // back reference length
@@ -118,10 +118,9 @@ ErrorOr<Bytes> GzipDecompressor::read_some(Bytes bytes)
                 return Error::from_string_literal("Header is not supported by implementation");
 
             if (header.flags & Flags::FEXTRA) {
-                u16 subfield_id = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                u16 length = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                TRY(m_input_stream->discard(length));
-                (void)subfield_id;
+                // The extra field is XLEN bytes of subfields, each with its own ID and length. We don't use any of them.
+                u16 extra_length = TRY(m_input_stream->read_value<LittleEndian<u16>>());
+                TRY(m_input_stream->discard(extra_length));
             }
 
             auto discard_string = [&]() -> ErrorOr<void> {
@@ -199,7 +198,7 @@ ErrorOr<Bytes> GzipCompressor::read_some(Bytes)
     return Error::from_errno(EBADF);
 }
 
-ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+static ErrorOr<void> write_header(Stream& stream)
 {
     BlockHeader header;
     header.identification_1 = 0x1f;
@@ -209,7 +208,13 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.modification_time = 0;
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
-    TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
+    TRY(stream.write_until_depleted({ &header, sizeof(header) }));
+    return {};
+}
+
+ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    TRY(write_header(*m_output_stream));
     auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
     TRY(compressed_stream->write_until_depleted(bytes));
     TRY(compressed_stream->final_flush());
@@ -246,4 +251,198 @@ ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
     return buffer;
 }
 
+ErrorOr<NonnullOwnPtr<ParallelGzipCompressor>> ParallelGzipCompressor::create(MaybeOwned<Stream> stream, size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+    auto pending_chunk = TRY(try_make<Chunk>(TRY(ByteBuffer::create_uninitialized(dictionary_size + chunk_size))));
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ParallelGzipCompressor(move(stream), thread_count, move(pending_chunk))));
+
+    // The calling thread is one of the threads, see write_compressed_chunks().
+    TRY(compressor->m_threads.try_ensure_capacity(thread_count - 1));
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread_or_error = Threading::Thread::try_create([&compressor = *compressor]() -> intptr_t {
+            Threading::MutexLocker locker(compressor.m_mutex);
+            for (;;) {
+                compressor.m_chunk_queued.wait_while([&] {
+                    return compressor.m_queued_chunks.is_empty() && !compressor.m_is_shutting_down;
+                });
+                if (compressor.m_is_shutting_down)
+                    return 0;
+                compressor.compress_queued_chunk();
+            }
+        },
+            "Gzip compressor"sv);
+        // If we can't create more threads, we'll just have to get by with the ones we have.
+        if (thread_or_error.is_error())
+            break;
+        auto thread = thread_or_error.release_value();
+        thread->start();
+        compressor->m_threads.unchecked_append(move(thread));
+    }
+
+    return compressor;
+}
+
+ParallelGzipCompressor::ParallelGzipCompressor(MaybeOwned<Stream> stream, size_t thread_count, NonnullOwnPtr<Chunk> pending_chunk)
+    : m_output_stream(move(stream))
+    , m_thread_count(thread_count)
+    , m_pending_chunk(move(pending_chunk))
+{
+}
+
+ParallelGzipCompressor::~ParallelGzipCompressor()
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_is_shutting_down = true;
+        m_chunk_queued.broadcast();
+    }
+    for (auto& thread : m_threads)
+        (void)thread->join();
+}
+
+ErrorOr<Bytes> ParallelGzipCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ParallelGzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+
+    if (m_pending_chunk->input_size == chunk_size)
+        TRY(compress_pending_input());
+
+    auto written = bytes.copy_trimmed_to(pending_input().slice(m_pending_chunk->input_size));
+    m_pending_chunk->input_size += written;
+    return written;
+}
+
+ErrorOr<void> ParallelGzipCompressor::compress_pending_input()
+{
+    if (!m_wrote_header) {
+        TRY(write_header(*m_output_stream));
+        m_wrote_header = true;
+    }
+
+    if (m_pending_chunk->input_size == 0)
+        return {};
+
+    // Make room for the pending chunk, writing out everything that has been compressed so far.
+    TRY(write_compressed_chunks(max_chunks_in_flight() - 1));
+    TRY(m_chunks_in_flight.try_ensure_capacity(m_chunks_in_flight.size() + 1));
+
+    auto buffer = m_spare_buffers.is_empty() ? TRY(ByteBuffer::create_uninitialized(dictionary_size + chunk_size)) : m_spare_buffers.take_last();
+    auto next_chunk = TRY(try_make<Chunk>(move(buffer)));
+
+    // Keep the end of the input as the dictionary of the next chunk.
+    auto const& chunk = *m_pending_chunk;
+    next_chunk->used_dictionary_size = min(chunk.used_dictionary_size + chunk.input_size, dictionary_size);
+    chunk.buffer.bytes().slice(dictionary_size + chunk.input_size - next_chunk->used_dictionary_size, next_chunk->used_dictionary_size).copy_to(next_chunk->buffer.bytes().slice(dictionary_size - next_chunk->used_dictionary_size));
+
+    Threading::MutexLocker locker(m_mutex);
+    TRY(m_queued_chunks.try_append(m_pending_chunk.ptr()));
+    m_chunks_in_flight.unchecked_append(exchange(m_pending_chunk, move(next_chunk)));
+    m_chunk_queued.signal();
+    return {};
+}
+
+// Writes out the compressed chunks at the front of the queue. If more than max_chunks_left_in_flight remain, this also
+// compresses queued chunks on the calling thread (or waits for the other threads) until enough of them can be written.
+ErrorOr<void> ParallelGzipCompressor::write_compressed_chunks(size_t max_chunks_left_in_flight)
+{
+    while (!m_chunks_in_flight.is_empty()) {
+        {
+            Threading::MutexLocker locker(m_mutex);
+            auto const& chunk = *m_chunks_in_flight.first();
+            if (!chunk.is_compressed && m_chunks_in_flight.size() <= max_chunks_left_in_flight)
+                return {};
+            while (!chunk.is_compressed) {
+                if (m_queued_chunks.is_empty())
+                    m_chunk_compressed.wait();
+                else
+                    compress_queued_chunk();
+            }
+        }
+
+        auto chunk = m_chunks_in_flight.take_first();
+        auto output = TRY(move(chunk->output));
+        TRY(m_output_stream->write_until_depleted(output));
+        m_checksum = Crypto::Checksum::CRC32::combine(m_checksum, chunk->checksum, chunk->input_size);
+        m_input_size += chunk->input_size;
+        TRY(m_spare_buffers.try_append(move(chunk->buffer)));
+    }
+    return {};
+}
+
+// Must be called with m_mutex locked, which is released while the chunk is being compressed.
+void ParallelGzipCompressor::compress_queued_chunk()
+{
+    auto& chunk = *m_queued_chunks.take_first();
+    m_mutex.unlock();
+
+    auto compress = [&]() -> ErrorOr<ByteBuffer> {
+        AllocatingMemoryStream output_stream;
+        auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+        deflate_stream->set_dictionary(chunk.dictionary());
+        TRY(deflate_stream->write_until_depleted(chunk.input()));
+        TRY(deflate_stream->final_sync_flush());
+
+        auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+        TRY(output_stream.read_until_filled(buffer));
+        return buffer;
+    };
+    auto output = compress();
+    auto checksum = Crypto::Checksum::CRC32 { chunk.input() }.digest();
+
+    m_mutex.lock();
+    chunk.output = move(output);
+    chunk.checksum = checksum;
+    chunk.is_compressed = true;
+    m_chunk_compressed.broadcast();
+}
+
+ErrorOr<void> ParallelGzipCompressor::finish()
+{
+    VERIFY(!m_finished);
+    TRY(compress_pending_input());
+    TRY(write_compressed_chunks(0));
+    m_finished = true;
+
+    // The chunks did not mark the end of the deflate stream, so end it with an empty final block.
+    auto final_block_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+    TRY(final_block_stream->final_flush());
+
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(m_checksum));
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(m_input_size));
+    return {};
+}
+
+bool ParallelGzipCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ParallelGzipCompressor::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void ParallelGzipCompressor::close()
+{
+}
+
+ErrorOr<ByteBuffer> ParallelGzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto gzip_stream = TRY(ParallelGzipCompressor::create(MaybeOwned<Stream>(*output_stream), thread_count));
+
+    TRY(gzip_stream->write_until_depleted(bytes));
+    TRY(gzip_stream->finish());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+    TRY(output_stream->read_until_filled(buffer.bytes()));
+    return buffer;
+}
+
 }
@@ -12,6 +12,9 @@
 #include <AK/Stream.h>
 #include <LibCompress/Deflate.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -97,4 +100,81 @@ private:
     MaybeOwned<Stream> m_output_stream;
 };
 
+// Splits its input into chunks that are compressed on a pool of threads, each with the end of the previous chunk as its
+// dictionary, and writes them out in order as a single gzip member as soon as they have been compressed.
+class ParallelGzipCompressor final : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ParallelGzipCompressor>> create(MaybeOwned<Stream>, size_t thread_count);
+    virtual ~ParallelGzipCompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    // Compresses the remaining input and ends the gzip member. Must be called after the last write.
+    ErrorOr<void> finish();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count);
+
+private:
+    static constexpr size_t chunk_size = 4 * DeflateCompressor::block_size;
+    static constexpr size_t dictionary_size = 32 * KiB;
+
+    struct Chunk {
+        explicit Chunk(ByteBuffer buffer)
+            : buffer(move(buffer))
+        {
+        }
+
+        // The last used_dictionary_size bytes of the first dictionary_size bytes are the end of the previous input,
+        // and the input follows them.
+        ByteBuffer buffer;
+        size_t used_dictionary_size { 0 };
+        size_t input_size { 0 };
+
+        // Protected by the compressor's m_mutex.
+        bool is_compressed { false };
+        ErrorOr<ByteBuffer> output { ByteBuffer {} };
+        u32 checksum { 0 };
+
+        ReadonlyBytes dictionary() const { return buffer.bytes().slice(dictionary_size - used_dictionary_size, used_dictionary_size); }
+        ReadonlyBytes input() const { return buffer.bytes().slice(dictionary_size, input_size); }
+    };
+
+    ParallelGzipCompressor(MaybeOwned<Stream>, size_t thread_count, NonnullOwnPtr<Chunk> pending_chunk);
+
+    // The calling thread takes part in compressing, so this many chunks keep every thread busy while it waits.
+    size_t max_chunks_in_flight() const { return 2 * m_thread_count; }
+
+    Bytes pending_input() { return m_pending_chunk->buffer.bytes().slice(dictionary_size); }
+    ErrorOr<void> compress_pending_input();
+    ErrorOr<void> write_compressed_chunks(size_t max_chunks_left_in_flight);
+    void compress_queued_chunk();
+
+    MaybeOwned<Stream> m_output_stream;
+    size_t m_thread_count { 1 };
+
+    NonnullOwnPtr<Chunk> m_pending_chunk;
+    Vector<ByteBuffer> m_spare_buffers;
+
+    // The chunks that have been handed to the threads, in input order.
+    Vector<NonnullOwnPtr<Chunk>> m_chunks_in_flight;
+
+    Vector<NonnullRefPtr<Threading::Thread>> m_threads;
+
+    // Everything below is shared with the threads, and protected by m_mutex.
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_chunk_queued { m_mutex };
+    Threading::ConditionVariable m_chunk_compressed { m_mutex };
+    Vector<Chunk*> m_queued_chunks;
+    bool m_is_shutting_down { false };
+
+    bool m_wrote_header { false };
+    bool m_finished { false };
+    u32 m_checksum { 0 };
+    u64 m_input_size { 0 };
+};
+
 }
@@ -34,6 +34,20 @@ ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Str
     return adopt_nonnull_own_or_enomem(new (nothrow) ZlibDecompressor(header, move(deflate_stream)));
 }
 
+bool ZlibDecompressor::is_likely_compressed(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    auto maybe_header = stream.read_value<ZlibHeader>();
+    if (maybe_header.is_error())
+        return false;
+
+    auto header = maybe_header.release_value();
+    return header.compression_method == ZlibCompressionMethod::Deflate
+        && header.compression_info <= 7
+        && !header.present_dictionary
+        && header.as_u16 % 31 == 0;
+}
+
 ZlibDecompressor::ZlibDecompressor(ZlibHeader header, NonnullOwnPtr<Stream> stream)
     : m_header(header)
     , m_stream(move(stream))
@@ -47,6 +47,7 @@ static_assert(sizeof(ZlibHeader) == sizeof(u16));
 class ZlibDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<ZlibDecompressor>> create(MaybeOwned<Stream>);
+    static bool is_likely_compressed(ReadonlyBytes bytes);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
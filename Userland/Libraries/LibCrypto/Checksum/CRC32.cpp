@@ -171,4 +171,46 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// Multiplies two polynomials modulo the CRC polynomial, both in the same bit-reversed representation as the checksum.
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    constexpr u32 reversed_polynomial = 0xEDB88320;
+
+    u32 product = 0;
+    for (u32 mask = 1u << 31; mask != 0; mask >>= 1) {
+        if (a & mask)
+            product ^= b;
+        b = (b >> 1) ^ ((b & 1) * reversed_polynomial);
+    }
+    return product;
+}
+
+// x^(2^n) modulo the CRC polynomial, for every bit of a 64-bit length in bits.
+static constexpr auto generate_power_of_two_powers_table()
+{
+    Array<u32, 64 + 3> data {};
+
+    u32 power = 1u << 30; // x^1
+    for (auto& entry : data) {
+        entry = power;
+        power = multiply_modulo_polynomial(power, power);
+    }
+    return data;
+}
+
+static constexpr auto power_of_two_powers = generate_power_of_two_powers_table();
+
+u32 CRC32::combine(u32 first_checksum, u32 second_checksum, u64 second_length)
+{
+    // Appending n bytes to some data multiplies its checksum polynomial by x^(8n) (the initial and final inversions cancel
+    // out between the two checksums), so compute x^(8n) from its binary representation.
+    u32 shift = 1u << 31; // x^0
+    for (size_t bit = 3; second_length != 0; ++bit, second_length >>= 1) {
+        if (second_length & 1)
+            shift = multiply_modulo_polynomial(power_of_two_powers[bit], shift);
+    }
+
+    return multiply_modulo_polynomial(shift, first_checksum) ^ second_checksum;
+}
+
 }
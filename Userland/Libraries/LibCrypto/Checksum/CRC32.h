@@ -29,6 +29,9 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the CRC of two concatenated pieces of data, given the CRCs of both and the length of the second one.
+    static u32 combine(u32 first_checksum, u32 second_checksum, u64 second_length);
+
 private:
     u32 m_state { ~0u };
 };
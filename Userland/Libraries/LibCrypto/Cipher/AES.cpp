@@ -6,6 +6,7 @@
 
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
+#include <LibCrypto/Cipher/AESNI.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
 namespace Crypto::Cipher {
@@ -196,8 +197,27 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
     }
 }
 
+void AESCipherKey::update_hardware_round_keys()
+{
+    m_has_hardware_round_keys = AESNI::is_supported();
+    if (!m_has_hardware_round_keys)
+        return;
+
+    for (size_t i = 0; i < (rounds() + 1) * 4; ++i) {
+        m_hardware_round_keys[i * 4] = m_rd_keys[i] >> 24;
+        m_hardware_round_keys[i * 4 + 1] = m_rd_keys[i] >> 16;
+        m_hardware_round_keys[i * 4 + 2] = m_rd_keys[i] >> 8;
+        m_hardware_round_keys[i * 4 + 3] = m_rd_keys[i];
+    }
+}
+
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+    if (auto const* hardware_round_keys = key().hardware_round_keys()) {
+        AESNI::encrypt_block(hardware_round_keys, key().rounds(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -287,6 +307,11 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+    if (auto const* hardware_round_keys = key().hardware_round_keys()) {
+        AESNI::decrypt_block(hardware_round_keys, key().rounds(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
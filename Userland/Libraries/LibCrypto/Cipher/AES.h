@@ -72,6 +72,12 @@ struct AESCipherKey : public CipherKey {
         return (u32 const*)m_rd_keys;
     }
 
+    // The round keys in the byte order AES-NI expects, or nullptr if this CPU doesn't support it.
+    u8 const* hardware_round_keys() const
+    {
+        return m_has_hardware_round_keys ? m_hardware_round_keys : nullptr;
+    }
+
     AESCipherKey(ReadonlyBytes user_key, size_t key_bits, Intent intent)
         : m_bits(key_bits)
     {
@@ -79,6 +85,7 @@ struct AESCipherKey : public CipherKey {
             expand_encrypt_key(user_key, key_bits);
         else
             expand_decrypt_key(user_key, key_bits);
+        update_hardware_round_keys();
     }
 
     virtual ~AESCipherKey() override = default;
@@ -93,8 +100,12 @@ protected:
     }
 
 private:
+    void update_hardware_round_keys();
+
     static constexpr size_t MAX_ROUND_COUNT = 14;
     u32 m_rd_keys[(MAX_ROUND_COUNT + 1) * 4] { 0 };
+    u8 m_hardware_round_keys[(MAX_ROUND_COUNT + 1) * 16] { 0 };
+    bool m_has_hardware_round_keys { false };
     size_t m_rounds;
     size_t m_bits;
 };
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/Platform.h>
+#include <LibCrypto/Cipher/AESNI.h>
+
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
+namespace Crypto::Cipher::AESNI {
+
+static bool s_is_disabled_for_testing { false };
+
+void set_disabled_for_testing(bool disabled)
+{
+    s_is_disabled_for_testing = disabled;
+}
+
+#if ARCH(X86_64)
+
+// These are built for the instruction sets we check for in is_supported(), independently of the baseline the rest of the
+// library is compiled for.
+#    define AESNI_FUNCTION [[gnu::target("aes,pclmul,ssse3")]]
+
+namespace {
+
+using Block = __m128i;
+
+static constexpr size_t max_round_count = 14;
+static constexpr size_t blocks_per_iteration = GHashKey::power_count;
+
+AESNI_FUNCTION ALWAYS_INLINE Block load(u8 const* data)
+{
+    return _mm_loadu_si128(reinterpret_cast<Block const*>(data));
+}
+
+AESNI_FUNCTION ALWAYS_INLINE void store(u8* data, Block value)
+{
+    _mm_storeu_si128(reinterpret_cast<Block*>(data), value);
+}
+
+// GHASH treats blocks as big-endian 128-bit polynomials, PCLMULQDQ multiplies little-endian ones.
+AESNI_FUNCTION ALWAYS_INLINE Block reverse_bytes(Block value)
+{
+    return _mm_shuffle_epi8(value, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+struct KeySchedule {
+    AESNI_FUNCTION KeySchedule(u8 const* round_keys, size_t rounds)
+        : rounds(rounds)
+    {
+        VERIFY(rounds <= max_round_count);
+        for (size_t i = 0; i <= rounds; ++i)
+            keys[i] = load(round_keys + i * 16);
+    }
+
+    Block keys[max_round_count + 1];
+    size_t rounds;
+};
+
+AESNI_FUNCTION ALWAYS_INLINE Block encrypt(KeySchedule const& schedule, Block block)
+{
+    block = _mm_xor_si128(block, schedule.keys[0]);
+    for (size_t round = 1; round < schedule.rounds; ++round)
+        block = _mm_aesenc_si128(block, schedule.keys[round]);
+    return _mm_aesenclast_si128(block, schedule.keys[schedule.rounds]);
+}
+
+// A 128-bit big-endian counter, incremented the same way as IncrementInplace.
+class Counter {
+public:
+    explicit Counter(ReadonlyBytes iv)
+    {
+        VERIFY(iv.size() == 16);
+        __builtin_memcpy(&m_high, iv.data(), sizeof(m_high));
+        __builtin_memcpy(&m_low, iv.data() + sizeof(m_high), sizeof(m_low));
+        m_high = AK::convert_between_host_and_big_endian(m_high);
+        m_low = AK::convert_between_host_and_big_endian(m_low);
+    }
+
+    void increment()
+    {
+        if (++m_low == 0)
+            ++m_high;
+    }
+
+    AESNI_FUNCTION ALWAYS_INLINE Block next()
+    {
+        auto block = _mm_set_epi64x(AK::convert_between_host_and_big_endian(m_low), AK::convert_between_host_and_big_endian(m_high));
+        increment();
+        return block;
+    }
+
+private:
+    u64 m_high { 0 };
+    u64 m_low { 0 };
+};
+
+// The unreduced 256-bit sum of several carry-less products, see "Intel Carry-Less Multiplication Instruction and its
+// Usage for Computing the GCM Mode" (Gueron, Kounavis), algorithms 1 and 4 with the reduction deferred.
+struct Product {
+    Block low { _mm_setzero_si128() };
+    Block middle { _mm_setzero_si128() };
+    Block high { _mm_setzero_si128() };
+};
+
+AESNI_FUNCTION ALWAYS_INLINE void multiply_accumulate(Product& product, Block x, Block y)
+{
+    product.low = _mm_xor_si128(product.low, _mm_clmulepi64_si128(x, y, 0x00));
+    product.middle = _mm_xor_si128(product.middle, _mm_clmulepi64_si128(x, y, 0x01));
+    product.middle = _mm_xor_si128(product.middle, _mm_clmulepi64_si128(x, y, 0x10));
+    product.high = _mm_xor_si128(product.high, _mm_clmulepi64_si128(x, y, 0x11));
+}
+
+AESNI_FUNCTION ALWAYS_INLINE Block reduce(Product const& product)
+{
+    auto low = _mm_xor_si128(product.low, _mm_slli_si128(product.middle, 8));
+    auto high = _mm_xor_si128(product.high, _mm_srli_si128(product.middle, 8));
+
+    // The operands are bit-reflected, so the product is off by one bit and has to be shifted left.
+    auto low_carries = _mm_srli_epi32(low, 31);
+    auto high_carries = _mm_srli_epi32(high, 31);
+    low = _mm_slli_epi32(low, 1);
+    high = _mm_slli_epi32(high, 1);
+    high = _mm_or_si128(high, _mm_srli_si128(low_carries, 12));
+    high = _mm_or_si128(high, _mm_slli_si128(high_carries, 4));
+    low = _mm_or_si128(low, _mm_slli_si128(low_carries, 4));
+
+    // Reduce modulo x^128 + x^7 + x^2 + x + 1.
+    auto folded = _mm_xor_si128(_mm_slli_epi32(low, 31), _mm_xor_si128(_mm_slli_epi32(low, 30), _mm_slli_epi32(low, 25)));
+    auto folded_high = _mm_srli_si128(folded, 4);
+    low = _mm_xor_si128(low, _mm_slli_si128(folded, 12));
+
+    auto shifted = _mm_xor_si128(_mm_srli_epi32(low, 1), _mm_xor_si128(_mm_srli_epi32(low, 2), _mm_srli_epi32(low, 7)));
+    low = _mm_xor_si128(low, _mm_xor_si128(shifted, folded_high));
+    return _mm_xor_si128(high, low);
+}
+
+AESNI_FUNCTION ALWAYS_INLINE Block multiply(Block x, Block y)
+{
+    Product product;
+    multiply_accumulate(product, x, y);
+    return reduce(product);
+}
+
+struct HashKey {
+    AESNI_FUNCTION explicit HashKey(GHashKey const& key)
+    {
+        for (size_t i = 0; i < blocks_per_iteration; ++i)
+            powers[i] = load(key.powers[i]);
+    }
+
+    // H^(i + 1), byte-reversed.
+    Block powers[blocks_per_iteration];
+};
+
+// Folds `blocks_per_iteration` blocks into the hash state: (((state ^ X1) * H ^ X2) * H ...) * H is the same as
+// (state ^ X1) * H^n ^ X2 * H^(n - 1) ^ ... ^ Xn * H, which only needs a single reduction.
+AESNI_FUNCTION ALWAYS_INLINE Block hash_blocks(HashKey const& key, Block state, u8 const* data)
+{
+    Product product;
+#    pragma GCC unroll 8
+    for (size_t i = 0; i < blocks_per_iteration; ++i) {
+        auto block = reverse_bytes(load(data + i * 16));
+        if (i == 0)
+            block = _mm_xor_si128(block, state);
+        multiply_accumulate(product, block, key.powers[blocks_per_iteration - 1 - i]);
+    }
+    return reduce(product);
+}
+
+AESNI_FUNCTION ALWAYS_INLINE Block hash_block(HashKey const& key, Block state, Block block)
+{
+    return multiply(_mm_xor_si128(state, reverse_bytes(block)), key.powers[0]);
+}
+
+AESNI_FUNCTION Block hash(HashKey const& key, Block state, ReadonlyBytes data)
+{
+    size_t offset = 0;
+    for (; data.size() - offset >= blocks_per_iteration * 16; offset += blocks_per_iteration * 16)
+        state = hash_blocks(key, state, data.offset(offset));
+    for (; data.size() - offset >= 16; offset += 16)
+        state = hash_block(key, state, load(data.offset(offset)));
+
+    if (offset < data.size()) {
+        u8 padded[16] {};
+        __builtin_memcpy(padded, data.offset(offset), data.size() - offset);
+        state = hash_block(key, state, load(padded));
+    }
+    return state;
+}
+
+enum class Direction {
+    Encryption,
+    Decryption,
+};
+
+// Runs CTR over `blocks_per_iteration` blocks while folding the ciphertext blocks at `ciphertext` into the hash state.
+// The multiplications are interleaved with the AES rounds, so that both execution units are kept busy.
+// When encrypting, `ciphertext` is the output of the previous iteration, as this iteration's isn't known yet.
+template<bool hash_ciphertext>
+AESNI_FUNCTION ALWAYS_INLINE void crypt_blocks(KeySchedule const& schedule, HashKey const& key, Counter& counter, Block& state, u8 const* in, u8* out, u8 const* ciphertext)
+{
+    Block blocks[blocks_per_iteration];
+#    pragma GCC unroll 8
+    for (size_t i = 0; i < blocks_per_iteration; ++i)
+        blocks[i] = _mm_xor_si128(counter.next(), schedule.keys[0]);
+
+    Product product;
+    for (size_t round = 1; round < schedule.rounds; ++round) {
+#    pragma GCC unroll 8
+        for (size_t i = 0; i < blocks_per_iteration; ++i)
+            blocks[i] = _mm_aesenc_si128(blocks[i], schedule.keys[round]);
+
+        // Even AES-128 has more than `blocks_per_iteration` middle rounds.
+        if constexpr (hash_ciphertext) {
+            if (round <= blocks_per_iteration) {
+                auto index = round - 1;
+                auto block = reverse_bytes(load(ciphertext + index * 16));
+                if (index == 0)
+                    block = _mm_xor_si128(block, state);
+                multiply_accumulate(product, block, key.powers[blocks_per_iteration - 1 - index]);
+            }
+        }
+    }
+
+#    pragma GCC unroll 8
+    for (size_t i = 0; i < blocks_per_iteration; ++i) {
+        blocks[i] = _mm_aesenclast_si128(blocks[i], schedule.keys[schedule.rounds]);
+        blocks[i] = _mm_xor_si128(blocks[i], load(in + i * 16));
+    }
+
+    // Note: The stores have to come after all loads from `ciphertext`, which may alias `out` when decrypting in place.
+#    pragma GCC unroll 8
+    for (size_t i = 0; i < blocks_per_iteration; ++i)
+        store(out + i * 16, blocks[i]);
+
+    if constexpr (hash_ciphertext)
+        state = reduce(product);
+}
+
+template<Direction direction>
+AESNI_FUNCTION void gcm_crypt(u8 const* round_keys, size_t rounds, GHashKey const& ghash_key, ReadonlyBytes iv, ReadonlyBytes aad, ReadonlyBytes in, Bytes out, Bytes tag)
+{
+    VERIFY(out.size() >= in.size());
+    VERIFY(tag.size() >= 16);
+
+    KeySchedule const schedule { round_keys, rounds };
+    HashKey const key { ghash_key };
+
+    Counter counter { iv };
+    counter.increment();
+    auto tag_mask = encrypt(schedule, counter.next());
+
+    auto state = hash(key, _mm_setzero_si128(), aad);
+
+    auto const* input = in.data();
+    auto* output = out.data();
+    auto length = in.size();
+    size_t offset = 0;
+    constexpr size_t iteration_size = blocks_per_iteration * 16;
+
+    if constexpr (direction == Direction::Encryption) {
+        if (length >= iteration_size) {
+            crypt_blocks<false>(schedule, key, counter, state, input, output, nullptr);
+            offset += iteration_size;
+            for (; length - offset >= iteration_size; offset += iteration_size)
+                crypt_blocks<true>(schedule, key, counter, state, input + offset, output + offset, output + offset - iteration_size);
+            state = hash_blocks(key, state, output + offset - iteration_size);
+        }
+    } else {
+        for (; length - offset >= iteration_size; offset += iteration_size)
+            crypt_blocks<true>(schedule, key, counter, state, input + offset, output + offset, input + offset);
+    }
+
+    for (; length - offset >= 16; offset += 16) {
+        auto block = load(input + offset);
+        auto result = _mm_xor_si128(encrypt(schedule, counter.next()), block);
+        store(output + offset, result);
+        state = hash_block(key, state, direction == Direction::Encryption ? result : block);
+    }
+
+    if (offset < length) {
+        auto remaining = length - offset;
+        u8 buffer[16] {};
+        __builtin_memcpy(buffer, input + offset, remaining);
+        auto ciphertext = load(buffer);
+        auto result = _mm_xor_si128(encrypt(schedule, counter.next()), ciphertext);
+        store(buffer, result);
+        __builtin_memcpy(output + offset, buffer, remaining);
+
+        if constexpr (direction == Direction::Encryption) {
+            __builtin_memset(buffer + remaining, 0, sizeof(buffer) - remaining);
+            ciphertext = load(buffer);
+        }
+        state = hash_block(key, state, ciphertext);
+    }
+
+    auto aad_bits = AK::convert_between_host_and_big_endian(8 * (u64)aad.size());
+    auto cipher_bits = AK::convert_between_host_and_big_endian(8 * (u64)length);
+    state = hash_block(key, state, _mm_set_epi64x(cipher_bits, aad_bits));
+
+    store(tag.data(), _mm_xor_si128(reverse_bytes(state), tag_mask));
+}
+
+}
+
+bool is_supported()
+{
+    return !s_is_disabled_for_testing && __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+}
+
+AESNI_FUNCTION void encrypt_block(u8 const* round_keys, size_t rounds, u8 const* in, u8* out)
+{
+    auto block = _mm_xor_si128(load(in), load(round_keys));
+    for (size_t round = 1; round < rounds; ++round)
+        block = _mm_aesenc_si128(block, load(round_keys + round * 16));
+    store(out, _mm_aesenclast_si128(block, load(round_keys + rounds * 16)));
+}
+
+// The decryption key schedule already has InvMixColumns applied to its middle round keys, which is what AESDEC expects.
+AESNI_FUNCTION void decrypt_block(u8 const* round_keys, size_t rounds, u8 const* in, u8* out)
+{
+    auto block = _mm_xor_si128(load(in), load(round_keys));
+    for (size_t round = 1; round < rounds; ++round)
+        block = _mm_aesdec_si128(block, load(round_keys + round * 16));
+    store(out, _mm_aesdeclast_si128(block, load(round_keys + rounds * 16)));
+}
+
+AESNI_FUNCTION void expand_ghash_key(GHashKey& key, ReadonlyBytes hash_subkey)
+{
+    VERIFY(hash_subkey.size() >= 16);
+    auto h = reverse_bytes(load(hash_subkey.data()));
+    auto power = h;
+    for (size_t i = 0; i < GHashKey::power_count; ++i) {
+        store(key.powers[i], power);
+        power = multiply(power, h);
+    }
+}
+
+void gcm_encrypt(u8 const* round_keys, size_t rounds, GHashKey const& key, ReadonlyBytes iv, ReadonlyBytes aad, ReadonlyBytes in, Bytes out, Bytes tag)
+{
+    gcm_crypt<Direction::Encryption>(round_keys, rounds, key, iv, aad, in, out, tag);
+}
+
+void gcm_decrypt(u8 const* round_keys, size_t rounds, GHashKey const& key, ReadonlyBytes iv, ReadonlyBytes aad, ReadonlyBytes in, Bytes out, Bytes tag)
+{
+    gcm_crypt<Direction::Decryption>(round_keys, rounds, key, iv, aad, in, out, tag);
+}
+
+#    undef AESNI_FUNCTION
+
+#else
+
+bool is_supported()
+{
+    return false;
+}
+
+void encrypt_block(u8 const*, size_t, u8 const*, u8*)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void decrypt_block(u8 const*, size_t, u8 const*, u8*)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void expand_ghash_key(GHashKey&, ReadonlyBytes)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void gcm_encrypt(u8 const*, size_t, GHashKey const&, ReadonlyBytes, ReadonlyBytes, ReadonlyBytes, Bytes, Bytes)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void gcm_decrypt(u8 const*, size_t, GHashKey const&, ReadonlyBytes, ReadonlyBytes, ReadonlyBytes, Bytes, Bytes)
+{
+    VERIFY_NOT_REACHED();
+}
+
+#endif
+
+}
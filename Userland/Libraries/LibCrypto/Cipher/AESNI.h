@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+// AES and GHASH on top of the x86-64 AES-NI and PCLMULQDQ instructions.
+// Everything but is_supported() and set_disabled_for_testing() must only be called if is_supported() returned true.
+namespace Crypto::Cipher::AESNI {
+
+bool is_supported();
+
+// Makes is_supported() return false, so that tests and benchmarks can run the table-based code on any CPU. This only
+// affects keys (and GCM modes) that are set up afterwards.
+void set_disabled_for_testing(bool);
+
+// The round keys are the (rounds + 1) * 16 byte big-endian serialization of AESCipherKey::round_keys().
+void encrypt_block(u8 const* round_keys, size_t rounds, u8 const* in, u8* out);
+void decrypt_block(u8 const* round_keys, size_t rounds, u8 const* in, u8* out);
+
+// Powers H^1 to H^8 of the GHASH key, so that eight blocks can be folded into the hash with a single reduction.
+struct GHashKey {
+    static constexpr size_t power_count = 8;
+    u8 powers[power_count][16];
+};
+
+void expand_ghash_key(GHashKey&, ReadonlyBytes hash_subkey);
+
+// These behave like GCM<AESCipher>::encrypt() and decrypt(): `iv` is a 128-bit big-endian counter that is incremented once
+// for the block that masks the tag, and once more for the first block of data.
+// Both write the 16-byte authentication tag for `in` (or `out`, when encrypting) into `tag`.
+void gcm_encrypt(u8 const* round_keys, size_t rounds, GHashKey const&, ReadonlyBytes iv, ReadonlyBytes aad, ReadonlyBytes in, Bytes out, Bytes tag);
+void gcm_decrypt(u8 const* round_keys, size_t rounds, GHashKey const&, ReadonlyBytes iv, ReadonlyBytes aad, ReadonlyBytes in, Bytes out, Bytes tag);
+
+}
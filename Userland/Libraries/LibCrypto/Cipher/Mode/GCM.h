@@ -11,6 +11,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <LibCrypto/Authentication/GHash.h>
+#include <LibCrypto/Cipher/AESNI.h>
 #include <LibCrypto/Cipher/Mode/CTR.h>
 #include <LibCrypto/Verification.h>
 
@@ -41,6 +42,11 @@ public:
         key_block.bytes().copy_to(m_auth_key);
 
         m_ghash = Authentication::GHash(m_auth_key);
+
+        if constexpr (has_hardware_support) {
+            if (this->cipher().key().hardware_round_keys())
+                AESNI::expand_ghash_key(m_hardware_ghash_key, m_auth_key);
+        }
     }
 
 #ifndef KERNEL
@@ -74,6 +80,14 @@ public:
 
     void encrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes iv_in, ReadonlyBytes aad, Bytes tag)
     {
+        if constexpr (has_hardware_support) {
+            auto const& key = this->cipher().key();
+            if (key.hardware_round_keys() && iv_in.size() == block_size && in.size() == out.size()) {
+                AESNI::gcm_encrypt(key.hardware_round_keys(), key.rounds(), m_hardware_ghash_key, iv_in, aad, in, out, tag);
+                return;
+            }
+        }
+
         auto iv_buf_result = ByteBuffer::copy(iv_in);
         // Not enough memory to figure out :shrug:
         if (iv_buf_result.is_error()) {
@@ -104,6 +118,17 @@ public:
 
     VerificationConsistency decrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes iv_in, ReadonlyBytes aad, ReadonlyBytes tag)
     {
+        if constexpr (has_hardware_support) {
+            auto const& key = this->cipher().key();
+            if (key.hardware_round_keys() && iv_in.size() == block_size && in.size() <= out.size()) {
+                u8 expected_tag[block_size];
+                AESNI::gcm_decrypt(key.hardware_round_keys(), key.rounds(), m_hardware_ghash_key, iv_in, aad, in, out, { expected_tag, block_size });
+                if (tag.size() != block_size || !timing_safe_compare(expected_tag, tag.data(), tag.size()))
+                    return VerificationConsistency::Inconsistent;
+                return VerificationConsistency::Consistent;
+            }
+        }
+
         auto iv_buf_result = ByteBuffer::copy(iv_in);
         // Not enough memory to figure out :shrug:
         if (iv_buf_result.is_error())
@@ -140,10 +165,14 @@ public:
     }
 
 private:
+    // Ciphers that can hand out AES-NI round keys get the stitched CTR + GHASH implementation, if the CPU supports it.
+    static constexpr bool has_hardware_support = requires(T const& cipher) { cipher.key().hardware_round_keys(); };
+
     static constexpr auto block_size = T::BlockType::BlockSizeInBits / 8;
     u8 m_auth_key_storage[block_size];
     Bytes m_auth_key { m_auth_key_storage, block_size };
     Optional<Authentication::GHash> m_ghash;
+    AESNI::GHashKey m_hardware_ghash_key {};
 };
 
 }
@@ -9,6 +9,8 @@
 #include <AK/Memory.h>
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/Hash/SHAMultiBuffer.h>
+#include <LibCrypto/Hash/SHANI.h>
 
 namespace Crypto::Hash {
 
@@ -19,6 +21,11 @@ static constexpr auto ROTATE_LEFT(u32 value, size_t bits)
 
 inline void SHA1::transform(u8 const* data)
 {
+    if (SHANI::is_supported()) {
+        SHANI::sha1_transform(m_state, data, 1);
+        return;
+    }
+
     u32 blocks[80];
     for (size_t i = 0; i < 16; ++i)
         blocks[i] = AK::convert_between_host_and_network_endian(((u32 const*)data)[i]);
@@ -70,6 +77,16 @@ inline void SHA1::transform(u8 const* data)
 void SHA1::update(u8 const* message, size_t length)
 {
     while (length > 0) {
+        // With the SHA extensions, whole blocks are hashed straight out of the message.
+        if (m_data_length == 0 && length >= BlockSize && SHANI::is_supported()) {
+            auto block_count = length / BlockSize;
+            SHANI::sha1_transform(m_state, message, block_count);
+            m_bit_length += block_count * BlockSize * 8;
+            message += block_count * BlockSize;
+            length -= block_count * BlockSize;
+            continue;
+        }
+
         size_t copy_bytes = AK::min(length, BlockSize - m_data_length);
         __builtin_memcpy(m_data_buffer + m_data_length, message, copy_bytes);
         message += copy_bytes;
@@ -83,6 +100,21 @@ void SHA1::update(u8 const* message, size_t length)
     }
 }
 
+void SHA1::hash_many(ReadonlySpan<ReadonlyBytes> messages, Span<DigestType> digests)
+{
+    VERIFY(messages.size() == digests.size());
+
+    // Eight SHA-1 lanes are faster than the SHA extensions, as long as there are enough messages to keep them busy.
+    auto minimum_message_count = SHANI::is_supported() ? SHAMultiBuffer::lane_count : 2;
+    if (messages.size() >= minimum_message_count && SHAMultiBuffer::is_supported()) {
+        SHAMultiBuffer::sha1_hash(messages, digests);
+        return;
+    }
+
+    for (size_t i = 0; i < messages.size(); ++i)
+        digests[i] = hash(messages[i].data(), messages[i].size());
+}
+
 SHA1::DigestType SHA1::digest()
 {
     auto digest = peek();
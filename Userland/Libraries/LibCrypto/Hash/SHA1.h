@@ -51,6 +51,10 @@ public:
     static DigestType hash(ByteBuffer const& buffer) { return hash(buffer.data(), buffer.size()); }
     static DigestType hash(StringView buffer) { return hash((u8 const*)buffer.characters_without_null_termination(), buffer.length()); }
 
+    // Hashes each message into the digest with the same index. Where the CPU allows hashing several messages side by side,
+    // this is much faster than hashing them one after another.
+    static void hash_many(ReadonlySpan<ReadonlyBytes> messages, Span<DigestType> digests);
+
 #ifndef KERNEL
     virtual ByteString class_name() const override
     {
@@ -7,6 +7,8 @@
 
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/Hash/SHAMultiBuffer.h>
+#include <LibCrypto/Hash/SHANI.h>
 
 namespace Crypto::Hash {
 constexpr static auto ROTRIGHT(u32 a, size_t b) { return (a >> b) | (a << (32 - b)); }
@@ -27,6 +29,11 @@ constexpr static auto SIGN1(u64 x) { return ROTRIGHT(x, 19) ^ ROTRIGHT(x, 61) ^
 
 inline void SHA256::transform(u8 const* data)
 {
+    if (SHANI::is_supported()) {
+        SHANI::sha256_transform(m_state, data, 1);
+        return;
+    }
+
     u32 m[64];
 
     size_t i = 0;
@@ -84,10 +91,42 @@ void update_buffer(u8* buffer, u8 const* input, size_t length, size_t& data_leng
 
 void SHA256::update(u8 const* message, size_t length)
 {
-    update_buffer<BlockSize>(m_data_buffer, message, length, m_data_length, [&]() {
+    auto transform_buffer = [&]() {
         transform(m_data_buffer);
         m_bit_length += BlockSize * 8;
-    });
+    };
+
+    if (m_data_length > 0) {
+        auto copy_bytes = AK::min(length, BlockSize - m_data_length);
+        update_buffer<BlockSize>(m_data_buffer, message, copy_bytes, m_data_length, transform_buffer);
+        message += copy_bytes;
+        length -= copy_bytes;
+    }
+
+    // With the SHA extensions, whole blocks are hashed straight out of the message.
+    if (length >= BlockSize && SHANI::is_supported()) {
+        auto block_count = length / BlockSize;
+        SHANI::sha256_transform(m_state, message, block_count);
+        m_bit_length += block_count * BlockSize * 8;
+        message += block_count * BlockSize;
+        length -= block_count * BlockSize;
+    }
+
+    update_buffer<BlockSize>(m_data_buffer, message, length, m_data_length, transform_buffer);
+}
+
+void SHA256::hash_many(ReadonlySpan<ReadonlyBytes> messages, Span<DigestType> digests)
+{
+    VERIFY(messages.size() == digests.size());
+
+    // The SHA extensions beat eight SHA-256 lanes, so only use those on CPUs without them.
+    if (messages.size() > 1 && !SHANI::is_supported() && SHAMultiBuffer::is_supported()) {
+        SHAMultiBuffer::sha256_hash(messages, digests);
+        return;
+    }
+
+    for (size_t i = 0; i < messages.size(); ++i)
+        digests[i] = hash(messages[i].data(), messages[i].size());
 }
 
 SHA256::DigestType SHA256::digest()
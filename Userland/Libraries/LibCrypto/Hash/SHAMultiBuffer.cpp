@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/Hash/SHAMultiBuffer.h>
+
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
+namespace Crypto::Hash::SHAMultiBuffer {
+
+static bool s_is_disabled_for_testing { false };
+
+void set_disabled_for_testing(bool disabled)
+{
+    s_is_disabled_for_testing = disabled;
+}
+
+#if ARCH(X86_64)
+
+#    define AVX2_FUNCTION [[gnu::target("avx2")]]
+
+namespace {
+
+using WordVector = __m256i;
+
+static constexpr size_t block_size = 64;
+
+AVX2_FUNCTION ALWAYS_INLINE WordVector add(WordVector a, WordVector b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+template<int bits>
+AVX2_FUNCTION ALWAYS_INLINE WordVector rotate_left(WordVector value)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(value, bits), _mm256_srli_epi32(value, 32 - bits));
+}
+
+template<int bits>
+AVX2_FUNCTION ALWAYS_INLINE WordVector rotate_right(WordVector value)
+{
+    return rotate_left<32 - bits>(value);
+}
+
+// Loads the sixteen big-endian message words of each lane's block, transposed so that words[i] holds word i of every lane.
+AVX2_FUNCTION ALWAYS_INLINE void load_message_words(WordVector (&words)[16], u8 const* const (&blocks)[lane_count])
+{
+    auto const byte_swap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    for (size_t half = 0; half < 2; ++half) {
+        WordVector rows[lane_count];
+        for (size_t lane = 0; lane < lane_count; ++lane)
+            rows[lane] = _mm256_loadu_si256(reinterpret_cast<WordVector const*>(blocks[lane] + half * 32));
+
+        // A regular 8x8 transpose of 32-bit elements.
+        WordVector pairs[lane_count];
+        for (size_t i = 0; i < lane_count; i += 2) {
+            pairs[i] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+            pairs[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+        }
+        WordVector quads[lane_count];
+        for (size_t i = 0; i < lane_count; i += 4) {
+            quads[i] = _mm256_unpacklo_epi64(pairs[i], pairs[i + 2]);
+            quads[i + 1] = _mm256_unpackhi_epi64(pairs[i], pairs[i + 2]);
+            quads[i + 2] = _mm256_unpacklo_epi64(pairs[i + 1], pairs[i + 3]);
+            quads[i + 3] = _mm256_unpackhi_epi64(pairs[i + 1], pairs[i + 3]);
+        }
+        auto* out = words + half * 8;
+        for (size_t i = 0; i < 4; ++i) {
+            out[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(quads[i], quads[i + 4], 0x20), byte_swap);
+            out[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(quads[i], quads[i + 4], 0x31), byte_swap);
+        }
+    }
+}
+
+struct SHA1Lanes {
+    using DigestType = Digest<160>;
+    static constexpr size_t state_size = 5;
+    static constexpr auto const& initial_state = SHA1Constants::InitializationHashes;
+
+    AVX2_FUNCTION ALWAYS_INLINE static void transform(WordVector (&state)[state_size], WordVector (&w)[16])
+    {
+        auto a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+#    pragma GCC unroll 80
+        for (size_t i = 0; i < 80; ++i) {
+            if (i >= 16)
+                w[i % 16] = rotate_left<1>(_mm256_xor_si256(_mm256_xor_si256(w[(i - 3) % 16], w[(i - 8) % 16]), _mm256_xor_si256(w[(i - 14) % 16], w[i % 16])));
+
+            WordVector f;
+            if (i <= 19)
+                f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_andnot_si256(b, d));
+            else if (i <= 39 || i >= 60)
+                f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+            else
+                f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+            auto k = _mm256_set1_epi32(SHA1Constants::RoundConstants[i / 20]);
+
+            auto temp = add(add(rotate_left<5>(a), f), add(add(e, k), w[i % 16]));
+            e = d;
+            d = c;
+            c = rotate_left<30>(b);
+            b = a;
+            a = temp;
+        }
+
+        state[0] = add(state[0], a);
+        state[1] = add(state[1], b);
+        state[2] = add(state[2], c);
+        state[3] = add(state[3], d);
+        state[4] = add(state[4], e);
+    }
+};
+
+struct SHA256Lanes {
+    using DigestType = Digest<256>;
+    static constexpr size_t state_size = 8;
+    static constexpr auto const& initial_state = SHA256Constants::InitializationHashes;
+
+    AVX2_FUNCTION ALWAYS_INLINE static void transform(WordVector (&state)[state_size], WordVector (&w)[16])
+    {
+        auto a = state[0], b = state[1], c = state[2], d = state[3],
+             e = state[4], f = state[5], g = state[6], h = state[7];
+
+#    pragma GCC unroll 64
+        for (size_t i = 0; i < 64; ++i) {
+            if (i >= 16) {
+                auto s0 = _mm256_xor_si256(_mm256_xor_si256(rotate_right<7>(w[(i - 15) % 16]), rotate_right<18>(w[(i - 15) % 16])), _mm256_srli_epi32(w[(i - 15) % 16], 3));
+                auto s1 = _mm256_xor_si256(_mm256_xor_si256(rotate_right<17>(w[(i - 2) % 16]), rotate_right<19>(w[(i - 2) % 16])), _mm256_srli_epi32(w[(i - 2) % 16], 10));
+                w[i % 16] = add(add(w[i % 16], s0), add(w[(i - 7) % 16], s1));
+            }
+
+            auto ep1 = _mm256_xor_si256(_mm256_xor_si256(rotate_right<6>(e), rotate_right<11>(e)), rotate_right<25>(e));
+            auto ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            auto temp0 = add(add(h, ep1), add(ch, add(_mm256_set1_epi32(SHA256Constants::RoundConstants[i]), w[i % 16])));
+
+            auto ep0 = _mm256_xor_si256(_mm256_xor_si256(rotate_right<2>(a), rotate_right<13>(a)), rotate_right<22>(a));
+            auto maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            auto temp1 = add(ep0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = add(d, temp0);
+            d = c;
+            c = b;
+            b = a;
+            a = add(temp0, temp1);
+        }
+
+        state[0] = add(state[0], a);
+        state[1] = add(state[1], b);
+        state[2] = add(state[2], c);
+        state[3] = add(state[3], d);
+        state[4] = add(state[4], e);
+        state[5] = add(state[5], f);
+        state[6] = add(state[6], g);
+        state[7] = add(state[7], h);
+    }
+};
+
+// One message that is being hashed in a lane: its whole blocks come straight from the message, followed by one or two blocks
+// with the tail of the message and the padding.
+struct Lane {
+    void start(size_t index, ReadonlyBytes message)
+    {
+        message_index = index;
+        data = message.data();
+        whole_block_count = message.size() / block_size;
+        next_block = 0;
+
+        auto tail_size = message.size() % block_size;
+        padding_block_count = tail_size < block_size - 8 ? 1 : 2;
+        __builtin_memset(padding, 0, sizeof(padding));
+        if (tail_size > 0)
+            __builtin_memcpy(padding, data + whole_block_count * block_size, tail_size);
+        padding[tail_size] = 0x80;
+
+        auto bit_length = (u64)message.size() * 8;
+        auto* end = padding + padding_block_count * block_size;
+        for (size_t i = 1; i <= 8; ++i, bit_length >>= 8)
+            end[-i] = bit_length;
+    }
+
+    u8 const* block() const
+    {
+        if (next_block < whole_block_count)
+            return data + next_block * block_size;
+        return padding + (next_block - whole_block_count) * block_size;
+    }
+
+    bool is_finished() const { return next_block == whole_block_count + padding_block_count; }
+
+    size_t message_index { 0 };
+    u8 const* data { nullptr };
+    size_t whole_block_count { 0 };
+    size_t padding_block_count { 0 };
+    size_t next_block { 0 };
+    u8 padding[2 * block_size];
+};
+
+// Feeds the messages to the lanes one after another: whenever a lane finishes its message, it picks up the next one.
+// Lanes without a message left hash a dummy block whose result is thrown away.
+template<typename Algorithm>
+AVX2_FUNCTION void hash_messages(ReadonlySpan<ReadonlyBytes> messages, Span<typename Algorithm::DigestType> digests)
+{
+    VERIFY(messages.size() == digests.size());
+
+    static constexpr u8 idle_block[block_size] {};
+    alignas(32) u32 state[Algorithm::state_size][lane_count];
+    Lane lanes[lane_count];
+    bool active[lane_count] {};
+    size_t active_count = 0;
+    size_t next_message = 0;
+
+    auto start_next_message = [&](size_t lane) {
+        if (next_message == messages.size()) {
+            active[lane] = false;
+            return;
+        }
+        lanes[lane].start(next_message, messages[next_message]);
+        for (size_t i = 0; i < Algorithm::state_size; ++i)
+            state[i][lane] = Algorithm::initial_state[i];
+        ++next_message;
+        if (!active[lane])
+            ++active_count;
+        active[lane] = true;
+    };
+
+    for (size_t lane = 0; lane < lane_count; ++lane)
+        start_next_message(lane);
+
+    while (active_count > 0) {
+        u8 const* blocks[lane_count];
+        for (size_t lane = 0; lane < lane_count; ++lane)
+            blocks[lane] = active[lane] ? lanes[lane].block() : idle_block;
+
+        WordVector words[16];
+        load_message_words(words, blocks);
+
+        WordVector vectors[Algorithm::state_size];
+        for (size_t i = 0; i < Algorithm::state_size; ++i)
+            vectors[i] = _mm256_load_si256(reinterpret_cast<WordVector const*>(state[i]));
+        Algorithm::transform(vectors, words);
+        for (size_t i = 0; i < Algorithm::state_size; ++i)
+            _mm256_store_si256(reinterpret_cast<WordVector*>(state[i]), vectors[i]);
+
+        for (size_t lane = 0; lane < lane_count; ++lane) {
+            if (!active[lane])
+                continue;
+            auto& current = lanes[lane];
+            ++current.next_block;
+            if (!current.is_finished())
+                continue;
+
+            auto& digest = digests[current.message_index];
+            for (size_t i = 0; i < Algorithm::state_size; ++i) {
+                auto word = state[i][lane];
+                digest.data[i * 4 + 0] = word >> 24;
+                digest.data[i * 4 + 1] = word >> 16;
+                digest.data[i * 4 + 2] = word >> 8;
+                digest.data[i * 4 + 3] = word;
+            }
+
+            --active_count;
+            active[lane] = false;
+            start_next_message(lane);
+        }
+    }
+}
+
+}
+
+bool is_supported()
+{
+    return !s_is_disabled_for_testing && __builtin_cpu_supports("avx2");
+}
+
+void sha1_hash(ReadonlySpan<ReadonlyBytes> messages, Span<Digest<160>> digests)
+{
+    hash_messages<SHA1Lanes>(messages, digests);
+}
+
+void sha256_hash(ReadonlySpan<ReadonlyBytes> messages, Span<Digest<256>> digests)
+{
+    hash_messages<SHA256Lanes>(messages, digests);
+}
+
+#    undef AVX2_FUNCTION
+
+#else
+
+bool is_supported()
+{
+    return false;
+}
+
+void sha1_hash(ReadonlySpan<ReadonlyBytes>, Span<Digest<160>>)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void sha256_hash(ReadonlySpan<ReadonlyBytes>, Span<Digest<256>>)
+{
+    VERIFY_NOT_REACHED();
+}
+
+#endif
+
+}
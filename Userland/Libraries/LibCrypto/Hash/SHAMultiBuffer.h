@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <LibCrypto/Hash/HashFunction.h>
+
+// SHA-1 and SHA-256 over several independent messages at once, with one message per 32-bit lane of an AVX2 register.
+// Everything but is_supported() and set_disabled_for_testing() must only be called if is_supported() returned true.
+namespace Crypto::Hash::SHAMultiBuffer {
+
+static constexpr size_t lane_count = 8;
+
+bool is_supported();
+
+// Makes is_supported() return false, so that tests and benchmarks can run the scalar code on any CPU.
+void set_disabled_for_testing(bool);
+
+// These hash each message into the digest with the same index.
+void sha1_hash(ReadonlySpan<ReadonlyBytes> messages, Span<Digest<160>> digests);
+void sha256_hash(ReadonlySpan<ReadonlyBytes> messages, Span<Digest<256>> digests);
+
+}
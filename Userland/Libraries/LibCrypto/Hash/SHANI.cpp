@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Assertions.h>
+#include <AK/Platform.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/Hash/SHANI.h>
+
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
+namespace Crypto::Hash::SHANI {
+
+static bool s_is_disabled_for_testing { false };
+
+void set_disabled_for_testing(bool disabled)
+{
+    s_is_disabled_for_testing = disabled;
+}
+
+#if ARCH(X86_64)
+
+#    define SHANI_FUNCTION [[gnu::target("sha,sse4.1,ssse3")]]
+
+bool is_supported()
+{
+    return !s_is_disabled_for_testing && __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("ssse3");
+}
+
+// See "Intel SHA Extensions: New Instructions Supporting the Secure Hash Algorithm on Intel Architecture Processors"
+// (Gulley et al.) for how the message schedule and the rounds are split across the instructions.
+
+SHANI_FUNCTION void sha1_transform(u32 (&state)[5], u8 const* data, size_t block_count)
+{
+    // Reverses the bytes of the whole vector, which both converts from big-endian words and puts W0 in the top lane.
+    auto const byte_swap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state)), 0x1b);
+    auto e0 = _mm_set_epi32(state[4], 0, 0, 0);
+    __m128i e1;
+
+    for (; block_count > 0; --block_count, data += 64) {
+        auto const saved_abcd = abcd;
+        auto const saved_e = e0;
+
+        // w[i] holds the message words 4i to 4i + 3 (modulo 16), one rnds4 instruction consumes one of them.
+        __m128i w[4];
+#    pragma GCC unroll 20
+        for (size_t i = 0; i < 20; ++i) {
+            if (i < 4)
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 16)), byte_swap);
+
+            auto& e = i % 2 == 0 ? e0 : e1;
+            auto& next_e = i % 2 == 0 ? e1 : e0;
+            if (i == 0)
+                e = _mm_add_epi32(e, w[0]);
+            else
+                e = _mm_sha1nexte_epu32(e, w[i % 4]);
+            next_e = abcd;
+
+            if (i >= 3 && i <= 18)
+                w[(i + 1) % 4] = _mm_sha1msg2_epu32(w[(i + 1) % 4], w[i % 4]);
+
+            // The function and constant change every 20 rounds, i.e. every five iterations.
+            switch (i / 5) {
+            case 0:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+                break;
+            case 1:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 1);
+                break;
+            case 2:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 2);
+                break;
+            default:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 3);
+                break;
+            }
+
+            if (i >= 1 && i <= 16)
+                w[(i + 3) % 4] = _mm_sha1msg1_epu32(w[(i + 3) % 4], w[i % 4]);
+            if (i >= 2 && i <= 17)
+                w[(i + 2) % 4] = _mm_xor_si128(w[(i + 2) % 4], w[i % 4]);
+        }
+
+        e0 = _mm_sha1nexte_epu32(e0, saved_e);
+        abcd = _mm_add_epi32(abcd, saved_abcd);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = _mm_extract_epi32(e0, 3);
+}
+
+SHANI_FUNCTION void sha256_transform(u32 (&state)[8], u8 const* data, size_t block_count)
+{
+    auto const byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The round instructions want the state as ABEF and CDGH.
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state)), 0xb1);
+    auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state + 4)), 0x1b);
+    auto abef = _mm_alignr_epi8(abcd, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, abcd, 0xf0);
+
+    for (; block_count > 0; --block_count, data += 64) {
+        auto const saved_abef = abef;
+        auto const saved_cdgh = cdgh;
+
+        // w[i] holds the message words 4i to 4i + 3 (modulo 16), each iteration runs four rounds.
+        __m128i w[4];
+#    pragma GCC unroll 16
+        for (size_t i = 0; i < 16; ++i) {
+            if (i < 4)
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 16)), byte_swap);
+
+            auto message = _mm_add_epi32(w[i % 4], _mm_loadu_si128(reinterpret_cast<__m128i const*>(SHA256Constants::RoundConstants + i * 4)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+
+            if (i >= 3 && i <= 14) {
+                auto next = _mm_add_epi32(w[(i + 1) % 4], _mm_alignr_epi8(w[i % 4], w[(i + 3) % 4], 4));
+                w[(i + 1) % 4] = _mm_sha256msg2_epu32(next, w[i % 4]);
+            }
+
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0e));
+
+            if (i >= 1 && i <= 12)
+                w[(i + 3) % 4] = _mm_sha256msg1_epu32(w[(i + 3) % 4], w[i % 4]);
+        }
+
+        abef = _mm_add_epi32(abef, saved_abef);
+        cdgh = _mm_add_epi32(cdgh, saved_cdgh);
+    }
+
+    auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#    undef SHANI_FUNCTION
+
+#else
+
+bool is_supported()
+{
+    return false;
+}
+
+void sha1_transform(u32 (&)[5], u8 const*, size_t)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void sha256_transform(u32 (&)[8], u8 const*, size_t)
+{
+    VERIFY_NOT_REACHED();
+}
+
+#endif
+
+}
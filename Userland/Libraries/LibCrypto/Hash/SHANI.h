@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// SHA-1 and SHA-256 compression functions on top of the x86-64 SHA extensions.
+// Everything but is_supported() and set_disabled_for_testing() must only be called if is_supported() returned true.
+namespace Crypto::Hash::SHANI {
+
+bool is_supported();
+
+// Makes is_supported() return false, so that tests and benchmarks can run the scalar code on any CPU.
+void set_disabled_for_testing(bool);
+
+// These run the compression function over `block_count` consecutive 64-byte blocks.
+void sha1_transform(u32 (&state)[5], u8 const* data, size_t block_count);
+void sha256_transform(u32 (&state)[8], u8 const* data, size_t block_count);
+
+}
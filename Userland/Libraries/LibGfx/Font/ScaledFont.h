@@ -28,6 +28,8 @@ public:
     ScaledFontMetrics metrics() const { return m_font->metrics(m_x_scale, m_y_scale); }
     ScaledGlyphMetrics glyph_metrics(u32 glyph_id) const { return m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale, m_point_width, m_point_height); }
     RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset) const;
+    // Doesn't look at or fill the glyph bitmap cache, so it can be called from threads that don't own the font.
+    RefPtr<Gfx::Bitmap> rasterize_glyph_uncached(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const { return m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, subpixel_offset); }
     bool append_glyph_path_to(Gfx::Path&, u32 glyph_id) const;
 
     // ^Gfx::Font
@@ -82,8 +82,15 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // ideal_size is a hint for formats that can cheaply decode at a smaller size. Such a frame may be smaller than
+    // size(), but should still be at least as large as ideal_size.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if the format can show something useful before all of its data has arrived, e.g. the top rows of
+    // a sequential image or the first passes of an interlaced one. The plugin was created with whatever prefix of the
+    // data is available so far. Parts of the first frame that this data doesn't cover yet should be left transparent.
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame() { return Error::from_string_literal("Partial decoding is not supported for this format"); }
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() { return OptionalNone {}; }
@@ -110,6 +117,7 @@ public:
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    ErrorOr<ImageFrameDescriptor> partial_frame() const { return m_plugin->partial_frame(); }
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
@@ -13,6 +13,7 @@
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
@@ -23,6 +24,11 @@
 
 namespace Gfx {
 
+using AK::SIMD::f32x4;
+using AK::SIMD::i16x8;
+using AK::SIMD::i32x4;
+using AK::SIMD::u32x4;
+
 struct MacroblockMeta {
     u32 total { 0 };
     u32 padded_total { 0 };
@@ -416,6 +422,9 @@ struct Scan {
 
     u64 end_of_bands_run_count { 0 };
 
+    // The number of macroblock rows that this scan has been fully decoded for.
+    u32 decoded_macroblock_rows { 0 };
+
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
     {
@@ -461,9 +470,14 @@ struct JPEGLoadingContext {
     SamplingFactors sampling_factors {};
 
     Optional<Scan> current_scan {};
+    u32 number_of_started_scans { 0 };
 
     Vector<Component, 4> components;
 
+    // The width and height of the area that an 8x8 block covers in the decoded bitmap. Anything below 8 means that the
+    // image is decoded at a reduced scale, see inverse_dct_reduced().
+    u8 scaled_block_size { 8 };
+
     RefPtr<Gfx::Bitmap> bitmap;
     RefPtr<Gfx::CMYKBitmap> cmyk_bitmap;
 
@@ -806,6 +820,7 @@ static void reset_decoder(JPEGLoadingContext& context)
 static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
+        context.current_scan->decoded_macroblock_rows = vcursor;
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             // FIXME: This is likely wrong for non-interleaved scans.
             VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
@@ -841,6 +856,7 @@ static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<M
             }
         }
     }
+    context.current_scan->decoded_macroblock_rows = context.mblock_meta.vcount;
     return {};
 }
 
@@ -1407,32 +1423,94 @@ static ErrorOr<void> skip_segment(JPEGStream& stream)
     return {};
 }
 
-static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+// Functions taking or returning vectors make GCC warn about ABI changes when compiling for architectures without SIMD
+// registers. They are all local to this file, so that doesn't matter.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+static ALWAYS_INLINE i16x8 load_row(i16 const* row)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            for (u32 i = 0; i < context.components.size(); i++) {
-                auto const& component = context.components[i];
-
-                auto const& table = context.quantization_tables[component.quantization_table_id];
-
-                for (u32 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
-                    for (u32 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
-                    }
+    i16x8 vector;
+    __builtin_memcpy(&vector, row, sizeof(vector));
+    return vector;
+}
+
+static ALWAYS_INLINE void store_row(i16* row, i16x8 vector)
+{
+    __builtin_memcpy(row, &vector, sizeof(vector));
+}
+
+// NOTE: Some compilers convert between vectors of 16-bit and 32-bit integers one lane at a time, so we widen and
+//       narrow them with shuffles instead.
+static ALWAYS_INLINE i32x4 widen_low(i16x8 vector)
+{
+    return bit_cast<i32x4>(__builtin_shufflevector(vector, vector, 0, 0, 1, 1, 2, 2, 3, 3)) >> 16;
+}
+
+static ALWAYS_INLINE i32x4 widen_high(i16x8 vector)
+{
+    return bit_cast<i32x4>(__builtin_shufflevector(vector, vector, 4, 4, 5, 5, 6, 6, 7, 7)) >> 16;
+}
+
+// Keeps the lower 16 bits of each lane.
+static ALWAYS_INLINE i16x8 narrow(i32x4 low, i32x4 high)
+{
+    if constexpr (AK::HostIsLittleEndian)
+        return __builtin_shufflevector(bit_cast<i16x8>(low), bit_cast<i16x8>(high), 0, 2, 4, 6, 8, 10, 12, 14);
+    else
+        return __builtin_shufflevector(bit_cast<i16x8>(low), bit_cast<i16x8>(high), 1, 3, 5, 7, 9, 11, 13, 15);
+}
+
+static ALWAYS_INLINE f32x4 to_f32x4(i32x4 vector)
+{
+    return __builtin_convertvector(vector, f32x4);
+}
+
+// NOTE: This truncates, just like converting a float to an integer does.
+static ALWAYS_INLINE i32x4 to_i32x4(f32x4 vector)
+{
+    return __builtin_convertvector(vector, i32x4);
+}
+
+static ALWAYS_INLINE i32x4 clamp_lanes(i32x4 vector, i32 min, i32 max)
+{
+    auto const min_vector = i32x4 {} + min;
+    auto const max_vector = i32x4 {} + max;
+    vector = vector < min_vector ? min_vector : vector;
+    return vector > max_vector ? max_vector : vector;
+}
+
+static Span<Macroblock> macroblocks_in_mcu_row(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 vcursor)
+{
+    auto const row_length = context.mblock_meta.hpadded_count;
+    return macroblocks.span().slice(vcursor * row_length, context.sampling_factors.vertical * row_length);
+}
+
+static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor)
+{
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
+        for (u32 i = 0; i < context.components.size(); i++) {
+            auto const& component = context.components[i];
+
+            auto const& table = context.quantization_tables[component.quantization_table_id];
+
+            for (u32 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
+                for (u32 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
+                    u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[macroblock_index];
+                    auto* block_component = get_component(block, i);
+                    for (u32 k = 0; k < 64; k++)
+                        block_component[k] *= table[k];
                 }
             }
         }
     }
 }
 
-static void inverse_dct_8x8(i16* block_component)
+// Does a 1-D IDCT of eight floats, or of eight f32x4 vectors in each of their four lanes.
+template<typename T>
+static ALWAYS_INLINE void inverse_dct_8(T (&values)[8])
 {
-    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
     // The 1-D DCT idea is described at https://unix4lyfe.org/dct-1d/, read aan.cc from bottom to top.
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -1449,155 +1527,207 @@ static void inverse_dct_8x8(i16* block_component)
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
+    T const g0 = values[0] * s0;
+    T const g1 = values[4] * s4;
+    T const g2 = values[2] * s2;
+    T const g3 = values[6] * s6;
+    T const g4 = values[5] * s5;
+    T const g5 = values[1] * s1;
+    T const g6 = values[7] * s7;
+    T const g7 = values[3] * s3;
+
+    T const f0 = g0;
+    T const f1 = g1;
+    T const f2 = g2;
+    T const f3 = g3;
+    T const f4 = g4 - g7;
+    T const f5 = g5 + g6;
+    T const f6 = g5 - g6;
+    T const f7 = g4 + g7;
+
+    T const e0 = f0;
+    T const e1 = f1;
+    T const e2 = f2 - f3;
+    T const e3 = f2 + f3;
+    T const e4 = f4;
+    T const e5 = f5 - f7;
+    T const e6 = f6;
+    T const e7 = f5 + f7;
+    T const e8 = f4 + f6;
+
+    T const d0 = e0;
+    T const d1 = e1;
+    T const d2 = e2 * m1;
+    T const d3 = e3;
+    T const d4 = e4 * m2;
+    T const d5 = e5 * m3;
+    T const d6 = e6 * m4;
+    T const d7 = e7;
+    T const d8 = e8 * m5;
+
+    T const c0 = d0 + d1;
+    T const c1 = d0 - d1;
+    T const c2 = d2 - d3;
+    T const c3 = d3;
+    T const c4 = d4 + d8;
+    T const c5 = d5 + d7;
+    T const c6 = d6 - d8;
+    T const c7 = d7;
+    T const c8 = c5 - c6;
+
+    T const b0 = c0 + c3;
+    T const b1 = c1 + c2;
+    T const b2 = c1 - c2;
+    T const b3 = c0 - c3;
+    T const b4 = c4 - c8;
+    T const b5 = c8;
+    T const b6 = c6 - c7;
+    T const b7 = c7;
+
+    values[0] = b0 + b7;
+    values[1] = b1 + b6;
+    values[2] = b2 + b5;
+    values[3] = b3 + b4;
+    values[4] = b3 - b4;
+    values[5] = b2 - b5;
+    values[6] = b1 - b6;
+    values[7] = b0 - b7;
+}
+
+static ALWAYS_INLINE void transpose_4x4(f32x4& a, f32x4& b, f32x4& c, f32x4& d)
+{
+    auto const ab_low = __builtin_shufflevector(a, b, 0, 4, 1, 5);
+    auto const ab_high = __builtin_shufflevector(a, b, 2, 6, 3, 7);
+    auto const cd_low = __builtin_shufflevector(c, d, 0, 4, 1, 5);
+    auto const cd_high = __builtin_shufflevector(c, d, 2, 6, 3, 7);
+    a = __builtin_shufflevector(ab_low, cd_low, 0, 1, 4, 5);
+    b = __builtin_shufflevector(ab_low, cd_low, 2, 3, 6, 7);
+    c = __builtin_shufflevector(ab_high, cd_high, 0, 1, 4, 5);
+    d = __builtin_shufflevector(ab_high, cd_high, 2, 3, 6, 7);
+}
+
+// Transposes an 8x8 block, given as the left and right halves of its rows.
+static ALWAYS_INLINE void transpose_8x8(f32x4 (&left)[8], f32x4 (&right)[8])
+{
+    transpose_4x4(left[0], left[1], left[2], left[3]);
+    transpose_4x4(right[0], right[1], right[2], right[3]);
+    transpose_4x4(left[4], left[5], left[6], left[7]);
+    transpose_4x4(right[4], right[5], right[6], right[7]);
+    for (u32 i = 0; i < 4; ++i)
+        swap(right[i], left[i + 4]);
+}
+
+static void inverse_dct_8x8(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    // With one row of the block per pair of vectors, the first pass transforms four columns at a time. Transposing the
+    // block then lets the second pass do the same for the rows.
+    f32x4 left[8];
+    f32x4 right[8];
+    for (u32 i = 0; i < 8; ++i) {
+        auto const row = load_row(block_component + i * 8);
+        left[i] = to_f32x4(widen_low(row));
+        right[i] = to_f32x4(widen_high(row));
+    }
+
+    inverse_dct_8(left);
+    inverse_dct_8(right);
+
+    // NOTE: Keep the intermediate results integral, as they were back when they were stored in the block in between.
+    for (u32 i = 0; i < 8; ++i) {
+        left[i] = to_f32x4(to_i32x4(left[i]));
+        right[i] = to_f32x4(to_i32x4(right[i]));
+    }
+
+    transpose_8x8(left, right);
+    inverse_dct_8(left);
+    inverse_dct_8(right);
+    transpose_8x8(left, right);
+
+    for (u32 i = 0; i < 8; ++i)
+        store_row(block_component + i * 8, narrow(to_i32x4(left[i]), to_i32x4(right[i])));
+}
+
+static void inverse_dct_8x8_scalar(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
     for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
+        float column[8];
+        for (u32 i = 0; i < 8; ++i)
+            column[i] = block_component[i * 8 + k];
+        inverse_dct_8(column);
+        for (u32 i = 0; i < 8; ++i)
+            block_component[i * 8 + k] = column[i];
     }
     for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
-    }
-}
-
-static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+        float row[8];
+        for (u32 i = 0; i < 8; ++i)
+            row[i] = block_component[l * 8 + i];
+        inverse_dct_8(row);
+        for (u32 i = 0; i < 8; ++i)
+            block_component[l * 8 + i] = row[i];
+    }
+}
+
+// Decodes a block at 1/2, 1/4 or 1/8 scale, by doing an IDCT of size 4, 2 or 1 on the low-frequency coefficients only.
+// The scaled_block_size x scaled_block_size result is stored in the top-left corner of the block.
+static void inverse_dct_reduced(i16* block_component, u8 scaled_block_size)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
-                auto& component = context.components[component_i];
-                for (u8 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
-                    for (u8 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component = get_component(block, component_i);
+    // With N = scaled_block_size and C(u) as in the full-size IDCT, this is an N-point IDCT scaled by sqrt(N / 8):
+    //     f(x) = sum over u < N of C(u) / 2 * F(u) * cos((2x + 1) * u * pi / 2N)
+    // This keeps the average of the block the same as that of the full-size result.
+    static auto const tables = [] {
+        Array<Array<float, 16>, 3> tables {};
+        for (u8 table_index = 0; table_index < 3; ++table_index) {
+            u8 const size = 1 << table_index;
+            for (u8 x = 0; x < size; ++x) {
+                for (u8 u = 0; u < size; ++u) {
+                    float const c = u == 0 ? 1.0f / AK::sqrt(2.0f) : 1.0f;
+                    tables[table_index][x * size + u] = c / 2.0f * AK::cos((2 * x + 1) * u * AK::Pi<float> / (2 * size));
+                }
+            }
+        }
+        return tables;
+    }();
+
+    VERIFY(scaled_block_size == 1 || scaled_block_size == 2 || scaled_block_size == 4);
+    auto const& table = tables[count_trailing_zeroes(scaled_block_size)];
+
+    // Columns first, then rows.
+    float columns[4][4] {};
+    for (u8 y = 0; y < scaled_block_size; ++y) {
+        for (u8 u = 0; u < scaled_block_size; ++u) {
+            for (u8 v = 0; v < scaled_block_size; ++v)
+                columns[y][u] += table[y * scaled_block_size + v] * block_component[v * 8 + u];
+        }
+    }
+
+    for (u8 y = 0; y < scaled_block_size; ++y) {
+        for (u8 x = 0; x < scaled_block_size; ++x) {
+            float value = 0;
+            for (u8 u = 0; u < scaled_block_size; ++u)
+                value += table[x * scaled_block_size + u] * columns[y][u];
+            block_component[y * 8 + x] = round_to<i16>(value);
+        }
+    }
+}
+
+static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 vcursor)
+{
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
+        for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
+            auto& component = context.components[component_i];
+            for (u8 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
+                for (u8 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
+                    u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[macroblock_index];
+                    auto* block_component = get_component(block, component_i);
+                    if (context.scaled_block_size < 8)
+                        inverse_dct_reduced(block_component, context.scaled_block_size);
+                    else if (context.options.use_simd)
                         inverse_dct_8x8(block_component);
-                    }
+                    else
+                        inverse_dct_8x8_scalar(block_component);
                 }
             }
         }
@@ -1606,35 +1736,34 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
     auto const max_value = (1 << context.frame.precision) - 1;
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
-                for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
-                    u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
-
-                            // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
-                            //        12 bits JPEGs without rewriting all color transformations.
-                            auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-                                if (context.frame.precision == 8)
-                                    return static_cast<u8>(color);
-                                return static_cast<u8>(color >> 4);
-                            };
-
-                            macroblocks[mb_index].r[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].g[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].b[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].k[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i * 8 + j] + level_shift, 0, max_value));
-                        }
-                    }
-                }
-            }
+
+    // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
+    //        12 bits JPEGs without rewriting all color transformations.
+    auto const shift_to_8_bits = context.frame.precision - 8;
+
+    auto const level_shift_and_clamp = [&](i16* block_component) {
+        if (!context.options.use_simd) {
+            for (u8 i = 0; i < 64; ++i)
+                block_component[i] = clamp(block_component[i] + level_shift, 0, max_value) >> shift_to_8_bits;
+            return;
+        }
+        for (u8 i = 0; i < 64; i += 8) {
+            auto const row = load_row(block_component + i);
+            auto const low = clamp_lanes(widen_low(row) + level_shift, 0, max_value) >> shift_to_8_bits;
+            auto const high = clamp_lanes(widen_high(row) + level_shift, 0, max_value) >> shift_to_8_bits;
+            store_row(block_component + i, narrow(low, high));
         }
+    };
+
+    for (auto& macroblock : macroblocks_in_mcu_row(context, macroblocks, vcursor)) {
+        level_shift_and_clamp(macroblock.r);
+        level_shift_and_clamp(macroblock.g);
+        level_shift_and_clamp(macroblock.b);
+        level_shift_and_clamp(macroblock.k);
     }
 }
 
-static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 vcursor)
 {
     // The first component has sampling factors of context.sampling_factors, while the others
     // divide the first component's sampling factors. This is enforced by read_start_of_frame().
@@ -1649,28 +1778,43 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
         if (component.sampling_factors == context.sampling_factors)
             continue;
 
-        for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-            for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-                u32 const component_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
-                Macroblock& component_block = macroblocks[component_block_index];
-                auto* block_component_source = get_component(component_block, component_i);
-
-                // Overflows are intentional.
-                for (u8 vfactor_i = context.sampling_factors.vertical - 1; vfactor_i < context.sampling_factors.vertical; --vfactor_i) {
-                    for (u8 hfactor_i = context.sampling_factors.horizontal - 1; hfactor_i < context.sampling_factors.horizontal; --hfactor_i) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
-                                // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
-                                block_component_destination[pixel] = block_component_source[component_pixel];
+        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
+            u32 const component_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
+            Macroblock& component_block = macroblocks[component_block_index];
+            auto* block_component_source = get_component(component_block, component_i);
+
+            // Overflows are intentional.
+            // NOTE: The source block is also the last destination block, and the rows within a block are written from
+            //       the bottom up, so no source row is overwritten before it's been read.
+            for (u8 vfactor_i = context.sampling_factors.vertical - 1; vfactor_i < context.sampling_factors.vertical; --vfactor_i) {
+                for (u8 hfactor_i = context.sampling_factors.horizontal - 1; hfactor_i < context.sampling_factors.horizontal; --hfactor_i) {
+                    u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[macroblock_index];
+                    auto* block_component_destination = get_component(block, component_i);
+                    if (context.scaled_block_size < 8 || !context.options.use_simd) {
+                        // This goes one pixel at a time. Blocks that were decoded at a reduced scale only use their top-left
+                        // corner, see inverse_dct_reduced().
+                        u8 const size = context.scaled_block_size;
+                        for (u8 i = size - 1; i < size; --i) {
+                            for (u8 j = size - 1; j < size; --j) {
+                                u32 const component_pxrow = (i + size * vfactor_i) / context.sampling_factors.vertical;
+                                u32 const component_pxcolumn = (j + size * hfactor_i) / context.sampling_factors.horizontal;
+                                block_component_destination[i * 8 + j] = block_component_source[component_pxrow * 8 + component_pxcolumn];
                             }
                         }
+                        continue;
+                    }
+                    for (u8 i = 7; i < 8; --i) {
+                        // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
+                        u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
+                        auto row = load_row(block_component_source + component_pxrow * 8);
+                        if (context.sampling_factors.horizontal == 2) {
+                            if (hfactor_i == 0)
+                                row = __builtin_shufflevector(row, row, 0, 0, 1, 1, 2, 2, 3, 3);
+                            else
+                                row = __builtin_shufflevector(row, row, 4, 4, 5, 5, 6, 6, 7, 7);
+                        }
+                        store_row(block_component_destination + i * 8, row);
                     }
                 }
             }
@@ -1678,27 +1822,29 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     }
 }
 
-static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
+static ALWAYS_INLINE void ycbcr_to_rgb(i16 y, i16 cb, i16 cr, i16& r, i16& g, i16& b)
 {
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
     // 7 - Conversion to and from RGB
+    int red = y + 1.402f * (cr - 128);
+    int green = y - 0.3441f * (cb - 128) - 0.7141f * (cr - 128);
+    int blue = y + 1.772f * (cb - 128);
+    r = clamp(red, 0, 255);
+    g = clamp(green, 0, 255);
+    b = clamp(blue, 0, 255);
+}
+
+static void ycbcr_to_rgb(Span<Macroblock> macroblocks)
+{
+    // NOTE: This loop is simple enough for the compiler to vectorize it as wide as the target allows.
     for (auto& macroblock : macroblocks) {
-        auto* y = macroblock.y;
-        auto* cb = macroblock.cb;
-        auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
-            int r = y[i] + 1.402f * (cr[i] - 128);
-            int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
-            int b = y[i] + 1.772f * (cb[i] - 128);
-            y[i] = clamp(r, 0, 255);
-            cb[i] = clamp(g, 0, 255);
-            cr[i] = clamp(b, 0, 255);
-        }
+        for (u8 i = 0; i < 64; ++i)
+            ycbcr_to_rgb(macroblock.y[i], macroblock.cb[i], macroblock.cr[i], macroblock.r[i], macroblock.g[i], macroblock.b[i]);
     }
 }
 
-static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     if (!context.color_transform.has_value())
         return;
@@ -1719,7 +1865,7 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     }
 }
 
-static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
+static void ycck_to_cmyk(Span<Macroblock> macroblocks)
 {
     // 7 - Conversions between colour encodings
     // YCCK is obtained from CMYK by converting the CMY channels to YCC channel.
@@ -1737,7 +1883,7 @@ static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
     }
 }
 
-static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, Span<Macroblock> macroblocks)
 {
     // Note: This is non-standard but some encoder still add the App14 segment for grayscale images.
     //       So let's ignore the color transform value if we only have one component.
@@ -1783,48 +1929,110 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
     return {};
 }
 
-static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
+
+static void compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks, u32 vcursor)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
+    u32 const first_row = vcursor * 8;
+    u32 const end_row = min(context.frame.height, (vcursor + context.sampling_factors.vertical) * 8);
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
+    for (u32 y = first_row; y < end_row; y++) {
         u32 const block_row = y / 8;
         u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 block_column = 0; block_column < context.mblock_meta.hcount; block_column++) {
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
-            Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+            u32 const pixel_index = pixel_row * 8;
+            auto const r = load_row(block.r + pixel_index);
+            auto const g = load_row(block.g + pixel_index);
+            auto const b = load_row(block.b + pixel_index);
+            u32x4 const pixels[2] = {
+                bit_cast<u32x4>((widen_low(r) << 16) | (widen_low(g) << 8) | widen_low(b)) | 0xff000000u,
+                bit_cast<u32x4>((widen_high(r) << 16) | (widen_high(g) << 8) | widen_high(b)) | 0xff000000u,
+            };
+
+            u32 const x = block_column * 8;
+            if (x + 8 <= context.frame.width) {
+                __builtin_memcpy(scanline + x, pixels, sizeof(pixels));
+                continue;
+            }
+            for (u32 i = 0; x + i < context.frame.width; i++)
+                scanline[x + i] = pixels[i / 4][i % 4];
         }
     }
+}
 
-    return {};
+static void compose_bitmap_from_ycbcr(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks, u32 vcursor)
+{
+    // NOTE: This does the work of ycbcr_to_rgb() and compose_bitmap() in a single pass, which saves a round trip through
+    //       the macroblocks for the most common kind of JPEG.
+    u32 const first_row = vcursor * 8;
+    u32 const end_row = min(context.frame.height, (vcursor + context.sampling_factors.vertical) * 8);
+
+    for (u32 y = first_row; y < end_row; y++) {
+        u32 const block_row = y / 8;
+        u32 const pixel_index = (y % 8) * 8;
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 block_column = 0; block_column < context.mblock_meta.hcount; block_column++) {
+            auto const& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
+            ARGB32 pixels[8];
+            for (u8 i = 0; i < 8; ++i) {
+                i16 r, g, b;
+                ycbcr_to_rgb(block.y[pixel_index + i], block.cb[pixel_index + i], block.cr[pixel_index + i], r, g, b);
+                pixels[i] = 0xff000000u | (r << 16) | (g << 8) | b;
+            }
+
+            u32 const x = block_column * 8;
+            if (x + 8 <= context.frame.width)
+                __builtin_memcpy(scanline + x, pixels, sizeof(pixels));
+            else
+                __builtin_memcpy(scanline + x, pixels, (context.frame.width - x) * sizeof(ARGB32));
+        }
+    }
+}
+
+// Composes one pixel at a time, which works for any block size.
+static void compose_bitmap_scalar(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks, u32 vcursor)
+{
+    u32 const block_size = context.scaled_block_size;
+    u32 const first_row = vcursor * block_size;
+    u32 const end_row = min<u32>(context.bitmap->height(), (vcursor + context.sampling_factors.vertical) * block_size);
+
+    for (u32 y = first_row; y < end_row; y++) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 x = 0; x < static_cast<u32>(context.bitmap->width()); x++) {
+            auto const& block = macroblocks[block_row * context.mblock_meta.hpadded_count + x / block_size];
+            u32 const pixel_index = pixel_row * 8 + x % block_size;
+            scanline[x] = Color(block.r[pixel_index], block.g[pixel_index], block.b[pixel_index]).value();
+        }
+    }
 }
 
-static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor)
 {
     if (context.options.cmyk == JPEGDecoderOptions::CMYK::Normal)
-        invert_colors_for_adobe_images(context, macroblocks);
+        invert_colors_for_adobe_images(context, macroblocks_in_mcu_row(context, macroblocks, vcursor));
 
-    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
+    u32 const block_size = context.scaled_block_size;
+    u32 const first_row = vcursor * block_size;
+    u32 const end_row = min<u32>(context.cmyk_bitmap->size().height(), (vcursor + context.sampling_factors.vertical) * block_size);
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    for (u32 y = first_row; y < end_row; y++) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        for (u32 x = 0; x < static_cast<u32>(context.cmyk_bitmap->size().width()); x++) {
+            u32 const block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
+            u32 const pixel_column = x % block_size;
             u32 const pixel_index = pixel_row * 8 + pixel_column;
             context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
         }
     }
-
-    return {};
 }
 
+#pragma GCC diagnostic pop
+
 static bool is_app_marker(Marker const marker)
 {
     return marker >= JPEG_APPN0 && marker <= JPEG_APPN15;
@@ -1941,24 +2149,22 @@ static ErrorOr<void> decode_header(JPEGLoadingContext& context)
     return {};
 }
 
-static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+static ErrorOr<void> decode_scans(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     // B.6 - Summary
     // See: Figure B.16 – Flow of compressed data syntax
     // This function handles the "Multi-scan" loop.
 
-    Vector<Macroblock> macroblocks;
-    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
-
     Marker marker = TRY(read_marker_at_cursor(context.stream));
     while (true) {
         if (is_miscellaneous_or_table_marker(marker)) {
             TRY(handle_miscellaneous_or_table(context.stream, context, marker));
         } else if (marker == JPEG_SOS) {
             TRY(read_start_of_scan(context.stream, context));
+            ++context.number_of_started_scans;
             TRY(decode_huffman_stream(context, macroblocks));
         } else if (marker == JPEG_EOI) {
-            return macroblocks;
+            return {};
         } else {
             dbgln_if(JPEG_DEBUG, "Unexpected marker {:x}!", marker);
             return Error::from_string_literal("Unexpected marker");
@@ -1968,22 +2174,84 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
     }
 }
 
-static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
 {
-    auto macroblocks = TRY(construct_macroblocks(context));
-    dequantize(context, macroblocks);
-    inverse_dct(context, macroblocks);
-    undo_subsampling(context, macroblocks);
-    TRY(handle_color_transform(context, macroblocks));
+    Vector<Macroblock> macroblocks;
+    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
+    TRY(decode_scans(context, macroblocks));
+    return macroblocks;
+}
+
+// Decodes as much of the scans as the data we have so far allows, and also returns the number of macroblock rows that
+// have seen any data at all.
+static ErrorOr<Vector<Macroblock>> construct_macroblocks_from_incomplete_data(JPEGLoadingContext& context, u32& macroblock_rows_with_data)
+{
+    Vector<Macroblock> macroblocks;
+    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
+
+    macroblock_rows_with_data = context.mblock_meta.vcount;
+    if (auto result = decode_scans(context, macroblocks); result.is_error()) {
+        // NOTE: We assume that whatever went wrong is due to the data running out. If the image is actually broken,
+        //       decoding the complete data will tell.
+        if (context.number_of_started_scans == 0)
+            return result.release_error();
+
+        // Later scans only refine the image, so everything that the first scan covered is worth showing.
+        if (context.number_of_started_scans == 1)
+            macroblock_rows_with_data = context.current_scan->decoded_macroblock_rows;
+    }
+
+    if (macroblock_rows_with_data == 0)
+        return Error::from_string_literal("No complete row of macroblocks yet");
+    return macroblocks;
+}
+
+static ErrorOr<void> compose_bitmap_from_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    // NOTE: Reduced scale decoding rounds up, like libjpeg does.
+    IntSize const size {
+        ceil_div(context.frame.width * context.scaled_block_size, 8),
+        ceil_div(context.frame.height * context.scaled_block_size, 8),
+    };
     if (context.components.size() == 4)
-        TRY(compose_cmyk_bitmap(context, macroblocks));
+        context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size(size));
     else
-        TRY(compose_bitmap(context, macroblocks));
+        context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, size));
+
+    bool const is_vectorized = context.options.use_simd && context.scaled_block_size == 8;
+    bool const is_ycbcr = context.components.size() == 3
+        && (!context.color_transform.has_value() || *context.color_transform == ColorTransform::YCbCr);
+
+    // NOTE: Each row of MCUs goes through all of the steps while it's still in the cache, rather than doing each step
+    //       for the whole image at once.
+    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
+        dequantize(context, macroblocks, vcursor);
+        inverse_dct(context, macroblocks, vcursor);
+        undo_subsampling(context, macroblocks, vcursor);
+        if (is_ycbcr && is_vectorized) {
+            compose_bitmap_from_ycbcr(context, macroblocks, vcursor);
+            continue;
+        }
+        TRY(handle_color_transform(context, macroblocks_in_mcu_row(context, macroblocks, vcursor)));
+        if (context.components.size() == 4)
+            compose_cmyk_bitmap(context, macroblocks, vcursor);
+        else if (is_vectorized)
+            compose_bitmap(context, macroblocks, vcursor);
+        else
+            compose_bitmap_scalar(context, macroblocks, vcursor);
+    }
     return {};
 }
 
-JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
-    : m_context(move(context))
+static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+{
+    auto macroblocks = TRY(construct_macroblocks(context));
+    return compose_bitmap_from_macroblocks(context, macroblocks);
+}
+
+JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(ReadonlyBytes data, NonnullOwnPtr<JPEGLoadingContext> context)
+    : m_data(data)
+    , m_context(move(context))
 {
 }
 
@@ -2011,33 +2279,93 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_o
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
     auto context = TRY(JPEGLoadingContext::create(move(stream), options));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(data, move(context))));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+// Returns the smallest scale at which the decoded image still covers the ideal size.
+static u8 scaled_block_size_for_ideal_size(JPEGLoadingContext const& context, IntSize ideal_size)
 {
-    if (index > 0)
-        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+    for (u8 block_size = 1; block_size < 8; block_size *= 2) {
+        if (ceil_div(context.frame.width * block_size, 8) >= ideal_size.width() && ceil_div(context.frame.height * block_size, 8) >= ideal_size.height())
+            return block_size;
+    }
+    return 8;
+}
 
+ErrorOr<void> JPEGImageDecoderPlugin::decode_bitmap(u8 scaled_block_size)
+{
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    if (m_context->state == JPEGLoadingContext::State::BitmapDecoded) {
+        if (m_context->scaled_block_size >= scaled_block_size)
+            return {};
+
+        // Decoding consumes the stream, so getting a larger bitmap than the one we have means starting over.
+        auto stream = TRY(try_make<FixedMemoryStream>(m_data));
+        auto context = TRY(JPEGLoadingContext::create(move(stream), m_context->options));
+        TRY(decode_header(*context));
+        m_context = move(context);
     }
 
+    m_context->scaled_block_size = scaled_block_size;
+    if (auto result = decode_jpeg(*m_context); result.is_error()) {
+        m_context->state = JPEGLoadingContext::State::Error;
+        return result.release_error();
+    }
+    m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
+{
+    if (index > 0)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+
+    // NOTE: Decoding at 1/2, 1/4 or 1/8 scale costs a lot less than decoding the whole image and scaling it down later.
+    u8 scaled_block_size = 8;
+    if (ideal_size.has_value())
+        scaled_block_size = scaled_block_size_for_ideal_size(*m_context, *ideal_size);
+    TRY(decode_bitmap(scaled_block_size));
+
     if (m_context->cmyk_bitmap && !m_context->bitmap)
         return ImageFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), 0 };
 
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::partial_frame()
+{
+    if (m_context->state != JPEGLoadingContext::State::HeaderDecoded)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
+
+    // NOTE: This consumes the stream, so the decoder can't be used for anything else afterwards.
+    m_context->state = JPEGLoadingContext::State::Error;
+
+    u32 macroblock_rows_with_data = 0;
+    auto macroblocks = TRY(construct_macroblocks_from_incomplete_data(*m_context, macroblock_rows_with_data));
+    TRY(compose_bitmap_from_macroblocks(*m_context, macroblocks));
+
+    RefPtr<Bitmap> bitmap = m_context->bitmap;
+    if (m_context->cmyk_bitmap && !bitmap)
+        bitmap = TRY(m_context->cmyk_bitmap->to_low_quality_rgb());
+
+    if (macroblock_rows_with_data >= m_context->mblock_meta.vcount)
+        return ImageFrameDescriptor { bitmap, 0 };
+
+    // Leave the rows that haven't seen any data yet transparent, rather than showing them as a flat gray.
+    auto partial_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, bitmap->size()));
+    partial_bitmap->fill(Color::Transparent);
+    auto visible_rows = min(bitmap->height(), static_cast<int>(macroblock_rows_with_data * 8));
+    for (int y = 0; y < visible_rows; ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            partial_bitmap->set_pixel(x, y, bitmap->get_pixel(x, y));
+    }
+    return ImageFrameDescriptor { move(partial_bitmap), 0 };
+}
+
 Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
@@ -2068,14 +2396,7 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
     VERIFY(natural_frame_format() == NaturalFrameFormat::CMYK);
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
-
+    TRY(decode_bitmap(8));
     return *m_context->cmyk_bitmap;
 }
 
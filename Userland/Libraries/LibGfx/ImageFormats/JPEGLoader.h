@@ -25,6 +25,14 @@ struct JPEGDecoderOptions {
         PDF,
     };
     CMYK cmyk { CMYK::Normal };
+
+    // Whether the inverse DCT, upsampling and conversion to pixels work on 128-bit vectors, or on one sample at a time.
+    // Both give the same result. Targets without vector registers use the scalar code by default.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    bool use_simd { true };
+#else
+    bool use_simd { false };
+#endif
 };
 
 class JPEGImageDecoderPlugin : public ImageDecoderPlugin {
@@ -37,6 +45,7 @@ public:
     virtual IntSize size() override;
 
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame() override;
 
     virtual Optional<Metadata const&> metadata() override;
 
@@ -46,8 +55,11 @@ public:
     virtual ErrorOr<NonnullRefPtr<CMYKBitmap>> cmyk_frame() override;
 
 private:
-    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
+    JPEGImageDecoderPlugin(ReadonlyBytes, NonnullOwnPtr<JPEGLoadingContext>);
+
+    ErrorOr<void> decode_bitmap(u8 scaled_block_size);
 
+    ReadonlyBytes m_data;
     NonnullOwnPtr<JPEGLoadingContext> m_context;
 };
 
@@ -876,6 +876,112 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     return {};
 }
 
+// Decompresses as much of the image data as we can, stopping where the data we have so far runs out.
+static ErrorOr<ByteBuffer> decompress_available_image_data(ReadonlyBytes compressed_data)
+{
+    auto decompressor = TRY(Compress::ZlibDecompressor::create(make<FixedMemoryStream>(compressed_data)));
+
+    ByteBuffer decompressed_data;
+    Array<u8, 4096> buffer;
+    while (!decompressor->is_eof()) {
+        auto result_or_error = decompressor->read_some(buffer);
+        if (result_or_error.is_error() || result_or_error.value().is_empty())
+            break;
+        TRY(decompressed_data.try_append(result_or_error.value()));
+    }
+    return decompressed_data;
+}
+
+// Size of the block of pixels that each decoded pixel stands in for, indexed by the number of completed Adam7 passes.
+static int adam7_block_width[8] = { 8, 8, 4, 4, 2, 2, 1, 1 };
+static int adam7_block_height[8] = { 8, 8, 8, 4, 4, 2, 2, 1 };
+
+// Decodes the scanlines (or, for interlaced images, the Adam7 passes) that the data we have so far covers completely.
+static ErrorOr<NonnullRefPtr<Bitmap>> decode_partial_png_bitmap(PNGLoadingContext& context)
+{
+    // NOTE: Chunk decoding stops at the first chunk that's cut off. If that's an image data chunk, we still want the
+    //       part of it that we have, as some encoders put all of the image data into a single chunk.
+    decode_png_chunks(context);
+    if (!context.has_seen_iend) {
+        Streamer streamer(context.data_current_ptr, context.data_size - (context.data_current_ptr - context.data));
+        u32 chunk_size = 0;
+        Array<u8, 4> chunk_type_buffer;
+        if (streamer.read(chunk_size) && streamer.read_bytes(chunk_type_buffer.data(), chunk_type_buffer.size()) && StringView { chunk_type_buffer.span() } == "IDAT"sv) {
+            auto available_size = context.data_size - (streamer.current_data_ptr() - context.data);
+            TRY(context.compressed_data.try_append(streamer.current_data_ptr(), min<size_t>(chunk_size, available_size)));
+        }
+    }
+
+    if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: No palette yet");
+    if (context.compressed_data.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: No image data yet");
+
+    auto decompression_buffer = TRY(decompress_available_image_data(context.compressed_data));
+
+    auto bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, { context.width, context.height }));
+    bitmap->fill(Color::Transparent);
+
+    if (context.interlace_method == PngInterlaceMethod::Null) {
+        auto row_size = context.compute_row_size_for_width(context.width);
+        if (row_size.has_overflow())
+            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+        // Each scanline is preceded by its filter type byte.
+        auto available_rows = static_cast<int>(min<size_t>(context.height, decompression_buffer.size() / (row_size.value() + 1)));
+        if (available_rows == 0)
+            return Error::from_string_literal("PNGImageDecoderPlugin: No complete scanline yet");
+
+        auto rows_context = context.create_subimage_context(context.width, available_rows);
+        rows_context.scanlines.ensure_capacity(available_rows);
+        TRY(decode_png_bitmap_simple(rows_context, decompression_buffer));
+
+        for (int y = 0; y < available_rows; ++y) {
+            for (int x = 0; x < context.width; ++x)
+                bitmap->set_pixel(x, y, rows_context.bitmap->get_pixel(x, y));
+        }
+        return bitmap;
+    }
+
+    if (context.interlace_method != PngInterlaceMethod::Adam7)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+
+    auto passes_context = context.create_subimage_context(context.width, context.height);
+    passes_context.bitmap = bitmap;
+
+    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
+    size_t bytes_needed = 0;
+    int completed_passes = 0;
+    for (int pass = 1; pass <= 7; ++pass) {
+        auto pass_width = adam7_width(context, pass);
+        auto pass_height = adam7_height(context, pass);
+        if (pass_width != 0 && pass_height != 0) {
+            auto row_size = context.compute_row_size_for_width(pass_width);
+            if (row_size.has_overflow())
+                return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+            bytes_needed += static_cast<size_t>(pass_height) * (row_size.value() + 1);
+            if (bytes_needed > decompression_buffer.size())
+                break;
+            TRY(decode_adam7_pass(passes_context, streamer, pass));
+        }
+        completed_passes = pass;
+    }
+
+    if (completed_passes == 0)
+        return Error::from_string_literal("PNGImageDecoderPlugin: No complete interlacing pass yet");
+
+    // Until the remaining passes arrive, let each pixel we have fill the block of pixels that it stands in for.
+    auto block_width = adam7_block_width[completed_passes];
+    auto block_height = adam7_block_height[completed_passes];
+    if (block_width > 1 || block_height > 1) {
+        for (int y = 0; y < context.height; ++y) {
+            for (int x = 0; x < context.width; ++x)
+                bitmap->set_pixel(x, y, bitmap->get_pixel(x - x % block_width, y - y % block_height));
+        }
+    }
+    return bitmap;
+}
+
 static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingContext& context, AnimationFrame& animation_frame)
 {
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
@@ -1450,6 +1556,14 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     return descriptor;
 }
 
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::partial_frame()
+{
+    if (m_context->state == PNGLoadingContext::State::Error)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+    return ImageFrameDescriptor { TRY(decode_partial_png_bitmap(*m_context)), 0 };
+}
+
 Optional<Metadata const&> PNGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
@@ -1842,6 +1842,8 @@ ErrorOr<NonnullRefPtr<Bitmap>> Painter::get_region_bitmap(IntRect const& region,
 {
     VERIFY(scale() == 1);
     auto bitmap_region = region.translated(state().translation).intersected(m_target->rect());
+    if (m_clip_origin_restriction.has_value())
+        bitmap_region.intersect(*m_clip_origin_restriction);
     if (actual_region.has_value())
         actual_region.value() = bitmap_region.translated(-state().translation);
     return m_target->cropped(bitmap_region, format);
@@ -2324,6 +2326,13 @@ void Painter::clear_clip_rect()
     state().clip_rect = m_clip_origin;
 }
 
+void Painter::restrict_clip_origin(IntRect const& rect)
+{
+    m_clip_origin.intersect(rect);
+    state().clip_rect.intersect(m_clip_origin);
+    m_clip_origin_restriction = m_clip_origin_restriction.has_value() ? m_clip_origin_restriction->intersected(rect) : rect;
+}
+
 PainterStateSaver::PainterStateSaver(Painter& painter)
     : m_painter(painter)
 {
@@ -9,6 +9,7 @@
 #include <AK/Forward.h>
 #include <AK/Memory.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
 #include <LibGfx/Color.h>
@@ -179,6 +180,9 @@ public:
     void add_clip_rect(IntRect const& rect);
     void clear_clip_rect();
 
+    // Confines all painting to the given rect, even across clear_clip_rect(). Used when several painters share one target.
+    void restrict_clip_origin(IntRect const& rect);
+
     void translate(int dx, int dy) { translate({ dx, dy }); }
     void translate(IntPoint delta) { state().translation.translate_by(delta); }
 
@@ -226,6 +230,7 @@ protected:
     void fill_physical_rect(IntRect const&, Color);
 
     IntRect m_clip_origin;
+    Optional<IntRect> m_clip_origin_restriction;
     NonnullRefPtr<Gfx::Bitmap> m_target;
     Vector<State, 4> m_state_stack;
 
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitStream.h>
+#include <AK/Debug.h>
+#include <LibCompress/Brotli.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibHTTP/ContentDecoder.h>
+
+namespace HTTP {
+
+ErrorOr<NonnullOwnPtr<ContentDecoder>> ContentDecoder::create(Encoding encoding)
+{
+    auto decoder = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ContentDecoder(encoding)));
+    decoder->m_thread = TRY(Threading::Thread::try_create([&decoder = *decoder] {
+        auto result = decoder.decode();
+
+        Threading::MutexLocker locker(decoder.m_mutex);
+        if (result.is_error())
+            decoder.m_error = result.release_error();
+        decoder.m_is_done = true;
+        decoder.m_decoder_state_changed.signal();
+        return 0;
+    },
+        "ContentDecoder"sv));
+    decoder->m_thread->start();
+    return decoder;
+}
+
+ContentDecoder::ContentDecoder(Encoding encoding)
+    : m_encoding(encoding)
+{
+}
+
+ContentDecoder::~ContentDecoder()
+{
+    if (!m_thread || !m_thread->needs_to_be_joined())
+        return;
+
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_is_cancelled = true;
+        m_input_changed.signal();
+        m_decoded_content_was_read.signal();
+    }
+    (void)m_thread->join();
+}
+
+ErrorOr<void> ContentDecoder::write(ReadonlyBytes bytes)
+{
+    Threading::MutexLocker locker(m_mutex);
+    VERIFY(!m_has_received_everything);
+    if (m_error.has_value())
+        return Error::copy(*m_error);
+    TRY(m_encoded_content.write_until_depleted(bytes));
+    m_is_waiting_for_input = false;
+    m_input_changed.signal();
+    return {};
+}
+
+void ContentDecoder::finish()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_has_received_everything = true;
+    m_input_changed.signal();
+}
+
+ErrorOr<ByteBuffer> ContentDecoder::read()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_decoder_state_changed.wait_while([&] {
+        if (m_is_done || m_decoded_content.size() >= max_buffered_decoded_size)
+            return false;
+        return m_has_received_everything || !m_is_waiting_for_input;
+    });
+
+    if (m_error.has_value())
+        return Error::copy(*m_error);
+
+    dbgln_if(JOB_DEBUG, "ContentDecoder: Decoded {} bytes of content, {} encoded bytes left", m_decoded_content.size(), m_encoded_content.used_buffer_size());
+    auto decoded_content = move(m_decoded_content);
+    m_decoded_content_was_read.signal();
+    return decoded_content;
+}
+
+bool ContentDecoder::is_done() const
+{
+    Threading::MutexLocker locker(m_mutex);
+    return m_is_done && m_decoded_content.is_empty();
+}
+
+size_t ContentDecoder::peak_buffered_decoded_size() const
+{
+    Threading::MutexLocker locker(m_mutex);
+    return m_peak_buffered_decoded_size;
+}
+
+// Runs on the decoder thread.
+ErrorOr<void> ContentDecoder::decode()
+{
+    static constexpr size_t decode_step_size = 16 * KiB;
+
+    auto decompressor = TRY(create_decompressor());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(decode_step_size));
+    size_t buffered_decoded_size = 0;
+
+    while (!decompressor->is_eof()) {
+        // NOTE: Never decode more than fits next to what hasn't been read yet.
+        auto decoded = TRY(decompressor->read_some(buffer.bytes().trim(max_buffered_decoded_size - buffered_decoded_size)));
+        if (decoded.is_empty()) {
+            // NOTE: Anything after the end of the compressed data is ignored.
+            if (m_input.is_eof())
+                break;
+            continue;
+        }
+
+        Threading::MutexLocker locker(m_mutex);
+        TRY(m_decoded_content.try_append(decoded));
+        m_peak_buffered_decoded_size = max(m_peak_buffered_decoded_size, m_decoded_content.size());
+        if (m_decoded_content.size() >= max_buffered_decoded_size) {
+            m_decoder_state_changed.signal();
+            m_decoded_content_was_read.wait_while([&] {
+                return !m_is_cancelled && m_decoded_content.size() >= max_buffered_decoded_size;
+            });
+            if (m_is_cancelled)
+                return Error::from_string_literal("Content decoding was cancelled");
+        }
+        buffered_decoded_size = m_decoded_content.size();
+    }
+    return {};
+}
+
+// Runs on the decoder thread.
+ErrorOr<NonnullOwnPtr<Stream>> ContentDecoder::create_decompressor()
+{
+    switch (m_encoding) {
+    case Encoding::Gzip:
+        return TRY(try_make<Compress::GzipDecompressor>(MaybeOwned<Stream>(m_input)));
+    case Encoding::Deflate: {
+        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
+        // https://tools.ietf.org/html/rfc7230#section-4.2.2
+        // From the RFC:
+        // "Note: Some non-conformant implementations send the "deflate"
+        //        compressed data without the zlib wrapper."
+        // So we have to look at the zlib header to tell which one we got.
+        Array<u8, 2> header_buffer;
+        auto header = TRY(m_input.peek(header_buffer));
+
+        if (Compress::ZlibDecompressor::is_likely_compressed(header))
+            return TRY(Compress::ZlibDecompressor::create(MaybeOwned<Stream>(m_input)));
+
+        dbgln_if(JOB_DEBUG, "ContentDecoder: Deflate content doesn't have a zlib header, decoding it as raw deflate data");
+        auto bit_stream = TRY(try_make<LittleEndianInputBitStream>(MaybeOwned<Stream>(m_input)));
+        return TRY(Compress::DeflateDecompressor::construct(move(bit_stream)));
+    }
+    case Encoding::Brotli:
+        return TRY(try_make<Compress::BrotliDecompressionStream>(MaybeOwned<Stream>(m_input)));
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Blocks the decoder thread until there are at least `size` bytes of input to read, or until the input is finished.
+ErrorOr<void> ContentDecoder::Input::wait_for_input(size_t size)
+{
+    auto& decoder = m_decoder;
+    decoder.m_input_changed.wait_while([&] {
+        if (decoder.m_is_cancelled || decoder.m_has_received_everything || decoder.m_encoded_content.used_buffer_size() >= size)
+            return false;
+        decoder.m_is_waiting_for_input = true;
+        decoder.m_decoder_state_changed.signal();
+        return true;
+    });
+
+    if (decoder.m_is_cancelled)
+        return Error::from_string_literal("Content decoding was cancelled");
+    return {};
+}
+
+ErrorOr<Bytes> ContentDecoder::Input::read_some(Bytes bytes)
+{
+    Threading::MutexLocker locker(m_decoder.m_mutex);
+    TRY(wait_for_input(1));
+    return m_decoder.m_encoded_content.read_some(bytes);
+}
+
+ErrorOr<ReadonlyBytes> ContentDecoder::Input::peek(Bytes bytes)
+{
+    Threading::MutexLocker locker(m_decoder.m_mutex);
+    TRY(wait_for_input(bytes.size()));
+
+    // The stream can't be peeked into, so put everything back once we have seen it.
+    auto& encoded_content = m_decoder.m_encoded_content;
+    auto size = min(bytes.size(), encoded_content.used_buffer_size());
+    auto content = TRY(encoded_content.read_until_eof());
+    content.bytes().slice(0, size).copy_to(bytes);
+    TRY(encoded_content.write_until_depleted(content));
+    return bytes.trim(size);
+}
+
+ErrorOr<size_t> ContentDecoder::Input::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ContentDecoder::Input::is_eof() const
+{
+    Threading::MutexLocker locker(m_decoder.m_mutex);
+    return m_decoder.m_has_received_everything && m_decoder.m_encoded_content.used_buffer_size() == 0;
+}
+
+}
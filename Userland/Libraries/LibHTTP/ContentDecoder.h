@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/MemoryStream.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace HTTP {
+
+// Decodes content with a Content-Encoding while it is being received.
+// NOTE: The LibCompress decompressors pull their input from a stream, and can't stop halfway through a block (or a
+//       gzip header, or a brotli metadata block) to wait for more input to arrive. So the decompressor runs on a
+//       thread of its own, where running out of input simply blocks until more is written or the input is finished.
+//       The decompressor thread stops whenever max_buffered_decoded_size bytes of decoded content are waiting to be
+//       read, so a small amount of input that decodes to a huge amount of content can't exhaust our memory.
+class ContentDecoder {
+public:
+    enum class Encoding {
+        Gzip,
+        Deflate,
+        Brotli,
+    };
+
+    static constexpr size_t max_buffered_decoded_size = 256 * KiB;
+
+    static ErrorOr<NonnullOwnPtr<ContentDecoder>> create(Encoding);
+    ~ContentDecoder();
+
+    // Hands more input over to the decompressor, without waiting for it to be decoded.
+    ErrorOr<void> write(ReadonlyBytes);
+
+    // Marks the end of the input.
+    void finish();
+
+    // Returns at most max_buffered_decoded_size bytes of decoded content. This waits until the decompressor has that
+    // much, needs more input, or is done, which takes no longer than decoding that much content would.
+    // An empty buffer means that more input has to be written first, or that everything has been decoded.
+    ErrorOr<ByteBuffer> read();
+
+    // Whether everything has been decoded and read.
+    bool is_done() const;
+
+    // The most decoded content that was ever waiting to be read at once.
+    size_t peak_buffered_decoded_size() const;
+
+private:
+    class Input final : public Stream {
+    public:
+        explicit Input(ContentDecoder& decoder)
+            : m_decoder(decoder)
+        {
+        }
+
+        virtual ErrorOr<Bytes> read_some(Bytes) override;
+        virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+        virtual bool is_eof() const override;
+        virtual bool is_open() const override { return true; }
+        virtual void close() override { }
+
+        ErrorOr<ReadonlyBytes> peek(Bytes);
+
+    private:
+        ErrorOr<void> wait_for_input(size_t size);
+
+        ContentDecoder& m_decoder;
+    };
+
+    explicit ContentDecoder(Encoding);
+
+    ErrorOr<NonnullOwnPtr<Stream>> create_decompressor();
+    ErrorOr<void> decode();
+
+    Encoding m_encoding;
+    Input m_input { *this };
+    RefPtr<Threading::Thread> m_thread;
+
+    // Everything below is shared with the decoder thread, and protected by m_mutex.
+    mutable Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_input_changed { m_mutex };
+    Threading::ConditionVariable m_decoder_state_changed { m_mutex };
+    Threading::ConditionVariable m_decoded_content_was_read { m_mutex };
+
+    AllocatingMemoryStream m_encoded_content;
+    bool m_has_received_everything { false };
+    bool m_is_cancelled { false };
+
+    ByteBuffer m_decoded_content;
+    size_t m_peak_buffered_decoded_size { 0 };
+    bool m_is_waiting_for_input { false };
+    bool m_is_done { false };
+    Optional<Error> m_error;
+};
+
+}
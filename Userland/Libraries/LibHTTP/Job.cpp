@@ -8,11 +8,7 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/JsonObject.h>
-#include <AK/MemoryStream.h>
 #include <AK/Try.h>
-#include <LibCompress/Brotli.h>
-#include <LibCompress/Gzip.h>
-#include <LibCompress/Zlib.h>
 #include <LibCore/Event.h>
 #include <LibHTTP/HttpResponse.h>
 #include <LibHTTP/Job.h>
@@ -21,75 +17,6 @@
 
 namespace HTTP {
 
-static ErrorOr<ByteBuffer> handle_content_encoding(ByteBuffer const& buf, ByteString const& content_encoding)
-{
-    dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf has content_encoding={}", content_encoding);
-
-    // FIXME: Actually do the decompression of the data using streams, instead of all at once when everything has been
-    //        received. This will require that some of the decompression algorithms are implemented in a streaming way.
-    //        Gzip and Deflate are implemented using Stream, while Brotli uses the newer Core::Stream. The Gzip and
-    //        Deflate implementations will likely need to be changed to LibCore::Stream for this to work easily.
-
-    if (content_encoding == "gzip") {
-        if (!Compress::GzipDecompressor::is_likely_compressed(buf)) {
-            dbgln("Job::handle_content_encoding: buf is not gzip compressed!");
-        }
-
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is gzip compressed!");
-
-        auto uncompressed = TRY(Compress::GzipDecompressor::decompress_all(buf));
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Gzip::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.size());
-        }
-
-        return uncompressed;
-    } else if (content_encoding == "deflate") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is deflate compressed!");
-
-        // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
-        // https://tools.ietf.org/html/rfc7230#section-4.2.2
-        auto memory_stream = make<FixedMemoryStream>(buf);
-        auto zlib_decompressor = Compress::ZlibDecompressor::create(move(memory_stream));
-        Optional<ByteBuffer> uncompressed;
-        if (zlib_decompressor.is_error()) {
-            // From the RFC:
-            // "Note: Some non-conformant implementations send the "deflate"
-            //        compressed data without the zlib wrapper."
-            dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: ZlibDecompressor::decompress_all() failed. Trying DeflateDecompressor::decompress_all()");
-            uncompressed = TRY(Compress::DeflateDecompressor::decompress_all(buf));
-        } else {
-            uncompressed = TRY(zlib_decompressor.value()->read_until_eof());
-        }
-
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Deflate decompression successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.value().size());
-        }
-
-        return uncompressed.release_value();
-    } else if (content_encoding == "br") {
-        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is brotli compressed!");
-
-        FixedMemoryStream bufstream { buf };
-        auto brotli_stream = Compress::BrotliDecompressionStream { MaybeOwned<Stream>(bufstream) };
-
-        auto uncompressed = TRY(brotli_stream.read_until_eof());
-        if constexpr (JOB_DEBUG) {
-            dbgln("Job::handle_content_encoding: Brotli::decompress() successful.");
-            dbgln("  Input size: {}", buf.size());
-            dbgln("  Output size: {}", uncompressed.size());
-        }
-
-        return uncompressed;
-    }
-
-    return buf;
-}
-
 Job::Job(HttpRequest&& request, Stream& output_stream)
     : Core::NetworkJob(output_stream)
     , m_request(move(request))
@@ -122,7 +49,7 @@ void Job::shutdown(ShutdownMode mode)
 
 void Job::flush_received_buffers()
 {
-    if (!m_can_stream_response || m_buffered_size == 0)
+    if (m_buffered_size == 0)
         return;
     dbgln_if(JOB_DEBUG, "Job: Flushing received buffers: have {} bytes in {} buffers for {}", m_buffered_size, m_received_buffers.size(), m_request.url());
     for (size_t i = 0; i < m_received_buffers.size(); ++i) {
@@ -164,7 +91,7 @@ void Job::register_on_ready_to_read(Function<void()> callback)
         auto can_read_without_blocking = m_socket->can_read_without_blocking();
         if (can_read_without_blocking.is_error())
             return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
-        if (can_read_without_blocking.value() && m_state != State::Finished && !has_error()) {
+        if (can_read_without_blocking.value() && m_state != State::Finished && !m_has_failed_to_decode_content && !has_error()) {
             deferred_invoke([this] {
                 if (m_socket && m_socket->on_ready_to_read)
                     m_socket->on_ready_to_read();
@@ -197,6 +124,50 @@ ErrorOr<ByteBuffer> Job::receive(size_t size)
     return buffer.slice(0, nread);
 }
 
+ErrorOr<void> Job::buffer_received_payload(ByteBuffer const& payload)
+{
+    if (!m_content_encoding.has_value()) {
+        m_received_buffers.append(make<ReceivedBuffer>(payload));
+        m_buffered_size += payload.size();
+        return {};
+    }
+
+    // Responses without a body (e.g. to a HEAD request) still come with the Content-Encoding of the resource,
+    // so we only start decoding once there is something to decode.
+    if (payload.is_empty())
+        return {};
+    if (!m_content_decoder)
+        m_content_decoder = TRY(ContentDecoder::create(*m_content_encoding));
+
+    TRY(m_content_decoder->write(payload));
+    if (TRY(read_decoded_content()) && !has_timer()) {
+        // NOTE: The client hasn't caught up with what we have decoded so far, so come back for the rest later.
+        start_timer(50);
+    }
+    return {};
+}
+
+// Moves decoded content into the received buffers, as long as the client keeps up with reading them.
+// Returns whether the decoder had more content for us than that.
+ErrorOr<bool> Job::read_decoded_content()
+{
+    while (m_buffered_size < ContentDecoder::max_buffered_decoded_size) {
+        auto decoded_content = TRY(m_content_decoder->read());
+        if (decoded_content.is_empty())
+            return false;
+        append_decoded_content(move(decoded_content));
+    }
+    return true;
+}
+
+void Job::append_decoded_content(ByteBuffer decoded_content)
+{
+    if (decoded_content.is_empty())
+        return;
+    m_buffered_size += decoded_content.size();
+    m_received_buffers.append(make<ReceivedBuffer>(move(decoded_content)));
+}
+
 void Job::on_socket_connected()
 {
     auto raw_request = m_request.to_raw_request().release_value_but_fixme_should_propagate_errors();
@@ -212,7 +183,7 @@ void Job::on_socket_connected()
 
     register_on_ready_to_read([&] {
         dbgln_if(JOB_DEBUG, "Ready to read for {}, state = {}, cancelled = {}", m_request.url(), to_underlying(m_state), is_cancelled());
-        if (is_cancelled())
+        if (is_cancelled() || m_has_failed_to_decode_content)
             return;
 
         if (m_state == State::Finished) {
@@ -321,6 +292,19 @@ void Job::on_socket_connected()
                 }
                 m_state = State::InBody;
 
+                if (auto content_encoding = m_headers.get("Content-Encoding"sv); content_encoding.has_value()) {
+                    auto encoding = content_encoding->view().trim_whitespace();
+                    dbgln_if(JOB_DEBUG, "Job: This content has content encoding '{}'", encoding);
+                    if (encoding.equals_ignoring_ascii_case("gzip"sv))
+                        m_content_encoding = ContentDecoder::Encoding::Gzip;
+                    else if (encoding.equals_ignoring_ascii_case("deflate"sv))
+                        m_content_encoding = ContentDecoder::Encoding::Deflate;
+                    else if (encoding.equals_ignoring_ascii_case("br"sv))
+                        m_content_encoding = ContentDecoder::Encoding::Brotli;
+                    else if (!encoding.equals_ignoring_ascii_case("identity"sv))
+                        dbgln("Job: Unknown content encoding '{}', passing the content through as-is", encoding);
+                }
+
                 // We've reached the end of the headers, there's a possibility that the server
                 // responds with nothing (content-length = 0 with normal encoding); if that's the case,
                 // quit early as we won't be reading anything anyway.
@@ -380,11 +364,7 @@ void Job::on_socket_connected()
             } else {
                 m_headers.set(name, value);
             }
-            if (name.equals_ignoring_ascii_case("Content-Encoding"sv)) {
-                // Assume that any content-encoding means that we can't decode it as a stream :(
-                dbgln_if(JOB_DEBUG, "Content-Encoding {} detected, cannot stream output :(", value);
-                m_can_stream_response = false;
-            } else if (name.equals_ignoring_ascii_case("Content-Length"sv)) {
+            if (name.equals_ignoring_ascii_case("Content-Length"sv)) {
                 auto length = value.to_number<u64>();
                 if (length.has_value())
                     m_content_length = length.value();
@@ -523,9 +503,14 @@ void Job::on_socket_connected()
                 }
             }
 
-            m_received_buffers.append(make<ReceivedBuffer>(payload));
-            m_buffered_size += payload.size();
             m_received_size += payload.size();
+            if (auto result = buffer_received_payload(payload); result.is_error()) {
+                dbgln_if(JOB_DEBUG, "Job: Could not decode the payload: {}", result.error());
+                // NOTE: Nothing we receive from here on can be decoded, so stop reading right away.
+                m_has_failed_to_decode_content = true;
+                m_content_decoder = nullptr;
+                return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+            }
             flush_received_buffers();
 
             deferred_invoke([this] { did_progress(m_content_length, m_received_size); });
@@ -587,8 +572,26 @@ void Job::on_socket_connected()
 void Job::timer_event(Core::TimerEvent& event)
 {
     event.accept();
-    finish_up();
-    if (m_buffered_size == 0)
+    if (m_state == State::Finished) {
+        finish_up();
+        return;
+    }
+
+    if (!m_content_decoder) {
+        stop_timer();
+        return;
+    }
+
+    auto result = read_decoded_content();
+    if (result.is_error()) {
+        dbgln_if(JOB_DEBUG, "Job: Could not decode the payload: {}", result.error());
+        stop_timer();
+        m_has_failed_to_decode_content = true;
+        m_content_decoder = nullptr;
+        return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+    }
+    flush_received_buffers();
+    if (!result.value() && m_buffered_size == 0)
         stop_timer();
 }
 
@@ -596,36 +599,21 @@ void Job::finish_up()
 {
     VERIFY(!m_has_scheduled_finish);
     m_state = State::Finished;
-    if (!m_can_stream_response) {
-        auto maybe_flattened_buffer = ByteBuffer::create_uninitialized(m_buffered_size);
-        if (maybe_flattened_buffer.is_error())
+    m_content_encoding.clear();
+    if (m_content_decoder) {
+        m_content_decoder->finish();
+        if (auto result = read_decoded_content(); result.is_error()) {
+            dbgln_if(JOB_DEBUG, "Job: Could not decode the content: {}", result.error());
+            m_content_decoder = nullptr;
+            stop_timer();
             return did_fail(Core::NetworkJob::Error::TransmissionFailed);
-        auto flattened_buffer = maybe_flattened_buffer.release_value();
-
-        u8* flat_ptr = flattened_buffer.data();
-        for (auto& received_buffer : m_received_buffers) {
-            memcpy(flat_ptr, received_buffer->pending_flush.data(), received_buffer->pending_flush.size());
-            flat_ptr += received_buffer->pending_flush.size();
-        }
-        m_received_buffers.clear();
-
-        // For the time being, we cannot stream stuff with content-encoding set to _anything_.
-        // FIXME: LibCompress exposes a streaming interface, so this can be resolved
-        auto content_encoding = m_headers.get("Content-Encoding");
-        if (content_encoding.has_value()) {
-            if (auto result = handle_content_encoding(flattened_buffer, content_encoding.value()); !result.is_error())
-                flattened_buffer = result.release_value();
-            else
-                return did_fail(Core::NetworkJob::Error::TransmissionFailed);
         }
-
-        m_buffered_size = flattened_buffer.size();
-        m_received_buffers.append(make<ReceivedBuffer>(move(flattened_buffer)));
-        m_can_stream_response = true;
+        if (m_content_decoder->is_done())
+            m_content_decoder = nullptr;
     }
 
     flush_received_buffers();
-    if (m_buffered_size != 0) {
+    if (m_buffered_size != 0 || m_content_decoder) {
         // We have to wait for the client to consume all the downloaded data
         // before we can actually call `did_finish`. in a normal flow, this should
         // never be hit since the client is reading as we are writing, unless there
@@ -8,8 +8,10 @@
 
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <LibCore/NetworkJob.h>
 #include <LibCore/Socket.h>
+#include <LibHTTP/ContentDecoder.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 
@@ -38,6 +40,9 @@ protected:
     void register_on_ready_to_read(Function<void()>);
     ErrorOr<ByteString> read_line(size_t);
     ErrorOr<ByteBuffer> receive(size_t);
+    ErrorOr<void> buffer_received_payload(ByteBuffer const&);
+    ErrorOr<bool> read_decoded_content();
+    void append_decoded_content(ByteBuffer);
     void timer_event(Core::TimerEvent&) override;
 
     enum class State {
@@ -77,7 +82,11 @@ protected:
     Optional<u64> m_content_length;
     Optional<ssize_t> m_current_chunk_remaining_size;
     Optional<size_t> m_current_chunk_total_size;
-    bool m_can_stream_response { true };
+
+    Optional<ContentDecoder::Encoding> m_content_encoding;
+    OwnPtr<ContentDecoder> m_content_decoder;
+    bool m_has_failed_to_decode_content { false };
+
     bool m_should_read_chunk_ending_line { false };
     bool m_has_scheduled_finish { false };
 };
@@ -20,6 +20,8 @@ void Client::die()
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_partial_image_callbacks.clear();
+    m_animation_frames_callbacks.clear();
 
     if (on_death)
         on_death();
@@ -60,7 +62,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale)
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale)
 {
     VERIFY(!bitmaps.is_empty());
 
@@ -75,6 +77,9 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Ve
     image.is_animated = is_animated;
     image.loop_count = loop_count;
     image.scale = scale;
+    image.frame_count = frame_count;
+    if (frame_count > bitmaps.size())
+        image.image_id = image_id;
     image.frames.ensure_capacity(bitmaps.size());
     for (size_t i = 0; i < bitmaps.size(); ++i) {
         if (!bitmaps[i].is_valid()) {
@@ -103,4 +108,106 @@ void Client::did_fail_to_decode_image(i64 image_id, String const& error_message)
     promise->reject(Error::from_string_literal("Image decoding failed or aborted"));
 }
 
+Optional<i64> Client::start_progressive_decode(PartialImageCallback on_partial_image, Optional<ByteString> mime_type)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::StartProgressiveDecode>(move(mime_type));
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to start a progressive decode");
+        return {};
+    }
+
+    if (on_partial_image)
+        m_partial_image_callbacks.set(response->image_id(), move(on_partial_image));
+    return response->image_id();
+}
+
+void Client::append_progressive_decode_data(i64 image_id, ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return;
+
+    auto buffer_or_error = Core::AnonymousBuffer::create_with_size(data.size());
+    if (buffer_or_error.is_error()) {
+        dbgln("Could not allocate buffer for progressive decode {}: {}", image_id, buffer_or_error.error());
+        return;
+    }
+    auto buffer = buffer_or_error.release_value();
+    memcpy(buffer.data<void>(), data.data(), data.size());
+
+    async_append_progressive_decode_data(image_id, move(buffer));
+}
+
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::finish_progressive_decode(i64 image_id, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size)
+{
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    m_partial_image_callbacks.remove(image_id);
+    m_pending_decoded_images.set(image_id, promise);
+    async_finish_progressive_decode(image_id, ideal_size);
+
+    return promise;
+}
+
+void Client::cancel_progressive_decode(i64 image_id)
+{
+    m_partial_image_callbacks.remove(image_id);
+    async_cancel_decoding(image_id);
+}
+
+void Client::did_decode_partial_image(i64 image_id, Gfx::ShareableBitmap const& bitmap)
+{
+    auto callback = m_partial_image_callbacks.get(image_id);
+    if (!callback.has_value())
+        return;
+
+    if (!bitmap.is_valid()) {
+        dbgln("ImageDecoderClient: Invalid partial bitmap for request {}", image_id);
+        return;
+    }
+
+    (*callback)(*bitmap.bitmap());
+}
+
+void Client::request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, AnimationFramesCallback callback)
+{
+    m_animation_frames_callbacks.set(image_id, move(callback));
+    async_request_animation_frames(image_id, start_frame_index, count);
+}
+
+void Client::stop_animation_decode(i64 image_id)
+{
+    m_animation_frames_callbacks.remove(image_id);
+    async_stop_animation_decode(image_id);
+}
+
+void Client::did_decode_animation_frames(i64 image_id, u32 start_frame_index, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations)
+{
+    // NOTE: The callback may well ask for more frames, which replaces the callback in the map, so take it out first.
+    auto callback = m_animation_frames_callbacks.take(image_id);
+    if (!callback.has_value()) {
+        // NOTE: This happens when the animation was stopped while the decoder was still busy with its frames.
+        return;
+    }
+
+    Vector<Frame> frames;
+    frames.ensure_capacity(bitmaps.size());
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+        if (!bitmaps[i].is_valid()) {
+            dbgln("ImageDecoderClient: Invalid bitmap for animation {} at frame {}", image_id, start_frame_index + i);
+            break;
+        }
+        frames.empend(*bitmaps[i].bitmap(), durations[i]);
+    }
+
+    (*callback)(start_frame_index, frames);
+
+    // NOTE: Frames for a request that was made earlier may still arrive, and they should go to the same callback.
+    if (!m_animation_frames_callbacks.contains(image_id))
+        m_animation_frames_callbacks.set(image_id, callback.release_value());
+}
+
 }
@@ -23,7 +23,12 @@ struct DecodedImage {
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
     Vector<Frame> frames;
+
+    // Long animations only come with their first few frames. The rest can be requested with the image ID, see
+    // Client::request_animation_frames().
+    Optional<i64> image_id;
 };
 
 class Client final
@@ -36,15 +41,39 @@ public:
 
     NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
 
+    using PartialImageCallback = Function<void(NonnullRefPtr<Gfx::Bitmap>)>;
+
+    // Starts decoding an image whose data is still arriving. Whenever the decoder manages to make something of the data
+    // it has so far, on_partial_image is called with a bitmap of the full size of the image.
+    Optional<i64> start_progressive_decode(PartialImageCallback on_partial_image, Optional<ByteString> mime_type = {});
+    void append_progressive_decode_data(i64 image_id, ReadonlyBytes);
+
+    // Once all of the data has arrived, this decodes the image just like decode_image() does.
+    NonnullRefPtr<Core::Promise<DecodedImage>> finish_progressive_decode(i64 image_id, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {});
+    void cancel_progressive_decode(i64 image_id);
+
+    using AnimationFramesCallback = Function<void(u32 start_frame_index, Vector<Frame>&)>;
+
+    // Asks the decoder for `count` frames of an animation, starting at `start_frame_index` and wrapping around at the
+    // end. Only the callback of the most recent request for an image is kept.
+    void request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, AnimationFramesCallback);
+
+    // Lets the decoder throw away its state for an animation once we don't need any more of its frames.
+    void stop_animation_decode(i64 image_id);
+
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
     virtual void did_fail_to_decode_image(i64 image_id, String const& error_message) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::ShareableBitmap const& bitmap) override;
+    virtual void did_decode_animation_frames(i64 image_id, u32 start_frame_index, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations) override;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, PartialImageCallback> m_partial_image_callbacks;
+    HashMap<i64, AnimationFramesCallback> m_animation_frames_callbacks;
 };
 
 }
@@ -103,6 +103,42 @@ ALWAYS_INLINE ThrowCompletionOr<NonnullGCPtr<Object>> base_object_for_get(VM& vm
     return throw_null_or_undefined_property_access(vm, base_value, base_identifier, property_identifier);
 }
 
+ALWAYS_INLINE ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() != src2.encoded());
+    }
+    return Value(!TRY(is_loosely_equal(vm, src1, src2)));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> loosely_equals(VM& vm, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() == src2.encoded());
+    }
+    return Value(TRY(is_loosely_equal(vm, src1, src2)));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> strict_inequals(VM&, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() != src2.encoded());
+    }
+    return Value(!is_strictly_equal(src1, src2));
+}
+
+ALWAYS_INLINE ThrowCompletionOr<Value> strict_equals(VM&, Value src1, Value src2)
+{
+    if (src1.tag() == src2.tag()) {
+        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
+            return Value(src1.encoded() == src2.encoded());
+    }
+    return Value(is_strictly_equal(src1, src2));
+}
+
 enum class GetByIdMode {
     Normal,
     Length,
@@ -128,37 +164,39 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString c
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache)
-            return cache.prototype->get_direct(cache.property_offset.value());
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        return base_obj->get_direct(cache.property_offset.value());
+    if (auto* entry = cache.find(shape)) {
+        if (entry->prototype) {
+            // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+            if (entry->prototype_chain_validity && entry->prototype_chain_validity->is_valid()) {
+                cache.record_hit();
+                return entry->prototype->get_direct(entry->property_offset.value());
+            }
+        } else {
+            // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+            cache.record_hit();
+            return base_obj->get_direct(entry->property_offset.value());
+        }
     }
 
+    cache.record_miss();
+
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(property, this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        if (auto* entry = cache.entry_for_shape(shape)) {
+            *entry = {};
+            entry->shape = shape;
+            entry->property_offset = cacheable_metadata.property_offset.value();
+        }
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        if (auto* entry = cache.entry_for_shape(base_obj->shape())) {
+            *entry = {};
+            entry->shape = &base_obj->shape();
+            entry->property_offset = cacheable_metadata.property_offset.value();
+            entry->prototype = *cacheable_metadata.prototype;
+            entry->prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        }
     }
 
     return value;
@@ -247,12 +285,18 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
 
     // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
     auto& shape = binding_object.shape();
-    if (cache.environment_serial_number == declarative_record.environment_serial_number()
-        && &shape == cache.shape) {
-        return binding_object.get_direct(cache.property_offset.value());
+    if (cache.environment_serial_number == declarative_record.environment_serial_number()) {
+        if (auto* entry = cache.find(shape)) {
+            cache.record_hit();
+            return binding_object.get_direct(entry->property_offset.value());
+        }
+    } else {
+        // NOTE: A new declarative binding may now shadow any of the properties we've cached.
+        static_cast<PropertyLookupCache&>(cache) = {};
+        cache.environment_serial_number = declarative_record.environment_serial_number();
     }
 
-    cache.environment_serial_number = declarative_record.environment_serial_number();
+    cache.record_miss();
 
     auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
 
@@ -275,8 +319,11 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         CacheablePropertyMetadata cacheable_metadata;
         auto value = TRY(binding_object.internal_get(identifier, js_undefined(), &cacheable_metadata));
         if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache.shape = shape;
-            cache.property_offset = cacheable_metadata.property_offset.value();
+            if (auto* entry = cache.entry_for_shape(shape)) {
+                *entry = {};
+                entry->shape = shape;
+                entry->property_offset = cacheable_metadata.property_offset.value();
+            }
         }
         return value;
     }
@@ -316,17 +363,65 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            if (auto* entry = cache->find(object->shape())) {
+                if (!entry->is_transition) {
+                    cache->record_hit();
+                    object->put_direct(*entry->property_offset, value);
+                    return {};
+                }
+                // NOTE: If the target shape has been garbage collected, the entry is useless and its offset is past the end of the object's storage.
+                if (!entry->transition_target_shape) {
+                    *entry = {};
+                } else if (auto* prototype = object->shape().prototype(); this_value.is_object() && &this_value.as_object() == object.ptr() && (!prototype || (entry->prototype_chain_validity && entry->prototype_chain_validity->is_valid()))) {
+                    // OPTIMIZATION: If nothing in the prototype chain could have started intercepting the property, we can replay the put transition.
+                    //               Exotic objects can share a shape with ordinary ones, so add_property_with_cached_transition() refuses them.
+                    if (object->add_property_with_cached_transition(*entry->transition_target_shape, value)) {
+                        cache->record_hit();
+                        return {};
+                    }
+                }
+            }
+            cache->record_miss();
         }
 
+        auto& old_shape = object->shape();
+
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            if (auto* entry = cache->entry_for_shape(object->shape())) {
+                *entry = {};
+                entry->shape = object->shape();
+                entry->property_offset = cacheable_metadata.property_offset.value();
+            }
+        } else if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::AddOwnProperty) {
+            auto& new_shape = object->shape();
+            // NOTE: We can only replay plain put transitions from a shared shape that added exactly this one property to the end of the object's storage.
+            bool can_cache_transition = this_value.is_object() && &this_value.as_object() == object.ptr()
+                && !object->has_exotic_property_access()
+                && &new_shape != &old_shape
+                && !old_shape.is_dictionary() && !old_shape.is_prototype_shape() && old_shape.is_cacheable()
+                && !new_shape.is_dictionary()
+                && new_shape.property_count() == old_shape.property_count() + 1
+                && cacheable_metadata.property_offset.value() == old_shape.property_count();
+            // NOTE: Dictionary prototypes can gain properties without invalidating prototype chains, so we can't rely on them staying unchanged.
+            for (auto* prototype = old_shape.prototype(); can_cache_transition && prototype; prototype = prototype->shape().prototype()) {
+                if (prototype->shape().is_dictionary() || !prototype->shape().prototype_chain_validity())
+                    can_cache_transition = false;
+            }
+            if (can_cache_transition) {
+                if (auto* entry = cache->entry_for_shape(old_shape)) {
+                    *entry = {};
+                    entry->shape = old_shape;
+                    entry->property_offset = cacheable_metadata.property_offset.value();
+                    entry->transition_target_shape = new_shape;
+                    entry->is_transition = true;
+                    if (auto* prototype = old_shape.prototype())
+                        entry->prototype_chain_validity = *prototype->shape().prototype_chain_validity();
+                }
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
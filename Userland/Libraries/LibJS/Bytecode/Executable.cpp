@@ -8,12 +8,33 @@
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
 
 JS_DEFINE_ALLOCATOR(Executable);
 
+PropertyLookupCacheStatistics g_property_lookup_cache_statistics;
+
+void dump_property_lookup_cache_statistics()
+{
+    if constexpr (!PROPERTY_LOOKUP_CACHE_DEBUG) {
+        dbgln("Property lookup cache statistics are only collected with PROPERTY_LOOKUP_CACHE_DEBUG enabled");
+        return;
+    }
+
+    auto const& statistics = g_property_lookup_cache_statistics;
+    auto total = statistics.monomorphic_hits + statistics.polymorphic_hits + statistics.megamorphic_lookups + statistics.misses;
+    auto percentage = [&](u64 count) { return total ? (static_cast<double>(count) * 100.0 / static_cast<double>(total)) : 0.0; };
+
+    dbgln("Property lookup cache statistics ({} lookups):", total);
+    dbgln("  Monomorphic hits:    {} ({:.1}%)", statistics.monomorphic_hits, percentage(statistics.monomorphic_hits));
+    dbgln("  Polymorphic hits:    {} ({:.1}%)", statistics.polymorphic_hits, percentage(statistics.polymorphic_hits));
+    dbgln("  Megamorphic lookups: {} ({:.1}%)", statistics.megamorphic_lookups, percentage(statistics.megamorphic_lookups));
+    dbgln("  Misses:              {} ({:.1}%)", statistics.misses, percentage(statistics.misses));
+}
+
 Executable::Executable(
     Vector<u8> bytecode,
     NonnullOwnPtr<IdentifierTable> identifier_table,
@@ -40,6 +61,13 @@ Executable::Executable(
 
 Executable::~Executable() = default;
 
+JIT::NativeExecutable const* Executable::compile_to_native_code()
+{
+    m_did_try_jitting = true;
+    m_native_executable = JIT::Compiler::compile(*this);
+    return m_native_executable.ptr();
+}
+
 void Executable::dump() const
 {
     warnln("\033[37;1mJS bytecode executable\033[0m \"{}\"", name);
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Debug.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -22,13 +24,112 @@
 
 namespace JS::Bytecode {
 
+// NOTE: These are only collected with PROPERTY_LOOKUP_CACHE_DEBUG enabled, to keep them out of the hot path otherwise.
+struct PropertyLookupCacheStatistics {
+    u64 monomorphic_hits { 0 };
+    u64 polymorphic_hits { 0 };
+    u64 megamorphic_lookups { 0 };
+    u64 misses { 0 };
+};
+
+extern PropertyLookupCacheStatistics g_property_lookup_cache_statistics;
+
+void dump_property_lookup_cache_statistics();
+
+// NOTE: Holding four entries makes this about four times the size of a monomorphic cache (200 bytes on 64-bit), but there's
+//       only one per property access site in the bytecode, not one per object. Keep the entry count small, since a miss scans all of them.
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+
+        // For PutById caches, the shape an object with `shape` transitions to when the property is added.
+        // NOTE: The target shape is only weakly held, so `is_transition` is what tells a transition entry apart from a plain put.
+        WeakPtr<Shape> transition_target_shape;
+        bool is_transition { false };
+    };
+
+    enum class State : u8 {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        Megamorphic,
+    };
+
+    State state() const
+    {
+        if (is_megamorphic)
+            return State::Megamorphic;
+        if (number_of_entries == 0)
+            return State::Uninitialized;
+        if (number_of_entries == 1)
+            return State::Monomorphic;
+        return State::Polymorphic;
+    }
+
+    Entry* find(Shape const& shape)
+    {
+        for (size_t i = 0; i < number_of_entries; ++i) {
+            if (entries[i].shape == &shape)
+                return &entries[i];
+        }
+        return nullptr;
+    }
+
+    // Returns the entry that should describe the given shape, reusing the slot of a shape that has been
+    // garbage collected if possible. Returns nullptr once the site has seen too many shapes to be worth caching.
+    Entry* entry_for_shape(Shape const& shape)
+    {
+        if (auto* entry = find(shape))
+            return entry;
+        if (is_megamorphic)
+            return nullptr;
+        for (size_t i = 0; i < number_of_entries; ++i) {
+            if (!entries[i].shape)
+                return &entries[i];
+        }
+        if (number_of_entries < max_number_of_shapes_to_remember)
+            return &entries[number_of_entries++];
+
+        // NOTE: Once a site goes megamorphic it stays that way, we don't want to keep thrashing the cache.
+        entries = {};
+        number_of_entries = 0;
+        is_megamorphic = true;
+        return nullptr;
+    }
+
+    void record_hit() const
+    {
+        if constexpr (PROPERTY_LOOKUP_CACHE_DEBUG) {
+            if (number_of_entries == 1)
+                ++g_property_lookup_cache_statistics.monomorphic_hits;
+            else
+                ++g_property_lookup_cache_statistics.polymorphic_hits;
+        }
+    }
+
+    void record_miss() const
+    {
+        if constexpr (PROPERTY_LOOKUP_CACHE_DEBUG) {
+            if (is_megamorphic)
+                ++g_property_lookup_cache_statistics.megamorphic_lookups;
+            else
+                ++g_property_lookup_cache_statistics.misses;
+        }
+    }
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    u8 number_of_entries { 0 };
+    bool is_megamorphic { false };
 };
 
+// The entry count and megamorphic flag should fit in the padding after the entries.
+static_assert(sizeof(PropertyLookupCache) <= sizeof(PropertyLookupCache::Entry) * PropertyLookupCache::max_number_of_shapes_to_remember + alignof(PropertyLookupCache));
+
 struct GlobalVariableCache : public PropertyLookupCache {
     u64 environment_serial_number { 0 };
 };
@@ -98,8 +199,27 @@ public:
 
     void dump() const;
 
+    // Number of times this executable has been entered (or looped back) before we compile it to native code.
+    static constexpr u32 jit_hotness_threshold = 100;
+
+    // Returns the native version of this executable once it has become hot enough, or null if we should keep interpreting.
+    [[nodiscard]] JIT::NativeExecutable const* tick_hotness_counter()
+    {
+        if (m_native_executable)
+            return m_native_executable.ptr();
+        if (m_did_try_jitting || ++m_hotness_counter < jit_hotness_threshold)
+            return nullptr;
+        return compile_to_native_code();
+    }
+
 private:
     virtual void visit_edges(Visitor&) override;
+
+    JIT::NativeExecutable const* compile_to_native_code();
+
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
+    u32 m_hotness_counter { 0 };
+    bool m_did_try_jitting { false };
 };
 
 }
@@ -15,6 +15,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -110,42 +111,6 @@ static ByteString format_value_list(StringView name, ReadonlySpan<Value> values)
     return builder.to_byte_string();
 }
 
-ALWAYS_INLINE static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() != src2.encoded());
-    }
-    return Value(!TRY(is_loosely_equal(vm, src1, src2)));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() == src2.encoded());
-    }
-    return Value(TRY(is_loosely_equal(vm, src1, src2)));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> strict_inequals(VM&, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() != src2.encoded());
-    }
-    return Value(!is_strictly_equal(src1, src2));
-}
-
-ALWAYS_INLINE static ThrowCompletionOr<Value> strict_equals(VM&, Value src1, Value src2)
-{
-    if (src1.tag() == src2.tag()) {
-        if (src1.is_int32() || src1.is_object() || src1.is_boolean() || src1.is_nullish())
-            return Value(src1.encoded() == src2.encoded());
-    }
-    return Value(is_strictly_equal(src1, src2));
-}
-
 Interpreter::Interpreter(VM& vm)
     : m_vm(vm)
 {
@@ -407,7 +372,15 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
-            program_counter = instruction.target().address();
+            auto target = instruction.target().address();
+            // OPTIMIZATION: A backward jump means we're in a loop, so this is a good place to tier up to native code.
+            if (target <= program_counter) {
+                if (auto const* native_executable = executable.tick_hotness_counter()) {
+                    native_executable->run(*this, target);
+                    return;
+                }
+            }
+            program_counter = target;
             goto start;
         }
 
@@ -726,7 +699,10 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
     }
 
-    run_bytecode(entry_point.value_or(0));
+    if (auto const* native_executable = executable.tick_hotness_counter())
+        native_executable->run(*this, entry_point.value_or(0));
+    else
+        run_bytecode(entry_point.value_or(0));
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -81,6 +81,9 @@ public:
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
 private:
+    friend class JIT::Compiler;
+    friend class JIT::NativeExecutable;
+
     void run_bytecode(size_t entry_point);
 
     enum class HandleExceptionResponse {
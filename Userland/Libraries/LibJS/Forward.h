@@ -325,4 +325,9 @@ class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class Compiler;
+class NativeExecutable;
+}
+
 }
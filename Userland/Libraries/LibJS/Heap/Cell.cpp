@@ -15,6 +15,11 @@ void JS::Cell::initialize(JS::Realm&)
 {
 }
 
+void JS::Cell::write_barrier_slow_path()
+{
+    heap().write_barrier_slow_path({}, *this);
+}
+
 void JS::Cell::Visitor::visit(JS::Value value)
 {
     if (value.is_cell())
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -19,14 +20,29 @@
 
 namespace JS {
 
-#define JS_CELL(class_, base_class)                \
-public:                                            \
-    using Base = base_class;                       \
-    virtual StringView class_name() const override \
-    {                                              \
-        return #class_##sv;                        \
-    }                                              \
-    friend class JS::Heap;
+struct CellTraits;
+
+#define JS_CELL(class_, base_class)                          \
+public:                                                      \
+    using Base = base_class;                                 \
+    virtual StringView class_name() const override           \
+    {                                                        \
+        return #class_##sv;                                  \
+    }                                                        \
+    virtual bool has_write_barriers() const override         \
+    {                                                        \
+        return JS::CellTraits::has_write_barriers<class_>(); \
+    }                                                        \
+    friend class JS::Heap;                                   \
+    friend struct JS::CellTraits;
+
+// Declares that every store of a GC edge into this exact class goes through Cell::write_barrier().
+// Subclasses that trace edges of their own (i.e. override visit_edges()) have to declare this again.
+#define JS_DECLARE_WRITE_BARRIERS(ClassName) \
+    using WriteBarrieredCellType = ClassName
+
+template<typename T>
+concept CellDeclaresWriteBarriers = requires { typename T::WriteBarrieredCellType; } && IsSame<typename T::WriteBarrieredCellType, T>;
 
 class Cell : public Weakable<Cell> {
     AK_MAKE_NONCOPYABLE(Cell);
@@ -39,6 +55,9 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Returns true if the cell was not already marked. Used when several threads are marking at the same time.
+    bool try_set_marked_atomically() { return !AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
+
     enum class State : bool {
         Live,
         Dead,
@@ -47,7 +66,24 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Lazy sweeping destroys dead cells some time after the collection that found them,
+    // so anything observing the cell has to be told that it's gone right away.
+    void did_become_unreachable(Badge<Heap>)
+    {
+        revoke_weak_ptrs();
+        m_state = State::Dead;
+    }
+
+    // Cells start out young and are promoted to the old generation when they survive a collection.
+    bool is_young() const { return m_young; }
+    void set_young(bool b) { m_young = b; }
+
+    // An old cell is remembered if it may point to young cells, and must be traced by young generation collections.
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
     virtual StringView class_name() const = 0;
+    virtual bool has_write_barriers() const { return false; }
 
     class Visitor {
     public:
@@ -168,10 +204,44 @@ protected:
 
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
+    // Must be called by cells declared with JS_DECLARE_WRITE_BARRIERS right before storing a new edge to another cell.
+    // NOTE: Nothing may allocate between the barrier and the store, since a collection in between could forget the cell again.
+    // NOTE: Outside of garbage collection, a cell is only ever marked while incremental marking is in progress.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (m_mark || (!m_young && !m_remembered)) [[unlikely]]
+            write_barrier_slow_path();
+    }
+
 private:
-    bool m_mark : 1 { false };
+    void write_barrier_slow_path();
+
+    // NOTE: This is not a bitfield, since parallel marking needs to be able to set it atomically.
+    bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    bool m_young : 1 { true };
+    bool m_remembered : 1 { false };
+};
+
+struct CellTraits {
+    // A cell class that doesn't override visit_edges() has no edges besides those of its base class, so it has write
+    // barriers if its base class does. Cell itself has no edges at all.
+    // NOTE: This is a friend of every cell class, so that it can look at visit_edges() whatever its access.
+    template<typename T>
+    static constexpr bool has_write_barriers()
+    {
+        if constexpr (IsSame<T, Cell> || CellDeclaresWriteBarriers<T>) {
+            return true;
+        } else if constexpr (requires { &T::visit_edges; }) {
+            if constexpr (IsSame<decltype(&T::visit_edges), void (T::*)(Cell::Visitor&)>)
+                return false;
+            else
+                return has_write_barriers<typename T::Base>();
+        } else {
+            return false;
+        }
+    }
 };
 
 }
@@ -23,6 +23,9 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    // NOTE: Blocks that were left unswept by the last collection are swept on demand, as we run out of free cells.
+    while (m_usable_blocks.is_empty() && sweep_next_pending_block()) { }
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
         auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
@@ -36,6 +39,8 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
     VERIFY(cell);
+    if (!block.is_in_nursery())
+        heap.add_block_to_nursery({}, block);
     if (block.is_full())
         m_full_blocks.append(*m_usable_blocks.last());
     return cell;
@@ -43,10 +48,7 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
 {
-    block.m_list_node.remove();
-    // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
-    block.~HeapBlock();
-    m_block_allocator.deallocate_block(&block);
+    destroy_block(block);
 }
 
 void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
@@ -55,4 +57,37 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_did_become_pending_sweep(Badge<Heap>, HeapBlock& block)
+{
+    m_blocks_pending_sweep.append(block);
+}
+
+void CellAllocator::sweep_all_pending_blocks(Badge<Heap>)
+{
+    while (sweep_next_pending_block()) { }
+}
+
+bool CellAllocator::sweep_next_pending_block()
+{
+    auto* block = m_blocks_pending_sweep.take_first();
+    if (!block)
+        return false;
+
+    if (!block->sweep())
+        destroy_block(*block);
+    else if (block->is_full())
+        m_full_blocks.append(*block);
+    else
+        m_usable_blocks.append(*block);
+    return true;
+}
+
+void CellAllocator::destroy_block(HeapBlock& block)
+{
+    block.m_list_node.remove();
+    // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
+    block.~HeapBlock();
+    m_block_allocator.deallocate_block(&block);
+}
+
 }
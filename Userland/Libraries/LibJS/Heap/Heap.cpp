@@ -14,14 +14,18 @@
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
+#include <LibJS/Heap/WorkStealingDeque.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/WeakContainer.h>
 #include <LibJS/SafeFunction.h>
+#include <LibThreading/ThreadPool.h>
+#include <sched.h>
 #include <setjmp.h>
 
 #ifdef AK_OS_SERENITY
@@ -42,31 +46,6 @@ static int gc_perf_string_id;
 static __thread HashMap<FlatPtr*, size_t>* s_custom_ranges_for_conservative_scan = nullptr;
 static __thread HashMap<FlatPtr*, SourceLocation*>* s_safe_function_locations = nullptr;
 
-Heap::Heap(VM& vm)
-    : HeapBase(vm)
-{
-#ifdef AK_OS_SERENITY
-    auto gc_signpost_string = "Garbage collection"sv;
-    gc_perf_string_id = perf_register_string(gc_signpost_string.characters_without_null_termination(), gc_signpost_string.length());
-#endif
-
-    static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
-    m_size_based_cell_allocators.append(make<CellAllocator>(64));
-    m_size_based_cell_allocators.append(make<CellAllocator>(96));
-    m_size_based_cell_allocators.append(make<CellAllocator>(128));
-    m_size_based_cell_allocators.append(make<CellAllocator>(256));
-    m_size_based_cell_allocators.append(make<CellAllocator>(512));
-    m_size_based_cell_allocators.append(make<CellAllocator>(1024));
-    m_size_based_cell_allocators.append(make<CellAllocator>(3072));
-}
-
-Heap::~Heap()
-{
-    vm().string_cache().clear();
-    vm().byte_string_cache().clear();
-    collect_garbage(CollectionType::CollectEverything);
-}
-
 void Heap::will_allocate(size_t size)
 {
     if (should_collect_on_every_allocation()) {
@@ -75,9 +54,50 @@ void Heap::will_allocate(size_t size)
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
+    } else if (m_incremental_marking_in_progress) {
+        // NOTE: Marking will be finished by the event loop, or when the allocation threshold is reached.
+    } else if (m_incremental_marking_enabled && m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold / 2) {
+        start_incremental_marking();
+    } else if (m_remembered_set_is_valid && m_allocated_bytes_since_last_young_gc + size > GC_YOUNG_GENERATION_BYTES_THRESHOLD) {
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     m_allocated_bytes_since_last_gc += size;
+    m_allocated_bytes_since_last_young_gc += size;
+}
+
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    m_generational_collection_enabled = enabled;
+
+    // NOTE: The remembered set becomes valid again once the next full collection has rebuilt it.
+    if (!enabled)
+        m_remembered_set_is_valid = false;
+}
+
+void Heap::remember_cell(Cell& cell)
+{
+    VERIFY(!cell.is_young());
+    VERIFY(!cell.is_remembered());
+    cell.set_remembered(true);
+    if (m_remembered_set_is_valid)
+        m_remembered_set.append(&cell);
+}
+
+void Heap::promote_cell(Cell& cell)
+{
+    cell.set_young(false);
+
+    // NOTE: Cells without write barriers can't tell us when they start pointing to young cells,
+    //       so they stay in the remembered set for as long as they live.
+    //       When the remembered set is not maintained, marking every cell as remembered keeps write barriers cheap.
+    if (!m_generational_collection_enabled || !cell.has_write_barriers()) {
+        cell.set_remembered(true);
+        if (m_generational_collection_enabled)
+            m_remembered_set.append(&cell);
+    } else {
+        cell.set_remembered(false);
+    }
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -273,17 +293,67 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     if (print_report)
         collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type == CollectionType::CollectYoungGeneration && (!m_remembered_set_is_valid || m_incremental_marking_in_progress))
+        collection_type = CollectionType::CollectGarbage;
+
+    if (collection_type == CollectionType::CollectEverything && m_incremental_marking_in_progress)
+        cancel_incremental_marking();
+
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
+        // NOTE: This also makes sure that dead cells are destroyed by the next collection at the latest.
+        sweep_all_pending_blocks();
+
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+
+        if (collection_type == CollectionType::CollectYoungGeneration) {
+            mark_live_young_cells(roots);
+            finalize_unmarked_young_cells();
+            sweep_dead_young_cells(print_report, collection_measurement_timer);
+            return;
+        }
+
+        if (m_incremental_marking_in_progress)
+            finish_incremental_marking(roots);
+        else
+            mark_live_cells(roots);
+
+        // NOTE: Dead cells are destroyed later on, by the cell allocators, as they run out of free cells.
+        finalize_unmarked_cells();
+        sweep_dead_cells(SweepMode::Lazy, print_report, collection_measurement_timer);
+        return;
     }
+
+    sweep_all_pending_blocks();
     finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    sweep_dead_cells(SweepMode::Eager, print_report, collection_measurement_timer);
+}
+
+void Heap::sweep_all_pending_blocks()
+{
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.sweep_all_pending_blocks({});
+    m_has_blocks_pending_sweep = false;
+}
+
+void Heap::perform_lazy_sweep_slice(Duration budget)
+{
+    VERIFY(!m_collecting_garbage);
+    if (!m_has_blocks_pending_sweep)
+        return;
+
+    auto deadline = MonotonicTime::now() + budget;
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.sweep_next_pending_block({})) {
+            if (MonotonicTime::now() >= deadline)
+                return;
+        }
+    }
+    m_has_blocks_pending_sweep = false;
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -389,8 +459,20 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    enum class Generation {
+        All,
+        Young,
+    };
+
+    enum class Mode {
+        Atomic,
+        Incremental,
+    };
+
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, Generation generation = Generation::All, Mode mode = Mode::Atomic)
         : m_heap(heap)
+        , m_generation(generation)
+        , m_mode(mode)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
         m_heap.for_each_block([&](auto& block) {
@@ -405,12 +487,11 @@ public:
 
     virtual void visit_impl(Cell& cell) override
     {
-        if (cell.is_marked())
+        if (cell.is_marked() || !should_mark(cell))
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
-        cell.set_marked(true);
-        m_work_queue.append(cell);
+        mark(cell);
     }
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
@@ -422,35 +503,463 @@ public:
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
         for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
+            if (cell->is_marked() || !should_mark(*cell))
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
-            m_work_queue.append(*cell);
+            mark(*cell);
         });
     }
 
-    void mark_all_live_cells()
+    // Old cells are not marked during a young generation collection, so any young cells they point to
+    // have to be found by tracing the edges of the remembered cells instead.
+    void visit_remembered_cells(ReadonlySpan<Cell*> remembered_cells)
+    {
+        VERIFY(m_generation == Generation::Young);
+        for (auto* cell : remembered_cells)
+            cell->visit_edges(*this);
+    }
+
+    // Returns the number of cells that were traced.
+    size_t mark_all_live_cells()
     {
+        size_t marked_cells = 0;
         while (!m_work_queue.is_empty()) {
             m_work_queue.take_last()->visit_edges(*this);
+            ++marked_cells;
         }
+        return marked_cells;
+    }
+
+    // Returns true if there is nothing left to mark.
+    bool mark_live_cells_until(MonotonicTime deadline, size_t& marked_cells)
+    {
+        VERIFY(m_mode == Mode::Incremental);
+
+        // NOTE: Reading the clock is not free, so we only check the deadline every so often.
+        static constexpr size_t cells_between_deadline_checks = 256;
+        size_t cells_since_deadline_check = 0;
+        auto deadline_reached = [&] {
+            if (++cells_since_deadline_check < cells_between_deadline_checks)
+                return false;
+            cells_since_deadline_check = 0;
+            return MonotonicTime::now() >= deadline;
+        };
+
+        for (;;) {
+            drain_gray_cells();
+
+            while (!m_work_queue.is_empty()) {
+                m_work_queue.take_last()->visit_edges(*this);
+                ++marked_cells;
+                if (deadline_reached())
+                    return false;
+            }
+
+            // Cells without write barriers have to be traced again in the final pause. Tracing them here first means
+            // that whatever they gained edges to in the meantime gets marked now, and the final pause finds little
+            // left to do. We're done once a whole pass over them has turned up nothing new.
+            while (m_next_cell_without_write_barriers_to_retrace < m_cells_without_write_barriers.size()) {
+                m_cells_without_write_barriers[m_next_cell_without_write_barriers_to_retrace++]->visit_edges(*this);
+                if (deadline_reached())
+                    return false;
+            }
+
+            if (m_work_queue.is_empty() && m_gray_cells.is_empty())
+                return true;
+            m_next_cell_without_write_barriers_to_retrace = 0;
+        }
+    }
+
+    void did_write_to_marked_cell(Cell& cell)
+    {
+        VERIFY(m_mode == Mode::Incremental);
+
+        // NOTE: Unmarking the cell keeps further writes to it from going through the slow path again.
+        cell.set_marked(false);
+        m_gray_cells.append(cell);
+    }
+
+    // Completes an incremental marking cycle in a single pause. Returns the number of cells that were traced.
+    size_t finish(HashMap<Cell*, HeapRoot> const& roots)
+    {
+        VERIFY(m_mode == Mode::Incremental);
+        m_mode = Mode::Atomic;
+
+        // NOTE: The roots are not behind write barriers, but only the ones that are new since the cycle started (or
+        //       were reached since) are unmarked, so visiting them is cheap.
+        for (auto* root : roots.keys())
+            visit(root);
+
+        drain_gray_cells();
+
+        // NOTE: Cells without write barriers may have gained edges to unmarked cells at any point, so we have to trace
+        //       them again. Since the slices have already done so, this rarely finds anything new.
+        size_t marked_cells = m_cells_without_write_barriers.size();
+        for (auto& cell : m_cells_without_write_barriers)
+            cell->visit_edges(*this);
+        m_cells_without_write_barriers.clear();
+
+        return marked_cells + mark_all_live_cells();
     }
 
 private:
+    void drain_gray_cells()
+    {
+        for (auto& cell : m_gray_cells)
+            visit(cell);
+        m_gray_cells.clear();
+    }
+
+    bool should_mark(Cell const& cell) const
+    {
+        return m_generation == Generation::All || cell.is_young();
+    }
+
+    void mark(Cell& cell)
+    {
+        cell.set_marked(true);
+        m_work_queue.append(cell);
+        if (m_mode == Mode::Incremental && !cell.has_write_barriers())
+            m_cells_without_write_barriers.append(cell);
+    }
+
     Heap& m_heap;
+    Generation m_generation { Generation::All };
+    Mode m_mode { Mode::Atomic };
     Vector<NonnullGCPtr<Cell>> m_work_queue;
+
+    // Cells that were turned grey again by the write barrier because they got a new edge after being traced.
+    Vector<NonnullGCPtr<Cell>> m_gray_cells;
+
+    Vector<NonnullGCPtr<Cell>> m_cells_without_write_barriers;
+    size_t m_next_cell_without_write_barriers_to_retrace { 0 };
     HashTable<HeapBlock*> m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
+Heap::Heap(VM& vm)
+    : HeapBase(vm)
+{
+#ifdef AK_OS_SERENITY
+    auto gc_signpost_string = "Garbage collection"sv;
+    gc_perf_string_id = perf_register_string(gc_signpost_string.characters_without_null_termination(), gc_signpost_string.length());
+#endif
+
+    static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
+    m_size_based_cell_allocators.append(make<CellAllocator>(64));
+    m_size_based_cell_allocators.append(make<CellAllocator>(96));
+    m_size_based_cell_allocators.append(make<CellAllocator>(128));
+    m_size_based_cell_allocators.append(make<CellAllocator>(256));
+    m_size_based_cell_allocators.append(make<CellAllocator>(512));
+    m_size_based_cell_allocators.append(make<CellAllocator>(1024));
+    m_size_based_cell_allocators.append(make<CellAllocator>(3072));
+}
+
+Heap::~Heap()
+{
+    vm().string_cache().clear();
+    vm().byte_string_cache().clear();
+    collect_garbage(CollectionType::CollectEverything);
+}
+
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_collecting_garbage);
+    VERIFY(!m_incremental_marking_in_progress);
+
+    if (m_gc_deferrals)
+        return;
+
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    TemporaryChange change(m_collecting_garbage, true);
+
+    sweep_all_pending_blocks();
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+
+    m_incremental_marking_slices.clear();
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots, MarkingVisitor::Generation::All, MarkingVisitor::Mode::Incremental);
+    m_incremental_marking_in_progress = true;
+}
+
+void Heap::perform_incremental_marking_slice(Duration budget)
+{
+    if (!m_incremental_marking_in_progress)
+        return;
+
+    bool done = false;
+    {
+        VERIFY(!m_collecting_garbage);
+        TemporaryChange change(m_collecting_garbage, true);
+
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        auto deadline = MonotonicTime::now() + budget;
+        size_t marked_cells = 0;
+        done = m_incremental_marking_visitor->mark_live_cells_until(deadline, marked_cells);
+
+        m_incremental_marking_slices.append({ .time_spent = timer.elapsed_time(), .marked_cells = marked_cells });
+        dbgln_if(HEAP_DEBUG, "incremental marking slice: {} cells in {} us", marked_cells, m_incremental_marking_slices.last().time_spent.to_microseconds());
+    }
+
+    // NOTE: The final pause only has to revisit the roots and the cells that were mutated behind our back.
+    if (done)
+        collect_garbage();
+}
+
+void Heap::finish_incremental_marking(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+    m_incremental_marking_in_progress = false;
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto marked_cells = visitor->finish(roots);
+    m_incremental_marking_final_pause = { .time_spent = timer.elapsed_time(), .marked_cells = marked_cells };
+    dbgln_if(HEAP_DEBUG, "incremental marking final pause: {} cells in {} us", marked_cells, m_incremental_marking_final_pause.time_spent.to_microseconds());
+
+    for (auto& inverse_root : m_uprooted_cells)
+        inverse_root->set_marked(false);
+
+    m_uprooted_cells.clear();
+}
+
+void Heap::cancel_incremental_marking()
+{
+    m_incremental_marking_visitor = nullptr;
+    m_incremental_marking_in_progress = false;
+
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::write_barrier_slow_path(Badge<Cell>, Cell& cell)
+{
+    // NOTE: A marked cell that gets a new edge is turned grey again, so that it is traced once more before marking completes.
+    if (cell.is_marked() && m_incremental_marking_in_progress)
+        m_incremental_marking_visitor->did_write_to_marked_cell(cell);
+
+    if (!cell.is_young() && !cell.is_remembered())
+        remember_cell(cell);
+}
+
+void Heap::did_allocate_cell_during_incremental_marking(Cell& cell)
+{
+    // NOTE: New cells are allocated grey, so that everything they were constructed with gets marked as well.
+    m_incremental_marking_visitor->visit(cell);
+}
+
+// Each thread taking part in parallel marking has a deque of cells to trace. Threads push and pop cells at the bottom of their
+// own deque, and threads that run out of work steal cells from the top of the others' deques.
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    using Deque = WorkStealingDeque<Cell, 4096>;
+
+    struct SharedState {
+        HashTable<HeapBlock*> all_live_heap_blocks;
+        FlatPtr min_block_address { 0 };
+        FlatPtr max_block_address { 0 };
+
+        Vector<NonnullOwnPtr<Deque>> deques;
+        Atomic<size_t> active_thread_count { 0 };
+    };
+
+    ParallelMarkingVisitor(SharedState& state, size_t thread_index)
+        : m_state(state)
+        , m_thread_index(thread_index)
+        , m_deque(*state.deques[thread_index])
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!cell.try_set_marked_atomically())
+            return;
+        // NOTE: Cells that don't fit in the deque can't be stolen until we move them over, see take_own_work().
+        if (!m_deque.push(&cell))
+            m_overflow.append(cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_state.min_block_address, m_state.max_block_address);
+
+        for_each_cell_among_possible_pointers(m_state.all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() != Cell::State::Live)
+                return;
+            visit_impl(*cell);
+        });
+    }
+
+    void mark_all_live_cells()
+    {
+        while (true) {
+            while (auto* cell = take_own_work())
+                cell->visit_edges(*this);
+
+            // NOTE: Marking is done once every thread is idle and every deque is empty. Only active threads push cells,
+            //       so a thread has to count itself as active again before it steals anything.
+            --m_state.active_thread_count;
+            while (true) {
+                if (any_other_deque_has_work()) {
+                    ++m_state.active_thread_count;
+                    if (auto* cell = steal_work()) {
+                        cell->visit_edges(*this);
+                        break;
+                    }
+                    --m_state.active_thread_count;
+                }
+                if (m_state.active_thread_count.load() == 0 && !any_other_deque_has_work())
+                    return;
+                sched_yield();
+            }
+        }
+    }
+
+private:
+    Cell* take_own_work()
+    {
+        if (auto* cell = m_deque.pop())
+            return cell;
+        if (m_overflow.is_empty())
+            return nullptr;
+
+        // Make some of the overflow available to other threads again.
+        auto count = min(m_overflow.size(), Deque::capacity() / 2);
+        for (size_t i = 1; i < count; ++i)
+            (void)m_deque.push(m_overflow.take_last().ptr());
+        return m_overflow.take_last().ptr();
+    }
+
+    Cell* steal_work()
+    {
+        auto thread_count = m_state.deques.size();
+        for (size_t i = 1; i < thread_count; ++i) {
+            if (auto* cell = m_state.deques[(m_thread_index + i) % thread_count]->steal())
+                return cell;
+        }
+        return nullptr;
+    }
+
+    bool any_other_deque_has_work() const
+    {
+        for (size_t i = 0; i < m_state.deques.size(); ++i) {
+            if (i != m_thread_index && !m_state.deques[i]->is_empty())
+                return true;
+        }
+        return false;
+    }
+
+    SharedState& m_state;
+    size_t m_thread_index { 0 };
+    Deque& m_deque;
+    Vector<NonnullGCPtr<Cell>> m_overflow;
+};
+
+class ParallelMarker {
+public:
+    explicit ParallelMarker(size_t thread_count)
+        : m_thread_count(thread_count)
+        , m_thread_pool([](Function<void()> work) { work(); }, thread_count - 1)
+    {
+        VERIFY(thread_count > 1);
+    }
+
+    size_t thread_count() const { return m_thread_count; }
+
+    void mark_live_cells(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    {
+        ParallelMarkingVisitor::SharedState state;
+        state.active_thread_count = m_thread_count;
+        for (size_t i = 0; i < m_thread_count; ++i)
+            state.deques.append(make<ParallelMarkingVisitor::Deque>());
+        heap.find_min_and_max_block_addresses(state.min_block_address, state.max_block_address);
+        heap.for_each_block([&](auto& block) {
+            state.all_live_heap_blocks.set(&block);
+            return IterationDecision::Continue;
+        });
+
+        // NOTE: The roots go into this thread's deque, and the other threads start out by stealing from it.
+        ParallelMarkingVisitor visitor(state, 0);
+        for (auto* root : roots.keys())
+            visitor.visit(root);
+
+        for (size_t i = 1; i < m_thread_count; ++i) {
+            m_thread_pool.submit([&state, i] {
+                ParallelMarkingVisitor visitor(state, i);
+                visitor.mark_all_live_cells();
+            });
+        }
+
+        visitor.mark_all_live_cells();
+
+        m_thread_pool.wait_for_all();
+    }
+
+private:
+    size_t m_thread_count { 0 };
+    Threading::ThreadPool<Function<void()>> m_thread_pool;
+};
+
+void Heap::set_parallel_marking_enabled(bool enabled, Optional<size_t> thread_count)
+{
+    // NOTE: There's no point in having more threads than this, as they'd spend most of their time trying to steal work.
+    static constexpr size_t max_parallel_marking_threads = 8;
+
+    if (!thread_count.has_value())
+        thread_count = min(static_cast<size_t>(Core::System::hardware_concurrency()), max_parallel_marking_threads);
+    if (!enabled || *thread_count < 2) {
+        m_parallel_marker = nullptr;
+        return;
+    }
+    if (!m_parallel_marker || m_parallel_marker->thread_count() != *thread_count)
+        m_parallel_marker = make<ParallelMarker>(*thread_count);
+}
+
 void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    if (m_parallel_marker) {
+        m_parallel_marker->mark_live_cells(*this, roots);
+    } else {
+        MarkingVisitor visitor(*this, roots);
+        visitor.mark_all_live_cells();
+    }
+
+    for (auto& inverse_root : m_uprooted_cells)
+        inverse_root->set_marked(false);
+
+    m_uprooted_cells.clear();
+}
+
+void Heap::mark_live_young_cells(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_young_cells:");
+
+    MarkingVisitor visitor(*this, roots, MarkingVisitor::Generation::Young);
+
+    visitor.visit_remembered_cells(m_remembered_set);
+
+    // NOTE: Young cells that must survive are treated as roots, since they will be promoted along with everything they point to.
+    for (auto* block : m_nursery_blocks) {
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_young() && cell_must_survive_garbage_collection(*cell))
+                visitor.visit(cell);
+        });
+    }
 
     visitor.mark_all_live_cells();
 
@@ -478,11 +987,26 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::finalize_unmarked_young_cells()
+{
+    for (auto* block : m_nursery_blocks) {
+        block->for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            if (cell->is_young() && !cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+                cell->finalize();
+        });
+    }
+}
+
+void Heap::sweep_dead_cells(SweepMode sweep_mode, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+    Vector<HeapBlock*, 32> blocks_pending_sweep;
+
+    // NOTE: The remembered set is rebuilt from the survivors below, since some of the cells in it are about to die.
+    m_remembered_set.clear();
+    m_nursery_blocks.clear();
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
@@ -491,27 +1015,41 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     for_each_block([&](auto& block) {
         bool block_has_live_cells = false;
+        bool block_has_dead_cells = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                if (sweep_mode == SweepMode::Lazy)
+                    cell->did_become_unreachable({});
+                else
+                    block.deallocate(cell);
+                block_has_dead_cells = true;
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                promote_cell(*cell);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        block.set_in_nursery(false);
+        if (sweep_mode == SweepMode::Lazy) {
+            if (block_has_dead_cells)
+                blocks_pending_sweep.append(&block);
+        } else if (!block_has_live_cells) {
             empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
+        } else if (block_was_full != block.is_full()) {
             full_blocks_that_became_usable.append(&block);
+        }
         return IterationDecision::Continue;
     });
 
+    m_remembered_set_is_valid = m_generational_collection_enabled;
+    m_allocated_bytes_since_last_young_gc = 0;
+
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
@@ -525,6 +1063,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         block->cell_allocator().block_did_become_usable({}, *block);
     }
 
+    for (auto* block : blocks_pending_sweep) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock pending sweep @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_pending_sweep({}, *block);
+    }
+    if (!blocks_pending_sweep.is_empty())
+        m_has_blocks_pending_sweep = true;
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -549,6 +1094,97 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        if (sweep_mode == SweepMode::Lazy)
+            dbgln(" Blocks pending sweep: {}", blocks_pending_sweep.size());
+        if (!m_incremental_marking_slices.is_empty()) {
+            Duration longest_slice;
+            for (auto const& slice : m_incremental_marking_slices)
+                longest_slice = max(longest_slice, slice.time_spent);
+            dbgln(" Marking slices: {} (longest {} ms)", m_incremental_marking_slices.size(), longest_slice.to_milliseconds());
+            dbgln("    Final pause: {} cells in {} ms", m_incremental_marking_final_pause.marked_cells, m_incremental_marking_final_pause.time_spent.to_milliseconds());
+        }
+        dbgln("=============================================");
+    }
+}
+
+void Heap::sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_young_cells:");
+    Vector<HeapBlock*, 32> empty_blocks;
+    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+
+    size_t collected_cells = 0;
+    size_t promoted_cells = 0;
+    size_t collected_cell_bytes = 0;
+    size_t promoted_cell_bytes = 0;
+
+    // NOTE: Cells with write barriers only need to stay remembered until their young referents have been promoted.
+    m_remembered_set.remove_all_matching([](Cell* cell) {
+        if (!cell->has_write_barriers())
+            return false;
+        cell->set_remembered(false);
+        return true;
+    });
+
+    for (auto* block : m_nursery_blocks) {
+        bool block_has_live_cells = false;
+        bool block_was_full = block->is_full();
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (!cell->is_young()) {
+                block_has_live_cells = true;
+                return;
+            }
+            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                block->deallocate(cell);
+                ++collected_cells;
+                collected_cell_bytes += block->cell_size();
+            } else {
+                cell->set_marked(false);
+                promote_cell(*cell);
+                block_has_live_cells = true;
+                ++promoted_cells;
+                promoted_cell_bytes += block->cell_size();
+            }
+        });
+        block->set_in_nursery(false);
+        if (!block_has_live_cells)
+            empty_blocks.append(block);
+        else if (block_was_full != block->is_full())
+            full_blocks_that_became_usable.append(block);
+    }
+
+    size_t nursery_block_count = m_nursery_blocks.size();
+    m_nursery_blocks.clear();
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    for (auto* block : empty_blocks) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_empty({}, *block);
+    }
+
+    for (auto* block : full_blocks_that_became_usable) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_usable({}, *block);
+    }
+
+    // NOTE: Garbage collected from the young generation no longer counts towards the next full collection.
+    m_allocated_bytes_since_last_gc -= min(m_allocated_bytes_since_last_gc, collected_cell_bytes);
+    m_allocated_bytes_since_last_young_gc = 0;
+
+    if (print_report) {
+        Duration const time_spent = measurement_timer.elapsed_time();
+
+        dbgln("Young generation garbage collection report");
+        dbgln("=============================================");
+        dbgln("      Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln("  Nursery blocks: {}", nursery_block_count);
+        dbgln("Remembered cells: {}", m_remembered_set.size());
+        dbgln("  Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
+        dbgln(" Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("    Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
     }
 }
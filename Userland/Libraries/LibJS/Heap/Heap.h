@@ -11,6 +11,9 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -28,6 +31,9 @@
 
 namespace JS {
 
+class MarkingVisitor;
+class ParallelMarker;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -43,6 +49,8 @@ public:
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
+        if (m_incremental_marking_in_progress) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*memory);
         return *static_cast<T*>(memory);
     }
 
@@ -53,6 +61,8 @@ public:
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
+        if (m_incremental_marking_in_progress) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*memory);
         auto* cell = static_cast<T*>(memory);
         memory->initialize(realm);
         return *cell;
@@ -61,6 +71,7 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
@@ -69,6 +80,41 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    bool generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool);
+
+    // Old cells that young generation collections have to trace, since they may point to young cells.
+    size_t remembered_cell_count() const { return m_remembered_set.size(); }
+
+    bool parallel_marking_enabled() const { return m_parallel_marker; }
+    // Uses one thread per core by default, up to a limit.
+    void set_parallel_marking_enabled(bool, Optional<size_t> thread_count = {});
+
+    bool incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool b) { m_incremental_marking_enabled = b; }
+
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_in_progress; }
+    void start_incremental_marking();
+
+    // Marks cells until the budget is exhausted. Once there is nothing left to mark, the collection is completed.
+    void perform_incremental_marking_slice(Duration budget);
+
+    struct IncrementalMarkingSlice {
+        Duration time_spent;
+        size_t marked_cells { 0 };
+    };
+
+    // The slices of the incremental marking cycle that is in progress, or the one that completed most recently.
+    Vector<IncrementalMarkingSlice> const& incremental_marking_slices() const { return m_incremental_marking_slices; }
+
+    // The pause that completed the most recent incremental marking cycle. Only the cells it had to trace again are counted.
+    IncrementalMarkingSlice const& incremental_marking_final_pause() const { return m_incremental_marking_final_pause; }
+
+    // Cells found dead by a collection are only destroyed once their block is swept. The cell allocators do that as they
+    // need the space, the next collection sweeps whatever is left, and the embedder can do so in between when it's idle.
+    bool has_blocks_pending_sweep() const { return m_has_blocks_pending_sweep; }
+    void perform_lazy_sweep_slice(Duration budget);
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -85,11 +131,15 @@ public:
     void did_destroy_execution_context(Badge<ExecutionContext>, ExecutionContext&);
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
+    void add_block_to_nursery(Badge<CellAllocator>, HeapBlock&);
+
+    void write_barrier_slow_path(Badge<Cell>, Cell&);
 
     void uproot_cell(Cell* cell);
 
 private:
     friend class MarkingVisitor;
+    friend class ParallelMarker;
     friend class GraphConstructorVisitor;
     friend class DeferGC;
 
@@ -118,7 +168,24 @@ private:
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+
+    enum class SweepMode {
+        Eager,
+        Lazy,
+    };
+    void sweep_dead_cells(SweepMode, bool print_report, Core::ElapsedTimer const&);
+    void sweep_all_pending_blocks();
+
+    void mark_live_young_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void finalize_unmarked_young_cells();
+    void sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const&);
+
+    void promote_cell(Cell&);
+    void remember_cell(Cell&);
+
+    void finish_incremental_marking(HashMap<Cell*, HeapRoot> const& live_cells);
+    void cancel_incremental_marking();
+    void did_allocate_cell_during_incremental_marking(Cell&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -144,6 +211,9 @@ private:
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
+    static constexpr size_t GC_YOUNG_GENERATION_BYTES_THRESHOLD { 1 * 1024 * 1024 };
+    size_t m_allocated_bytes_since_last_young_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
@@ -156,6 +226,23 @@ private:
 
     Vector<GCPtr<Cell>> m_uprooted_cells;
 
+    bool m_generational_collection_enabled { false };
+
+    // The remembered set is only complete after a full collection has run with generational collection enabled.
+    bool m_remembered_set_is_valid { false };
+    Vector<Cell*> m_remembered_set;
+    Vector<HeapBlock*> m_nursery_blocks;
+
+    OwnPtr<ParallelMarker> m_parallel_marker;
+
+    bool m_incremental_marking_enabled { false };
+    bool m_incremental_marking_in_progress { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    Vector<IncrementalMarkingSlice> m_incremental_marking_slices;
+    IncrementalMarkingSlice m_incremental_marking_final_pause;
+
+    bool m_has_blocks_pending_sweep { false };
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
 
@@ -215,4 +302,11 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::add_block_to_nursery(Badge<CellAllocator>, HeapBlock& block)
+{
+    VERIFY(!block.is_in_nursery());
+    block.set_in_nursery(true);
+    m_nursery_blocks.append(&block);
+}
+
 }
@@ -51,6 +51,29 @@ void HeapBlock::deallocate(Cell* cell)
     VERIFY(!cell->is_marked());
 
     cell->~Cell();
+    add_to_freelist(cell);
+}
+
+bool HeapBlock::sweep()
+{
+    bool has_live_cells = false;
+
+    // NOTE: Cells that were already on the freelist are dead as well, so we simply rebuild the whole freelist.
+    m_freelist = nullptr;
+    for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::Live) {
+            has_live_cells = true;
+            return;
+        }
+        cell->~Cell();
+        add_to_freelist(cell);
+    });
+
+    return has_live_cells;
+}
+
+void HeapBlock::add_to_freelist(Cell* cell)
+{
     auto* freelist_entry = new (cell) FreelistEntry();
     freelist_entry->set_state(Cell::State::Dead);
     freelist_entry->next = m_freelist;
@@ -50,6 +50,9 @@ public:
 
     void deallocate(Cell*);
 
+    // Destroys the cells that were found dead by the last collection, and returns whether any live cells remain.
+    bool sweep();
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -92,11 +95,17 @@ public:
 
     CellAllocator& cell_allocator() { return m_cell_allocator; }
 
+    // A block is in the nursery if cells have been allocated in it since the last collection.
+    bool is_in_nursery() const { return m_in_nursery; }
+    void set_in_nursery(bool b) { m_in_nursery = b; }
+
 private:
     HeapBlock(Heap&, CellAllocator&, size_t cell_size);
 
     bool has_lazy_freelist() const { return m_next_lazy_freelist_index < cell_count(); }
 
+    void add_to_freelist(Cell*);
+
     struct FreelistEntry final : public Cell {
         JS_CELL(FreelistEntry, Cell);
 
@@ -111,6 +120,7 @@ private:
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_in_nursery { false };
     GCPtr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
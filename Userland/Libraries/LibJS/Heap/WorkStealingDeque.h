@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace JS {
+
+// A fixed-size Chase-Lev deque, as described in "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al. 2013).
+// Only the thread that owns the deque may push() and pop() at the bottom, while any other thread may steal() from the top.
+template<typename T, size_t Capacity>
+class WorkStealingDeque {
+    AK_MAKE_NONCOPYABLE(WorkStealingDeque);
+    AK_MAKE_NONMOVABLE(WorkStealingDeque);
+
+    static_assert(is_power_of_two(Capacity));
+
+public:
+    WorkStealingDeque() = default;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Returns false if the deque is full.
+    bool push(T* value)
+    {
+        auto bottom = m_bottom.load(AK::memory_order_relaxed);
+        auto top = m_top.load(AK::memory_order_acquire);
+        if (bottom - top >= static_cast<i64>(Capacity))
+            return false;
+        m_buffer[bottom & (Capacity - 1)].store(value, AK::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::memory_order_release);
+        m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+        return true;
+    }
+
+    // Returns nullptr if the deque is empty.
+    T* pop()
+    {
+        auto bottom = m_bottom.load(AK::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, AK::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::memory_order_seq_cst);
+        auto top = m_top.load(AK::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* value = m_buffer[bottom & (Capacity - 1)].load(AK::memory_order_relaxed);
+        if (top == bottom) {
+            // NOTE: This is the last value, so we have to race any thieves for it.
+            if (!m_top.compare_exchange_strong(top, top + 1, AK::memory_order_seq_cst))
+                value = nullptr;
+            m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    // Returns nullptr if the deque is empty, or if another thread got to the value first.
+    T* steal()
+    {
+        auto top = m_top.load(AK::memory_order_acquire);
+        AK::atomic_thread_fence(AK::memory_order_seq_cst);
+        auto bottom = m_bottom.load(AK::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        auto* value = m_buffer[top & (Capacity - 1)].load(AK::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, AK::memory_order_seq_cst))
+            return nullptr;
+        return value;
+    }
+
+    bool is_empty() const
+    {
+        return m_top.load(AK::memory_order_relaxed) >= m_bottom.load(AK::memory_order_relaxed);
+    }
+
+private:
+    Atomic<i64> m_top { 0 };
+    Atomic<i64> m_bottom { 0 };
+    AK::Array<Atomic<T*>, Capacity> m_buffer;
+};
+
+}
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A tiny x86-64 assembler that only knows the handful of instructions the baseline JIT needs.
+struct Assembler {
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    Vector<u8>& m_output;
+
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        EqualTo = 0x4,
+        NotEqualTo = 0x5,
+        SignedLessThan = 0xC,
+        SignedGreaterThanOrEqualTo = 0xD,
+        SignedLessThanOrEqualTo = 0xE,
+        SignedGreaterThan = 0xF,
+    };
+
+    struct Label {
+        Optional<size_t> offset_of_label_in_instruction_stream;
+        Vector<size_t> jump_slot_offsets_in_instruction_stream;
+
+        void add_jump(Assembler& assembler, size_t offset)
+        {
+            jump_slot_offsets_in_instruction_stream.append(offset);
+            if (offset_of_label_in_instruction_stream.has_value())
+                link_jump(assembler, offset);
+        }
+
+        void link(Assembler& assembler)
+        {
+            link_to(assembler, assembler.m_output.size());
+        }
+
+        void link_to(Assembler& assembler, size_t link_offset)
+        {
+            VERIFY(!offset_of_label_in_instruction_stream.has_value());
+            offset_of_label_in_instruction_stream = link_offset;
+            for (auto offset : jump_slot_offsets_in_instruction_stream)
+                link_jump(assembler, offset);
+        }
+
+    private:
+        void link_jump(Assembler& assembler, size_t offset_in_instruction_stream)
+        {
+            // The jump slot is the rel32 at the very end of the jump instruction.
+            auto offset = static_cast<i32>(offset_of_label_in_instruction_stream.value() - offset_in_instruction_stream);
+            assembler.patch_i32(offset_in_instruction_stream - 4, offset);
+        }
+    };
+
+    [[nodiscard]] Label make_label()
+    {
+        return Label {
+            .offset_of_label_in_instruction_stream = m_output.size(),
+            .jump_slot_offsets_in_instruction_stream = {},
+        };
+    }
+
+    static constexpr u8 encode_reg(Reg reg) { return to_underlying(reg) & 0x7; }
+    static constexpr bool is_extended(Reg reg) { return to_underlying(reg) >= 8; }
+
+    void emit8(u8 value)
+    {
+        m_output.append(value);
+    }
+
+    void emit32(u32 value)
+    {
+        m_output.append((value >> 0) & 0xff);
+        m_output.append((value >> 8) & 0xff);
+        m_output.append((value >> 16) & 0xff);
+        m_output.append((value >> 24) & 0xff);
+    }
+
+    void emit64(u64 value)
+    {
+        emit32(value & 0xffffffff);
+        emit32(value >> 32);
+    }
+
+    void patch_i32(size_t offset, i32 value)
+    {
+        auto bits = static_cast<u32>(value);
+        m_output[offset + 0] = (bits >> 0) & 0xff;
+        m_output[offset + 1] = (bits >> 8) & 0xff;
+        m_output[offset + 2] = (bits >> 16) & 0xff;
+        m_output[offset + 3] = (bits >> 24) & 0xff;
+    }
+
+    void emit_rex(bool wide, Reg reg, Reg rm)
+    {
+        emit8(0x40 | (wide ? 0x08 : 0) | (is_extended(reg) ? 0x04 : 0) | (is_extended(rm) ? 0x01 : 0));
+    }
+
+    void emit_rex_if_needed(Reg reg, Reg rm)
+    {
+        if (is_extended(reg) || is_extended(rm))
+            emit_rex(false, reg, rm);
+    }
+
+    void emit_modrm_register(Reg reg, Reg rm)
+    {
+        emit8(0xc0 | (encode_reg(reg) << 3) | encode_reg(rm));
+    }
+
+    // NOTE: We always use the [base + disp32] form, which needs a SIB byte when the base is RSP or R12.
+    void emit_modrm_memory(Reg reg, Reg base, i32 displacement)
+    {
+        emit8(0x80 | (encode_reg(reg) << 3) | encode_reg(base));
+        if (encode_reg(base) == encode_reg(Reg::RSP))
+            emit8(0x24);
+        emit32(static_cast<u32>(displacement));
+    }
+
+    // mov dst, imm64
+    void mov64(Reg dst, u64 immediate)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xb8 | encode_reg(dst));
+        emit64(immediate);
+    }
+
+    // mov dst, src
+    void mov64(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x89);
+        emit_modrm_register(src, dst);
+    }
+
+    // mov dst, [base + displacement]
+    void load64(Reg dst, Reg base, i32 displacement)
+    {
+        emit_rex(true, dst, base);
+        emit8(0x8b);
+        emit_modrm_memory(dst, base, displacement);
+    }
+
+    // mov dst, [base + index * 8 + displacement]
+    void load64(Reg dst, Reg base, Reg index, i32 displacement)
+    {
+        VERIFY(index != Reg::RSP);
+        emit8(0x48 | (is_extended(dst) ? 0x04 : 0) | (is_extended(index) ? 0x02 : 0) | (is_extended(base) ? 0x01 : 0));
+        emit8(0x8b);
+        emit8(0x84 | (encode_reg(dst) << 3));
+        emit8(0xc0 | (encode_reg(index) << 3) | encode_reg(base));
+        emit32(static_cast<u32>(displacement));
+    }
+
+    // mov dst32, [base + displacement]
+    void load32(Reg dst, Reg base, i32 displacement)
+    {
+        emit_rex_if_needed(dst, base);
+        emit8(0x8b);
+        emit_modrm_memory(dst, base, displacement);
+    }
+
+    // movzx dst32, byte [base + displacement]
+    void load8(Reg dst, Reg base, i32 displacement)
+    {
+        emit_rex_if_needed(dst, base);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_memory(dst, base, displacement);
+    }
+
+    // mov [base + displacement], src
+    void store64(Reg base, i32 displacement, Reg src)
+    {
+        emit_rex(true, src, base);
+        emit8(0x89);
+        emit_modrm_memory(src, base, displacement);
+    }
+
+    // mov qword [base + displacement], sign_extend(imm32)
+    void store64(Reg base, i32 displacement, i32 immediate)
+    {
+        emit_rex(true, Reg::RAX, base);
+        emit8(0xc7);
+        emit_modrm_memory(Reg::RAX, base, displacement);
+        emit32(static_cast<u32>(immediate));
+    }
+
+    // shl reg, imm8
+    void shift_left64(Reg reg, u8 immediate)
+    {
+        emit_rex(true, Reg::RAX, reg);
+        emit8(0xc1);
+        emit_modrm_register(static_cast<Reg>(4), reg);
+        emit8(immediate);
+    }
+
+    // shr reg, imm8
+    void shift_right64(Reg reg, u8 immediate)
+    {
+        emit_rex(true, Reg::RAX, reg);
+        emit8(0xc1);
+        emit_modrm_register(static_cast<Reg>(5), reg);
+        emit8(immediate);
+    }
+
+    // sar reg, imm8
+    void arithmetic_shift_right64(Reg reg, u8 immediate)
+    {
+        emit_rex(true, Reg::RAX, reg);
+        emit8(0xc1);
+        emit_modrm_register(static_cast<Reg>(7), reg);
+        emit8(immediate);
+    }
+
+    // and reg, sign_extend(imm32)
+    void bitwise_and64(Reg reg, i32 immediate)
+    {
+        emit_rex(true, Reg::RAX, reg);
+        emit8(0x81);
+        emit_modrm_register(static_cast<Reg>(4), reg);
+        emit32(static_cast<u32>(immediate));
+    }
+
+    // or dst, src
+    void bitwise_or64(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x09);
+        emit_modrm_register(src, dst);
+    }
+
+    // cmp reg, sign_extend(imm32)
+    void compare64(Reg reg, i32 immediate)
+    {
+        emit_rex(true, Reg::RAX, reg);
+        emit8(0x81);
+        emit_modrm_register(static_cast<Reg>(7), reg);
+        emit32(static_cast<u32>(immediate));
+    }
+
+    // cmp lhs, rhs
+    void compare64(Reg lhs, Reg rhs)
+    {
+        emit_rex(true, rhs, lhs);
+        emit8(0x39);
+        emit_modrm_register(rhs, lhs);
+    }
+
+    // cmp lhs32, rhs32
+    void compare32(Reg lhs, Reg rhs)
+    {
+        emit_rex_if_needed(rhs, lhs);
+        emit8(0x39);
+        emit_modrm_register(rhs, lhs);
+    }
+
+    // test reg, reg
+    void test64(Reg reg)
+    {
+        emit_rex(true, reg, reg);
+        emit8(0x85);
+        emit_modrm_register(reg, reg);
+    }
+
+    // add dst32, src32
+    void add32(Reg dst, Reg src)
+    {
+        emit_rex_if_needed(src, dst);
+        emit8(0x01);
+        emit_modrm_register(src, dst);
+    }
+
+    // sub dst32, src32
+    void sub32(Reg dst, Reg src)
+    {
+        emit_rex_if_needed(src, dst);
+        emit8(0x29);
+        emit_modrm_register(src, dst);
+    }
+
+    // add dst32, sign_extend(imm8)
+    void add32(Reg dst, i8 immediate)
+    {
+        emit_rex_if_needed(Reg::RAX, dst);
+        emit8(0x83);
+        emit_modrm_register(static_cast<Reg>(0), dst);
+        emit8(static_cast<u8>(immediate));
+    }
+
+    // sub dst32, sign_extend(imm8)
+    void sub32(Reg dst, i8 immediate)
+    {
+        emit_rex_if_needed(Reg::RAX, dst);
+        emit8(0x83);
+        emit_modrm_register(static_cast<Reg>(5), dst);
+        emit8(static_cast<u8>(immediate));
+    }
+
+    // setcc dst8; movzx dst32, dst8
+    void set_if(Condition condition, Reg dst)
+    {
+        // NOTE: Always emit a REX prefix so that we get SIL/DIL rather than AH/BH etc. for the byte registers.
+        emit_rex(false, Reg::RAX, dst);
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_register(Reg::RAX, dst);
+
+        emit_rex(false, dst, dst);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_register(dst, dst);
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit32(0xdeadbeef);
+        label.add_jump(*this, m_output.size());
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit32(0xdeadbeef);
+        label.add_jump(*this, m_output.size());
+    }
+
+    // jmp reg
+    void jump(Reg reg)
+    {
+        emit_rex_if_needed(Reg::RAX, reg);
+        emit8(0xff);
+        emit_modrm_register(static_cast<Reg>(4), reg);
+    }
+
+    // call reg
+    void call(Reg reg)
+    {
+        emit_rex_if_needed(Reg::RAX, reg);
+        emit8(0xff);
+        emit_modrm_register(static_cast<Reg>(2), reg);
+    }
+
+    void native_call(void* callee)
+    {
+        mov64(Reg::RAX, bit_cast<u64>(callee));
+        call(Reg::RAX);
+    }
+
+    void push(Reg reg)
+    {
+        if (is_extended(reg))
+            emit8(0x41);
+        emit8(0x50 | encode_reg(reg));
+    }
+
+    void pop(Reg reg)
+    {
+        if (is_extended(reg))
+            emit8(0x41);
+        emit8(0x58 | encode_reg(reg));
+    }
+
+    // sub rsp, imm8
+    void allocate_stack(u8 size)
+    {
+        emit_rex(true, Reg::RAX, Reg::RSP);
+        emit8(0x83);
+        emit_modrm_register(static_cast<Reg>(5), Reg::RSP);
+        emit8(size);
+    }
+
+    // add rsp, imm8
+    void free_stack(u8 size)
+    {
+        emit_rex(true, Reg::RAX, Reg::RSP);
+        emit8(0x83);
+        emit_modrm_register(static_cast<Reg>(0), Reg::RSP);
+        emit8(size);
+    }
+
+    void ret()
+    {
+        emit8(0xc3);
+    }
+};
+
+}
@@ -0,0 +1,792 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Platform.h>
+#include <LibJS/Bytecode/CommonImplementations.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+bool g_jit_enabled = getenv("LIBJS_JIT") != nullptr;
+
+// These are executed through their regular execute_impl() and only need the exception check around them.
+#define JS_ENUMERATE_GENERIC_JIT_OPS(O) \
+    O(AddPrivateName)                   \
+    O(ArrayAppend)                      \
+    O(AsyncIteratorClose)               \
+    O(BitwiseAnd)                       \
+    O(BitwiseNot)                       \
+    O(BitwiseOr)                        \
+    O(BitwiseXor)                       \
+    O(BlockDeclarationInstantiation)    \
+    O(Call)                             \
+    O(CallWithArgumentArray)            \
+    O(Catch)                            \
+    O(ConcatString)                     \
+    O(CopyObjectExcludingProperties)    \
+    O(CreateArguments)                  \
+    O(CreateLexicalEnvironment)         \
+    O(CreatePrivateEnvironment)         \
+    O(CreateRestParams)                 \
+    O(CreateVariable)                   \
+    O(CreateVariableEnvironment)        \
+    O(DeleteById)                       \
+    O(DeleteByIdWithThis)               \
+    O(DeleteByValue)                    \
+    O(DeleteByValueWithThis)            \
+    O(DeleteVariable)                   \
+    O(Div)                              \
+    O(Dump)                             \
+    O(EnterObjectEnvironment)           \
+    O(Exp)                              \
+    O(GetByIdWithThis)                  \
+    O(GetByValue)                       \
+    O(GetByValueWithThis)               \
+    O(GetCalleeAndThisFromEnvironment)  \
+    O(GetGlobal)                        \
+    O(GetImportMeta)                    \
+    O(GetIterator)                      \
+    O(GetLength)                        \
+    O(GetLengthWithThis)                \
+    O(GetMethod)                        \
+    O(GetNewTarget)                     \
+    O(GetNextMethodFromIteratorRecord)  \
+    O(GetObjectFromIteratorRecord)      \
+    O(GetObjectPropertyIterator)        \
+    O(GetPrivateById)                   \
+    O(GetBinding)                       \
+    O(HasPrivateId)                     \
+    O(ImportCall)                       \
+    O(In)                               \
+    O(InitializeLexicalBinding)         \
+    O(InitializeVariableBinding)        \
+    O(InstanceOf)                       \
+    O(IteratorClose)                    \
+    O(IteratorNext)                     \
+    O(IteratorToArray)                  \
+    O(LeaveFinally)                     \
+    O(LeaveLexicalEnvironment)          \
+    O(LeavePrivateEnvironment)          \
+    O(LeaveUnwindContext)               \
+    O(LeftShift)                        \
+    O(LooselyEquals)                    \
+    O(LooselyInequals)                  \
+    O(Mod)                              \
+    O(Mul)                              \
+    O(NewArray)                         \
+    O(NewClass)                         \
+    O(NewFunction)                      \
+    O(NewObject)                        \
+    O(NewPrimitiveArray)                \
+    O(NewRegExp)                        \
+    O(NewTypeError)                     \
+    O(Not)                              \
+    O(PrepareYield)                     \
+    O(PostfixDecrement)                 \
+    O(PostfixIncrement)                 \
+    O(PutByIdWithThis)                  \
+    O(PutByValue)                       \
+    O(PutByValueWithThis)               \
+    O(PutPrivateById)                   \
+    O(ResolveSuperBase)                 \
+    O(ResolveThisBinding)               \
+    O(RestoreScheduledJump)             \
+    O(RightShift)                       \
+    O(SetLexicalBinding)                \
+    O(SetVariableBinding)               \
+    O(StrictlyEquals)                   \
+    O(StrictlyInequals)                 \
+    O(SuperCallWithArgumentArray)       \
+    O(Throw)                            \
+    O(ThrowIfNotObject)                 \
+    O(ThrowIfNullish)                   \
+    O(ThrowIfTDZ)                       \
+    O(Typeof)                           \
+    O(TypeofVariable)                   \
+    O(UnaryMinus)                       \
+    O(UnaryPlus)                        \
+    O(UnsignedRightShift)
+
+Value Compiler::get(Bytecode::Interpreter& interpreter, Bytecode::Operand operand)
+{
+    return interpreter.m_registers_and_constants_and_locals.data()[operand.index()];
+}
+
+void* Compiler::address_after_exception(Bytecode::Interpreter& interpreter, NativeExecutable const& native_executable, Value exception)
+{
+    auto& program_counter = interpreter.m_program_counter.value();
+    if (interpreter.handle_exception(program_counter, exception) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return native_executable.exit_address();
+    return native_executable.address_for_bytecode_offset(program_counter);
+}
+
+template<typename OpType>
+void* Compiler::cxx_execute(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction, NativeExecutable const& native_executable)
+{
+    auto const& op = static_cast<OpType const&>(instruction);
+    if constexpr (IsSame<decltype(op.execute_impl(interpreter)), void>) {
+        op.execute_impl(interpreter);
+    } else {
+        auto result = op.execute_impl(interpreter);
+        if (result.is_error())
+            return address_after_exception(interpreter, native_executable, result.error_value());
+    }
+    return nullptr;
+}
+
+u64 Compiler::cxx_to_boolean(u64 encoded_value)
+{
+    return bit_cast<Value>(encoded_value).to_boolean();
+}
+
+void Compiler::cxx_put_direct(Object& object, u32 property_offset, u64 encoded_value)
+{
+    object.put_direct(property_offset, bit_cast<Value>(encoded_value));
+}
+
+void* Compiler::cxx_enter_unwind_context(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction, NativeExecutable const& native_executable)
+{
+    auto const& op = static_cast<Bytecode::Op::EnterUnwindContext const&>(instruction);
+    interpreter.enter_unwind_context();
+    return native_executable.address_for_bytecode_offset(op.entry_point().address());
+}
+
+void* Compiler::cxx_schedule_jump(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction, NativeExecutable const& native_executable)
+{
+    auto const& op = static_cast<Bytecode::Op::ScheduleJump const&>(instruction);
+    auto& program_counter = interpreter.m_program_counter.value();
+    interpreter.m_scheduled_jump = op.target().address();
+    auto finalizer = interpreter.current_executable().exception_handlers_for_offset(program_counter).value().finalizer_offset;
+    VERIFY(finalizer.has_value());
+    return native_executable.address_for_bytecode_offset(finalizer.value());
+}
+
+// NOTE: This mirrors the ContinuePendingUnwind handler in Interpreter::run_bytecode().
+void* Compiler::cxx_continue_pending_unwind(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction, NativeExecutable const& native_executable)
+{
+    auto const& op = static_cast<Bytecode::Op::ContinuePendingUnwind const&>(instruction);
+    auto& program_counter = interpreter.m_program_counter.value();
+    auto& running_execution_context = interpreter.running_execution_context();
+
+    if (auto exception = interpreter.reg(Bytecode::Register::exception()); !exception.is_empty())
+        return address_after_exception(interpreter, native_executable, exception);
+
+    if (!interpreter.saved_return_value().is_empty()) {
+        interpreter.do_return(interpreter.saved_return_value());
+        if (auto handlers = interpreter.current_executable().exception_handlers_for_offset(program_counter); handlers.has_value()) {
+            if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
+                VERIFY(!running_execution_context.unwind_contexts.is_empty());
+                auto& unwind_context = running_execution_context.unwind_contexts.last();
+                VERIFY(unwind_context.executable == interpreter.m_current_executable);
+                interpreter.reg(Bytecode::Register::saved_return_value()) = interpreter.reg(Bytecode::Register::return_value());
+                interpreter.reg(Bytecode::Register::return_value()) = {};
+                return native_executable.address_for_bytecode_offset(finalizer.value());
+            }
+        }
+        return native_executable.exit_address();
+    }
+
+    auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
+    if (interpreter.m_scheduled_jump.has_value()) {
+        auto target = interpreter.m_scheduled_jump.value();
+        interpreter.m_scheduled_jump = {};
+        return native_executable.address_for_bytecode_offset(target);
+    }
+    interpreter.m_scheduled_jump = old_scheduled_jump;
+    return native_executable.address_for_bytecode_offset(op.resume_target().address());
+}
+
+#define DEFINE_COMPARISON_JUMP_HELPER(op_TitleCase, op_snake_case, numeric_operator)                                                                   \
+    void* Compiler::cxx_jump_##op_snake_case(Bytecode::Interpreter& interpreter, Bytecode::Instruction const& instruction, NativeExecutable const& native_executable) \
+    {                                                                                                                                                  \
+        auto const& op = static_cast<Bytecode::Op::Jump##op_TitleCase const&>(instruction);                                                            \
+        using namespace Bytecode;                                                                                     \
+        auto result = op_snake_case(interpreter.vm(), get(interpreter, op.lhs()), get(interpreter, op.rhs()));                            \
+        if (result.is_error())                                                                                                                         \
+            return address_after_exception(interpreter, native_executable, result.error_value());                                                      \
+        if (result.value().to_boolean())                                                                                                               \
+            return native_executable.address_for_bytecode_offset(op.true_target().address());                                                          \
+        return native_executable.address_for_bytecode_offset(op.false_target().address());                                                             \
+    }
+JS_ENUMERATE_COMPARISON_OPS(DEFINE_COMPARISON_JUMP_HELPER)
+#undef DEFINE_COMPARISON_JUMP_HELPER
+
+void Compiler::load_vm_register(Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.load64(dst, REGISTER_ARRAY_BASE, operand.index() * sizeof(Value));
+}
+
+void Compiler::store_vm_register(Bytecode::Operand operand, Reg src)
+{
+    m_assembler.store64(REGISTER_ARRAY_BASE, operand.index() * sizeof(Value), src);
+}
+
+void Compiler::jump_to_bytecode_offset(size_t offset)
+{
+    m_assembler.jump(m_labels.ensure(offset));
+}
+
+void Compiler::jump_to_bytecode_offset_if(Assembler::Condition condition, size_t offset)
+{
+    m_assembler.jump_if(condition, m_labels.ensure(offset));
+}
+
+void Compiler::branch_if_not_int32(Reg reg, Assembler::Label& label)
+{
+    m_assembler.mov64(GPR2, reg);
+    m_assembler.shift_right64(GPR2, TAG_SHIFT);
+    m_assembler.compare64(GPR2, INT32_TAG);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, label);
+}
+
+void Compiler::box_int32(Reg reg)
+{
+    // NOTE: The 32-bit operation that produced the value has already cleared the upper half of the register.
+    m_assembler.mov64(GPR2, SHIFTED_INT32_TAG);
+    m_assembler.bitwise_or64(reg, GPR2);
+}
+
+void Compiler::box_boolean(Reg reg)
+{
+    m_assembler.mov64(GPR2, SHIFTED_BOOLEAN_TAG);
+    m_assembler.bitwise_or64(reg, GPR2);
+}
+
+void Compiler::branch_if_not_object(Reg reg, Assembler::Label& label)
+{
+    m_assembler.mov64(GPR2, reg);
+    m_assembler.shift_right64(GPR2, TAG_SHIFT);
+    m_assembler.compare64(GPR2, OBJECT_TAG);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, label);
+}
+
+// NOTE: This mirrors Value::extract_pointer_bits() on x86-64.
+void Compiler::extract_object_pointer(Reg reg)
+{
+    m_assembler.shift_left64(reg, 16);
+    m_assembler.arithmetic_shift_right64(reg, 16);
+}
+
+// Jumps to `miss` unless one of the cache's entries is for the object's shape, in which case GPR2 points to that entry.
+// NOTE: The cache is only read here, so it keeps being filled (and cleared) by the C++ slow path.
+void Compiler::emit_cached_shape_lookup(Reg object, Bytecode::PropertyLookupCache& cache, Assembler::Label& miss)
+{
+    static_assert(sizeof(GCPtr<Shape>) == sizeof(Shape*));
+    static_assert(sizeof(WeakPtr<Shape>) == sizeof(AK::WeakLink*));
+
+    Assembler::Label hit;
+
+    m_assembler.load64(GPR1, object, Object::shape_offset());
+
+    // NOTE: Unused entries have no weak link, and the link of an entry whose shape has been garbage collected points
+    //       nowhere, so neither can match a live object's shape.
+    for (auto& entry : cache.entries) {
+        Assembler::Label next_entry;
+        m_assembler.mov64(GPR2, bit_cast<u64>(&entry));
+        m_assembler.load64(GPR3, GPR2, __builtin_offsetof(Bytecode::PropertyLookupCache::Entry, shape));
+        m_assembler.test64(GPR3);
+        m_assembler.jump_if(Assembler::Condition::EqualTo, next_entry);
+        m_assembler.load64(GPR3, GPR3, AK::WeakLink::ptr_offset());
+        m_assembler.compare64(GPR3, GPR1);
+        m_assembler.jump_if(Assembler::Condition::EqualTo, hit);
+        next_entry.link(m_assembler);
+    }
+    m_assembler.jump(miss);
+
+    hit.link(m_assembler);
+}
+
+void Compiler::emit_helper_call(Helper helper, Bytecode::Instruction const& instruction, HelperResult result)
+{
+    // Keep the interpreter's program counter up to date, it's used for exception handling and source locations.
+    m_assembler.store64(PROGRAM_COUNTER, 0, static_cast<i32>(m_current_bytecode_offset));
+
+    m_assembler.mov64(ARG0, INTERPRETER);
+    m_assembler.mov64(ARG1, bit_cast<u64>(&instruction));
+    m_assembler.mov64(ARG2, NATIVE_EXECUTABLE);
+    m_assembler.native_call(bit_cast<void*>(helper));
+
+    if (result == HelperResult::AlwaysJumps) {
+        m_assembler.jump(GPR0);
+        return;
+    }
+
+    Assembler::Label continue_label;
+    m_assembler.test64(GPR0);
+    m_assembler.jump_if(Assembler::Condition::EqualTo, continue_label);
+    m_assembler.jump(GPR0);
+    continue_label.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_generic(OpType const& op)
+{
+    emit_helper_call(&cxx_execute<OpType>, op, HelperResult::MayContinue);
+}
+
+void Compiler::compile_mov(Bytecode::Op::Mov const& op)
+{
+    load_vm_register(GPR0, op.src());
+    store_vm_register(op.dst(), GPR0);
+}
+
+void Compiler::compile_get_argument(Bytecode::Op::GetArgument const& op)
+{
+    m_assembler.load64(GPR0, ARGUMENTS_BASE, op.index() * sizeof(Value));
+    store_vm_register(op.dst(), GPR0);
+}
+
+void Compiler::compile_set_argument(Bytecode::Op::SetArgument const& op)
+{
+    load_vm_register(GPR0, op.src());
+    m_assembler.store64(ARGUMENTS_BASE, op.index() * sizeof(Value), GPR0);
+}
+
+void Compiler::compile_end(Bytecode::Op::End const& op)
+{
+    load_vm_register(GPR0, op.value());
+    store_vm_register(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+    m_assembler.jump(m_exit_label);
+}
+
+void Compiler::compile_jump(Bytecode::Op::Jump const& op)
+{
+    jump_to_bytecode_offset(op.target().address());
+}
+
+void Compiler::compile_to_boolean_jump(Bytecode::Instruction const&, Bytecode::Operand condition, Optional<size_t> true_target, Optional<size_t> false_target)
+{
+    Assembler::Label slow_case;
+    Assembler::Label have_result;
+
+    load_vm_register(GPR0, condition);
+
+    // OPTIMIZATION: Booleans can be tested directly, everything else goes through Value::to_boolean().
+    m_assembler.mov64(GPR2, GPR0);
+    m_assembler.shift_right64(GPR2, TAG_SHIFT);
+    m_assembler.compare64(GPR2, BOOLEAN_TAG);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, slow_case);
+    m_assembler.bitwise_and64(GPR0, 1);
+    m_assembler.jump(have_result);
+
+    slow_case.link(m_assembler);
+    m_assembler.mov64(ARG0, GPR0);
+    m_assembler.native_call(bit_cast<void*>(&cxx_to_boolean));
+    m_assembler.test64(GPR0);
+
+    // At this point, the zero flag is clear if the condition was truthy.
+    have_result.link(m_assembler);
+    if (true_target.has_value())
+        jump_to_bytecode_offset_if(Assembler::Condition::NotEqualTo, true_target.value());
+    if (false_target.has_value()) {
+        if (true_target.has_value())
+            jump_to_bytecode_offset(false_target.value());
+        else
+            jump_to_bytecode_offset_if(Assembler::Condition::EqualTo, false_target.value());
+    }
+}
+
+void Compiler::compile_jump_nullish(Bytecode::Op::JumpNullish const& op)
+{
+    load_vm_register(GPR0, op.condition());
+    m_assembler.shift_right64(GPR0, TAG_SHIFT);
+    m_assembler.bitwise_and64(GPR0, IS_NULLISH_EXTRACT_PATTERN);
+    m_assembler.compare64(GPR0, IS_NULLISH_PATTERN);
+    jump_to_bytecode_offset_if(Assembler::Condition::EqualTo, op.true_target().address());
+    jump_to_bytecode_offset(op.false_target().address());
+}
+
+void Compiler::compile_jump_undefined(Bytecode::Op::JumpUndefined const& op)
+{
+    load_vm_register(GPR0, op.condition());
+    m_assembler.shift_right64(GPR0, TAG_SHIFT);
+    m_assembler.compare64(GPR0, UNDEFINED_TAG);
+    jump_to_bytecode_offset_if(Assembler::Condition::EqualTo, op.true_target().address());
+    jump_to_bytecode_offset(op.false_target().address());
+}
+
+void Compiler::compile_get_by_id(Bytecode::Op::GetById const& op)
+{
+    // NOTE: The statistics are only kept by the C++ implementation.
+    if constexpr (PROPERTY_LOOKUP_CACHE_DEBUG) {
+        compile_generic(op);
+        return;
+    }
+
+    using Entry = Bytecode::PropertyLookupCache::Entry;
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_register(GPR0, op.base());
+    branch_if_not_object(GPR0, slow_case);
+    extract_object_pointer(GPR0);
+    emit_cached_shape_lookup(GPR0, m_bytecode_executable.property_lookup_caches[op.cache_index()], slow_case);
+
+    // Properties found in the prototype chain need its validity checked first, which is left to C++.
+    m_assembler.load64(GPR3, GPR2, __builtin_offsetof(Entry, prototype));
+    m_assembler.test64(GPR3);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, slow_case);
+
+    // NOTE: Own property entries always have an offset, which is stored at the start of the Optional.
+    m_assembler.load32(GPR3, GPR2, __builtin_offsetof(Entry, property_offset));
+    m_assembler.load64(GPR0, GPR0, Object::storage_offset() + Vector<Value>::outline_buffer_offset());
+    m_assembler.load64(GPR0, GPR0, GPR3, 0);
+    store_vm_register(op.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+void Compiler::compile_put_by_id(Bytecode::Op::PutById const& op)
+{
+    if (op.kind() != Bytecode::Op::PropertyKind::KeyValue || PROPERTY_LOOKUP_CACHE_DEBUG) {
+        compile_generic(op);
+        return;
+    }
+
+    using Entry = Bytecode::PropertyLookupCache::Entry;
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_register(GPR0, op.base());
+    branch_if_not_object(GPR0, slow_case);
+    extract_object_pointer(GPR0);
+    emit_cached_shape_lookup(GPR0, m_bytecode_executable.property_lookup_caches[op.cache_index()], slow_case);
+
+    // Replaying a put transition takes a lot more checks, so that's left to C++.
+    m_assembler.load8(GPR3, GPR2, __builtin_offsetof(Entry, is_transition));
+    m_assembler.test64(GPR3);
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, slow_case);
+
+    // NOTE: The store itself goes through C++ as well, since it needs a write barrier.
+    m_assembler.load32(ARG1, GPR2, __builtin_offsetof(Entry, property_offset));
+    m_assembler.mov64(ARG0, GPR0);
+    load_vm_register(ARG2, op.src());
+    m_assembler.native_call(bit_cast<void*>(&cxx_put_direct));
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_arithmetic(OpType const& op, bool is_add)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_register(GPR0, op.lhs());
+    load_vm_register(GPR1, op.rhs());
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    if (is_add)
+        m_assembler.add32(GPR0, GPR1);
+    else
+        m_assembler.sub32(GPR0, GPR1);
+    m_assembler.jump_if(Assembler::Condition::Overflow, slow_case);
+    box_int32(GPR0);
+    store_vm_register(op.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison(OpType const& op, Assembler::Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_register(GPR0, op.lhs());
+    load_vm_register(GPR1, op.rhs());
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    m_assembler.compare32(GPR0, GPR1);
+    m_assembler.set_if(condition, GPR0);
+    box_boolean(GPR0);
+    store_vm_register(op.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison_jump(OpType const& op, Assembler::Condition condition, Helper slow_case_helper)
+{
+    Assembler::Label slow_case;
+
+    load_vm_register(GPR0, op.lhs());
+    load_vm_register(GPR1, op.rhs());
+    branch_if_not_int32(GPR0, slow_case);
+    branch_if_not_int32(GPR1, slow_case);
+    m_assembler.compare32(GPR0, GPR1);
+    jump_to_bytecode_offset_if(condition, op.true_target().address());
+    jump_to_bytecode_offset(op.false_target().address());
+
+    slow_case.link(m_assembler);
+    emit_helper_call(slow_case_helper, op, HelperResult::AlwaysJumps);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_increment_or_decrement(OpType const& op, bool is_increment)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_register(GPR0, op.dst());
+    branch_if_not_int32(GPR0, slow_case);
+    if (is_increment)
+        m_assembler.add32(GPR0, static_cast<i8>(1));
+    else
+        m_assembler.sub32(GPR0, static_cast<i8>(1));
+    m_assembler.jump_if(Assembler::Condition::Overflow, slow_case);
+    box_int32(GPR0);
+    store_vm_register(op.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+void Compiler::emit_prologue()
+{
+    m_assembler.push(Reg::RBP);
+    m_assembler.mov64(Reg::RBP, Reg::RSP);
+    m_assembler.push(INTERPRETER);
+    m_assembler.push(REGISTER_ARRAY_BASE);
+    m_assembler.push(NATIVE_EXECUTABLE);
+    m_assembler.push(PROGRAM_COUNTER);
+    m_assembler.push(ARGUMENTS_BASE);
+    // NOTE: Keep the stack 16-byte aligned for the calls we make into C++.
+    m_assembler.allocate_stack(8);
+
+    m_assembler.mov64(INTERPRETER, ARG0);
+    m_assembler.mov64(REGISTER_ARRAY_BASE, ARG1);
+    m_assembler.mov64(NATIVE_EXECUTABLE, ARG2);
+    m_assembler.mov64(PROGRAM_COUNTER, ARG3);
+    m_assembler.mov64(ARGUMENTS_BASE, ARG4);
+    m_assembler.jump(ARG5);
+}
+
+void Compiler::emit_epilogue()
+{
+    m_exit_label.link(m_assembler);
+    m_assembler.free_stack(8);
+    m_assembler.pop(ARGUMENTS_BASE);
+    m_assembler.pop(PROGRAM_COUNTER);
+    m_assembler.pop(NATIVE_EXECUTABLE);
+    m_assembler.pop(REGISTER_ARRAY_BASE);
+    m_assembler.pop(INTERPRETER);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+}
+
+bool Compiler::compile_bytecode()
+{
+    emit_prologue();
+
+    Bytecode::InstructionStreamIterator it(m_bytecode_executable.bytecode, &m_bytecode_executable);
+    while (!it.at_end()) {
+        m_current_bytecode_offset = it.offset();
+        m_labels.ensure(m_current_bytecode_offset).link(m_assembler);
+
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+        case Bytecode::Instruction::Type::Mov:
+            compile_mov(static_cast<Bytecode::Op::Mov const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::GetArgument:
+            compile_get_argument(static_cast<Bytecode::Op::GetArgument const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::SetArgument:
+            compile_set_argument(static_cast<Bytecode::Op::SetArgument const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::End:
+            compile_end(static_cast<Bytecode::Op::End const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::Jump:
+            compile_jump(static_cast<Bytecode::Op::Jump const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::JumpIf: {
+            auto const& op = static_cast<Bytecode::Op::JumpIf const&>(instruction);
+            compile_to_boolean_jump(op, op.condition(), op.true_target().address(), op.false_target().address());
+            break;
+        }
+        case Bytecode::Instruction::Type::JumpTrue: {
+            auto const& op = static_cast<Bytecode::Op::JumpTrue const&>(instruction);
+            compile_to_boolean_jump(op, op.condition(), op.target().address(), {});
+            break;
+        }
+        case Bytecode::Instruction::Type::JumpFalse: {
+            auto const& op = static_cast<Bytecode::Op::JumpFalse const&>(instruction);
+            compile_to_boolean_jump(op, op.condition(), {}, op.target().address());
+            break;
+        }
+        case Bytecode::Instruction::Type::JumpNullish:
+            compile_jump_nullish(static_cast<Bytecode::Op::JumpNullish const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::JumpUndefined:
+            compile_jump_undefined(static_cast<Bytecode::Op::JumpUndefined const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::JumpLessThan:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpLessThan const&>(instruction), Assembler::Condition::SignedLessThan, &cxx_jump_less_than);
+            break;
+        case Bytecode::Instruction::Type::JumpLessThanEquals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpLessThanEquals const&>(instruction), Assembler::Condition::SignedLessThanOrEqualTo, &cxx_jump_less_than_equals);
+            break;
+        case Bytecode::Instruction::Type::JumpGreaterThan:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpGreaterThan const&>(instruction), Assembler::Condition::SignedGreaterThan, &cxx_jump_greater_than);
+            break;
+        case Bytecode::Instruction::Type::JumpGreaterThanEquals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpGreaterThanEquals const&>(instruction), Assembler::Condition::SignedGreaterThanOrEqualTo, &cxx_jump_greater_than_equals);
+            break;
+        case Bytecode::Instruction::Type::JumpLooselyEquals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpLooselyEquals const&>(instruction), Assembler::Condition::EqualTo, &cxx_jump_loosely_equals);
+            break;
+        case Bytecode::Instruction::Type::JumpLooselyInequals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpLooselyInequals const&>(instruction), Assembler::Condition::NotEqualTo, &cxx_jump_loosely_inequals);
+            break;
+        case Bytecode::Instruction::Type::JumpStrictlyEquals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpStrictlyEquals const&>(instruction), Assembler::Condition::EqualTo, &cxx_jump_strict_equals);
+            break;
+        case Bytecode::Instruction::Type::JumpStrictlyInequals:
+            compile_int32_comparison_jump(static_cast<Bytecode::Op::JumpStrictlyInequals const&>(instruction), Assembler::Condition::NotEqualTo, &cxx_jump_strict_inequals);
+            break;
+        case Bytecode::Instruction::Type::GetById:
+            compile_get_by_id(static_cast<Bytecode::Op::GetById const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::PutById:
+            compile_put_by_id(static_cast<Bytecode::Op::PutById const&>(instruction));
+            break;
+        case Bytecode::Instruction::Type::Add:
+            compile_int32_arithmetic(static_cast<Bytecode::Op::Add const&>(instruction), true);
+            break;
+        case Bytecode::Instruction::Type::Sub:
+            compile_int32_arithmetic(static_cast<Bytecode::Op::Sub const&>(instruction), false);
+            break;
+        case Bytecode::Instruction::Type::LessThan:
+            compile_int32_comparison(static_cast<Bytecode::Op::LessThan const&>(instruction), Assembler::Condition::SignedLessThan);
+            break;
+        case Bytecode::Instruction::Type::LessThanEquals:
+            compile_int32_comparison(static_cast<Bytecode::Op::LessThanEquals const&>(instruction), Assembler::Condition::SignedLessThanOrEqualTo);
+            break;
+        case Bytecode::Instruction::Type::GreaterThan:
+            compile_int32_comparison(static_cast<Bytecode::Op::GreaterThan const&>(instruction), Assembler::Condition::SignedGreaterThan);
+            break;
+        case Bytecode::Instruction::Type::GreaterThanEquals:
+            compile_int32_comparison(static_cast<Bytecode::Op::GreaterThanEquals const&>(instruction), Assembler::Condition::SignedGreaterThanOrEqualTo);
+            break;
+        case Bytecode::Instruction::Type::Increment:
+            compile_int32_increment_or_decrement(static_cast<Bytecode::Op::Increment const&>(instruction), true);
+            break;
+        case Bytecode::Instruction::Type::Decrement:
+            compile_int32_increment_or_decrement(static_cast<Bytecode::Op::Decrement const&>(instruction), false);
+            break;
+        case Bytecode::Instruction::Type::EnterUnwindContext:
+            emit_helper_call(&cxx_enter_unwind_context, instruction, HelperResult::AlwaysJumps);
+            break;
+        case Bytecode::Instruction::Type::ScheduleJump:
+            emit_helper_call(&cxx_schedule_jump, instruction, HelperResult::AlwaysJumps);
+            break;
+        case Bytecode::Instruction::Type::ContinuePendingUnwind:
+            emit_helper_call(&cxx_continue_pending_unwind, instruction, HelperResult::AlwaysJumps);
+            break;
+        case Bytecode::Instruction::Type::Return:
+            compile_generic(static_cast<Bytecode::Op::Return const&>(instruction));
+            m_assembler.jump(m_exit_label);
+            break;
+        case Bytecode::Instruction::Type::Await:
+            compile_generic(static_cast<Bytecode::Op::Await const&>(instruction));
+            m_assembler.jump(m_exit_label);
+            break;
+        case Bytecode::Instruction::Type::Yield:
+            compile_generic(static_cast<Bytecode::Op::Yield const&>(instruction));
+            m_assembler.jump(m_exit_label);
+            break;
+
+#define CASE_GENERIC_OP(name)                                               \
+    case Bytecode::Instruction::Type::name:                                 \
+        compile_generic(static_cast<Bytecode::Op::name const&>(instruction)); \
+        break;
+            JS_ENUMERATE_GENERIC_JIT_OPS(CASE_GENERIC_OP)
+#undef CASE_GENERIC_OP
+
+        default:
+            dbgln_if(JS_BYTECODE_DEBUG, "JIT: Unsupported instruction {}, staying in the interpreter", instruction.to_byte_string(m_bytecode_executable));
+            return false;
+        }
+
+        ++it;
+    }
+
+    emit_epilogue();
+
+    // Every jump target must have turned out to be the start of an instruction.
+    for (auto& it : m_labels) {
+        if (!it.value.offset_of_label_in_instruction_stream.has_value())
+            return false;
+    }
+
+    return true;
+}
+
+OwnPtr<NativeExecutable> Compiler::finish()
+{
+    auto size = m_output.size();
+    auto* code = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("JIT: Failed to allocate memory for native code: {}", strerror(errno));
+        return nullptr;
+    }
+
+    memcpy(code, m_output.data(), size);
+
+    if (mprotect(code, size, PROT_READ | PROT_EXEC) < 0) {
+        dbgln("JIT: Failed to make native code executable: {}", strerror(errno));
+        munmap(code, size);
+        return nullptr;
+    }
+
+    HashMap<size_t, size_t> native_offsets_for_bytecode_offsets;
+    for (auto& it : m_labels)
+        native_offsets_for_bytecode_offsets.set(it.key, it.value.offset_of_label_in_instruction_stream.value());
+
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled {} bytes of bytecode into {} bytes of native code", m_bytecode_executable.bytecode.size(), size);
+
+    return make<NativeExecutable>(code, size, move(native_offsets_for_bytecode_offsets), m_exit_label.offset_of_label_in_instruction_stream.value());
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& bytecode_executable)
+{
+    if (!g_jit_enabled)
+        return nullptr;
+
+#if ARCH(X86_64)
+    Compiler compiler { bytecode_executable };
+    if (!compiler.compile_bytecode())
+        return nullptr;
+    return compiler.finish();
+#else
+    (void)bytecode_executable;
+    return nullptr;
+#endif
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Assembler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+extern bool g_jit_enabled;
+
+class Compiler {
+public:
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    using Reg = Assembler::Reg;
+
+    static constexpr auto GPR0 = Reg::RAX;
+    static constexpr auto GPR1 = Reg::RCX;
+    static constexpr auto GPR2 = Reg::RDX;
+    static constexpr auto GPR3 = Reg::R10;
+    static constexpr auto ARG0 = Reg::RDI;
+    static constexpr auto ARG1 = Reg::RSI;
+    static constexpr auto ARG2 = Reg::RDX;
+    static constexpr auto ARG3 = Reg::RCX;
+    static constexpr auto ARG4 = Reg::R8;
+    static constexpr auto ARG5 = Reg::R9;
+
+    // These are callee-saved, so they survive calls into C++ helpers.
+    static constexpr auto INTERPRETER = Reg::RBX;
+    static constexpr auto REGISTER_ARRAY_BASE = Reg::R12;
+    static constexpr auto NATIVE_EXECUTABLE = Reg::R13;
+    static constexpr auto PROGRAM_COUNTER = Reg::R14;
+    static constexpr auto ARGUMENTS_BASE = Reg::R15;
+
+    // A helper returns nullptr to continue with the next instruction, or the native address to continue at.
+    using Helper = void* (*)(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+
+    enum class HelperResult {
+        MayContinue,
+        AlwaysJumps,
+    };
+
+    explicit Compiler(Bytecode::Executable& bytecode_executable)
+        : m_bytecode_executable(bytecode_executable)
+    {
+    }
+
+    [[nodiscard]] bool compile_bytecode();
+    [[nodiscard]] OwnPtr<NativeExecutable> finish();
+
+    void emit_prologue();
+    void emit_epilogue();
+
+    void load_vm_register(Reg dst, Bytecode::Operand);
+    void store_vm_register(Bytecode::Operand, Reg src);
+
+    void jump_to_bytecode_offset(size_t);
+    void jump_to_bytecode_offset_if(Assembler::Condition, size_t);
+    void branch_if_not_int32(Reg, Assembler::Label&);
+    void box_int32(Reg);
+    void box_boolean(Reg);
+    void branch_if_not_object(Reg, Assembler::Label&);
+    void extract_object_pointer(Reg);
+    void emit_cached_shape_lookup(Reg object, Bytecode::PropertyLookupCache&, Assembler::Label& miss);
+
+    void emit_helper_call(Helper, Bytecode::Instruction const&, HelperResult);
+
+    template<typename OpType>
+    void compile_generic(OpType const&);
+
+    void compile_mov(Bytecode::Op::Mov const&);
+    void compile_get_argument(Bytecode::Op::GetArgument const&);
+    void compile_set_argument(Bytecode::Op::SetArgument const&);
+    void compile_end(Bytecode::Op::End const&);
+    void compile_jump(Bytecode::Op::Jump const&);
+    void compile_to_boolean_jump(Bytecode::Instruction const&, Bytecode::Operand condition, Optional<size_t> true_target, Optional<size_t> false_target);
+    void compile_jump_nullish(Bytecode::Op::JumpNullish const&);
+    void compile_jump_undefined(Bytecode::Op::JumpUndefined const&);
+    void compile_get_by_id(Bytecode::Op::GetById const&);
+    void compile_put_by_id(Bytecode::Op::PutById const&);
+
+    template<typename OpType>
+    void compile_int32_arithmetic(OpType const&, bool is_add);
+    template<typename OpType>
+    void compile_int32_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_int32_comparison_jump(OpType const&, Assembler::Condition, Helper);
+    template<typename OpType>
+    void compile_int32_increment_or_decrement(OpType const&, bool is_increment);
+
+    static Value get(Bytecode::Interpreter&, Bytecode::Operand);
+    static void* address_after_exception(Bytecode::Interpreter&, NativeExecutable const&, Value exception);
+
+    template<typename OpType>
+    static void* cxx_execute(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+    static u64 cxx_to_boolean(u64 encoded_value);
+    static void cxx_put_direct(Object&, u32 property_offset, u64 encoded_value);
+    static void* cxx_enter_unwind_context(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+    static void* cxx_schedule_jump(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+    static void* cxx_continue_pending_unwind(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+
+#define DECLARE_COMPARISON_JUMP_HELPER(op_TitleCase, op_snake_case, numeric_operator) \
+    static void* cxx_jump_##op_snake_case(Bytecode::Interpreter&, Bytecode::Instruction const&, NativeExecutable const&);
+    JS_ENUMERATE_COMPARISON_OPS(DECLARE_COMPARISON_JUMP_HELPER)
+#undef DECLARE_COMPARISON_JUMP_HELPER
+
+    Bytecode::Executable& m_bytecode_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    HashMap<size_t, Assembler::Label> m_labels;
+    Assembler::Label m_exit_label;
+    size_t m_current_bytecode_offset { 0 };
+};
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/TemporaryChange.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Error.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets_for_bytecode_offsets, size_t exit_offset)
+    : m_code(code)
+    , m_size(size)
+    , m_native_offsets_for_bytecode_offsets(move(native_offsets_for_bytecode_offsets))
+    , m_exit_offset(exit_offset)
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_size);
+}
+
+void* NativeExecutable::address_for_bytecode_offset(size_t offset) const
+{
+    auto native_offset = m_native_offsets_for_bytecode_offsets.get(offset);
+    VERIFY(native_offset.has_value());
+    return static_cast<u8*>(m_code) + native_offset.value();
+}
+
+void NativeExecutable::run(Bytecode::Interpreter& interpreter, size_t entry_point) const
+{
+    auto& vm = interpreter.vm();
+    if (vm.did_reach_stack_space_limit()) {
+        interpreter.reg(Bytecode::Register::exception()) = vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded).release_value().value();
+        return;
+    }
+
+    size_t program_counter = entry_point;
+    TemporaryChange change(interpreter.m_program_counter, Optional<size_t&>(program_counter));
+
+    using EntryFunction = void (*)(Bytecode::Interpreter*, Value* registers_and_constants_and_locals, NativeExecutable const*, size_t* program_counter, Value* arguments, void* entry_address);
+    auto entry = bit_cast<EntryFunction>(m_code);
+    entry(&interpreter,
+        interpreter.m_registers_and_constants_and_locals.data(),
+        this,
+        &program_counter,
+        interpreter.m_arguments.data(),
+        address_for_bytecode_offset(entry_point));
+}
+
+}
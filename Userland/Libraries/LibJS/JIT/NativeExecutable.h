@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets_for_bytecode_offsets, size_t exit_offset);
+    ~NativeExecutable();
+
+    void run(Bytecode::Interpreter&, size_t entry_point) const;
+
+    [[nodiscard]] void* address_for_bytecode_offset(size_t) const;
+    [[nodiscard]] void* exit_address() const { return static_cast<u8*>(m_code) + m_exit_offset; }
+
+    size_t size() const { return m_size; }
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets_for_bytecode_offsets;
+    size_t m_exit_offset { 0 };
+};
+
+}
@@ -16,6 +16,7 @@ namespace JS {
 class Accessor final : public Cell {
     JS_CELL(Accessor, Cell);
     JS_DECLARE_ALLOCATOR(Accessor);
+    JS_DECLARE_WRITE_BARRIERS(Accessor);
 
 public:
     static NonnullGCPtr<Accessor> create(VM& vm, FunctionObject* getter, FunctionObject* setter)
@@ -24,10 +25,18 @@ public:
     }
 
     FunctionObject* getter() const { return m_getter; }
-    void set_getter(FunctionObject* getter) { m_getter = getter; }
+    void set_getter(FunctionObject* getter)
+    {
+        write_barrier();
+        m_getter = getter;
+    }
 
     FunctionObject* setter() const { return m_setter; }
-    void set_setter(FunctionObject* setter) { m_setter = setter; }
+    void set_setter(FunctionObject* setter)
+    {
+        write_barrier();
+        m_setter = setter;
+    }
 
     void visit_edges(Cell::Visitor& visitor) override
     {
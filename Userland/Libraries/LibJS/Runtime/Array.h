@@ -22,6 +22,7 @@ namespace JS {
 class Array : public Object {
     JS_OBJECT(Array, Object);
     JS_DECLARE_ALLOCATOR(Array);
+    JS_DECLARE_WRITE_BARRIERS(Array);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<Array>> create(Realm&, u64 length, Object* prototype = nullptr);
@@ -46,6 +47,7 @@ public:
     virtual ThrowCompletionOr<bool> internal_define_own_property(PropertyKey const&, PropertyDescriptor const&) override final;
     virtual ThrowCompletionOr<bool> internal_delete(PropertyKey const&) override;
     virtual ThrowCompletionOr<MarkedVector<Value>> internal_own_property_keys() const override final;
+    virtual bool has_exotic_property_access() const override { return true; }
 
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; }
 
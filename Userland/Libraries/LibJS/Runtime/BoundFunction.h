@@ -14,6 +14,7 @@ namespace JS {
 class BoundFunction final : public FunctionObject {
     JS_OBJECT(BoundFunction, FunctionObject);
     JS_DECLARE_ALLOCATOR(BoundFunction);
+    JS_DECLARE_WRITE_BARRIERS(BoundFunction);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<BoundFunction>> create(Realm&, FunctionObject& target_function, Value bound_this, Vector<Value> bound_arguments);
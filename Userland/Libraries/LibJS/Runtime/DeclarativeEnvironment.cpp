@@ -125,6 +125,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::initialize_binding_direct(VM& vm
         TRY(add_disposable_resource(vm, m_disposable_resource_stack, value, hint));
 
     // 3. Set the bound value for N in envRec to V.
+    write_barrier();
     binding.value = value;
 
     // 4. Record that the binding for N in envRec has been initialized.
@@ -175,6 +176,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::set_mutable_binding_direct(VM& v
         return vm.throw_completion<ReferenceError>(ErrorType::BindingNotInitialized, binding.name);
 
     if (binding.mutable_) {
+        write_barrier();
         binding.value = value;
     } else {
         if (strict)
@@ -18,6 +18,7 @@ namespace JS {
 class DeclarativeEnvironment : public Environment {
     JS_ENVIRONMENT(DeclarativeEnvironment, Environment);
     JS_DECLARE_ALLOCATOR(DeclarativeEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(DeclarativeEnvironment);
 
     struct Binding {
         DeprecatedFlyString name;
@@ -564,6 +564,7 @@ void ECMAScriptFunctionObject::visit_edges(Visitor& visitor)
 void ECMAScriptFunctionObject::make_method(Object& home_object)
 {
     // 1. Set F.[[HomeObject]] to homeObject.
+    write_barrier();
     m_home_object = &home_object;
 
     // 2. Return unused.
@@ -831,6 +832,7 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
                 const_cast<Statement&>(*m_ecmascript_code).set_bytecode_executable(TRY(Bytecode::compile(vm, *this)));
             }
         }
+        write_barrier();
         m_bytecode_executable = m_ecmascript_code->bytecode_executable();
     }
 
@@ -868,7 +870,9 @@ void ECMAScriptFunctionObject::set_name(DeprecatedFlyString const& name)
 {
     auto& vm = this->vm();
     m_name = name;
-    m_name_string = PrimitiveString::create(vm, m_name);
+    auto name_string = PrimitiveString::create(vm, m_name);
+    write_barrier();
+    m_name_string = name_string;
     MUST(define_property_or_throw(vm.names.name, { .value = m_name_string, .writable = false, .enumerable = false, .configurable = true }));
 }
 }
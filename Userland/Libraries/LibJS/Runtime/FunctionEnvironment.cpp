@@ -89,6 +89,7 @@ ThrowCompletionOr<Value> FunctionEnvironment::bind_this_value(VM& vm, Value this
         return vm.throw_completion<ReferenceError>(ErrorType::ThisIsAlreadyInitialized);
 
     // 3. Set envRec.[[ThisValue]] to V.
+    write_barrier();
     m_this_value = this_value;
 
     // 4. Set envRec.[[ThisBindingStatus]] to initialized.
@@ -14,6 +14,7 @@ namespace JS {
 class FunctionEnvironment final : public DeclarativeEnvironment {
     JS_ENVIRONMENT(FunctionEnvironment, DeclarativeEnvironment);
     JS_DECLARE_ALLOCATOR(FunctionEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(FunctionEnvironment);
 
 public:
     enum class ThisBindingStatus : u8 {
@@ -29,12 +30,17 @@ public:
 
     ECMAScriptFunctionObject& function_object() { return *m_function_object; }
     ECMAScriptFunctionObject const& function_object() const { return *m_function_object; }
-    void set_function_object(ECMAScriptFunctionObject& function) { m_function_object = &function; }
+    void set_function_object(ECMAScriptFunctionObject& function)
+    {
+        write_barrier();
+        m_function_object = &function;
+    }
 
     Value new_target() const { return m_new_target; }
     void set_new_target(Value new_target)
     {
         VERIFY(!new_target.is_empty());
+        write_barrier();
         m_new_target = new_target;
     }
 
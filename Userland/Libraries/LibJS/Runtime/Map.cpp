@@ -64,6 +64,7 @@ bool Map::map_has(Value const& key) const
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
+    write_barrier();
     auto it = m_entries.find(key);
     if (it != m_entries.end()) {
         it->value = value;
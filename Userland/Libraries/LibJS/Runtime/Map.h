@@ -18,6 +18,7 @@ namespace JS {
 class Map : public Object {
     JS_OBJECT(Map, Object);
     JS_DECLARE_ALLOCATOR(Map);
+    JS_DECLARE_WRITE_BARRIERS(Map);
 
 public:
     static NonnullGCPtr<Map> create(Realm&);
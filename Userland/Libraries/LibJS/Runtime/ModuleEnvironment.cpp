@@ -74,6 +74,7 @@ ThrowCompletionOr<void> ModuleEnvironment::create_import_binding(DeprecatedFlySt
 
     // 3. Create an immutable indirect binding in envRec for N that references M and N2 as its target binding and record that the binding is initialized.
     // Note: We use the fact that the binding is in this list as it being initialized.
+    write_barrier();
     m_indirect_bindings.append({ move(name),
         module,
         move(binding_name) });
@@ -16,6 +16,7 @@ namespace JS {
 class ModuleEnvironment final : public DeclarativeEnvironment {
     JS_ENVIRONMENT(ModuleEnvironment, DeclarativeEnvironment);
     JS_DECLARE_ALLOCATOR(ModuleEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(ModuleEnvironment);
 
 public:
     // Note: Module Environment Records support all of the declarative Environment Record methods listed
@@ -550,6 +550,8 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
     if (!m_private_elements)
         m_private_elements = make<Vector<PrivateElement>>();
 
+    write_barrier();
+
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
 
@@ -578,6 +580,8 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
     if (!m_private_elements)
         m_private_elements = make<Vector<PrivateElement>>();
 
+    write_barrier();
+
     // 5. Append method to O.[[PrivateElements]].
     m_private_elements->append(move(element));
 
@@ -634,6 +638,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     // 3. If entry.[[Kind]] is field, then
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
+        write_barrier();
         entry->value = value;
         return {};
     }
@@ -972,7 +977,9 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
         // b. If parent is not null, then
         if (parent) {
             // i. Return ? parent.[[Set]](P, V, Receiver).
-            return TRY(parent->internal_set(property_key, value, receiver));
+            // NOTE: We pass the cacheable metadata along, so that adding a new property to the receiver can be cached
+            //       as long as every object in the prototype chain uses the ordinary [[Set]].
+            return TRY(parent->internal_set(property_key, value, receiver, cacheable_metadata));
         }
         // c. Else,
         else {
@@ -1012,7 +1019,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // iii. Let valueDesc be the PropertyDescriptor { [[Value]]: V }.
             auto value_descriptor = PropertyDescriptor { .value = value };
 
-            if (cacheable_metadata && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
+            if (cacheable_metadata && &receiver.as_object() == this && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
                 *cacheable_metadata = CacheablePropertyMetadata {
                     .type = CacheablePropertyMetadata::Type::OwnProperty,
                     .property_offset = own_descriptor->property_offset.value(),
@@ -1029,7 +1036,20 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             VERIFY(!receiver.as_object().storage_has(property_key));
 
             // ii. Return ? CreateDataProperty(Receiver, P, V).
-            return TRY(receiver.as_object().create_data_property(property_key, value));
+            auto& receiver_object = receiver.as_object();
+            auto succeeded = TRY(receiver_object.create_data_property(property_key, value));
+
+            // Non-standard: If the caller has requested cacheable metadata and the property was added to the receiver's shape, fill it in.
+            if (succeeded && cacheable_metadata && !property_key.is_number() && receiver_object.shape().is_cacheable() && !receiver_object.shape().is_dictionary()) {
+                if (auto metadata = receiver_object.shape().lookup(property_key.to_string_or_symbol()); metadata.has_value()) {
+                    *cacheable_metadata = CacheablePropertyMetadata {
+                        .type = CacheablePropertyMetadata::Type::AddOwnProperty,
+                        .property_offset = metadata->offset,
+                        .prototype = nullptr,
+                    };
+                }
+            }
+            return succeeded;
         }
     }
 
@@ -1161,8 +1181,11 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
             return {};
 
         if (m_has_intrinsic_accessors) {
-            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value()) {
+                // NOTE: The accessor allocates, so the barrier has to come after it.
+                auto value = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).put_direct(metadata->offset, value);
+            }
         }
 
         value = m_storage[metadata->offset];
@@ -1187,6 +1210,8 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
 
     auto [value, attributes, _] = value_and_attributes;
 
+    write_barrier();
+
     if (property_key.is_number()) {
         auto index = property_key.as_number();
         m_indexed_properties.put(index, value, attributes);
@@ -1240,15 +1265,16 @@ void Object::storage_delete(PropertyKey const& property_key)
     auto metadata = shape().lookup(property_key.to_string_or_symbol());
     VERIFY(metadata.has_value());
 
+    // NOTE: The transitions allocate, so the new shapes go through set_shape(), which only runs the write barrier afterwards.
     if (m_shape->is_cacheable_dictionary()) {
-        m_shape = m_shape->create_uncacheable_dictionary_transition();
+        set_shape(m_shape->create_uncacheable_dictionary_transition());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key.to_string_or_symbol(), metadata->offset);
         m_storage.remove(metadata->offset);
         return;
     }
-    m_shape = m_shape->create_delete_transition(property_key.to_string_or_symbol());
+    set_shape(m_shape->create_delete_transition(property_key.to_string_or_symbol()));
     m_storage.remove(metadata->offset);
 }
 
@@ -1256,7 +1282,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
-    m_shape = shape().create_prototype_transition(new_prototype);
+    set_shape(shape().create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
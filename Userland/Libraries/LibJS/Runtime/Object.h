@@ -47,6 +47,7 @@ struct CacheablePropertyMetadata {
         NotCacheable,
         OwnProperty,
         InPrototypeChain,
+        AddOwnProperty,
     };
     Type type { Type::NotCacheable };
     Optional<u32> property_offset;
@@ -56,6 +57,7 @@ struct CacheablePropertyMetadata {
 class Object : public Cell {
     JS_CELL(Object, Cell);
     JS_DECLARE_ALLOCATOR(Object);
+    JS_DECLARE_WRITE_BARRIERS(Object);
 
 public:
     static NonnullGCPtr<Object> create_prototype(Realm&, Object* prototype);
@@ -203,21 +205,56 @@ public:
     // B.3.7 The [[IsHTMLDDA]] Internal Slot, https://tc39.es/ecma262/#sec-IsHTMLDDA-internal-slot
     virtual bool is_htmldda() const { return false; }
 
+    // NOTE: PutById caches only replay put transitions on objects with the ordinary [[GetOwnProperty]], [[DefineOwnProperty]] and [[Set]].
+    //       Objects that override any of them must return true here.
+    virtual bool has_exotic_property_access() const { return false; }
+
     bool has_parameter_map() const { return m_has_parameter_map; }
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        write_barrier();
+        m_storage[index] = value;
+    }
+
+    // NOTE: This is used by PutById caches to replay a previously observed put transition.
+    //       The caller is responsible for ensuring that the transition adds exactly one property to the current shape.
+    [[nodiscard]] bool add_property_with_cached_transition(Shape& new_shape, Value value)
+    {
+        if (!m_is_extensible || has_exotic_property_access())
+            return false;
+        set_shape(new_shape);
+        m_storage.append(value);
+        return true;
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    IndexedProperties& indexed_properties()
+    {
+        // NOTE: We can't know what the caller is going to store, so we conservatively assume new edges.
+        //       The barrier only covers stores made before the next GC allocation, so callers must have
+        //       the values at hand before asking for the indexed properties, and not hold on to them.
+        write_barrier();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        IndexedProperties indexed_properties { move(values) };
+        write_barrier();
+        m_indexed_properties = move(indexed_properties);
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
 
+    // NOTE: These are used by the JIT to inline cached property accesses.
+    static constexpr size_t shape_offset() { return __builtin_offsetof(Object, m_shape); }
+    static constexpr size_t storage_offset() { return __builtin_offsetof(Object, m_storage); }
+
     void convert_to_prototype_if_needed();
 
     template<typename T>
@@ -254,7 +291,11 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        write_barrier();
+        m_shape = &shape;
+    }
 
     Object* prototype() { return shape().prototype(); }
 
@@ -13,6 +13,7 @@ namespace JS {
 class ObjectEnvironment final : public Environment {
     JS_ENVIRONMENT(ObjectEnvironment, Environment);
     JS_DECLARE_ALLOCATOR(ObjectEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(ObjectEnvironment);
 
 public:
     enum class IsWithEnvironment {
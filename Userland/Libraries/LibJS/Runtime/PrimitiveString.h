@@ -23,6 +23,7 @@ namespace JS {
 class PrimitiveString final : public Cell {
     JS_CELL(PrimitiveString, Cell);
     JS_DECLARE_ALLOCATOR(PrimitiveString);
+    JS_DECLARE_WRITE_BARRIERS(PrimitiveString);
 
 public:
     [[nodiscard]] static NonnullGCPtr<PrimitiveString> create(VM&, Utf16String);
@@ -16,6 +16,7 @@ namespace JS {
 class Set : public Object {
     JS_OBJECT(Set, Object);
     JS_DECLARE_ALLOCATOR(Set);
+    JS_DECLARE_WRITE_BARRIERS(Set);
 
 public:
     static NonnullGCPtr<Set> create(Realm&);
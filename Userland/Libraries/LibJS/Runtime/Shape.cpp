@@ -110,6 +110,7 @@ NonnullGCPtr<Shape> Shape::create_put_transition(StringOrSymbol const& property_
     if (!m_is_prototype_shape) {
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
+        write_barrier();
         m_forward_transitions->set(key, new_shape.ptr());
     }
     return new_shape;
@@ -125,6 +126,7 @@ NonnullGCPtr<Shape> Shape::create_configure_transition(StringOrSymbol const& pro
     if (!m_is_prototype_shape) {
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
+        write_barrier();
         m_forward_transitions->set(key, new_shape.ptr());
     }
     return new_shape;
@@ -278,6 +280,7 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
+    write_barrier();
     m_delete_transitions->set(property_key, new_shape.ptr());
     return new_shape;
 }
@@ -351,6 +354,7 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
 {
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
+    write_barrier();
     m_prototype = new_prototype;
 }
 
@@ -359,7 +363,9 @@ void Shape::set_prototype_shape()
     VERIFY(!m_is_prototype_shape);
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
-    m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    auto prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    write_barrier();
+    m_prototype_chain_validity = prototype_chain_validity;
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape> new_prototype_shape)
@@ -390,7 +396,9 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
         return;
     for (auto* shape : shapes_to_invalidate) {
         shape->m_prototype_chain_validity->set_valid(false);
-        shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+        auto prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+        shape->write_barrier();
+        shape->m_prototype_chain_validity = prototype_chain_validity;
     }
 }
 
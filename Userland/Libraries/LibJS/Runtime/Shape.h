@@ -50,6 +50,7 @@ private:
 class Shape final : public Cell {
     JS_CELL(Shape, Cell);
     JS_DECLARE_ALLOCATOR(Shape);
+    JS_DECLARE_WRITE_BARRIERS(Shape);
 
 public:
     virtual ~Shape() override;
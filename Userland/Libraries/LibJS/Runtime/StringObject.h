@@ -30,6 +30,7 @@ private:
     virtual ThrowCompletionOr<Optional<PropertyDescriptor>> internal_get_own_property(PropertyKey const&) const override;
     virtual ThrowCompletionOr<bool> internal_define_own_property(PropertyKey const&, PropertyDescriptor const&) override;
     virtual ThrowCompletionOr<MarkedVector<Value>> internal_own_property_keys() const override;
+    virtual bool has_exotic_property_access() const override { return true; }
 
     virtual bool is_string_object() const final { return true; }
     virtual void visit_edges(Visitor&) override;
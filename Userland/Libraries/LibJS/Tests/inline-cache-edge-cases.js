@@ -16,3 +16,180 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Cached put transition respects setter added to prototype afterwards", () => {
+    function Point(x) {
+        this.x = x;
+    }
+
+    let first = new Point(1);
+    let second = new Point(2);
+
+    let setterValue;
+    Object.defineProperty(Point.prototype, "x", {
+        set(value) {
+            setterValue = value;
+        },
+        configurable: true,
+    });
+
+    let third = new Point(3);
+
+    expect(first.x).toBe(1);
+    expect(second.x).toBe(2);
+    expect(Object.hasOwn(third, "x")).toBeFalse();
+    expect(setterValue).toBe(3);
+});
+
+test("Cached put transition respects non-extensible objects", () => {
+    function setFoo(o) {
+        o.foo = 1;
+    }
+
+    let a = {};
+    let b = {};
+    setFoo(a);
+    Object.preventExtensions(b);
+    setFoo(b);
+
+    expect(a.foo).toBe(1);
+    expect(Object.hasOwn(b, "foo")).toBeFalse();
+});
+
+test("Cached put transition respects non-writable property added to grandparent prototype", () => {
+    class Base {}
+    class Derived extends Base {
+        constructor() {
+            super();
+            this.value = 1;
+        }
+    }
+
+    let first = new Derived();
+    new Derived();
+    Object.defineProperty(Base.prototype, "value", { value: 2, writable: false });
+
+    expect(first.value).toBe(1);
+    expect(() => {
+        new Derived();
+    }).toThrow(TypeError);
+});
+
+test("Cached put transition survives its target shape being garbage collected", () => {
+    function setX(o) {
+        o.x = 1;
+    }
+
+    setX({});
+    gc();
+    let o = {};
+    setX(o);
+    setX(o);
+
+    expect(o.x).toBe(1);
+    expect(Object.keys(o)).toEqual(["x"]);
+});
+
+test("Cached put transition is not replayed on a proxy with a set trap", () => {
+    function setFoo(o) {
+        o.foo = 1;
+    }
+
+    setFoo({});
+    setFoo({});
+
+    let trappedKeys = [];
+    let target = {};
+    let proxy = new Proxy(target, {
+        set(target, key, value) {
+            trappedKeys.push(key);
+            return true;
+        },
+    });
+    setFoo(proxy);
+
+    expect(trappedKeys).toEqual(["foo"]);
+    expect(Object.hasOwn(target, "foo")).toBeFalse();
+    expect(Object.hasOwn(proxy, "foo")).toBeFalse();
+});
+
+test("Cached put transition is not replayed on an array", () => {
+    function setLength(o, value) {
+        o.length = value;
+    }
+
+    let arrayLike = Object.create(Array.prototype);
+    setLength(arrayLike, 5);
+    setLength(Object.create(Array.prototype), 5);
+
+    let array = [1, 2, 3];
+    setLength(array, 1);
+
+    expect(arrayLike.length).toBe(5);
+    expect(array.length).toBe(1);
+    expect(array).toEqual([1]);
+    expect(Object.getOwnPropertyNames(array)).toEqual(["0", "length"]);
+});
+
+test("Cached put transition is not replayed for a different receiver", () => {
+    function setFoo(o) {
+        o.foo = 1;
+    }
+
+    setFoo({});
+    setFoo({});
+
+    let target = {};
+    let receiver = {};
+    expect(Reflect.set(target, "foo", 2, receiver)).toBeTrue();
+    setFoo(target);
+
+    expect(receiver.foo).toBe(2);
+    expect(target.foo).toBe(1);
+    expect(Object.keys(target)).toEqual(["foo"]);
+
+    class Base {}
+    class Derived extends Base {
+        setFooViaSuper(value) {
+            super.foo = value;
+        }
+    }
+
+    let instance = new Derived();
+    instance.setFooViaSuper(3);
+    instance.setFooViaSuper(4);
+    let other = new Derived();
+    other.setFooViaSuper(5);
+
+    expect(Object.hasOwn(Base.prototype, "foo")).toBeFalse();
+    expect(Object.hasOwn(Derived.prototype, "foo")).toBeFalse();
+    expect(instance.foo).toBe(4);
+    expect(other.foo).toBe(5);
+});
+
+test("Cached global object property is shadowed by a later lexical declaration", () => {
+    globalThis.shadowedByLet = 1;
+    globalThis.shadowedByConst = 1;
+
+    function readShadowedByLet() {
+        return shadowedByLet;
+    }
+    function readShadowedByConst() {
+        return shadowedByConst;
+    }
+
+    for (let i = 0; i < 10; ++i) {
+        expect(readShadowedByLet()).toBe(1);
+        expect(readShadowedByConst()).toBe(1);
+    }
+
+    evaluateScript("let shadowedByLet = 2;");
+    evaluateScript("const shadowedByConst = 3;");
+
+    expect(readShadowedByLet()).toBe(2);
+    expect(readShadowedByConst()).toBe(3);
+    expect(globalThis.shadowedByLet).toBe(1);
+
+    evaluateScript("shadowedByLet = 4;");
+    expect(readShadowedByLet()).toBe(4);
+});
@@ -0,0 +1,288 @@
+// Runs the same code once in the interpreter and once compiled to native code, and checks that both agree.
+// Executables are only compiled once they're hot, so the compiled version gets called (or loops) often enough first.
+
+const WARM_UP_CALLS = 200;
+
+function outcome(fn, args) {
+    try {
+        return { value: fn(...args) };
+    } catch (e) {
+        return { error: `${e.constructor.name}: ${e.message}` };
+    }
+}
+
+function expectSameOutcomes(params, body, inputs) {
+    const wasEnabled = setJITEnabled(false);
+    try {
+        // NOTE: Each new Function() gets an executable of its own, so the two tiers don't share one.
+        const interpreted = new Function(...params, body);
+        const expected = inputs.map(args => outcome(interpreted, args));
+
+        setJITEnabled(true);
+        const compiled = new Function(...params, body);
+        for (let i = 0; i < WARM_UP_CALLS; ++i) outcome(compiled, inputs[i % inputs.length]);
+        const actual = inputs.map(args => outcome(compiled, args));
+
+        for (let i = 0; i < inputs.length; ++i) expect(actual[i]).toEqual(expected[i]);
+    } finally {
+        setJITEnabled(wasEnabled);
+    }
+}
+
+const MAX_INT32 = 2 ** 31 - 1;
+const MIN_INT32 = -(2 ** 31);
+
+const mixedOperands = [
+    [1, 2],
+    [-5, 3],
+    [MAX_INT32, 1],
+    [MIN_INT32, -1],
+    [MIN_INT32, 1],
+    [1.5, 2],
+    [0, -0],
+    [NaN, 1],
+    ["1", 2],
+    [2, "x"],
+    [true, null],
+    [undefined, 1],
+    [10n, 5n],
+    [{ valueOf: () => 7 }, 3],
+];
+
+describe("arithmetic", () => {
+    test("add", () => {
+        expectSameOutcomes(["a", "b"], "return a + b;", mixedOperands);
+    });
+
+    test("subtract", () => {
+        expectSameOutcomes(["a", "b"], "return a - b;", mixedOperands);
+    });
+
+    test("increment and decrement", () => {
+        const inputs = [[0], [-1], [MAX_INT32], [MIN_INT32], [0.5], ["3"], [10n], [null], [{ valueOf: () => 1 }]];
+        expectSameOutcomes(["a"], "let b = a; b++; let c = a; c--; return [b, c, ++a, --a];", inputs);
+    });
+
+    test("mixed BigInt and Number operands throw", () => {
+        expectSameOutcomes(["a", "b"], "return a + b;", [
+            [1n, 1],
+            [1, 1n],
+        ]);
+    });
+
+    test("valueOf is called once per operand, in order", () => {
+        expectSameOutcomes(
+            ["n"],
+            `
+            const log = [];
+            const a = { valueOf() { log.push("a"); return n; } };
+            const b = { valueOf() { log.push("b"); return 1; } };
+            return [a + b, a - b, a < b, log.join("")];
+            `,
+            [[1], [MAX_INT32], [1.5]]
+        );
+    });
+});
+
+describe("comparisons", () => {
+    for (const operator of ["<", "<=", ">", ">=", "==", "!=", "===", "!=="]) {
+        test(operator, () => {
+            expectSameOutcomes(["a", "b"], `return a ${operator} b;`, mixedOperands);
+        });
+
+        test(`${operator} in a condition`, () => {
+            expectSameOutcomes(["a", "b"], `if (a ${operator} b) return "yes"; return "no";`, mixedOperands);
+        });
+    }
+});
+
+describe("control flow", () => {
+    test("nullish and undefined jumps", () => {
+        const inputs = [[null], [undefined], [0], [""], [false], [{ x: 1 }]];
+        expectSameOutcomes(["a"], "return [a ?? 'default', a?.x, a === undefined ? 'u' : 'd'];", inputs);
+    });
+
+    test("truthiness of every kind of value", () => {
+        const inputs = [[0], [-0], [1], [NaN], [""], ["0"], [null], [undefined], [0n], [1n], [{}], [[]], [Symbol()]];
+        expectSameOutcomes(["a"], "return a ? 1 : 2;", inputs);
+    });
+
+    test("arguments", () => {
+        expectSameOutcomes(["a", "b"], "a = a + 1; return [a, b, arguments.length];", [[1], [1, 2], [MAX_INT32, 0]]);
+    });
+
+    test("exceptions unwind to the right handler", () => {
+        expectSameOutcomes(
+            ["a"],
+            `
+            const log = [];
+            try {
+                try {
+                    if (a > 1) throw new Error("inner " + a);
+                    log.push("no throw");
+                } finally {
+                    log.push("inner finally");
+                }
+            } catch (e) {
+                log.push(e.message);
+                if (a > 2) throw new TypeError("rethrown");
+            } finally {
+                log.push("outer finally");
+            }
+            return log.join(", ");
+            `,
+            [[0], [2], [3]]
+        );
+    });
+
+    test("break and continue through finally", () => {
+        expectSameOutcomes(
+            ["n"],
+            `
+            let log = "";
+            for (let i = 0; i < n; ++i) {
+                try {
+                    if (i === 1) continue;
+                    if (i === 3) break;
+                    log += i;
+                } finally {
+                    log += "f";
+                }
+            }
+            return log;
+            `,
+            [[0], [2], [5]]
+        );
+    });
+});
+
+describe("cached property accesses", () => {
+    test("own properties across several shapes", () => {
+        expectSameOutcomes(
+            ["o"],
+            "const before = o.x; o.x = before + 1; return [before, o.x, o.y];",
+            [[{ x: 1 }], [{ y: 2, x: 3 }], [{ x: 4, y: 5, z: 6 }], [{ x: 7, z: 8 }], [{ w: 0, x: 9 }]]
+        );
+    });
+
+    test("properties from the prototype chain", () => {
+        const prototype = { x: 1 };
+        const inputs = [[Object.create(prototype)], [{ x: 2 }], [Object.create(Object.create(prototype))]];
+        expectSameOutcomes(["o"], "return o.x;", inputs);
+        prototype.x = 3;
+        expectSameOutcomes(["o"], "return o.x;", inputs);
+    });
+
+    test("accessors, non-writable properties and proxies", () => {
+        const inputs = [
+            [{ x: 1 }],
+            [
+                {
+                    get x() {
+                        return 2;
+                    },
+                    set x(value) {},
+                },
+            ],
+            [Object.freeze({ x: 3 })],
+            [Object.defineProperty({}, "x", { value: 4, writable: false })],
+            [new Proxy({ x: 5 }, { get: (target, key) => target[key] * 10 })],
+        ];
+        expectSameOutcomes(["o"], "o.x = 42; return o.x;", inputs);
+        expectSameOutcomes(["o"], "'use strict'; o.x = 42; return o.x;", inputs);
+    });
+
+    test("primitive bases", () => {
+        const inputs = [["abc"], [1.5], [true], [10n], [Symbol("s")], [null], [undefined], [{ length: 7 }]];
+        expectSameOutcomes(["v"], "return [v.length, v.toString === undefined];", inputs);
+        expectSameOutcomes(["v"], "v.x = 1; return v.x;", inputs);
+    });
+
+    test("a property deleted from an object with a unique shape", () => {
+        expectSameOutcomes(
+            ["n"],
+            `
+            const o = {};
+            for (let i = 0; i < 1000; ++i) o["p" + i] = i;
+            let result = 0;
+            for (let i = 0; i < n; ++i) {
+                result += o.p2 ?? -1;
+                if (i === 150) delete o.p2;
+                o.p3 = i;
+            }
+            return [result, o.p3];
+            `,
+            [[300]]
+        );
+    });
+
+    test("added properties on objects that share a shape", () => {
+        expectSameOutcomes(
+            ["n"],
+            `
+            const objects = [];
+            for (let i = 0; i < n; ++i) {
+                const o = {};
+                o.a = i;
+                o.b = o.a + 1;
+                objects.push(o);
+            }
+            return objects.map(o => o.a + o.b).join();
+            `,
+            [[5], [300]]
+        );
+    });
+});
+
+describe("entering compiled code from a loop", () => {
+    test("operands change type after the loop got hot", () => {
+        expectSameOutcomes(
+            ["limit", "late"],
+            `
+            let sum = 0;
+            for (let i = 0; i < limit; ++i) {
+                sum = sum + (i < 150 ? i : late);
+                sum = sum - 1;
+            }
+            return sum;
+            `,
+            [
+                [300, 1],
+                [300, 0.25],
+                [300, "s"],
+                [300, MAX_INT32],
+                [300, 1n],
+            ]
+        );
+    });
+
+    test("int32 overflow in a hot loop", () => {
+        expectSameOutcomes(
+            ["start"],
+            `
+            let value = start;
+            for (let i = 0; i < 500; ++i)
+                value++;
+            return value;
+            `,
+            [[0], [MAX_INT32 - 200], [MIN_INT32]]
+        );
+    });
+
+    test("property accesses that change shape", () => {
+        expectSameOutcomes(
+            ["n"],
+            `
+            const objects = [{ x: 1 }, { y: 2, x: 3 }, { x: "a" }, Object.create({ x: 4 })];
+            let result = "";
+            for (let i = 0; i < n; ++i) {
+                const o = objects[i % objects.length];
+                result += o.x;
+                o.z = i;
+            }
+            return [result.length, result.slice(-8), objects.map(o => o.z)];
+            `,
+            [[10], [400]]
+        );
+    });
+});
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/HashMap.h>
 #include <AK/NumericLimits.h>
+#include <AK/QuickSort.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
@@ -37,6 +40,256 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
+// A table in the FROM clause, together with the parts of the WHERE clause that can be evaluated as soon as its rows
+// are joined to the rows of the tables preceding it. This way rows get discarded as early as possible, instead of
+// evaluating the WHERE clause on every row of the cartesian product of all tables.
+struct JoinedTable {
+    struct HashJoin {
+        size_t outer_column_index { 0 };
+        size_t column_index { 0 };
+        HashMap<u32, Vector<size_t>> row_indices_by_key {};
+    };
+
+    NonnullRefPtr<TableDef> table_def;
+    size_t first_column_in_row { 0 };
+    NonnullRefPtr<TupleDescriptor> descriptor;
+    Vector<Row> rows {};
+
+    // Terms that only refer to columns of this table, evaluated once per row of the table.
+    Vector<NonnullRefPtr<Expression>> row_filters {};
+    // Terms that refer to columns of this table and of the tables preceding it, evaluated once per joined row.
+    Vector<NonnullRefPtr<Expression>> join_filters {};
+    Optional<HashJoin> hash_join {};
+};
+
+struct ColumnLocation {
+    size_t table_index { 0 };
+    size_t column_index { 0 };
+};
+
+static void collect_terms(NonnullRefPtr<Expression> const& expression, Vector<NonnullRefPtr<Expression>>& terms)
+{
+    // NOTE: A parenthesized expression is parsed as a chained expression with a single element, which is true if and
+    //       only if that element is.
+    if (is<ChainedExpression>(*expression)) {
+        auto const& chained_expression = verify_cast<ChainedExpression>(*expression);
+        if (chained_expression.expressions().size() == 1) {
+            collect_terms(chained_expression.expressions().first(), terms);
+            return;
+        }
+    }
+
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(*expression);
+        if (binary_expression.type() == BinaryOperator::And) {
+            collect_terms(binary_expression.lhs(), terms);
+            collect_terms(binary_expression.rhs(), terms);
+            return;
+        }
+    }
+
+    terms.append(expression);
+}
+
+// Returns false if the expression contains anything of which we can't tell which columns it depends on.
+static bool collect_column_names(Expression const& expression, Vector<ColumnNameExpression const*>& column_names)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression)
+        || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression)) {
+        return true;
+    }
+
+    if (is<ColumnNameExpression>(expression)) {
+        column_names.append(&verify_cast<ColumnNameExpression>(expression));
+        return true;
+    }
+
+    if (is<UnaryOperatorExpression>(expression))
+        return collect_column_names(verify_cast<UnaryOperatorExpression>(expression).expression(), column_names);
+
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(expression);
+        return collect_column_names(binary_expression.lhs(), column_names)
+            && collect_column_names(binary_expression.rhs(), column_names);
+    }
+
+    if (is<MatchExpression>(expression)) {
+        auto const& match_expression = verify_cast<MatchExpression>(expression);
+        if (match_expression.escape() && !collect_column_names(*match_expression.escape(), column_names))
+            return false;
+        return collect_column_names(match_expression.lhs(), column_names)
+            && collect_column_names(match_expression.rhs(), column_names);
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        for (auto const& element : verify_cast<ChainedExpression>(expression).expressions()) {
+            if (!collect_column_names(element, column_names))
+                return false;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// Resolves a column the same way ColumnNameExpression::evaluate does. Ambiguous or unknown columns are left for the
+// evaluation of the expression to report.
+static Optional<ColumnLocation> locate_column(Vector<JoinedTable> const& tables, ColumnNameExpression const& column_name)
+{
+    Optional<ColumnLocation> location;
+
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto const& table_def = *tables[table_index].table_def;
+        if (!column_name.table_name().is_empty() && table_def.name() != column_name.table_name())
+            continue;
+
+        auto const& columns = table_def.columns();
+        for (size_t column_index = 0; column_index < columns.size(); ++column_index) {
+            if (columns[column_index]->name() != column_name.column_name())
+                continue;
+            if (location.has_value())
+                return {};
+
+            location = ColumnLocation { table_index, column_index };
+        }
+    }
+
+    return location;
+}
+
+// Returns the sorted indices of the tables whose columns the expression refers to, or an empty Optional if that can't
+// be determined.
+static Optional<Vector<size_t>> table_indices_for_expression(Vector<JoinedTable> const& tables, Expression const& expression)
+{
+    Vector<ColumnNameExpression const*> column_names;
+    if (!collect_column_names(expression, column_names))
+        return {};
+
+    Vector<size_t> table_indices;
+    for (auto const* column_name : column_names) {
+        auto location = locate_column(tables, *column_name);
+        if (!location.has_value())
+            return {};
+        if (!table_indices.contains_slow(location->table_index))
+            table_indices.append(location->table_index);
+    }
+
+    quick_sort(table_indices);
+    return table_indices;
+}
+
+// If one of the join filters of the table is an equality between one of its columns and a column of a preceding table,
+// index the rows of the table by that column so that joining a row only needs to look at the rows with an equal key.
+// The filter itself is still evaluated for each joined row, which takes care of hash collisions.
+static void set_up_hash_join(Vector<JoinedTable>& tables, size_t table_index)
+{
+    auto& table = tables[table_index];
+
+    auto type_supports_hash_join = [](SQLType type) {
+        // NOTE: Values of other types either don't have a hash, or compare equal to values that hash differently.
+        return type == SQLType::Text || type == SQLType::Integer;
+    };
+
+    for (auto const& term : table.join_filters) {
+        if (!is<BinaryOperatorExpression>(*term))
+            continue;
+
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(*term);
+        if (binary_expression.type() != BinaryOperator::Equals)
+            continue;
+        if (!is<ColumnNameExpression>(*binary_expression.lhs()) || !is<ColumnNameExpression>(*binary_expression.rhs()))
+            continue;
+
+        auto lhs = locate_column(tables, verify_cast<ColumnNameExpression>(*binary_expression.lhs()));
+        auto rhs = locate_column(tables, verify_cast<ColumnNameExpression>(*binary_expression.rhs()));
+        if (!lhs.has_value() || !rhs.has_value())
+            continue;
+        if (lhs->table_index == table_index)
+            swap(lhs, rhs);
+        if (rhs->table_index != table_index || lhs->table_index >= table_index)
+            continue;
+
+        auto outer_type = tables[lhs->table_index].table_def->columns()[lhs->column_index]->type();
+        auto type = table.table_def->columns()[rhs->column_index]->type();
+        if (outer_type != type || !type_supports_hash_join(type))
+            continue;
+
+        JoinedTable::HashJoin hash_join;
+        hash_join.outer_column_index = tables[lhs->table_index].first_column_in_row + lhs->column_index;
+        hash_join.column_index = rhs->column_index;
+
+        for (size_t row_index = 0; row_index < table.rows.size(); ++row_index) {
+            auto const& key = table.rows[row_index][hash_join.column_index];
+            if (key.is_null() || key.type() != type)
+                continue;
+            hash_join.row_indices_by_key.ensure(key.hash()).append(row_index);
+        }
+
+        table.hash_join = move(hash_join);
+        return;
+    }
+}
+
+static ResultOr<bool> evaluate_terms(ExecutionContext& context, Vector<NonnullRefPtr<Expression>> const& terms, bool is_conjunction)
+{
+    // NOTE: The terms were split off an AND, which evaluates all of its operands and rejects the ones that aren't
+    //       booleans. So all of the given terms are evaluated, even once one of them is false. (Terms that filter
+    //       other tables may still have rejected the row before it gets here, see Select::execute().)
+    bool result = true;
+    for (auto const& term : terms) {
+        auto term_result = TRY(term->evaluate(context)).to_bool();
+        if (!term_result.has_value()) {
+            if (is_conjunction)
+                return Result { SQLCommand::Select, SQLErrorCode::BooleanOperatorTypeMismatch, BinaryOperator_name(BinaryOperator::And) };
+            return false;
+        }
+        result = result && term_result.value();
+    }
+
+    return result;
+}
+
+template<typename Callback>
+static ResultOr<void> join_tables(ExecutionContext& context, Vector<JoinedTable> const& tables, size_t table_index, Tuple const& outer_row, Vector<Tuple>& joined_rows, bool is_conjunction, Callback const& callback)
+{
+    auto const& table = tables[table_index];
+    auto& joined_row = joined_rows[table_index];
+
+    for (size_t i = 0; i < table.first_column_in_row; ++i)
+        joined_row[i] = outer_row[i];
+
+    auto join_row = [&](Row const& row) -> ResultOr<void> {
+        for (size_t i = 0; i < row.size(); ++i)
+            joined_row[table.first_column_in_row + i] = row[i];
+
+        context.current_row = &joined_row;
+        if (!TRY(evaluate_terms(context, table.join_filters, is_conjunction)))
+            return {};
+
+        if (table_index + 1 == tables.size())
+            return callback(joined_row);
+        return join_tables(context, tables, table_index + 1, joined_row, joined_rows, is_conjunction, callback);
+    };
+
+    if (table.hash_join.has_value()) {
+        auto const& key = outer_row[table.hash_join->outer_column_index];
+        if (key.is_null())
+            return {};
+
+        auto row_indices = table.hash_join->row_indices_by_key.find(key.hash());
+        if (row_indices == table.hash_join->row_indices_by_key.end())
+            return {};
+
+        for (auto row_index : row_indices->value)
+            TRY(join_row(table.rows[row_index]));
+        return {};
+    }
+
+    for (auto const& row : table.rows)
+        TRY(join_row(row));
+    return {};
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
@@ -85,13 +338,12 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
+    auto unity_descriptor = adopt_ref(*new TupleDescriptor);
+    unity_descriptor->empend("__unity__"sv);
+    Tuple unity_row(unity_descriptor);
+    unity_row[0] = Value { true };
 
+    Vector<JoinedTable> tables;
     for (auto& table_descriptor : table_or_subquery_list()) {
         if (!table_descriptor->is_table())
             return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
@@ -100,19 +352,88 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         if (table_def->num_columns() == 0)
             continue;
 
-        auto old_descriptor_size = descriptor->size();
+        auto const& previous_descriptor = tables.is_empty() ? unity_descriptor : tables.last().descriptor;
+        auto descriptor = adopt_ref(*new TupleDescriptor);
+        descriptor->extend(*previous_descriptor);
         descriptor->extend(table_def->to_tuple_descriptor());
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+        auto rows = TRY(context.database->select_all(*table_def));
+        tables.append({
+            .table_def = table_def,
+            .first_column_in_row = previous_descriptor->size(),
+            .descriptor = move(descriptor),
+            .rows = move(rows),
+        });
+    }
+
+    Vector<NonnullRefPtr<Expression>> terms;
+    if (where_clause())
+        collect_terms(*where_clause(), terms);
+    bool const is_conjunction = terms.size() > 1;
+
+    Vector<NonnullRefPtr<Expression>> terms_for_complete_rows;
+    for (auto& term : terms) {
+        auto table_indices = table_indices_for_expression(tables, *term);
+        if (!table_indices.has_value() || tables.is_empty()) {
+            terms_for_complete_rows.append(move(term));
+            continue;
+        }
+        if (table_indices->is_empty()) {
+            tables.first().row_filters.append(move(term));
+            continue;
+        }
+
+        auto last_table_index = table_indices->last();
+        if (table_indices->first() == last_table_index)
+            tables[last_table_index].row_filters.append(move(term));
+        else
+            tables[last_table_index].join_filters.append(move(term));
+    }
+    if (!tables.is_empty())
+        tables.last().join_filters.extend(move(terms_for_complete_rows));
+
+    // NOTE: If one of the tables is empty, there are no rows to evaluate the WHERE clause on, so none of its terms get
+    //       a chance to fail on the rows of the other tables.
+    bool const has_rows_to_join = all_of(tables, [](auto const& table) { return !table.rows.is_empty(); });
+
+    // NOTE: Since terms are only evaluated on the rows that the terms before them let through, a term may never see a
+    //       row at all, and an error evaluating it would go unreported. To still fail on errors that don't depend on the
+    //       values in a row (like adding text to a number), the whole WHERE clause is evaluated on the first row of the
+    //       cross product, where evaluating it on every row would have failed first. Errors that only some values cause
+    //       are reported only if those values make it to the term.
+    if (where_clause() && has_rows_to_join && !tables.is_empty()) {
+        Tuple first_row(tables.last().descriptor);
+        first_row[0] = unity_row[0];
+        for (auto const& table : tables) {
+            auto const& row = table.rows.first();
+            for (size_t i = 0; i < row.size(); ++i)
+                first_row[table.first_column_in_row + i] = row[i];
+        }
+
+        context.current_row = &first_row;
+        (void)TRY(where_clause()->evaluate(context));
+    }
 
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto& table = tables[table_index];
+        if (!table.row_filters.is_empty() && has_rows_to_join) {
+            // NOTE: Rows read from the database don't know which table they belong to, so we evaluate the filters on a
+            //       tuple that does, in order to resolve qualified column names.
+            Tuple filter_row(table.table_def->to_tuple_descriptor());
+
+            Vector<Row> rows;
+            for (auto& row : table.rows) {
+                for (size_t i = 0; i < row.size(); ++i)
+                    filter_row[i] = row[i];
+
+                context.current_row = &filter_row;
+                if (TRY(evaluate_terms(context, table.row_filters, is_conjunction)))
+                    rows.append(move(row));
             }
+            table.rows = move(rows);
         }
+        if (table_index > 0)
+            set_up_hash_join(tables, table_index);
     }
 
     bool has_ordering { false };
@@ -122,16 +443,10 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         has_ordering = true;
     }
     Tuple sort_key(sort_descriptor);
+    Tuple tuple;
 
-    for (auto& row : rows) {
+    auto add_row_to_result = [&](Tuple& row) -> ResultOr<void> {
         context.current_row = &row;
-
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
-
         tuple.clear();
 
         for (auto& col : columns) {
@@ -148,6 +463,18 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
 
         result.insert_row(tuple, sort_key);
+        return {};
+    };
+
+    if (tables.is_empty()) {
+        context.current_row = &unity_row;
+        if (TRY(evaluate_terms(context, terms_for_complete_rows, is_conjunction)))
+            TRY(add_row_to_result(unity_row));
+    } else {
+        Vector<Tuple> joined_rows;
+        for (auto& table : tables)
+            joined_rows.append(Tuple { table.descriptor });
+        TRY(join_tables(context, tables, 0, unity_row, joined_rows, is_conjunction, add_row_to_result));
     }
 
     if (m_limit_clause != nullptr) {
@@ -9,6 +9,8 @@
 
 namespace Threading {
 
+class Mutex;
+
 template<typename ErrorType>
 class WorkerThread;
 
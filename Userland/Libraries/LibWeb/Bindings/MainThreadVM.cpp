@@ -86,6 +86,16 @@ ErrorOr<void> initialize_main_thread_vm()
     //       This avoids doing an exhaustive garbage collection on process exit.
     s_main_thread_vm->ref();
 
+    // NOTE: The event loop performs slices of incremental marking between tasks, see EventLoop::process().
+    s_main_thread_vm->heap().set_incremental_marking_enabled(true);
+
+    // NOTE: Collections that can't wait for incremental marking to finish mark on all cores instead.
+    s_main_thread_vm->heap().set_parallel_marking_enabled(true);
+
+    // NOTE: Generational collection stays off here for now. DOM nodes and the other LibWeb cells have no write barriers,
+    //       so each of them would stay in the remembered set once promoted, and every young collection would have to
+    //       trace all of them. It can be tried out with `js --generational-gc` in the meantime.
+
     auto& custom_data = verify_cast<WebEngineCustomData>(*s_main_thread_vm->custom_data());
     custom_data.event_loop = s_main_thread_vm->heap().allocate_without_realm<HTML::EventLoop>();
 
@@ -66,11 +66,13 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/HTML/TagNames.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Namespace.h>
@@ -2414,6 +2416,11 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
         return style;
     }
 
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value()) {
+        if (auto style = find_shareable_style(element))
+            return style;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2446,6 +2453,122 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     return style;
 }
 
+static bool state_allows_style_sharing(DOM::Element const& element)
+{
+    // NOTE: These mirror the element state checked by SelectorEngine for :hover, :focus, :focus-within, :active, :target and :target-within.
+    auto const& document = element.document();
+    if (auto const* hovered_node = document.hovered_node(); hovered_node && element.is_inclusive_ancestor_of(*hovered_node))
+        return false;
+    if (auto const* focused_element = document.focused_element(); focused_element && element.is_inclusive_ancestor_of(*focused_element))
+        return false;
+    if (auto const* target_element = document.target_element(); target_element && element.is_inclusive_ancestor_of(*target_element))
+        return false;
+    if (element.is_active())
+        return false;
+    return true;
+}
+
+static bool can_element_share_style(DOM::Element const& element)
+{
+    if (element.id().has_value() || element.inline_style() || element.shadow_root_internal())
+        return false;
+    if (element.is_document_element() || element.is_custom() || !element.is_defined())
+        return false;
+    if (element.cached_animation_name_animation() || element.has_associated_animations())
+        return false;
+
+    // These elements have state of their own that selectors can observe (e.g :checked, :open or :playing).
+    if (element.namespace_uri() == Namespace::HTML
+        && element.local_name().is_one_of(
+            HTML::TagNames::audio, HTML::TagNames::bdi, HTML::TagNames::button, HTML::TagNames::details,
+            HTML::TagNames::dialog, HTML::TagNames::fieldset, HTML::TagNames::input, HTML::TagNames::optgroup,
+            HTML::TagNames::option, HTML::TagNames::select, HTML::TagNames::textarea, HTML::TagNames::video))
+        return false;
+
+    // The directionality of dir=auto elements depends on their text content.
+    if (auto dir = element.attribute(HTML::AttributeNames::dir); dir.has_value() && dir->equals_ignoring_ascii_case("auto"sv))
+        return false;
+
+    return state_allows_style_sharing(element);
+}
+
+static bool can_share_style_with(DOM::Element const& element, DOM::Element const& candidate)
+{
+    if (candidate.local_name() != element.local_name() || candidate.namespace_uri() != element.namespace_uri())
+        return false;
+    if (candidate.needs_style_update() || !candidate.computed_css_values())
+        return false;
+    if (candidate.class_names() != element.class_names())
+        return false;
+    if (candidate.attribute_list_size() != element.attribute_list_size())
+        return false;
+
+    auto const& attributes = *element.attributes();
+    auto const& candidate_attributes = *candidate.attributes();
+    for (size_t i = 0; i < attributes.length(); ++i) {
+        auto const* attribute = attributes.item(i);
+        auto const* candidate_attribute = candidate_attributes.get_named_item(attribute->name());
+        if (!candidate_attribute || candidate_attribute->value() != attribute->value())
+            return false;
+    }
+
+    if (candidate.computed_css_values()->property_source_declaration(PropertyID::AnimationName))
+        return false;
+
+    return can_element_share_style(candidate);
+}
+
+bool StyleComputer::may_match_position_dependent_rules(DOM::Element const& element) const
+{
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author }) {
+        auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
+        if (rule_cache.has_position_dependent_other_rules)
+            return true;
+        if (rule_cache.tag_names_with_position_dependent_rules.contains(element.local_name()))
+            return true;
+        for (auto const& class_name : element.class_names()) {
+            if (rule_cache.classes_with_position_dependent_rules.contains(class_name))
+                return true;
+        }
+        bool has_position_dependent_attribute_rules = false;
+        element.for_each_attribute([&](auto& name, auto&) {
+            if (rule_cache.attribute_names_with_position_dependent_rules.contains(name))
+                has_position_dependent_attribute_rules = true;
+        });
+        if (has_position_dependent_attribute_rules)
+            return true;
+    }
+    return false;
+}
+
+// Sibling elements with the same tag, classes and attributes usually end up with the same computed style.
+// If one of the last few previous siblings is such an element, we reuse its style instead of running the cascade again.
+RefPtr<StyleProperties> StyleComputer::find_shareable_style(DOM::Element& element) const
+{
+    static constexpr size_t max_style_sharing_candidates = 8;
+
+    if (!m_style_sharing_enabled)
+        return nullptr;
+    if (!can_element_share_style(element) || may_match_position_dependent_rules(element))
+        return nullptr;
+
+    size_t candidate_count = 0;
+    for (auto* candidate = element.previous_element_sibling(); candidate && candidate_count < max_style_sharing_candidates; candidate = candidate->previous_element_sibling(), ++candidate_count) {
+        if (!can_share_style_with(element, *candidate))
+            continue;
+
+        dbgln_if(LIBWEB_STYLE_SHARING_DEBUG, "Sharing style of {} with its previous sibling {}", element.debug_description(), candidate->debug_description());
+        ++m_style_sharing_statistics.hits;
+
+        // NOTE: The cascade would have resolved the same custom properties for this element, so we copy those over too.
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        return candidate->computed_css_values()->clone();
+    }
+
+    ++m_style_sharing_statistics.misses;
+    return nullptr;
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2453,6 +2576,173 @@ void StyleComputer::build_rule_cache_if_needed() const
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
 
+// Returns true if the selector's subject may match one element but not an otherwise identical sibling,
+// i.e if it looks at the element's position among its siblings or at its contents.
+static bool selector_depends_on_element_position(Selector const& selector)
+{
+    auto const& subject = selector.compound_selectors().last();
+    if (subject.combinator == Selector::Combinator::NextSibling || subject.combinator == Selector::Combinator::SubsequentSibling)
+        return true;
+
+    for (auto const& simple_selector : subject.simple_selectors) {
+        if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        auto const& pseudo_class = simple_selector.pseudo_class();
+        switch (pseudo_class.type) {
+        case PseudoClass::Is:
+        case PseudoClass::Where:
+        case PseudoClass::Not:
+            for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                if (selector_depends_on_element_position(argument_selector))
+                    return true;
+            }
+            break;
+        // These only depend on the element's attributes, ancestors or document state.
+        case PseudoClass::AnyLink:
+        case PseudoClass::Dir:
+        case PseudoClass::Disabled:
+        case PseudoClass::Enabled:
+        case PseudoClass::Host:
+        case PseudoClass::Lang:
+        case PseudoClass::Link:
+        case PseudoClass::LocalLink:
+        case PseudoClass::ReadOnly:
+        case PseudoClass::ReadWrite:
+        case PseudoClass::Root:
+        case PseudoClass::Scope:
+        case PseudoClass::Visited:
+            break;
+        // These depend on element state, which find_shareable_style() checks for separately.
+        case PseudoClass::Active:
+        case PseudoClass::Buffering:
+        case PseudoClass::Checked:
+        case PseudoClass::Closed:
+        case PseudoClass::Defined:
+        case PseudoClass::Focus:
+        case PseudoClass::FocusVisible:
+        case PseudoClass::FocusWithin:
+        case PseudoClass::Hover:
+        case PseudoClass::Indeterminate:
+        case PseudoClass::Muted:
+        case PseudoClass::Open:
+        case PseudoClass::Paused:
+        case PseudoClass::PlaceholderShown:
+        case PseudoClass::Playing:
+        case PseudoClass::Seeking:
+        case PseudoClass::Stalled:
+        case PseudoClass::Target:
+        case PseudoClass::TargetWithin:
+        case PseudoClass::VolumeLocked:
+            break;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
+// Calls the callback for every class, id and attribute simple selector in the selector, along with the elements
+// that may match the selector differently if that class, id or attribute changes on an element.
+template<typename Callback>
+static void for_each_invalidation_feature(Selector const& selector, StyleInvalidationScope enclosing_scope, Callback const& callback)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        auto scope = enclosing_scope;
+        if (i == compound_selectors.size() - 1)
+            scope |= StyleInvalidationScope::Self;
+        for (size_t j = i + 1; j < compound_selectors.size(); ++j) {
+            switch (compound_selectors[j].combinator) {
+            case Selector::Combinator::Descendant:
+            case Selector::Combinator::ImmediateChild:
+                scope |= StyleInvalidationScope::Descendants;
+                break;
+            case Selector::Combinator::NextSibling:
+            case Selector::Combinator::SubsequentSibling:
+                scope |= StyleInvalidationScope::FollowingSiblings;
+                break;
+            default:
+                scope |= StyleInvalidationScope::Descendants | StyleInvalidationScope::FollowingSiblings;
+                break;
+            }
+        }
+
+        for (auto const& simple_selector : compound_selectors[i].simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Class:
+            case Selector::SimpleSelector::Type::Id:
+            case Selector::SimpleSelector::Type::Attribute:
+                callback(simple_selector, scope);
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                auto argument_scope = scope;
+                // NOTE: Arguments to anything other than :is(), :where() and :not() may be matched against other elements.
+                //       :nth-child(2n of .foo) counts the preceding siblings that match, so whether the following siblings
+                //       match depends on it, and it's the other way around for :nth-last-child(2n of .foo).
+                switch (pseudo_class.type) {
+                case PseudoClass::Is:
+                case PseudoClass::Where:
+                case PseudoClass::Not:
+                    break;
+                case PseudoClass::NthChild:
+                    argument_scope |= StyleInvalidationScope::FollowingSiblings;
+                    break;
+                case PseudoClass::NthLastChild:
+                    argument_scope |= StyleInvalidationScope::Self | StyleInvalidationScope::PrecedingSiblings;
+                    break;
+                default:
+                    argument_scope |= StyleInvalidationScope::Descendants | StyleInvalidationScope::FollowingSiblings | StyleInvalidationScope::PrecedingSiblings;
+                    break;
+                }
+                for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                    for_each_invalidation_feature(argument_selector, argument_scope, callback);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
+
+// Collects the names of the attributes that attr() functions in the given values read from.
+// Returns false if an attr() function refers to an attribute in a way we don't understand.
+static bool collect_attribute_names_referenced_by_attr_function(Vector<Parser::ComponentValue> const& values, HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits>& attribute_names)
+{
+    for (auto const& value : values) {
+        if (value.is_block()) {
+            if (!collect_attribute_names_referenced_by_attr_function(value.block().values(), attribute_names))
+                return false;
+            continue;
+        }
+        if (!value.is_function())
+            continue;
+
+        auto const& function = value.function();
+        if (function.name().equals_ignoring_ascii_case("attr"sv)) {
+            // attr() = attr( <wq-name> <attr-type>? , <declaration-value>?)
+            // NOTE: For a namespaced name like `ns|name` or `*|name`, the local name is the first ident that isn't followed by a `|`.
+            auto const& arguments = function.values();
+            Optional<FlyString> local_name;
+            for (size_t i = 0; i < arguments.size() && !arguments[i].is(Parser::Token::Type::Comma); ++i) {
+                if (!arguments[i].is(Parser::Token::Type::Ident))
+                    continue;
+                if (i + 1 < arguments.size() && arguments[i + 1].is_delim('|'))
+                    continue;
+                local_name = arguments[i].token().ident();
+                break;
+            }
+            if (!local_name.has_value())
+                return false;
+            attribute_names.set(local_name.release_value());
+        }
+        if (!collect_attribute_names_referenced_by_attr_function(function.values(), attribute_names))
+            return false;
+    }
+    return true;
+}
+
 NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
 {
     auto rule_cache = make<RuleCache>();
@@ -2469,6 +2759,17 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
     for_each_stylesheet(cascade_origin, [&](auto& sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root) {
         size_t rule_index = 0;
         sheet.for_each_effective_style_rule([&](auto const& rule) {
+            auto collect_attr_references = [&](StyleProperty const& property) {
+                if (rule_cache->has_unknown_attr_function_references || !property.value->is_unresolved() || !property.value->as_unresolved().contains_var_or_attr())
+                    return;
+                if (!collect_attribute_names_referenced_by_attr_function(property.value->as_unresolved().values(), rule_cache->attribute_names_referenced_by_attr_function))
+                    rule_cache->has_unknown_attr_function_references = true;
+            };
+            for (auto const& property : rule.declaration().properties())
+                collect_attr_references(property);
+            for (auto const& it : rule.declaration().custom_properties())
+                collect_attr_references(it.value);
+
             size_t selector_index = 0;
             for (CSS::Selector const& selector : rule.selectors()) {
                 MatchingRule matching_rule {
@@ -2501,6 +2802,17 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     }
                 }
 
+                bool const depends_on_element_position = !matching_rule.contains_pseudo_element && selector_depends_on_element_position(selector);
+
+                for_each_invalidation_feature(selector, StyleInvalidationScope::None, [&](CSS::Selector::SimpleSelector const& simple_selector, StyleInvalidationScope scope) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class)
+                        rule_cache->invalidation_scope_by_class_name.ensure(simple_selector.name()) |= scope;
+                    else if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id)
+                        rule_cache->invalidation_scope_by_id.ensure(simple_selector.name()) |= scope;
+                    else
+                        rule_cache->invalidation_scope_by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name) |= scope;
+                });
+
                 bool added_to_bucket = false;
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
@@ -2510,12 +2822,16 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                         break;
                     }
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class) {
+                        if (depends_on_element_position)
+                            rule_cache->classes_with_position_dependent_rules.set(simple_selector.name());
                         rule_cache->rules_by_class.ensure(simple_selector.name()).append(move(matching_rule));
                         ++num_class_rules;
                         added_to_bucket = true;
                         break;
                     }
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName) {
+                        if (depends_on_element_position)
+                            rule_cache->tag_names_with_position_dependent_rules.set(simple_selector.qualified_name().name.lowercase_name);
                         rule_cache->rules_by_tag_name.ensure(simple_selector.qualified_name().name.lowercase_name).append(move(matching_rule));
                         ++num_tag_name_rules;
                         added_to_bucket = true;
@@ -2530,6 +2846,8 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     } else {
                         for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                             if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute) {
+                                if (depends_on_element_position)
+                                    rule_cache->attribute_names_with_position_dependent_rules.set(simple_selector.attribute().qualified_name.name.lowercase_name);
                                 rule_cache->rules_by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name).append(move(matching_rule));
                                 ++num_attribute_rules;
                                 added_to_bucket = true;
@@ -2537,6 +2855,8 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                             }
                         }
                         if (!added_to_bucket) {
+                            if (depends_on_element_position)
+                                rule_cache->has_position_dependent_other_rules = true;
                             rule_cache->other_rules.append(move(matching_rule));
                         }
                     }
@@ -2628,6 +2948,52 @@ void StyleComputer::invalidate_rule_cache()
     m_user_agent_rule_cache = nullptr;
 }
 
+template<typename GetScope>
+Optional<StyleInvalidationScope> StyleComputer::invalidation_scope_across_cascade_origins(GetScope get_scope) const
+{
+    if (!m_author_rule_cache || !m_user_rule_cache || !m_user_agent_rule_cache)
+        return {};
+
+    auto scope = StyleInvalidationScope::None;
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author })
+        scope |= get_scope(rule_cache_for_cascade_origin(cascade_origin)).value_or(StyleInvalidationScope::None);
+    return scope;
+}
+
+Optional<StyleInvalidationScope> StyleComputer::invalidation_scope_for_class_name(FlyString const& class_name) const
+{
+    return invalidation_scope_across_cascade_origins([&](RuleCache const& rule_cache) {
+        return rule_cache.invalidation_scope_by_class_name.get(class_name);
+    });
+}
+
+Optional<StyleInvalidationScope> StyleComputer::invalidation_scope_for_id(FlyString const& id) const
+{
+    return invalidation_scope_across_cascade_origins([&](RuleCache const& rule_cache) {
+        return rule_cache.invalidation_scope_by_id.get(id);
+    });
+}
+
+Optional<StyleInvalidationScope> StyleComputer::invalidation_scope_for_attribute_name(FlyString const& attribute_name) const
+{
+    return invalidation_scope_across_cascade_origins([&](RuleCache const& rule_cache) {
+        return rule_cache.invalidation_scope_by_attribute_name.get(attribute_name);
+    });
+}
+
+bool StyleComputer::may_reference_attribute_via_attr_function(FlyString const& attribute_name) const
+{
+    if (!m_author_rule_cache || !m_user_rule_cache || !m_user_agent_rule_cache)
+        return true;
+
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author }) {
+        auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
+        if (rule_cache.has_unknown_attr_function_references || rule_cache.attribute_names_referenced_by_attr_function.contains(attribute_name))
+            return true;
+    }
+    return false;
+}
+
 void StyleComputer::did_load_font(FlyString const&)
 {
     document().invalidate_style();
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <AK/EnumBits.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/Animations/KeyframeEffect.h>
@@ -79,6 +81,16 @@ enum class CascadeOrigin : u8 {
     Transition,
 };
 
+// Which elements may start or stop matching a selector when a class name, id or attribute changes on an element.
+enum class StyleInvalidationScope : u8 {
+    None = 0,
+    Self = 1 << 0,
+    Descendants = 1 << 1,
+    FollowingSiblings = 1 << 2,
+    PrecedingSiblings = 1 << 3,
+};
+AK_ENUM_BITWISE_OPERATORS(StyleInvalidationScope);
+
 struct MatchingRule {
     JS::GCPtr<DOM::ShadowRoot const> shadow_root;
     JS::GCPtr<CSSStyleRule const> rule;
@@ -134,6 +146,14 @@ public:
 
     void invalidate_rule_cache();
 
+    // NOTE: These return an empty Optional if the rule caches haven't been built yet, in which case the caller has to assume the worst.
+    Optional<StyleInvalidationScope> invalidation_scope_for_class_name(FlyString const&) const;
+    Optional<StyleInvalidationScope> invalidation_scope_for_id(FlyString const&) const;
+    Optional<StyleInvalidationScope> invalidation_scope_for_attribute_name(FlyString const&) const;
+
+    // Returns true if a declaration may read the given attribute through attr(), or if the rule caches haven't been built yet.
+    bool may_reference_attribute_via_attr_function(FlyString const&) const;
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -146,6 +166,15 @@ public:
 
     void set_viewport_rect(Badge<DOM::Document>, CSSPixelRect const& viewport_rect) { m_viewport_rect = viewport_rect; }
 
+    // NOTE: Style sharing relies on previous siblings having up-to-date style, so it's only enabled while the document is updating style.
+    void set_style_sharing_enabled(Badge<DOM::Document>, bool enabled) { m_style_sharing_enabled = enabled; }
+
+    struct StyleSharingStatistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+    StyleSharingStatistics take_style_sharing_statistics() { return exchange(m_style_sharing_statistics, {}); }
+
     enum class AnimationRefresh {
         No,
         Yes,
@@ -163,6 +192,8 @@ private:
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
+    RefPtr<StyleProperties> find_shareable_style(DOM::Element&) const;
+    [[nodiscard]] bool may_match_position_dependent_rules(DOM::Element const&) const;
     void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -207,6 +238,20 @@ private:
         Vector<MatchingRule> root_rules;
         Vector<MatchingRule> other_rules;
 
+        // Buckets holding rules that may match differently for otherwise identical siblings (e.g :first-child or `a + b`).
+        HashTable<FlyString> classes_with_position_dependent_rules;
+        HashTable<FlyString> tag_names_with_position_dependent_rules;
+        HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_names_with_position_dependent_rules;
+        bool has_position_dependent_other_rules { false };
+
+        HashMap<FlyString, StyleInvalidationScope, AK::ASCIICaseInsensitiveFlyStringTraits> invalidation_scope_by_class_name;
+        HashMap<FlyString, StyleInvalidationScope, AK::ASCIICaseInsensitiveFlyStringTraits> invalidation_scope_by_id;
+        HashMap<FlyString, StyleInvalidationScope, AK::ASCIICaseInsensitiveFlyStringTraits> invalidation_scope_by_attribute_name;
+
+        // Attributes that declarations read through attr(), which can change style without any selector mentioning them.
+        HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_names_referenced_by_attr_function;
+        bool has_unknown_attr_function_references { false };
+
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
     };
 
@@ -214,6 +259,9 @@ private:
 
     RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
 
+    template<typename GetScope>
+    Optional<StyleInvalidationScope> invalidation_scope_across_cascade_origins(GetScope) const;
+
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
     OwnPtr<RuleCache> m_user_agent_rule_cache;
@@ -228,6 +276,9 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    bool m_style_sharing_enabled { false };
+    mutable StyleSharingStatistics m_style_sharing_statistics;
 };
 
 class FontLoader : public ResourceClient {
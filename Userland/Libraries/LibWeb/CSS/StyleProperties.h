@@ -24,6 +24,8 @@ public:
 
     static NonnullRefPtr<StyleProperties> create() { return adopt_ref(*new StyleProperties); }
 
+    NonnullRefPtr<StyleProperties> clone() const;
+
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
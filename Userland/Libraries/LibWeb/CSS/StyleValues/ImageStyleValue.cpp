@@ -72,6 +72,7 @@ void ImageStyleValue::animate()
 
     m_current_frame_index = (m_current_frame_index + 1) % image_data->frame_count();
     auto current_frame_duration = image_data->frame_duration(m_current_frame_index);
+    image_data->did_advance_to_frame(this, m_current_frame_index);
 
     if (current_frame_duration != m_timer->interval())
         m_timer->restart(current_frame_duration);
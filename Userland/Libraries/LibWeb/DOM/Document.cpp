@@ -29,6 +29,7 @@
 #include <LibWeb/CSS/FontFaceSet.h>
 #include <LibWeb/CSS/MediaQueryList.h>
 #include <LibWeb/CSS/MediaQueryListEvent.h>
+#include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/SystemColor.h>
 #include <LibWeb/CSS/VisualViewport.h>
@@ -97,6 +98,7 @@
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Scripting/WindowEnvironmentSettingsObject.h>
+#include <LibWeb/HTML/SharedImageRequest.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HTML/WindowProxy.h>
@@ -469,6 +471,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
         visitor.visit(form_associated_element->form_associated_element_to_html_element());
 
     visitor.visit(m_potentially_named_elements);
+    m_element_by_id_map.visit_edges(visitor);
 
     for (auto& event : m_pending_animation_event_queue) {
         visitor.visit(event.event);
@@ -1211,7 +1214,16 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    style_computer().set_style_sharing_enabled({}, true);
     auto invalidation = update_style_recursively(*this, style_computer());
+    style_computer().set_style_sharing_enabled({}, false);
+
+    auto statistics = style_computer().take_style_sharing_statistics();
+    if constexpr (LIBWEB_STYLE_SHARING_DEBUG) {
+        if (auto lookups = statistics.hits + statistics.misses; lookups > 0)
+            dbgln("Style sharing: {} of {} eligible elements shared style ({}%)", statistics.hits, lookups, statistics.hits * 100 / lookups);
+    }
+
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout();
     } else {
@@ -3212,6 +3224,13 @@ void Document::abort()
     //           If this resulted in any instances of the fetch algorithm being canceled
     //           or any queued tasks or any network data getting discarded,
     //           then set document's salvageable state to false.
+    // NOTE: For now, we only cancel image fetches, since those may also hold on to a progressive decode in the image decoder.
+    for (auto& it : m_shared_image_requests) {
+        if (it.value && it.value->is_fetching()) {
+            it.value->abort();
+            m_salvageable = false;
+        }
+    }
 
     // 3. If document's during-loading navigation ID for WebDriver BiDi is non-null, then:
     if (m_navigation_id.has_value()) {
@@ -4444,6 +4463,33 @@ static void insert_in_tree_order(Vector<JS::NonnullGCPtr<DOM::Element>>& element
         elements.append(element);
 }
 
+Optional<CSS::SelectorList> Document::parse_selector_with_cache(StringView selector_text) const
+{
+    // NOTE: Scripts tend to use the same handful of selectors over and over, so we don't need a big cache.
+    static constexpr size_t max_cached_selector_lists = 128;
+
+    auto use = ++m_selector_cache_use_counter;
+    auto it = m_selector_cache.find(selector_text.hash(), [&](auto& entry) { return entry.key == selector_text; });
+    if (it != m_selector_cache.end()) {
+        it->value.last_use = use;
+        return it->value.selectors;
+    }
+
+    auto selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+
+    if (m_selector_cache.size() >= max_cached_selector_lists) {
+        auto least_recently_used = m_selector_cache.begin();
+        for (auto candidate = m_selector_cache.begin(); candidate != m_selector_cache.end(); ++candidate) {
+            if (candidate->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = candidate;
+        }
+        m_selector_cache.remove(least_recently_used);
+    }
+
+    m_selector_cache.set(MUST(String::from_utf8(selector_text)), CachedSelectorList { selectors, use });
+    return selectors;
+}
+
 void Document::element_id_changed(Badge<DOM::Element>, JS::NonnullGCPtr<DOM::Element> element)
 {
     for (auto* form_associated_element : m_form_associated_elements_with_form_attribute)
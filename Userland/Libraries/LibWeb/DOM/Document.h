@@ -621,6 +621,12 @@ public:
     void set_latest_entry(JS::GCPtr<HTML::SessionHistoryEntry> e) { m_latest_entry = e; }
 
     void element_id_changed(Badge<DOM::Element>, JS::NonnullGCPtr<DOM::Element> element);
+
+    ElementByIdMap* element_by_id_map() { return &m_element_by_id_map; }
+    ElementByIdMap const* element_by_id_map() const { return &m_element_by_id_map; }
+
+    // Parses selectors for querySelector() and friends, reusing the result for recently used selector strings.
+    Optional<CSS::SelectorList> parse_selector_with_cache(StringView) const;
     void element_with_id_was_added(Badge<DOM::Element>, JS::NonnullGCPtr<DOM::Element> element);
     void element_with_id_was_removed(Badge<DOM::Element>, JS::NonnullGCPtr<DOM::Element> element);
     void element_name_changed(Badge<DOM::Element>, JS::NonnullGCPtr<DOM::Element> element);
@@ -910,6 +916,15 @@ private:
 
     Vector<JS::NonnullGCPtr<DOM::Element>> m_potentially_named_elements;
 
+    ElementByIdMap m_element_by_id_map;
+
+    struct CachedSelectorList {
+        Optional<CSS::SelectorList> selectors;
+        u64 last_use { 0 };
+    };
+    mutable HashMap<String, CachedSelectorList> m_selector_cache;
+    mutable u64 m_selector_cache_use_counter { 0 };
+
     bool m_design_mode_enabled { false };
 
     bool m_needs_to_resolve_paint_only_properties { true };
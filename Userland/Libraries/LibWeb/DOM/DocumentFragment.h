@@ -30,6 +30,9 @@ public:
 
     void set_host(Element*);
 
+    virtual ElementByIdMap* element_by_id_map() { return nullptr; }
+    virtual ElementByIdMap const* element_by_id_map() const { return nullptr; }
+
 protected:
     explicit DocumentFragment(Document& document);
 
@@ -19,10 +19,12 @@
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleValues/IdentifierStyleValue.h>
 #include <LibWeb/CSS/StyleValues/NumberStyleValue.h>
+#include <LibWeb/CSS/StyleValues/UnresolvedStyleValue.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/DOMTokenList.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
@@ -446,7 +448,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     // AD-HOC: Run our own internal attribute change handler.
     attribute_changed(local_name, value);
-    invalidate_style_after_attribute_change(local_name);
+    invalidate_style_after_attribute_change(local_name, old_value, value);
 
     document().bump_dom_tree_version();
 }
@@ -456,11 +458,18 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const& v
     auto value_or_empty = value.value_or(String {});
 
     if (name == HTML::AttributeNames::id) {
+        auto* element_by_id_map = ElementByIdMap::for_root_of(*this);
+        if (element_by_id_map && m_id.has_value())
+            element_by_id_map->remove(*m_id, *this);
+
         if (!value.has_value())
             m_id = {};
         else
             m_id = value_or_empty;
 
+        if (element_by_id_map && m_id.has_value())
+            element_by_id_map->add(*m_id, *this);
+
         document().element_id_changed({}, *this);
     } else if (name == HTML::AttributeNames::name) {
         if (!value.has_value())
@@ -504,6 +513,20 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const& v
     }
 }
 
+static bool custom_properties_equal(HashMap<FlyString, CSS::StyleProperty> const& a, HashMap<FlyString, CSS::StyleProperty> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto const& [name, property] : a) {
+        auto other_property = b.get(name);
+        if (!other_property.has_value())
+            return false;
+        if (property.important != other_property->important || !property.value->equals(other_property->value))
+            return false;
+    }
+    return true;
+}
+
 static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(CSS::StyleProperties const& old_style, CSS::StyleProperties const& new_style)
 {
     CSS::RequiredInvalidationAfterStyleChange invalidation;
@@ -528,6 +551,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     set_needs_style_update(false);
     VERIFY(parent());
 
+    // NOTE: Computing the style replaces our custom properties, so hold on to the old ones to see whether they changed.
+    auto old_custom_properties = custom_properties({});
     auto new_computed_css_values = document().style_computer().compute_style(*this);
 
     // Tables must not inherit -libweb-* values for text-align.
@@ -544,6 +569,17 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     else
         invalidation = CSS::RequiredInvalidationAfterStyleChange::full();
 
+    // NOTE: Custom properties don't affect how we're rendered, but descendants may use var() to refer to them.
+    //       Since their computed values are only resolved when their style is computed, they all need to be restyled.
+    if (!custom_properties_equal(old_custom_properties, custom_properties({}))) {
+        for_each_child([](Node& child) {
+            child.invalidate_style();
+            return IterationDecision::Continue;
+        });
+        if (auto* shadow_root = shadow_root_internal())
+            shadow_root->invalidate_style();
+    }
+
     if (invalidation.is_none())
         return invalidation;
 
@@ -553,6 +589,9 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.repaint)
         document().set_needs_to_resolve_paint_only_properties();
 
+    // NOTE: Our children may inherit from the values that just changed, so they need to have their style recomputed too.
+    set_children_need_style_update();
+
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_css_values);
@@ -661,7 +700,7 @@ JS::GCPtr<ShadowRoot> Element::shadow_root() const
 WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(static_cast<ParentNode&>(const_cast<Element&>(*this))), selectors);
+    auto maybe_selectors = document().parse_selector_with_cache(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -680,7 +719,7 @@ WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 WebIDL::ExceptionOr<DOM::Element const*> Element::closest(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(static_cast<ParentNode&>(const_cast<Element&>(*this))), selectors);
+    auto maybe_selectors = document().parse_selector_with_cache(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -1007,8 +1046,11 @@ void Element::inserted()
 {
     Base::inserted();
 
-    if (m_id.has_value())
+    if (m_id.has_value()) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root_of(*this))
+            element_by_id_map->add(*m_id, *this);
         document().element_with_id_was_added({}, *this);
+    }
 
     if (m_name.has_value())
         document().element_with_name_was_added({}, *this);
@@ -1018,6 +1060,18 @@ void Element::removed_from(Node* node)
 {
     Base::removed_from(node);
 
+    // NOTE: Only the root of the removed subtree is told which parent it was removed from, so it takes care of
+    //       removing all the elements in the subtree from the id map of the tree they used to be in.
+    if (node) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root_of(*node)) {
+            for_each_in_inclusive_subtree_of_type<Element>([&](Element& element) {
+                if (element.m_id.has_value())
+                    element_by_id_map->remove(*element.m_id, element);
+                return TraversalDecision::Continue;
+            });
+        }
+    }
+
     if (m_id.has_value())
         document().element_with_id_was_removed({}, *this);
 
@@ -1783,13 +1837,88 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+bool Element::inline_style_references_attr_function() const
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    if (!m_inline_style)
+        return false;
+    auto is_unresolved_with_attr = [](CSS::StyleProperty const& property) {
+        return property.value->is_unresolved() && property.value->as_unresolved().contains_var_or_attr();
+    };
+    for (auto const& property : m_inline_style->properties()) {
+        if (is_unresolved_with_attr(property))
+            return true;
+    }
+    for (auto const& it : m_inline_style->custom_properties()) {
+        if (is_unresolved_with_attr(it.value))
+            return true;
+    }
+    return false;
+}
 
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value)
+{
     // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style();
+    if (document().needs_full_style_update())
+        return;
+
+    auto const& style_computer = document().style_computer();
+
+    // NOTE: An empty scope means the style computer couldn't tell, so we have to assume the worst.
+    Optional<CSS::StyleInvalidationScope> scope = style_computer.invalidation_scope_for_attribute_name(attribute_name);
+    auto include_scope = [&](Optional<CSS::StyleInvalidationScope> other_scope) {
+        if (scope.has_value() && other_scope.has_value())
+            scope = scope.value() | other_scope.value();
+        else
+            scope = {};
+    };
+
+    if (attribute_name == HTML::AttributeNames::class_) {
+        // Only the classes that were added or removed can change the result of selector matching.
+        auto old_class_attribute = old_value.value_or(String {});
+        auto old_classes = old_class_attribute.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+        for (auto old_class : old_classes) {
+            auto class_name = FlyString::from_utf8(old_class).release_value_but_fixme_should_propagate_errors();
+            if (!m_classes.contains_slow(class_name))
+                include_scope(style_computer.invalidation_scope_for_class_name(class_name));
+        }
+        for (auto const& class_name : m_classes) {
+            if (!old_classes.contains_slow(class_name.bytes_as_string_view()))
+                include_scope(style_computer.invalidation_scope_for_class_name(class_name));
+        }
+    } else if (attribute_name == HTML::AttributeNames::id) {
+        if (old_value.has_value())
+            include_scope(style_computer.invalidation_scope_for_id(FlyString { old_value.value() }));
+        if (new_value.has_value())
+            include_scope(style_computer.invalidation_scope_for_id(FlyString { new_value.value() }));
+    } else if (attribute_name == HTML::AttributeNames::style) {
+        include_scope(CSS::StyleInvalidationScope::Self);
+    } else if (attribute_name.bytes_as_string_view().starts_with("data-"sv) || attribute_name.bytes_as_string_view().starts_with("aria-"sv)) {
+        // data-* and aria-* attributes have no presentational hints, so only selectors (covered above) and attr() can see them.
+        // NOTE: A value read through attr() may end up in inherited properties (e.g via a custom property), so descendants are affected too.
+        if (style_computer.may_reference_attribute_via_attr_function(attribute_name) || inline_style_references_attr_function())
+            include_scope(CSS::StyleInvalidationScope::Self | CSS::StyleInvalidationScope::Descendants);
+    } else {
+        // Other attributes may affect style through presentational hints or pseudo-classes like :checked and :disabled,
+        // and some of them (e.g lang, dir, or disabled on a fieldset) affect descendants as well.
+        include_scope(CSS::StyleInvalidationScope::Self | CSS::StyleInvalidationScope::Descendants);
+    }
+
+    auto invalidation_scope = scope.value_or(CSS::StyleInvalidationScope::Self | CSS::StyleInvalidationScope::Descendants | CSS::StyleInvalidationScope::FollowingSiblings | CSS::StyleInvalidationScope::PrecedingSiblings);
+
+    if (has_flag(invalidation_scope, CSS::StyleInvalidationScope::Descendants))
+        invalidate_style();
+    else if (has_flag(invalidation_scope, CSS::StyleInvalidationScope::Self))
+        set_needs_style_update(true);
+
+    if (has_flag(invalidation_scope, CSS::StyleInvalidationScope::FollowingSiblings)) {
+        for (auto* sibling = next_element_sibling(); sibling; sibling = sibling->next_element_sibling())
+            sibling->invalidate_style();
+    }
+
+    if (has_flag(invalidation_scope, CSS::StyleInvalidationScope::PrecedingSiblings)) {
+        for (auto* sibling = previous_element_sibling(); sibling; sibling = sibling->previous_element_sibling())
+            sibling->invalidate_style();
+    }
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/ShadowRoot.h>
+
+namespace Web::DOM {
+
+ElementByIdMap* ElementByIdMap::for_root_of(Node& node)
+{
+    auto& root = node.root();
+    if (root.is_document())
+        return static_cast<Document&>(root).element_by_id_map();
+    if (root.is_shadow_root())
+        return static_cast<ShadowRoot&>(root).element_by_id_map();
+    return nullptr;
+}
+
+void ElementByIdMap::add(FlyString const& element_id, Element& element)
+{
+    auto& elements = m_elements_by_id.ensure(element_id);
+    if (elements.find_first_index_if([&](auto& existing_element) { return existing_element.ptr() == &element; }).has_value())
+        return;
+
+    // NOTE: Elements are usually inserted in tree order (e.g by the parser), so check the common case of appending first.
+    if (elements.is_empty() || (elements.last()->compare_document_position(element) & Node::DOCUMENT_POSITION_FOLLOWING)) {
+        elements.append(element);
+        return;
+    }
+
+    auto index = elements.find_first_index_if([&](auto& existing_element) {
+        return element.compare_document_position(*existing_element) & Node::DOCUMENT_POSITION_FOLLOWING;
+    });
+    if (index.has_value())
+        elements.insert(index.value(), element);
+    else
+        elements.append(element);
+}
+
+void ElementByIdMap::remove(FlyString const& element_id, Element& element)
+{
+    auto it = m_elements_by_id.find(element_id);
+    if (it == m_elements_by_id.end())
+        return;
+    it->value.remove_first_matching([&](auto& existing_element) { return existing_element.ptr() == &element; });
+    if (it->value.is_empty())
+        m_elements_by_id.remove(it);
+}
+
+JS::GCPtr<Element> ElementByIdMap::get(FlyString const& element_id) const
+{
+    auto it = m_elements_by_id.find(element_id);
+    if (it == m_elements_by_id.end())
+        return nullptr;
+    return it->value.first();
+}
+
+void ElementByIdMap::visit_edges(JS::Cell::Visitor& visitor)
+{
+    for (auto& it : m_elements_by_id)
+        visitor.visit(it.value);
+}
+
+}
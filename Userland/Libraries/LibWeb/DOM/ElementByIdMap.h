@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Maps ids to the elements with that id in a document or shadow tree, kept in tree order.
+// This lets getElementById() and friends avoid walking the whole tree.
+class ElementByIdMap {
+public:
+    // Returns the id map of the document or shadow root that the node is in, if any.
+    static ElementByIdMap* for_root_of(Node&);
+
+    void add(FlyString const& element_id, Element&);
+    void remove(FlyString const& element_id, Element&);
+
+    JS::GCPtr<Element> get(FlyString const& element_id) const;
+
+    template<typename Callback>
+    void for_each_element_with_id(FlyString const& element_id, Callback callback) const
+    {
+        auto it = m_elements_by_id.find(element_id);
+        if (it == m_elements_by_id.end())
+            return;
+        for (auto& element : it->value) {
+            if (callback(*element) == IterationDecision::Break)
+                return;
+        }
+    }
+
+    void visit_edges(JS::Cell::Visitor&);
+
+private:
+    HashMap<FlyString, Vector<JS::NonnullGCPtr<Element>>> m_elements_by_id;
+};
+
+}
@@ -964,6 +964,31 @@ EventTarget* Node::get_parent(Event const&)
     return parent();
 }
 
+// Marks the children (and shadow root contents) of this node for a style update, without walking the rest of the subtree.
+// This is used after our own style changed, so that children pick up the new inherited values.
+void Node::set_children_need_style_update()
+{
+    if (document().needs_full_style_update())
+        return;
+
+    auto mark_children = [](Node& parent) {
+        if (!parent.has_children())
+            return;
+        parent.m_child_needs_style_update = true;
+        parent.for_each_child([](Node& child) {
+            child.m_needs_style_update = true;
+            return IterationDecision::Continue;
+        });
+    };
+
+    mark_children(*this);
+    if (auto* shadow_root = is_element() ? static_cast<DOM::Element&>(*this).shadow_root_internal() : nullptr) {
+        m_child_needs_style_update = true;
+        shadow_root->m_needs_style_update = true;
+        mark_children(*shadow_root);
+    }
+}
+
 void Node::set_needs_style_update(bool value)
 {
     if (m_needs_style_update == value)
@@ -222,6 +222,7 @@ public:
     void set_child_needs_style_update(bool b) { m_child_needs_style_update = b; }
 
     void invalidate_style();
+    void set_children_need_style_update();
 
     void set_document(Badge<Document>, Document&);
 
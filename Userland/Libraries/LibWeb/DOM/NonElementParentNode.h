@@ -9,6 +9,7 @@
 #include <AK/FlyString.h>
 #include <AK/Forward.h>
 #include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/TreeNode.h>
@@ -20,6 +21,10 @@ class NonElementParentNode {
 public:
     JS::GCPtr<Element const> get_element_by_id(FlyString const& id) const
     {
+        // NOTE: Documents and shadow roots keep an index of their elements by id, other fragments have to be searched.
+        if (auto const* element_by_id_map = static_cast<NodeType const*>(this)->element_by_id_map())
+            return element_by_id_map->get(id);
+
         JS::GCPtr<Element const> found_element;
         static_cast<NodeType const*>(this)->template for_each_in_inclusive_subtree_of_type<Element>([&](auto& element) {
             if (element.id() == id) {
@@ -33,15 +38,7 @@ public:
 
     JS::GCPtr<Element> get_element_by_id(FlyString const& id)
     {
-        JS::GCPtr<Element> found_element;
-        static_cast<NodeType*>(this)->template for_each_in_inclusive_subtree_of_type<Element>([&](auto& element) {
-            if (element.id() == id) {
-                found_element = &element;
-                return TraversalDecision::Continue;
-            }
-            return TraversalDecision::Continue;
-        });
-        return found_element;
+        return const_cast<Element*>(const_cast<NonElementParentNode const&>(*this).get_element_by_id(id).ptr());
     }
 
 protected:
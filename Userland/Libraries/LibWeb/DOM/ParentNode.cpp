@@ -21,6 +21,60 @@ namespace Web::DOM {
 
 JS_DEFINE_ALLOCATOR(ParentNode);
 
+// If the selector list is just a single #id selector, returns that id.
+static Optional<FlyString> lone_id_selector(CSS::SelectorList const& selectors, Document const& document)
+{
+    // NOTE: In quirks mode, ids are matched case-insensitively, which the id map can't help with.
+    if (selectors.size() != 1 || document.in_quirks_mode())
+        return {};
+    auto const& compound_selectors = selectors.first()->compound_selectors();
+    if (compound_selectors.size() != 1)
+        return {};
+    auto const& simple_selectors = compound_selectors.first().simple_selectors;
+    if (simple_selectors.size() != 1 || simple_selectors.first().type != CSS::Selector::SimpleSelector::Type::Id)
+        return {};
+    return simple_selectors.first().name();
+}
+
+// Calls the callback for each descendant of the scoping root that matches the selectors, in tree order.
+template<typename Callback>
+static void for_each_descendant_matching_selectors(ParentNode& scoping_root, CSS::SelectorList const& selectors, Callback callback)
+{
+    // OPTIMIZATION: Look up a lone #id selector in the id map of our tree instead of matching it against every element.
+    if (auto id = lone_id_selector(selectors, scoping_root.document()); id.has_value()) {
+        if (auto* element_by_id_map = ElementByIdMap::for_root_of(scoping_root)) {
+            element_by_id_map->for_each_element_with_id(*id, [&](Element& element) {
+                if (!element.is_descendant_of(scoping_root))
+                    return IterationDecision::Continue;
+                return callback(element);
+            });
+            return;
+        }
+    }
+
+    // OPTIMIZATION: Selectors made of type, class, id and attribute selectors (like a lone .class or tag name) can be
+    //               matched by SelectorEngine::fast_matches(), which avoids most of the general matching machinery.
+    Vector<bool, 4> can_use_fast_matches;
+    can_use_fast_matches.ensure_capacity(selectors.size());
+    for (auto const& selector : selectors)
+        can_use_fast_matches.unchecked_append(SelectorEngine::can_use_fast_matches(selector));
+
+    // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
+    scoping_root.for_each_in_subtree_of_type<Element>([&](Element& element) {
+        for (size_t i = 0; i < selectors.size(); ++i) {
+            bool matches = can_use_fast_matches[i]
+                ? SelectorEngine::fast_matches(selectors[i], {}, element)
+                : SelectorEngine::matches(selectors[i], {}, element, {}, &scoping_root);
+            if (!matches)
+                continue;
+            if (callback(element) == IterationDecision::Break)
+                return TraversalDecision::Break;
+            break;
+        }
+        return TraversalDecision::Continue;
+    });
+}
+
 // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
 WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView selector_text)
 {
@@ -30,25 +84,19 @@ WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView se
     // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+    auto maybe_selectors = document().parse_selector_with_cache(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(realm(), "Failed to parse selector"_fly_string);
 
-    auto selectors = maybe_selectors.value();
+    auto const& selectors = maybe_selectors.value();
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     JS::GCPtr<Element> result;
-    // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
-    for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto& selector : selectors) {
-            if (SelectorEngine::matches(selector, {}, element, {}, this)) {
-                result = &element;
-                return TraversalDecision::Break;
-            }
-        }
-        return TraversalDecision::Continue;
+    for_each_descendant_matching_selectors(*this, selectors, [&](Element& element) {
+        result = &element;
+        return IterationDecision::Break;
     });
 
     return result;
@@ -62,24 +110,19 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<NodeList>> ParentNode::query_selector_all(S
     // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingContext(*this), selector_text);
+    auto maybe_selectors = document().parse_selector_with_cache(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(realm(), "Failed to parse selector"_fly_string);
 
-    auto selectors = maybe_selectors.value();
+    auto const& selectors = maybe_selectors.value();
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     Vector<JS::Handle<Node>> elements;
-    // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
-    for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto& selector : selectors) {
-            if (SelectorEngine::matches(selector, {}, element, {}, this)) {
-                elements.append(&element);
-            }
-        }
-        return TraversalDecision::Continue;
+    for_each_descendant_matching_selectors(*this, selectors, [&](Element& element) {
+        elements.append(&element);
+        return IterationDecision::Continue;
     });
 
     return StaticNodeList::create(realm(), move(elements));
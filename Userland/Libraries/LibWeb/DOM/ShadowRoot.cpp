@@ -92,6 +92,7 @@ void ShadowRoot::visit_edges(Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_style_sheets);
     visitor.visit(m_adopted_style_sheets);
+    m_element_by_id_map.visit_edges(visitor);
 }
 
 JS::NonnullGCPtr<WebIDL::ObservableArray> ShadowRoot::adopted_style_sheets() const
@@ -49,6 +49,10 @@ public:
 
     Vector<JS::NonnullGCPtr<Animations::Animation>> get_animations();
 
+    // ^DocumentFragment
+    virtual ElementByIdMap* element_by_id_map() override { return &m_element_by_id_map; }
+    virtual ElementByIdMap const* element_by_id_map() const override { return &m_element_by_id_map; }
+
     virtual void finalize() override;
 
 protected:
@@ -70,6 +74,8 @@ private:
 
     JS::GCPtr<CSS::StyleSheetList> m_style_sheets;
     mutable JS::GCPtr<WebIDL::ObservableArray> m_adopted_style_sheets;
+
+    ElementByIdMap m_element_by_id_map;
 };
 
 template<>
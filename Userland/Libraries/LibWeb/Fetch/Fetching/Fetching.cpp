@@ -1981,6 +1981,13 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
             }));
     }
 
+    // AD-HOC: Speculative preloads only start the load. Nobody is waiting for their response, the fetch that later
+    //         makes the exact same request picks it up from ResourceLoader.
+    if (request->is_speculative_preload()) {
+        ResourceLoader::the().preload(load_request);
+        return PendingResponse::create(vm, request, Infrastructure::Response::network_error(vm, "Speculative preload"_string));
+    }
+
     auto pending_response = PendingResponse::create(vm, request);
 
     if constexpr (WEB_FETCH_DEBUG) {
@@ -251,6 +251,7 @@ JS::NonnullGCPtr<Request> Request::clone(JS::Realm& realm) const
     new_request->set_done(m_done);
     new_request->set_timing_allow_failed(m_timing_allow_failed);
     new_request->set_buffer_policy(m_buffer_policy);
+    new_request->set_speculative_preload(m_speculative_preload);
 
     // 2. If request’s body is non-null, set newRequest’s body to the result of cloning request’s body.
     if (auto const* body = m_body.get_pointer<JS::NonnullGCPtr<Body>>())
@@ -335,6 +335,9 @@ public:
     [[nodiscard]] BufferPolicy buffer_policy() const { return m_buffer_policy; }
     void set_buffer_policy(BufferPolicy buffer_policy) { m_buffer_policy = buffer_policy; }
 
+    [[nodiscard]] bool is_speculative_preload() const { return m_speculative_preload; }
+    void set_speculative_preload(bool speculative_preload) { m_speculative_preload = speculative_preload; }
+
 private:
     explicit Request(JS::NonnullGCPtr<HeaderList>);
 
@@ -527,6 +530,10 @@ private:
     Vector<JS::NonnullGCPtr<Fetching::PendingResponse>> m_pending_responses;
 
     BufferPolicy m_buffer_policy { BufferPolicy::BufferResponse };
+
+    // AD-HOC: Set for fetches started by the speculative HTML parser. These only hand their request to ResourceLoader
+    //         as a preload, which a later fetch with the exact same request then picks up.
+    bool m_speculative_preload { false };
 };
 
 StringView request_destination_to_string(Request::Destination);
@@ -240,6 +240,7 @@ class DOMEventListener;
 class DOMImplementation;
 class DOMTokenList;
 class Element;
+class ElementByIdMap;
 class Event;
 class EventHandler;
 class EventTarget;
@@ -457,6 +458,7 @@ class PluginArray;
 class PromiseRejectionEvent;
 class SelectedFile;
 class SharedImageRequest;
+class SpeculativeHTMLParser;
 class Storage;
 class SubmitEvent;
 class TextMetrics;
@@ -598,6 +600,7 @@ class AutoplayAllowlist;
 
 namespace Web::Platform {
 class AudioCodecPlugin;
+struct DecodedImage;
 class Timer;
 }
 
@@ -8,30 +8,163 @@
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
+// How many frames of an animation decoded on demand we try to have ready ahead of the one being shown.
+static constexpr size_t frames_to_decode_ahead = 8;
+
+// How long we wait for the decoder to reply to a request for frames before asking again.
+static constexpr auto frame_request_timeout = Duration::from_seconds(2);
+
+// How long a consumer that stopped telling us which frame it's on keeps frames alive.
+static constexpr auto inactive_consumer_timeout = Duration::from_seconds(5);
+
 ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
 {
     return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, animated);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(JS::Realm& realm, Vector<Frame>&& frames, size_t frame_count, size_t loop_count, i64 image_id)
+{
+    VERIFY(!frames.is_empty());
+    VERIFY(frame_count >= frames.size());
+
+    // NOTE: Until we learn the actual durations of the frames we haven't seen yet, assume they match the first one.
+    auto first_frame_duration = frames.first().duration;
+    TRY(frames.try_ensure_capacity(frame_count));
+    while (frames.size() < frame_count)
+        frames.unchecked_append(Frame { .bitmap = nullptr, .duration = first_frame_duration });
+
+    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, true, image_id);
+}
+
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, Optional<i64> image_id)
     : m_frames(move(frames))
     , m_loop_count(loop_count)
     , m_animated(animated)
+    , m_size(m_frames.first().bitmap->size())
+    , m_image_id(image_id)
 {
 }
 
 AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
 
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+    if (m_image_id.has_value())
+        Platform::ImageCodecPlugin::the().stop_animation_decode(*m_image_id);
+}
+
 RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
-    return m_frames[frame_index].bitmap;
+    if (!m_image_id.has_value())
+        return m_frames[frame_index].bitmap;
+
+    // NOTE: If the frame hasn't been decoded yet, we show the closest one before it that has been, which makes the
+    //       animation stall for a moment instead of flickering.
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        if (auto const& bitmap = m_frames[(frame_index + m_frames.size() - i) % m_frames.size()].bitmap)
+            return bitmap;
+    }
+    return nullptr;
+}
+
+void AnimatedBitmapDecodedImageData::did_advance_to_frame(void const* consumer, size_t frame_index)
+{
+    if (!m_image_id.has_value() || frame_index >= m_frames.size())
+        return;
+
+    m_consumers.set(consumer, Consumer { .frame_index = frame_index, .last_update = MonotonicTime::now_coarse() });
+    forget_inactive_consumers();
+    request_missing_frames();
+}
+
+void AnimatedBitmapDecodedImageData::forget_inactive_consumers()
+{
+    auto now = MonotonicTime::now_coarse();
+    m_consumers.remove_all_matching([&](auto const&, Consumer const& consumer) {
+        return now - consumer.last_update > inactive_consumer_timeout;
+    });
+}
+
+void AnimatedBitmapDecodedImageData::request_missing_frames()
+{
+    if (m_pending_frame_request_time.has_value() && MonotonicTime::now_coarse() - *m_pending_frame_request_time < frame_request_timeout)
+        return;
+    m_pending_frame_request_time = {};
+
+    // Ask for the missing frame that the consumers are going to need the soonest.
+    Optional<size_t> most_urgent_frame_index;
+    size_t most_urgent_frame_distance = frames_to_decode_ahead;
+    for (auto const& [_, consumer] : m_consumers) {
+        for (size_t distance = 0; distance < most_urgent_frame_distance; ++distance) {
+            auto index = (consumer.frame_index + distance) % m_frames.size();
+            if (m_frames[index].bitmap)
+                continue;
+            most_urgent_frame_index = index;
+            most_urgent_frame_distance = distance;
+            break;
+        }
+    }
+    if (!most_urgent_frame_index.has_value())
+        return;
+
+    m_pending_frame_request_time = MonotonicTime::now_coarse();
+    Platform::ImageCodecPlugin::the().request_animation_frames(*m_image_id, *most_urgent_frame_index, frames_to_decode_ahead, [this](u32 start_frame_index, Vector<Platform::Frame>& frames) {
+        Vector<Frame> decoded_frames;
+        decoded_frames.ensure_capacity(frames.size());
+        for (auto& frame : frames) {
+            decoded_frames.append(Frame {
+                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
+                .duration = static_cast<int>(frame.duration),
+            });
+        }
+        did_decode_frames(start_frame_index, move(decoded_frames));
+    });
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_frames(size_t start_frame_index, Vector<Frame>&& frames)
+{
+    // NOTE: If decoding failed, we get no frames. We leave the request pending until it times out, so that we don't
+    //       keep asking the decoder for frames it can't decode.
+    if (frames.is_empty())
+        return;
+    m_pending_frame_request_time = {};
+
+    for (size_t i = 0; i < frames.size(); ++i)
+        m_frames[(start_frame_index + i) % m_frames.size()] = move(frames[i]);
+
+    drop_frames_not_about_to_be_shown();
+    request_missing_frames();
+}
+
+// Drops every frame that isn't about to be shown by any of the consumers, so that memory use doesn't depend on the
+// length of the animation. We keep the frame just before the one each consumer is on, as that may still be on screen.
+void AnimatedBitmapDecodedImageData::drop_frames_not_about_to_be_shown()
+{
+    forget_inactive_consumers();
+    if (m_consumers.is_empty())
+        return;
+
+    for (size_t index = 0; index < m_frames.size(); ++index) {
+        bool is_about_to_be_shown = false;
+        for (auto const& [_, consumer] : m_consumers) {
+            auto distance_ahead = (index + m_frames.size() + 1 - consumer.frame_index) % m_frames.size();
+            if (distance_ahead <= frames_to_decode_ahead * 2) {
+                is_about_to_be_shown = true;
+                break;
+            }
+        }
+        if (!is_about_to_be_shown)
+            m_frames[index].bitmap = nullptr;
+    }
 }
 
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
@@ -43,17 +176,17 @@ int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frames.first().bitmap->width();
+    return m_size.width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frames.first().bitmap->height();
+    return m_size.height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frames.first().bitmap->width()) / CSSPixels(m_frames.first().bitmap->height());
+    return CSSPixels(m_size.width()) / CSSPixels(m_size.height());
 }
 
 }
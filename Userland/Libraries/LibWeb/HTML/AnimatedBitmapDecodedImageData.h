@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/Time.h>
 #include <LibGfx/ImmutableBitmap.h>
 #include <LibWeb/HTML/DecodedImageData.h>
 
@@ -22,6 +24,11 @@ public:
     };
 
     static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+
+    // Creates image data for a long animation that only comes with its first few frames. The others are decoded on
+    // demand (through ImageCodecPlugin, using the given image ID), and only a small window of them is kept around.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create_with_frames_decoded_on_demand(JS::Realm&, Vector<Frame>&&, size_t frame_count, size_t loop_count, i64 image_id);
+
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -31,16 +38,40 @@ public:
     virtual size_t loop_count() const override { return m_loop_count; }
     virtual bool is_animated() const override { return m_animated; }
 
+    virtual void did_advance_to_frame(void const* consumer, size_t frame_index) override;
+
     virtual Optional<CSSPixels> intrinsic_width() const override;
     virtual Optional<CSSPixels> intrinsic_height() const override;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, Optional<i64> image_id = {});
+
+    virtual void finalize() override;
+
+    void forget_inactive_consumers();
+    void request_missing_frames();
+    void did_decode_frames(size_t start_frame_index, Vector<Frame>&&);
+    void drop_frames_not_about_to_be_shown();
 
+    // NOTE: When frames are decoded on demand, this has an entry for every frame, but only the frames close to the ones
+    //       currently being shown have a bitmap.
     Vector<Frame> m_frames;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+    Gfx::IntSize m_size;
+
+    Optional<i64> m_image_id;
+
+    struct Consumer {
+        size_t frame_index { 0 };
+        MonotonicTime last_update;
+    };
+    HashMap<void const*, Consumer> m_consumers;
+
+    // NOTE: We only have one request for frames in flight at a time. If its reply doesn't arrive in time (or at all,
+    //       e.g because the decoder crashed), we give up on it and are free to ask again.
+    Optional<MonotonicTime> m_pending_frame_request_time;
 };
 
 }
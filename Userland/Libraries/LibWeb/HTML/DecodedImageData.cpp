@@ -12,4 +12,8 @@ DecodedImageData::DecodedImageData() = default;
 
 DecodedImageData::~DecodedImageData() = default;
 
+void DecodedImageData::did_advance_to_frame(void const*, size_t)
+{
+}
+
 }
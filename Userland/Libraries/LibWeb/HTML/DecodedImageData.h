@@ -27,6 +27,11 @@ public:
     virtual size_t loop_count() const = 0;
     virtual bool is_animated() const = 0;
 
+    // Whatever steps through the frames of an animated image reports the frame it's on, so that image data that decodes
+    // its frames on demand can have the following ones ready in time. The consumer pointer is only used to tell
+    // consumers apart, and consumers that stop reporting are forgotten after a while.
+    virtual void did_advance_to_frame(void const* consumer, size_t frame_index);
+
     virtual Optional<CSSPixels> intrinsic_width() const = 0;
     virtual Optional<CSSPixels> intrinsic_height() const = 0;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const = 0;
@@ -23,6 +23,10 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(EventLoop);
 
+// NOTE: Incremental marking work done between tasks is kept well below a frame, so that it doesn't cause jank.
+static constexpr Duration incremental_marking_slice_budget = Duration::from_milliseconds(2);
+static constexpr Duration lazy_sweep_slice_budget = Duration::from_milliseconds(2);
+
 EventLoop::EventLoop()
 {
     m_task_queue = heap().allocate_without_realm<TaskQueue>(*this);
@@ -172,6 +176,12 @@ void EventLoop::process()
     // 8. Microtasks: Perform a microtask checkpoint.
     perform_a_microtask_checkpoint();
 
+    // NOTE: Dead cells are only swept while there are no tasks to run, since the cell allocators sweep whatever they need anyway.
+    if (heap().is_incremental_marking_in_progress())
+        heap().perform_incremental_marking_slice(incremental_marking_slice_budget);
+    else if (!oldest_task && heap().has_blocks_pending_sweep())
+        heap().perform_lazy_sweep_slice(lazy_sweep_slice_budget);
+
     // 9. Let hasARenderingOpportunity be false.
     [[maybe_unused]] bool has_a_rendering_opportunity = false;
 
@@ -363,7 +373,9 @@ void EventLoop::process()
     // FIXME:     2. If there are no tasks in the event loop's task queues and the WorkerGlobalScope object's closing flag is true, then destroy the event loop, aborting these steps, resuming the run a worker steps described in the Web workers section below.
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
-    if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint))
+    // NOTE: We also keep processing while incremental marking is in progress, so that it gets to finish while we're idle.
+    //       The same goes for destroying the cells that the last garbage collection found dead.
+    if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint) || heap().is_incremental_marking_in_progress() || heap().has_blocks_pending_sweep())
         schedule();
 
     // For each doc of docs, process top layer removals given doc.
@@ -650,6 +650,20 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            // https://html.spec.whatwg.org/multipage/images.html#img-inc
+            // If the user agent is able to determine image request's image's width and height, and image request is the
+            // current request, prepare image request for presentation given the img element and set image request's
+            // state to partially available.
+            if (image_request != m_current_request || image_request->state() == ImageRequest::State::CompletelyAvailable)
+                return;
+            VERIFY(image_request->shared_image_request());
+            image_request->set_image_data(image_request->shared_image_request()->image_data());
+            image_request->prepare_for_presentation(*this);
+            image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+            document().set_needs_layout();
         });
 }
 
@@ -1007,6 +1021,7 @@ void HTMLImageElement::animate()
 
     m_current_frame_index = (m_current_frame_index + 1) % image_data->frame_count();
     auto current_frame_duration = image_data->frame_duration(m_current_frame_index);
+    image_data->did_advance_to_frame(this, m_current_frame_index);
 
     if (current_frame_duration != m_animation_timer->interval()) {
         m_animation_timer->restart(current_frame_duration);
@@ -490,6 +490,10 @@ static NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_favicon(
     };
 
     auto on_successful_decode = [navigable = JS::Handle(*navigable)](Web::Platform::DecodedImage& decoded_image) -> ErrorOr<void> {
+        // NOTE: We only ever show the first frame of an animated favicon.
+        if (decoded_image.image_id.has_value())
+            Platform::ImageCodecPlugin::the().stop_animation_decode(*decoded_image.image_id);
+
         auto favicon_bitmap = decoded_image.frames[0].bitmap;
         dbgln_if(IMAGE_DECODER_DEBUG, "Decoded favicon, {}", favicon_bitmap->size());
 
@@ -195,6 +195,9 @@ WebIDL::ExceptionOr<void> HTMLVideoElement::determine_element_poster_frame(Optio
             (void)Platform::ImageCodecPlugin::the().decode_image(
                 image_data,
                 [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& image) -> ErrorOr<void> {
+                    // NOTE: The poster frame is the first frame of an animated image.
+                    if (image.image_id.has_value())
+                        Platform::ImageCodecPlugin::the().stop_animation_decode(*image.image_id);
                     if (!image.frames.is_empty())
                         strong_this->m_poster_frame = move(image.frames[0].bitmap);
                     return {};
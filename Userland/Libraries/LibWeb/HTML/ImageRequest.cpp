@@ -130,10 +130,10 @@ void ImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::Infrast
     m_shared_image_request->fetch_image(realm, request);
 }
 
-void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     VERIFY(m_shared_image_request);
-    m_shared_image_request->add_callbacks(move(on_finish), move(on_fail));
+    m_shared_image_request->add_callbacks(move(on_finish), move(on_fail), move(on_partial_image));
 }
 
 }
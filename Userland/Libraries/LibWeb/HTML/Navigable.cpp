@@ -139,6 +139,7 @@ void Navigable::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_active_session_history_entry);
     visitor.visit(m_container);
     visitor.visit(m_cursor_position);
+    visitor.visit(m_damaged_paintables);
     m_event_handler.visit_edges(visitor);
 }
 
@@ -2006,6 +2007,7 @@ void Navigable::set_viewport_rect(CSSPixelRect const& rect)
         }
         did_change = true;
         m_needs_repaint = true;
+        m_needs_full_repaint = true;
     }
 
     if (m_viewport_scroll_offset != rect.location()) {
@@ -2013,6 +2015,7 @@ void Navigable::set_viewport_rect(CSSPixelRect const& rect)
         scroll_offset_did_change();
         did_change = true;
         m_needs_repaint = true;
+        m_needs_full_repaint = true;
     }
 
     if (did_change && active_document()) {
@@ -2055,15 +2058,17 @@ void Navigable::set_size(CSSPixelSize size)
 
 void Navigable::set_needs_display()
 {
+    m_needs_full_repaint = true;
     set_needs_display(viewport_rect());
 }
 
-void Navigable::set_needs_display(CSSPixelRect const&)
+void Navigable::set_needs_display(CSSPixelRect const& rect)
 {
     // FIXME: Ignore updates outside the visible viewport rect.
     //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
 
     m_needs_repaint = true;
+    m_damage_rect = m_damage_rect.united(rect);
 
     if (is<TraversableNavigable>(*this)) {
         // Schedule the main thread event loop, which will, in turn, schedule a repaint.
@@ -2071,8 +2076,84 @@ void Navigable::set_needs_display(CSSPixelRect const&)
         return;
     }
 
-    if (container() && container()->paintable())
-        container()->paintable()->set_needs_display();
+    // NOTE: Our damage is taken (and mapped into the parent's coordinates) when the parent's damage is taken,
+    //       so the parent only has to know that it needs to be repainted.
+    if (auto parent = this->parent())
+        parent->set_needs_display(CSSPixelRect {});
+}
+
+static constexpr size_t max_damaged_paintables_per_frame = 256;
+
+void Navigable::set_needs_display(Painting::Paintable const& paintable)
+{
+    auto rect = paintable.absolute_damage_rect();
+    if (!rect.has_value()) {
+        set_needs_display();
+        return;
+    }
+
+    // NOTE: The paintable may end up painting somewhere else once its paint-only properties (like shadows) have been
+    //       resolved, so we damage both where it is now and where it is when the damage is taken.
+    if (!m_needs_full_repaint) {
+        // If this many things changed, repainting everything isn't going to be much slower anyway.
+        if (m_damaged_paintables.size() >= max_damaged_paintables_per_frame) {
+            m_damaged_paintables.clear();
+            m_needs_full_repaint = true;
+        } else {
+            m_damaged_paintables.append(paintable);
+        }
+    }
+    set_needs_display(*rect);
+}
+
+Optional<CSSPixelRect> Navigable::take_damage_rect()
+{
+    auto damage_rect = exchange(m_damage_rect, {});
+    auto damaged_paintables = move(m_damaged_paintables);
+    bool needs_full_repaint = exchange(m_needs_full_repaint, false);
+
+    if (auto document = active_document())
+        document->update_paint_and_hit_testing_properties_if_needed();
+
+    for (auto const& paintable : damaged_paintables) {
+        if (needs_full_repaint)
+            break;
+        auto rect = paintable->absolute_damage_rect();
+        if (!rect.has_value())
+            needs_full_repaint = true;
+        else
+            damage_rect = damage_rect.united(*rect);
+    }
+
+    // NOTE: Every nested navigable keeps track of its own damage, which we map from its viewport into our document here.
+    //       This has to happen even if we repaint everything anyway, so that their damage doesn't carry over to the next frame.
+    for (auto& child : child_navigables()) {
+        auto child_damage_rect = child->take_damage_rect();
+        if (needs_full_repaint)
+            continue;
+        auto container = child->container();
+        if (!container || !container->paintable_box())
+            continue;
+        auto const& container_box = *container->paintable_box();
+        if (!child_damage_rect.has_value() || !container_box.is_painted_at_absolute_rect()) {
+            auto rect = container_box.absolute_damage_rect();
+            if (!rect.has_value())
+                needs_full_repaint = true;
+            else
+                damage_rect = damage_rect.united(*rect);
+            continue;
+        }
+        auto container_rect = container_box.absolute_rect();
+        if (auto scroll_offset = container_box.enclosing_scroll_frame_offset(); scroll_offset.has_value())
+            container_rect.translate_by(scroll_offset.value());
+        damage_rect = damage_rect.united(child_damage_rect->translated(container_rect.location()).intersected(container_rect));
+    }
+
+    if (needs_full_repaint)
+        return {};
+
+    auto viewport_rect = this->viewport_rect();
+    return damage_rect.intersected(viewport_rect).translated(-viewport_rect.location());
 }
 
 // https://html.spec.whatwg.org/#rendering-opportunity
@@ -169,6 +169,11 @@ public:
 
     void set_needs_display();
     void set_needs_display(CSSPixelRect const&);
+    void set_needs_display(Painting::Paintable const&);
+
+    // Returns the part of the viewport (in viewport-relative CSS pixels) that has changed since the last call,
+    // or an empty Optional if the whole viewport needs to be repainted.
+    [[nodiscard]] Optional<CSSPixelRect> take_damage_rect();
 
     void set_is_popup(TokenizedFeature::Popup is_popup) { m_is_popup = is_popup; }
 
@@ -253,6 +258,11 @@ private:
 
     bool m_needs_repaint { false };
 
+    // Damage is accumulated in document coordinates until the next frame is painted.
+    bool m_needs_full_repaint { true };
+    CSSPixelRect m_damage_rect;
+    Vector<JS::NonnullGCPtr<Painting::Paintable const>> m_damaged_paintables;
+
     Web::EventHandler m_event_handler;
 
     JS::GCPtr<DOM::Position> m_cursor_position;
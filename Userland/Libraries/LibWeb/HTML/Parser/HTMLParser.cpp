@@ -33,6 +33,7 @@
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Infra/CharacterTypes.h>
@@ -171,49 +172,105 @@ void HTMLParser::visit_edges(Cell::Visitor& visitor)
 
 void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
+    (void)run_until({}, stop_at_insertion_point);
+}
+
+HTMLParser::RunResult HTMLParser::run_until(Optional<MonotonicTime> deadline, HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
+{
+    // NOTE: Looking at the clock for every single token would be wasteful.
+    size_t const tokens_between_deadline_checks = s_incremental_parsing_yields_after_every_token ? 1 : 64;
+    size_t tokens_until_deadline_check = tokens_between_deadline_checks;
+
     for (;;) {
         // FIXME: Find a better way to say that we come from Document::close() and want to process EOF.
         if (!m_tokenizer.is_eof_inserted() && m_tokenizer.is_insertion_point_reached())
-            return;
+            return RunResult::Finished;
 
         auto optional_token = m_tokenizer.next_token(stop_at_insertion_point);
         if (!optional_token.has_value())
             break;
         auto& token = optional_token.value();
 
-        dbgln_if(HTML_PARSER_DEBUG, "[{}] {}", insertion_mode_name(), token.to_string());
-
-        // https://html.spec.whatwg.org/multipage/parsing.html#tree-construction-dispatcher
-        // As each token is emitted from the tokenizer, the user agent must follow the appropriate steps from the following list, known as the tree construction dispatcher:
-        if (m_stack_of_open_elements.is_empty()
-            || adjusted_current_node().namespace_uri() == Namespace::HTML
-            || (is_html_integration_point(adjusted_current_node()) && (token.is_start_tag() || token.is_character()))
-            || token.is_end_of_file()) {
-            // -> If the stack of open elements is empty
-            // -> If the adjusted current node is an element in the HTML namespace
-            // FIXME: -> If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
-            // FIXME: -> If the adjusted current node is a MathML text integration point and the token is a character token
-            // FIXME: -> If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
-            // -> If the adjusted current node is an HTML integration point and the token is a start tag
-            // -> If the adjusted current node is an HTML integration point and the token is a character token
-            // -> If the token is an end-of-file token
-
-            // Process the token according to the rules given in the section corresponding to the current insertion mode in HTML content.
-            process_using_the_rules_for(m_insertion_mode, token);
+        if (token.is_character_run() && !can_process_character_run_in_bulk()) {
+            // NOTE: The tree construction rules are written in terms of single character tokens. Unless the current
+            //       insertion mode can take the whole run at once, feed it to the dispatcher one code point at a time.
+            token.for_each_code_point([&](u32 code_point) {
+                auto character_token = HTMLToken::make_character(code_point);
+                process_token(character_token);
+            });
         } else {
-            // -> Otherwise
-
-            // Process the token according to the rules given in the section for parsing tokens in foreign content.
-            process_using_the_rules_for_foreign_content(token);
+            process_token(token);
         }
 
         if (m_stop_parsing) {
             dbgln_if(HTML_PARSER_DEBUG, "Stop parsing{}! :^)", m_parsing_fragment ? " fragment" : "");
             break;
         }
+
+        if (deadline.has_value() && --tokens_until_deadline_check == 0) {
+            tokens_until_deadline_check = tokens_between_deadline_checks;
+            if (MonotonicTime::now() >= *deadline) {
+                // NOTE: Flushing copies all of the text that's already in the text node, so when a long run of text spans
+                //       many time slices, we only flush once the pending characters have caught up with it. This keeps
+                //       the total amount of copying linear in the length of the text. The price is that whatever runs
+                //       between time slices may not see all of the text that has been parsed so far.
+                if (m_character_insertion_node && m_character_insertion_builder.length() >= m_character_insertion_node->data().bytes().size())
+                    flush_character_insertions();
+                return RunResult::ReachedDeadline;
+            }
+        }
     }
 
     flush_character_insertions();
+    return RunResult::Finished;
+}
+
+void HTMLParser::process_token(HTMLToken& token)
+{
+    dbgln_if(HTML_PARSER_DEBUG, "[{}] {}", insertion_mode_name(), token.to_string());
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#tree-construction-dispatcher
+    // As each token is emitted from the tokenizer, the user agent must follow the appropriate steps from the following list, known as the tree construction dispatcher:
+    if (m_stack_of_open_elements.is_empty()
+        || adjusted_current_node().namespace_uri() == Namespace::HTML
+        || (is_html_integration_point(adjusted_current_node()) && (token.is_start_tag() || token.is_character()))
+        || token.is_end_of_file()) {
+        // -> If the stack of open elements is empty
+        // -> If the adjusted current node is an element in the HTML namespace
+        // FIXME: -> If the adjusted current node is a MathML text integration point and the token is a start tag whose tag name is neither "mglyph" nor "malignmark"
+        // FIXME: -> If the adjusted current node is a MathML text integration point and the token is a character token
+        // FIXME: -> If the adjusted current node is a MathML annotation-xml element and the token is a start tag whose tag name is "svg"
+        // -> If the adjusted current node is an HTML integration point and the token is a start tag
+        // -> If the adjusted current node is an HTML integration point and the token is a character token
+        // -> If the token is an end-of-file token
+
+        // Process the token according to the rules given in the section corresponding to the current insertion mode in HTML content.
+        process_using_the_rules_for(m_insertion_mode, token);
+    } else {
+        // -> Otherwise
+
+        // Process the token according to the rules given in the section for parsing tokens in foreign content.
+        process_using_the_rules_for_foreign_content(token);
+    }
+}
+
+// When ignoring a leading U+000A LINE FEED (LF) character token, the rest of its character run still has to be processed.
+void HTMLParser::process_character_run_after_ignored_newline(HTMLToken const& token)
+{
+    if (!token.is_character_run())
+        return;
+    auto remaining_run = MUST(token.character_run().substring_from_byte_offset(1));
+    auto remaining_token = HTMLToken::make_character_run(move(remaining_run));
+    process_using_the_rules_for(m_insertion_mode, remaining_token);
+}
+
+bool HTMLParser::can_process_character_run_in_bulk()
+{
+    // Character runs go to the rules for HTML content (see process_token()), and only "in body" and "text" know how to
+    // insert a whole run of characters at once.
+    if (!m_stack_of_open_elements.is_empty() && adjusted_current_node().namespace_uri() != Namespace::HTML && !is_html_integration_point(adjusted_current_node()))
+        return false;
+    return m_insertion_mode == InsertionMode::InBody || m_insertion_mode == InsertionMode::Text;
 }
 
 void HTMLParser::run(const URL::URL& url, HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
@@ -225,6 +282,44 @@ void HTMLParser::run(const URL::URL& url, HTMLTokenizer::StopAtInsertionPoint st
     m_document->detach_parser({});
 }
 
+// How long we keep parsing before giving the event loop a chance to run other tasks.
+static constexpr auto incremental_parsing_time_slice = Duration::from_milliseconds(16);
+
+void HTMLParser::set_incremental_parsing_yields_after_every_token_for_testing(bool yields_after_every_token)
+{
+    s_incremental_parsing_yields_after_every_token = yields_after_every_token;
+}
+
+void HTMLParser::run_incrementally(URL::URL const& url)
+{
+    m_document->set_url(url);
+    m_document->set_source(MUST(String::from_byte_string(m_tokenizer.source())));
+    continue_running_incrementally();
+}
+
+void HTMLParser::continue_running_incrementally()
+{
+    // NOTE: If a script aborted us (e.g. through document.open()) while we were waiting, the parser is done for good.
+    if (m_aborted)
+        return;
+
+    // NOTE: Between time slices, the insertion point is undefined and the parser isn't blocked on a script, which is
+    //       just the state it would be in while waiting for more data from the network. So whatever runs in the
+    //       meantime sees the same thing it would see in a browser that parses as the data comes in.
+    auto deadline = MonotonicTime::now();
+    if (!s_incremental_parsing_yields_after_every_token)
+        deadline = deadline + incremental_parsing_time_slice;
+    if (run_until(deadline, HTMLTokenizer::StopAtInsertionPoint::No) == RunResult::ReachedDeadline) {
+        queue_global_task(HTML::Task::Source::Networking, *m_document, JS::create_heap_function(heap(), [parser = JS::NonnullGCPtr { *this }] {
+            parser->continue_running_incrementally();
+        }));
+        return;
+    }
+
+    the_end(*m_document, this);
+    m_document->detach_parser({});
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTMLParser> parser)
 {
@@ -1021,11 +1116,18 @@ static bool is_empty_text_node(DOM::Node const* node)
     return node && node->is_text() && static_cast<DOM::Text const*>(node)->data().is_empty();
 }
 
+// NOTE: Besides empty text nodes, we keep appending to the text node that we have been inserting characters into,
+//       even after its pending characters have been flushed (e.g. because the parser returned to the event loop).
+bool HTMLParser::can_insert_characters_into(DOM::Node const* node) const
+{
+    return is_empty_text_node(node) || (node && node == m_character_insertion_node.ptr());
+}
+
 DOM::Text* HTMLParser::find_character_insertion_node()
 {
     auto adjusted_insertion_location = find_appropriate_place_for_inserting_node();
     if (adjusted_insertion_location.insert_before_sibling) {
-        if (is_empty_text_node(adjusted_insertion_location.insert_before_sibling->previous_sibling()))
+        if (can_insert_characters_into(adjusted_insertion_location.insert_before_sibling->previous_sibling()))
             return static_cast<DOM::Text*>(adjusted_insertion_location.insert_before_sibling->previous_sibling());
         auto new_text_node = realm().heap().allocate<DOM::Text>(realm(), document(), String {});
         adjusted_insertion_location.parent->insert_before(*new_text_node, *adjusted_insertion_location.insert_before_sibling);
@@ -1033,7 +1135,7 @@ DOM::Text* HTMLParser::find_character_insertion_node()
     }
     if (adjusted_insertion_location.parent->is_document())
         return nullptr;
-    if (is_empty_text_node(adjusted_insertion_location.parent->last_child()))
+    if (can_insert_characters_into(adjusted_insertion_location.parent->last_child()))
         return static_cast<DOM::Text*>(adjusted_insertion_location.parent->last_child());
     auto new_text_node = realm().heap().allocate<DOM::Text>(realm(), document(), String {});
     MUST(adjusted_insertion_location.parent->append_child(*new_text_node));
@@ -1044,7 +1146,14 @@ void HTMLParser::flush_character_insertions()
 {
     if (m_character_insertion_builder.is_empty())
         return;
-    m_character_insertion_node->set_data(MUST(m_character_insertion_builder.to_string()));
+    if (!m_character_insertion_node->data().is_empty()) {
+        StringBuilder builder;
+        builder.append(m_character_insertion_node->data());
+        builder.append(m_character_insertion_builder.string_view());
+        m_character_insertion_node->set_data(MUST(builder.to_string()));
+    } else {
+        m_character_insertion_node->set_data(MUST(m_character_insertion_builder.to_string()));
+    }
     m_character_insertion_builder.clear();
 }
 
@@ -1065,6 +1174,23 @@ void HTMLParser::insert_character(u32 data)
     m_character_insertion_builder.append(Utf32View { &data, 1 });
 }
 
+// Inserts all characters of a character token, which may be a whole run of them.
+void HTMLParser::insert_characters(HTMLToken const& token)
+{
+    if (!token.is_character_run()) {
+        insert_character(token.code_point());
+        return;
+    }
+
+    // NOTE: Every character in the run would end up in the same place, so we only have to find it once.
+    auto node = find_character_insertion_node();
+    if (node != m_character_insertion_node.ptr()) {
+        flush_character_insertions();
+        m_character_insertion_node = JS::make_handle(node);
+    }
+    m_character_insertion_builder.append(token.character_run());
+}
+
 void HTMLParser::handle_after_head(HTMLToken& token)
 {
     if (token.is_character() && token.is_parser_whitespace()) {
@@ -1563,7 +1689,8 @@ void HTMLParser::handle_in_body(HTMLToken& token)
 {
     if (token.is_character()) {
         // -> A character token that is U+0000 NULL
-        if (token.code_point() == 0) {
+        // NOTE: Character runs never contain U+0000 NULL.
+        if (!token.is_character_run() && token.code_point() == 0) {
             // Parse error. Ignore the token.
             log_parse_error();
             return;
@@ -1575,7 +1702,7 @@ void HTMLParser::handle_in_body(HTMLToken& token)
             reconstruct_the_active_formatting_elements();
 
             // Insert the token's character.
-            insert_character(token.code_point());
+            insert_characters(token);
             return;
         }
 
@@ -1585,7 +1712,7 @@ void HTMLParser::handle_in_body(HTMLToken& token)
         reconstruct_the_active_formatting_elements();
 
         // Insert the token's character.
-        insert_character(token.code_point());
+        insert_characters(token);
 
         // Set the frameset-ok flag to "not ok".
         m_frameset_ok = false;
@@ -1804,8 +1931,9 @@ void HTMLParser::handle_in_body(HTMLToken& token)
         // then ignore that token and move on to the next one.
         // (Newlines at the start of pre blocks are ignored as an authoring convenience.)
         auto next_token = m_tokenizer.next_token();
-        if (next_token.has_value() && next_token.value().is_character() && next_token.value().code_point() == '\n') {
+        if (next_token.has_value() && next_token.value().is_character() && next_token.value().first_code_point() == '\n') {
             // Ignore it.
+            process_character_run_after_ignored_newline(next_token.value());
         } else {
             process_using_the_rules_for(m_insertion_mode, next_token.value());
         }
@@ -2363,8 +2491,9 @@ void HTMLParser::handle_in_body(HTMLToken& token)
         m_insertion_mode = InsertionMode::Text;
 
         // FIXME: This step is not in the spec.
-        if (next_token.has_value() && next_token.value().is_character() && next_token.value().code_point() == '\n') {
+        if (next_token.has_value() && next_token.value().is_character() && next_token.value().first_code_point() == '\n') {
             // Ignore it.
+            process_character_run_after_ignored_newline(next_token.value());
         } else {
             process_using_the_rules_for(m_insertion_mode, next_token.value());
         }
@@ -2743,11 +2872,50 @@ void HTMLParser::decrement_script_nesting_level()
     --m_script_nesting_level;
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: Since the whole document is available to the tokenizer at this point, a single speculative parser can scan
+    //       all of the remaining input. Later scripts only make it continue where it left off.
+    if (!m_speculative_html_parser)
+        m_speculative_html_parser = make<SpeculativeHTMLParser>(*m_document, m_tokenizer.unconsumed_input());
+    if (m_speculative_html_parser->is_finished() || m_speculative_html_parser_is_active)
+        return;
+
+    m_speculative_html_parser_is_active = true;
+    continue_running_the_speculative_html_parser();
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#stop-the-speculative-html-parser
+void HTMLParser::stop_the_speculative_html_parser()
+{
+    m_speculative_html_parser_is_active = false;
+}
+
+// How long the speculative parser runs before it lets the event loop handle other tasks, like the responses that the
+// parser is waiting for.
+static constexpr auto speculative_parsing_time_slice = Duration::from_milliseconds(2);
+
+void HTMLParser::continue_running_the_speculative_html_parser()
+{
+    if (!m_speculative_html_parser_is_active)
+        return;
+
+    if (m_speculative_html_parser->run_until(MonotonicTime::now() + speculative_parsing_time_slice) == SpeculativeHTMLParser::RunResult::Finished) {
+        m_speculative_html_parser_is_active = false;
+        return;
+    }
+
+    queue_global_task(HTML::Task::Source::Networking, *m_document, JS::create_heap_function(heap(), [parser = JS::NonnullGCPtr { *this }] {
+        parser->continue_running_the_speculative_html_parser();
+    }));
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-main-incdata
 void HTMLParser::handle_text(HTMLToken& token)
 {
     if (token.is_character()) {
-        insert_character(token.code_point());
+        insert_characters(token);
         return;
     }
     if (token.is_end_of_file()) {
@@ -2826,7 +2994,11 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The speculative parser only helps while we are waiting for the script (or the style sheets
+                    //       blocking it) to load, so we don't bother with it when the script can run right away.
+                    if (m_document->has_a_style_sheet_that_is_blocking_scripts() || !the_script->is_ready_to_be_parser_executed())
+                        start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2845,7 +3017,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    stop_the_speculative_html_parser();
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4752,7 +4925,8 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    stop_the_speculative_html_parser();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
@@ -56,6 +56,14 @@ public:
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
     void run(const URL::URL&, HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
 
+    // Like run(url), but returns to the event loop every now and then, so that parsing a large document doesn't keep
+    // input events, timers and rendering waiting until it's done. "The end" runs once all of the input is consumed.
+    void run_incrementally(URL::URL const&);
+
+    // Makes run_incrementally() return to the event loop after every token, so tests can check that parsing across
+    // time slices gives the same result as parsing in one go.
+    static void set_incremental_parsing_yields_after_every_token_for_testing(bool);
+
     static void the_end(JS::NonnullGCPtr<DOM::Document>, JS::GCPtr<HTMLParser> = nullptr);
 
     DOM::Document& document();
@@ -131,6 +139,7 @@ private:
     AdjustedInsertionLocation find_appropriate_place_for_inserting_node(JS::GCPtr<DOM::Element> override_target = nullptr);
 
     DOM::Text* find_character_insertion_node();
+    bool can_insert_characters_into(DOM::Node const*) const;
     void flush_character_insertions();
     JS::NonnullGCPtr<DOM::Element> insert_foreign_element(HTMLToken const&, Optional<FlyString> const& namespace_);
     JS::NonnullGCPtr<DOM::Element> insert_html_element(HTMLToken const&);
@@ -138,15 +147,29 @@ private:
     DOM::Element& adjusted_current_node();
     DOM::Element& node_before_current_node();
     void insert_character(u32 data);
+    void insert_characters(HTMLToken const&);
     void insert_comment(HTMLToken&);
     void reconstruct_the_active_formatting_elements();
     void close_a_p_element();
+    enum class RunResult {
+        Finished,
+        ReachedDeadline,
+    };
+    RunResult run_until(Optional<MonotonicTime> deadline, HTMLTokenizer::StopAtInsertionPoint);
+    void continue_running_incrementally();
+
+    void process_token(HTMLToken&);
     void process_using_the_rules_for(InsertionMode, HTMLToken&);
+    void process_character_run_after_ignored_newline(HTMLToken const&);
+    bool can_process_character_run_in_bulk();
     void process_using_the_rules_for_foreign_content(HTMLToken&);
     void parse_generic_raw_text_element(HTMLToken&);
     void increment_script_nesting_level();
     void decrement_script_nesting_level();
     void reset_the_insertion_mode_appropriately();
+    void start_the_speculative_html_parser();
+    void stop_the_speculative_html_parser();
+    void continue_running_the_speculative_html_parser();
 
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
@@ -196,8 +219,15 @@ private:
 
     Vector<HTMLToken> m_pending_table_character_tokens;
 
+    // NOTE: The speculative parser is kept around after it has been stopped, so that it can pick up where it left off
+    //       when the next parser-blocking script comes along, instead of scanning the same input again.
+    OwnPtr<SpeculativeHTMLParser> m_speculative_html_parser;
+    bool m_speculative_html_parser_is_active { false };
+
     JS::GCPtr<DOM::Text> m_character_insertion_node;
     StringBuilder m_character_insertion_builder;
+
+    static inline bool s_incremental_parsing_yields_after_every_token { false };
 };
 
 RefPtr<CSS::StyleValue> parse_dimension_value(StringView);
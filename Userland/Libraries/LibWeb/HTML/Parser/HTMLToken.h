@@ -10,6 +10,7 @@
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/OwnPtr.h>
+#include <AK/String.h>
 #include <AK/Types.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
@@ -68,6 +69,15 @@ public:
         return token;
     }
 
+    // A run of consecutive character tokens that the tree builder is allowed to process in one go.
+    // NOTE: A run never contains U+0000 NULL, and is either all parser whitespace or contains no parser whitespace at all.
+    static HTMLToken make_character_run(String run)
+    {
+        HTMLToken token { Type::Character };
+        token.m_data.set(move(run));
+        return token;
+    }
+
     static HTMLToken make_start_tag(FlyString const& tag_name)
     {
         HTMLToken token { Type::StartTag };
@@ -109,12 +119,39 @@ public:
         return m_data.get<u32>();
     }
 
-    bool is_parser_whitespace() const
+    bool is_character_run() const { return m_data.has<String>(); }
+
+    String const& character_run() const
+    {
+        VERIFY(is_character());
+        return m_data.get<String>();
+    }
+
+    // The first code point of a single character token or a character run.
+    u32 first_code_point() const
+    {
+        VERIFY(is_character());
+        if (is_character_run())
+            return *character_run().code_points().begin();
+        return code_point();
+    }
+
+    template<typename Callback>
+    void for_each_code_point(Callback callback) const
+    {
+        VERIFY(is_character());
+        if (!is_character_run()) {
+            callback(code_point());
+            return;
+        }
+        for (auto code_point : character_run().code_points())
+            callback(code_point);
+    }
+
+    static constexpr bool is_parser_whitespace(u32 code_point)
     {
         // NOTE: The parser considers '\r' to be whitespace, while the tokenizer does not.
-        if (!is_character())
-            return false;
-        switch (code_point()) {
+        switch (code_point) {
         case '\t':
         case '\n':
         case '\f':
@@ -126,6 +163,14 @@ public:
         }
     }
 
+    bool is_parser_whitespace() const
+    {
+        if (!is_character())
+            return false;
+        // NOTE: Character runs are never a mix of whitespace and non-whitespace, so looking at the first code point is enough.
+        return is_parser_whitespace(first_code_point());
+    }
+
     void set_code_point(u32 code_point)
     {
         VERIFY(is_character());
@@ -360,7 +405,8 @@ private:
     // Type::Comment (comment data)
     String m_comment_data;
 
-    Variant<Empty, u32, OwnPtr<DoctypeData>, OwnPtr<Vector<Attribute>>> m_data {};
+    // Type::Character holds either a single code point or a run of them.
+    Variant<Empty, u32, String, OwnPtr<DoctypeData>, OwnPtr<Vector<Attribute>>> m_data {};
 
     Position m_start_position;
     Position m_end_position;
@@ -162,6 +162,12 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+#define EMIT_CURRENT_CHARACTER_RUN                                                                                 \
+    do {                                                                                                           \
+        m_queued_tokens.enqueue(consume_character_run(current_input_character.value(), stop_at_insertion_point)); \
+        return m_queued_tokens.dequeue();                                                                          \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -218,6 +224,41 @@ Optional<u32> HTMLTokenizer::next_code_point()
     return code_point;
 }
 
+HTMLToken HTMLTokenizer::consume_character_run(u32 first_code_point, StopAtInsertionPoint stop_at_insertion_point)
+{
+    // NOTE: Only the tree builder knows how to handle character runs, other clients (like syntax highlighters)
+    //       expect one token per code point.
+    if (!m_parser)
+        return HTMLToken::make_character(first_code_point);
+
+    // The run ends at anything that the current state does not simply emit as a character, and at the boundary
+    // between whitespace and non-whitespace, since the tree builder treats those differently in many places.
+    bool const stops_at_ampersand = m_state == State::Data || m_state == State::RCDATA;
+    bool const is_whitespace_run = HTMLToken::is_parser_whitespace(first_code_point);
+
+    auto can_extend_run = [&](u32 code_point) {
+        if (code_point == 0 || code_point == '<' || (code_point == '&' && stops_at_ampersand))
+            return false;
+        // NOTE: U+000D CR is whitespace both before and after newline normalization.
+        return HTMLToken::is_parser_whitespace(code_point) == is_whitespace_run;
+    };
+
+    while (m_utf8_iterator != m_utf8_view.end() && can_extend_run(*m_utf8_iterator)) {
+        if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached())
+            break;
+        if (m_character_run_builder.is_empty())
+            m_character_run_builder.append_code_point(first_code_point);
+        m_character_run_builder.append_code_point(*next_code_point());
+    }
+
+    if (m_character_run_builder.is_empty())
+        return HTMLToken::make_character(first_code_point);
+
+    auto run = MUST(m_character_run_builder.to_string());
+    m_character_run_builder.clear();
+    return HTMLToken::make_character_run(move(run));
+}
+
 void HTMLTokenizer::skip(size_t count)
 {
     if (!m_source_positions.is_empty())
@@ -300,7 +341,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_RUN;
                 }
             }
             END_STATE
@@ -1910,7 +1951,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_RUN;
                 }
             }
             END_STATE
@@ -2029,7 +2070,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_RUN;
                 }
             }
             END_STATE
@@ -2148,7 +2189,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_RUN;
                 }
             }
             END_STATE
@@ -2167,7 +2208,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_RUN;
                 }
             }
             END_STATE
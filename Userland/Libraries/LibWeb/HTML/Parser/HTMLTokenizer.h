@@ -130,6 +130,9 @@ public:
 
     ByteString source() const { return m_decoded_input; }
 
+    // The part of the input that has not been consumed yet.
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -157,6 +160,7 @@ private:
     Optional<u32> peek_code_point(size_t offset) const;
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
+    HTMLToken consume_character_run(u32 first_code_point, StopAtInsertionPoint);
     bool current_end_tag_token_is_appropriate() const;
     String consume_current_builder();
 
@@ -203,6 +207,7 @@ private:
 
     HTMLToken m_current_token;
     StringBuilder m_current_builder;
+    StringBuilder m_character_run_builder;
 
     Optional<ByteString> m_last_emitted_start_tag_name;
 
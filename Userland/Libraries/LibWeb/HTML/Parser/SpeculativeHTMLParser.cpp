@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/SourceSet.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/ReferrerPolicy/ReferrerPolicy.h>
+
+namespace Web::HTML {
+
+SpeculativeHTMLParser::SpeculativeHTMLParser(DOM::Document& document, StringView input)
+    : m_document(document)
+    , m_tokenizer(input, "UTF-8"sv)
+    , m_base_url(document.base_url())
+{
+}
+
+SpeculativeHTMLParser::RunResult SpeculativeHTMLParser::run_until(MonotonicTime deadline)
+{
+    // NOTE: Looking at the clock for every single token would be wasteful.
+    static constexpr size_t tokens_between_deadline_checks = 64;
+    size_t tokens_until_deadline_check = tokens_between_deadline_checks;
+
+    while (!m_finished) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file()) {
+            m_finished = true;
+            break;
+        }
+        if (token->is_start_tag())
+            process_start_tag(*token);
+
+        if (--tokens_until_deadline_check == 0) {
+            tokens_until_deadline_check = tokens_between_deadline_checks;
+            if (MonotonicTime::now() >= deadline)
+                return RunResult::ReachedDeadline;
+        }
+    }
+    return RunResult::Finished;
+}
+
+void SpeculativeHTMLParser::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    if (tag_name == HTML::TagNames::base) {
+        // NOTE: Only the first base element with an href attribute sets the document base URL.
+        if (auto href = token.attribute(HTML::AttributeNames::href); href.has_value() && !m_has_seen_base_element) {
+            m_has_seen_base_element = true;
+            if (auto url = DOMURL::parse(*href, m_document.fallback_base_url()); url.is_valid())
+                m_base_url = move(url);
+        }
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::script) {
+        switch_tokenizer_state_for_start_tag(tag_name);
+
+        auto src = token.attribute(HTML::AttributeNames::src);
+        if (!src.has_value())
+            return;
+        // NOTE: With scripting enabled, nomodule scripts are never fetched.
+        if (token.has_attribute(HTML::AttributeNames::nomodule))
+            return;
+        if (auto type = token.attribute(HTML::AttributeNames::type); type.has_value() && !type->is_empty()) {
+            auto type_string = type->bytes_as_string_view();
+            if (!type_string.equals_ignoring_ascii_case("module"sv) && !type_string.contains("javascript"sv, CaseSensitivity::CaseInsensitive) && !type_string.contains("ecmascript"sv, CaseSensitivity::CaseInsensitive))
+                return;
+        }
+        if (auto url = url_to_preload(*src); url.has_value())
+            preload_script(token, *url);
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::link) {
+        auto href = token.attribute(HTML::AttributeNames::href);
+        auto rel = token.attribute(HTML::AttributeNames::rel);
+        if (!href.has_value() || !rel.has_value())
+            return;
+
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        bool is_preload = false;
+        for (auto keyword : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+            if (keyword.equals_ignoring_ascii_case("stylesheet"sv))
+                is_stylesheet = true;
+            else if (keyword.equals_ignoring_ascii_case("alternate"sv))
+                is_alternate = true;
+            else if (keyword.equals_ignoring_ascii_case("preload"sv))
+                is_preload = true;
+        }
+
+        auto url = url_to_preload(*href);
+        if (!url.has_value())
+            return;
+        if (is_stylesheet && !is_alternate) {
+            preload_with_potential_cors_request(token, *url, Fetch::Infrastructure::Request::Destination::Style);
+        } else if (is_preload) {
+            // NOTE: HTMLLinkElement loads preload hints with a plain request, without going through fetch, so we do the same.
+            LoadRequest request;
+            request.set_url(*url);
+            ResourceLoader::the().preload(request);
+        }
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::img) {
+        // NOTE: Lazy loaded images are only fetched once they come close to the viewport.
+        if (auto loading = token.attribute(HTML::AttributeNames::loading); loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv))
+            return;
+
+        auto preload_image = [&](StringView url_string) {
+            if (auto url = url_to_preload(url_string); url.has_value())
+                preload_with_potential_cors_request(token, *url, Fetch::Infrastructure::Request::Destination::Image);
+        };
+
+        auto src = token.attribute(HTML::AttributeNames::src);
+        auto srcset = token.attribute(HTML::AttributeNames::srcset);
+        if (!srcset.has_value() || srcset->is_empty()) {
+            if (src.has_value())
+                preload_image(*src);
+            return;
+        }
+
+        // NOTE: Candidates with width descriptors depend on the sizes attribute and layout, so we leave those to the
+        //       image element. For density descriptors, we pick the candidate that the image element will most likely
+        //       pick as well: the lowest density that still covers the device pixel ratio.
+        auto source_set = parse_a_srcset_attribute(*srcset);
+        auto device_pixel_ratio = m_document.page().client().device_pixels_per_css_pixel();
+        Optional<ImageSource const&> best_candidate;
+        double best_candidate_density = 0;
+        for (auto const& source : source_set.m_sources) {
+            if (source.descriptor.has<ImageSource::WidthDescriptorValue>())
+                return;
+            auto density = source.descriptor.has<ImageSource::PixelDensityDescriptorValue>()
+                ? source.descriptor.get<ImageSource::PixelDensityDescriptorValue>().value
+                : 1.0;
+            bool is_better = !best_candidate.has_value()
+                || (best_candidate_density < device_pixel_ratio && density > best_candidate_density)
+                || (density >= device_pixel_ratio && density < best_candidate_density);
+            if (is_better) {
+                best_candidate = source;
+                best_candidate_density = density;
+            }
+        }
+        if (best_candidate.has_value())
+            preload_image(best_candidate->url);
+        return;
+    }
+
+    switch_tokenizer_state_for_start_tag(tag_name);
+}
+
+// Mirrors the tokenizer state changes that the tree builder makes, so that we don't go looking for tags inside the
+// contents of scripts, style sheets and the like.
+void SpeculativeHTMLParser::switch_tokenizer_state_for_start_tag(FlyString const& tag_name)
+{
+    if (tag_name.is_one_of(HTML::TagNames::title, HTML::TagNames::textarea))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+    else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    else if (tag_name == HTML::TagNames::noscript && m_document.is_scripting_enabled())
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    else if (tag_name == HTML::TagNames::script)
+        m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+    else if (tag_name == HTML::TagNames::plaintext)
+        m_tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+}
+
+Optional<URL::URL> SpeculativeHTMLParser::url_to_preload(StringView url_string)
+{
+    auto url = DOMURL::parse(url_string.trim(Infra::ASCII_WHITESPACE), m_base_url);
+    if (!url.is_valid())
+        return {};
+    if (url.scheme() != "http"sv && url.scheme() != "https"sv)
+        return {};
+    if (m_preloaded_urls.set(url) != HashSetResult::InsertedNewEntry)
+        return {};
+
+    dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Preloading {}", url);
+    return url;
+}
+
+// Mirrors the requests made by https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-classic-script and
+// https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-single-module-script for a script element.
+void SpeculativeHTMLParser::preload_script(HTMLToken const& token, URL::URL const& url)
+{
+    auto& vm = m_document.vm();
+    auto cors_setting = cors_setting_attribute_from_keyword(token.attribute(HTML::AttributeNames::crossorigin));
+
+    JS::GCPtr<Fetch::Infrastructure::Request> request;
+    auto type = token.attribute(HTML::AttributeNames::type);
+    if (type.has_value() && type->equals_ignoring_ascii_case("module"sv)) {
+        request = Fetch::Infrastructure::Request::create(vm);
+        request->set_url(url);
+        request->set_mode(Fetch::Infrastructure::Request::Mode::CORS);
+        request->set_destination(Fetch::Infrastructure::Request::Destination::Script);
+        request->set_credentials_mode(cors_settings_attribute_credentials_mode(cors_setting));
+    } else {
+        request = create_potential_CORS_request(vm, url, Fetch::Infrastructure::Request::Destination::Script, cors_setting);
+    }
+
+    request->set_referrer_policy(ReferrerPolicy::from_string(token.attribute(HTML::AttributeNames::referrerpolicy).value_or({})).value_or(ReferrerPolicy::ReferrerPolicy::EmptyString));
+    fetch_speculatively(*request);
+}
+
+// Mirrors the requests made by img elements and by link elements for style sheets.
+void SpeculativeHTMLParser::preload_with_potential_cors_request(HTMLToken const& token, URL::URL const& url, Fetch::Infrastructure::Request::Destination destination)
+{
+    auto cors_setting = cors_setting_attribute_from_keyword(token.attribute(HTML::AttributeNames::crossorigin));
+    auto request = create_potential_CORS_request(m_document.vm(), url, destination, cors_setting);
+    request->set_referrer_policy(ReferrerPolicy::from_string(token.attribute(HTML::AttributeNames::referrerpolicy).value_or({})).value_or(ReferrerPolicy::ReferrerPolicy::EmptyString));
+    fetch_speculatively(*request);
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void SpeculativeHTMLParser::fetch_speculatively(Fetch::Infrastructure::Request& request)
+{
+    // NOTE: Going through fetch gives the preload the same headers (cookies, Origin, Referer, Accept and so on) as the
+    //       element's own fetch, which is what ResourceLoader matches preloads on. It also applies the same checks,
+    //       like the content security policy and mixed content blocking.
+    request.set_client(&m_document.relevant_settings_object());
+    request.set_speculative_preload(true);
+
+    auto& realm = m_document.realm();
+    auto result = Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(realm.vm(), {}));
+    if (result.is_error())
+        dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Could not preload {}", request.url());
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/Time.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// NOTE: This is a much simplified take on the speculative HTML parser. It does not build a tree of speculative mock
+//       elements, it only tokenizes the input that follows a parser-blocking script and starts fetching the scripts,
+//       style sheets, images and preload hints it finds. Each speculative fetch is set up like the one the element
+//       will make, so that ResourceLoader can hand its response to the element once the real parser gets to it.
+class SpeculativeHTMLParser {
+public:
+    SpeculativeHTMLParser(DOM::Document&, StringView input);
+
+    enum class RunResult {
+        Finished,
+        ReachedDeadline,
+    };
+    RunResult run_until(MonotonicTime deadline);
+    bool is_finished() const { return m_finished; }
+
+private:
+    void process_start_tag(HTMLToken const&);
+    void switch_tokenizer_state_for_start_tag(FlyString const& tag_name);
+    Optional<URL::URL> url_to_preload(StringView);
+    void preload_script(HTMLToken const&, URL::URL const&);
+    void preload_with_potential_cors_request(HTMLToken const&, URL::URL const&, Fetch::Infrastructure::Request::Destination);
+    void fetch_speculatively(Fetch::Infrastructure::Request&);
+
+    DOM::Document& m_document;
+    HTMLTokenizer m_tokenizer;
+    URL::URL m_base_url;
+    bool m_has_seen_base_element { false };
+    bool m_finished { false };
+    HashTable<URL::URL> m_preloaded_urls;
+};
+
+}
@@ -45,6 +45,7 @@ SharedImageRequest::~SharedImageRequest() = default;
 void SharedImageRequest::finalize()
 {
     Base::finalize();
+    cancel_progressive_decode();
     auto& shared_image_requests = m_document->shared_image_requests();
     shared_image_requests.remove(m_url);
 }
@@ -58,6 +59,7 @@ void SharedImageRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial_image);
     }
     visitor.visit(m_image_data);
 }
@@ -79,25 +81,79 @@ void SharedImageRequest::set_fetch_controller(JS::GCPtr<Fetch::Infrastructure::F
 
 void SharedImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::Infrastructure::Request> request)
 {
+    // AD-HOC: Let network responses stream in, so that we can show images while they are still loading.
+    if (request->url().scheme().is_one_of("http"sv, "https"sv))
+        request->set_buffer_policy(Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
     fetch_algorithms_input.process_response = [this, &realm, request](JS::NonnullGCPtr<Fetch::Infrastructure::Response> response) {
         // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
         //        https://github.com/whatwg/html/issues/9355
         response = response->unsafe_response();
 
-        auto process_body = JS::create_heap_function(heap(), [this, request, response](ByteBuffer data) {
-            auto extracted_mime_type = response->header_list()->extract_mime_type();
-            auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
-            handle_successful_fetch(request->url(), mime_type, move(data));
-        });
+        if (!response->body()) {
+            handle_failed_fetch();
+            return;
+        }
+
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence() : String {};
+
         auto process_body_error = JS::create_heap_function(heap(), [this](JS::Value) {
+            cancel_progressive_decode();
             handle_failed_fetch();
         });
 
-        if (response->body())
+        // NOTE: Buffered responses already have all of their data, so there is nothing to be gained by streaming them.
+        if (!response->body()->source().has<Empty>()) {
+            auto process_body = JS::create_heap_function(heap(), [this, request, mime_type](ByteBuffer data) {
+                handle_successful_fetch(request->url(), mime_type, move(data));
+            });
             response->body()->fully_read(realm, process_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
-        else
-            handle_failed_fetch();
+            return;
+        }
+
+        bool const is_svg_image = mime_type == "image/svg+xml"sv || request->url().basename().ends_with(".svg"sv);
+        if (!is_svg_image)
+            start_progressive_decode(mime_type.to_byte_string());
+
+        auto process_body_chunk = JS::create_heap_function(heap(), [this](ByteBuffer chunk) {
+            if (m_state != State::Fetching)
+                return;
+            // NOTE: An aborted fetch may not get to report the end of the body or an error, so don't wait for either.
+            if (m_fetch_controller && m_fetch_controller->state() != Fetch::Infrastructure::FetchController::State::Ongoing) {
+                cancel_progressive_decode();
+                handle_failed_fetch();
+                return;
+            }
+            if (m_progressive_decode_id.has_value()) {
+                Platform::ImageCodecPlugin::the().append_progressive_decode_data(*m_progressive_decode_id, chunk);
+                return;
+            }
+            if (m_encoded_data.try_append(chunk).is_error()) {
+                m_encoded_data.clear();
+                handle_failed_fetch();
+            }
+        });
+        auto process_end_of_body = JS::create_heap_function(heap(), [this, request, mime_type]() {
+            if (m_state != State::Fetching)
+                return;
+            if (m_progressive_decode_id.has_value()) {
+                (void)Platform::ImageCodecPlugin::the().finish_progressive_decode(
+                    m_progressive_decode_id.release_value(),
+                    [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+                        strong_this->handle_successful_bitmap_decode(result);
+                        return {};
+                    },
+                    [strong_this = JS::Handle(*this)](Error&) {
+                        strong_this->handle_failed_decode();
+                    });
+                return;
+            }
+            handle_successful_fetch(request->url(), mime_type, move(m_encoded_data));
+        });
+
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -111,7 +167,7 @@ void SharedImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::I
     set_fetch_controller(fetch_controller);
 }
 
-void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -130,6 +186,8 @@ void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void
         callbacks.on_finish = JS::create_heap_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = JS::create_heap_function(vm().heap(), move(on_fail));
+    if (on_partial_image)
+        callbacks.on_partial_image = JS::create_heap_function(vm().heap(), move(on_partial_image));
 
     m_callbacks.append(move(callbacks));
 }
@@ -141,48 +199,112 @@ void SharedImageRequest::handle_successful_fetch(URL::URL const& url_string, Str
 
     bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
 
-    auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
-        strong_this->m_state = State::Failed;
-        for (auto& callback : strong_this->m_callbacks) {
-            if (callback.on_fail)
-                callback.on_fail->function()();
-        }
-    };
-
-    auto handle_successful_decode = [](SharedImageRequest& self) {
-        self.m_state = State::Finished;
-        for (auto& callback : self.m_callbacks) {
-            if (callback.on_finish)
-                callback.on_finish->function()();
-        }
-        self.m_callbacks.clear();
-    };
-
     if (is_svg_image) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
-            handle_failed_decode(result.error());
+            handle_failed_decode();
         } else {
             m_image_data = result.release_value();
-            handle_successful_decode(*this);
+            handle_successful_decode();
         }
         return;
     }
 
-    auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this), handle_successful_decode = move(handle_successful_decode)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
-                .duration = static_cast<int>(frame.duration),
-            });
-        }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
-        handle_successful_decode(*strong_this);
-        return {};
-    };
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(
+        data.bytes(),
+        [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+            strong_this->handle_successful_bitmap_decode(result);
+            return {};
+        },
+        [strong_this = JS::Handle(*this)](Error&) {
+            strong_this->handle_failed_decode();
+        });
+}
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+void SharedImageRequest::start_progressive_decode(Optional<ByteString> mime_type)
+{
+    // NOTE: The callback only holds on to us weakly, as nothing guarantees that the decode ever gets finished.
+    m_progressive_decode_id = Platform::ImageCodecPlugin::the().start_progressive_decode(move(mime_type), [weak_this = make_weak_ptr<SharedImageRequest>()](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+        if (weak_this)
+            weak_this->handle_partial_image(move(bitmap));
+    });
+}
+
+void SharedImageRequest::cancel_progressive_decode()
+{
+    if (m_progressive_decode_id.has_value())
+        Platform::ImageCodecPlugin::the().cancel_progressive_decode(m_progressive_decode_id.release_value());
+    m_encoded_data.clear();
+}
+
+void SharedImageRequest::abort()
+{
+    if (m_state != State::Fetching)
+        return;
+    if (m_fetch_controller)
+        m_fetch_controller->stop_fetch();
+    cancel_progressive_decode();
+
+    // NOTE: Like the fetch's own tasks, the callbacks are discarded without running.
+    m_state = State::Failed;
+    m_callbacks.clear();
+}
+
+void SharedImageRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    // NOTE: A partial image that arrives after the full image has been decoded is stale.
+    if (m_state != State::Fetching)
+        return;
+
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append(AnimatedBitmapDecodedImageData::Frame {
+        .bitmap = Gfx::ImmutableBitmap::create(move(bitmap)),
+        .duration = 0,
+    });
+    auto image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false);
+    if (image_data.is_error())
+        return;
+    m_image_data = image_data.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial_image)
+            callback.on_partial_image->function()();
+    }
+}
+
+void SharedImageRequest::handle_successful_bitmap_decode(Web::Platform::DecodedImage& result)
+{
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+    if (result.image_id.has_value())
+        m_image_data = AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(m_document->realm(), move(frames), result.frame_count, result.loop_count, *result.image_id).release_value_but_fixme_should_propagate_errors();
+    else
+        m_image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+    handle_successful_decode();
+}
+
+void SharedImageRequest::handle_successful_decode()
+{
+    m_state = State::Finished;
+    for (auto& callback : m_callbacks) {
+        if (callback.on_finish)
+            callback.on_finish->function()();
+    }
+    m_callbacks.clear();
+}
+
+void SharedImageRequest::handle_failed_decode()
+{
+    m_state = State::Failed;
+    for (auto& callback : m_callbacks) {
+        if (callback.on_fail)
+            callback.on_fail->function()();
+    }
 }
 
 void SharedImageRequest::handle_failed_fetch()
@@ -8,6 +8,7 @@
 
 #include <AK/Error.h>
 #include <AK/OwnPtr.h>
+#include <LibGfx/Forward.h>
 #include <LibGfx/Size.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/HeapFunction.h>
@@ -35,7 +36,10 @@ public:
 
     void fetch_image(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // Stops fetching and decoding the image without notifying anyone, for example because its document is going away.
+    void abort();
+
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -49,6 +53,13 @@ private:
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
     void handle_failed_fetch();
 
+    void start_progressive_decode(Optional<ByteString> mime_type);
+    void cancel_progressive_decode();
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
+    void handle_successful_bitmap_decode(Web::Platform::DecodedImage&);
+    void handle_successful_decode();
+    void handle_failed_decode();
+
     enum class State {
         New,
         Fetching,
@@ -63,6 +74,7 @@ private:
     struct Callbacks {
         JS::GCPtr<JS::HeapFunction<void()>> on_finish;
         JS::GCPtr<JS::HeapFunction<void()>> on_fail;
+        JS::GCPtr<JS::HeapFunction<void()>> on_partial_image;
     };
     Vector<Callbacks> m_callbacks;
 
@@ -70,6 +82,11 @@ private:
     JS::GCPtr<DecodedImageData> m_image_data;
     JS::GCPtr<Fetch::Infrastructure::FetchController> m_fetch_controller;
 
+    // While the response body is streaming in, it is either fed to a progressive decode, or collected here if the
+    // image can't be decoded progressively.
+    Optional<i64> m_progressive_decode_id;
+    ByteBuffer m_encoded_data;
+
     JS::GCPtr<DOM::Document> m_document;
 };
 
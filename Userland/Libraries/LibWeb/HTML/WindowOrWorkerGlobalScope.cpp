@@ -229,6 +229,8 @@ JS::NonnullGCPtr<JS::Promise> WindowOrWorkerGlobalScopeMixin::create_image_bitma
                     // If this is an animated image, imageBitmap's bitmap data must only be taken from the default image
                     // of the animation (the one that the format defines is to be used when animation is not supported
                     // or is disabled), or, if there is no such image, the first frame of the animation.
+                    if (result.image_id.has_value())
+                        Web::Platform::ImageCodecPlugin::the().stop_animation_decode(*result.image_id);
                     image_bitmap->set_bitmap(result.frames.take_first().bitmap);
 
                     // 5. Resolve p with imageBitmap.
@@ -31,6 +31,7 @@ public:
     virtual JS::ThrowCompletionOr<bool> internal_set(JS::PropertyKey const&, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata*) override;
     virtual JS::ThrowCompletionOr<bool> internal_delete(JS::PropertyKey const&) override;
     virtual JS::ThrowCompletionOr<JS::MarkedVector<JS::Value>> internal_own_property_keys() const override;
+    virtual bool has_exotic_property_access() const override { return true; }
 
     JS::GCPtr<Window> window() const { return m_window; }
     void set_window(JS::NonnullGCPtr<Window>);
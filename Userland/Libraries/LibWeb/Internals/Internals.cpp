@@ -12,6 +12,8 @@
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/HTMLElement.h>
+#include <LibWeb/HTML/Parser/HTMLParser.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
 #include <LibWeb/Page/Page.h>
@@ -62,6 +64,20 @@ JS::Object* Internals::hit_test(double x, double y)
     return nullptr;
 }
 
+JS::GCPtr<Geometry::DOMRect> Internals::take_damage_rect()
+{
+    // NOTE: This takes the damage away from the next frame, so tests have to take care not to rely on what's on screen afterwards.
+    auto damage_rect = global_object().browsing_context()->page().top_level_traversable()->take_damage_rect();
+    if (!damage_rect.has_value())
+        return nullptr;
+    return Geometry::DOMRect::create(realm(), damage_rect->to_type<float>());
+}
+
+void Internals::set_html_parser_yields_after_every_token(bool yields)
+{
+    HTML::HTMLParser::set_incremental_parsing_yields_after_every_token_for_testing(yields);
+}
+
 void Internals::send_text(HTML::HTMLElement& target, String const& text)
 {
     auto& page = global_object().browsing_context()->page();
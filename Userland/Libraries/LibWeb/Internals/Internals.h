@@ -7,6 +7,7 @@
 #pragma once
 
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/Geometry/DOMRect.h>
 #include <LibWeb/Internals/InternalAnimationTimeline.h>
 
 namespace Web::Internals {
@@ -22,6 +23,8 @@ public:
 
     void gc();
     JS::Object* hit_test(double x, double y);
+    JS::GCPtr<Geometry::DOMRect> take_damage_rect();
+    void set_html_parser_yields_after_every_token(bool);
 
     void send_text(HTML::HTMLElement&, String const&);
     void commit_text();
@@ -248,6 +248,11 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         return;
     }
 
+    if (auto preloaded_response = take_preloaded_response(request)) {
+        use_preloaded_response(preloaded_response.release_nonnull(), move(success_callback), move(error_callback));
+        return;
+    }
+
     auto respond_directory_page = [](LoadRequest const& request, URL::URL const& url, SuccessCallback const& success_callback, ErrorCallback const& error_callback) {
         auto maybe_response = load_file_directory_page(url);
         if (maybe_response.is_error()) {
@@ -459,6 +464,169 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         error_callback(not_implemented_error, {}, {}, {});
 }
 
+static bool can_be_preloaded(LoadRequest const& request)
+{
+    auto const& url = request.url();
+    return (url.scheme() == "http"sv || url.scheme() == "https"sv) && request.method() == "GET"sv && request.body().is_empty();
+}
+
+// NOTE: Preloads that are never picked up just hold on to their response, so they only stick around for a while, and
+//       the least recently used ones make room for new ones.
+static constexpr size_t max_preloaded_responses = 64;
+
+void ResourceLoader::preload(LoadRequest& request)
+{
+    if (!can_be_preloaded(request))
+        return;
+
+    expire_preloaded_responses();
+    if (auto index = find_preloaded_response(request); index.has_value()) {
+        // NOTE: Asking for the same preload again counts as using it, so it moves to the back of the line.
+        auto preloaded_response = m_preloaded_responses.take(*index);
+        preloaded_response->expiry_time = MonotonicTime::now_coarse() + m_preloaded_response_lifetime;
+        m_preloaded_responses.append(move(preloaded_response));
+        return;
+    }
+    if (m_preloaded_responses.size() >= max_preloaded_responses)
+        m_preloaded_responses.remove(0);
+
+    dbgln_if(SPAM_DEBUG, "ResourceLoader: Preloading \"{}\"", request.url());
+
+    auto preloaded_response = make_ref_counted<PreloadedResponse>();
+    preloaded_response->request = request;
+    preloaded_response->expiry_time = MonotonicTime::now_coarse() + m_preloaded_response_lifetime;
+
+    load(
+        request,
+        [preloaded_response](auto data, auto& response_headers, auto status_code) {
+            if (preloaded_response->success_callback) {
+                preloaded_response->success_callback(data, response_headers, status_code);
+                return;
+            }
+            preloaded_response->finished = true;
+            preloaded_response->success = true;
+            preloaded_response->payload = MUST(ByteBuffer::copy(data));
+            preloaded_response->response_headers = response_headers;
+            preloaded_response->status_code = status_code;
+        },
+        [preloaded_response](auto& error, auto status_code, auto payload, auto& response_headers) {
+            if (preloaded_response->error_callback) {
+                preloaded_response->error_callback(error, status_code, payload, response_headers);
+                return;
+            }
+            preloaded_response->finished = true;
+            preloaded_response->error = error;
+            preloaded_response->payload = MUST(ByteBuffer::copy(payload));
+            preloaded_response->response_headers = response_headers;
+            preloaded_response->status_code = status_code;
+        });
+
+    // NOTE: This has to happen after starting the load, as load() would otherwise pick up the preload itself.
+    m_preloaded_responses.append(move(preloaded_response));
+
+    if (!m_preload_expiry_timer) {
+        m_preload_expiry_timer = Platform::Timer::create_single_shot(m_preloaded_response_lifetime.to_milliseconds(), [this] {
+            expire_preloaded_responses();
+        });
+    }
+    if (!m_preload_expiry_timer->is_active())
+        m_preload_expiry_timer->start();
+}
+
+void ResourceLoader::expire_preloaded_responses()
+{
+    auto now = MonotonicTime::now_coarse();
+    m_preloaded_responses.remove_all_matching([&](auto const& preloaded_response) {
+        if (preloaded_response->expiry_time > now)
+            return false;
+        dbgln_if(SPAM_DEBUG, "ResourceLoader: Preload of \"{}\" expired without being used", preloaded_response->request.url());
+        return true;
+    });
+
+    // NOTE: Keep checking for as long as there is something left to expire.
+    if (m_preload_expiry_timer && !m_preloaded_responses.is_empty())
+        m_preload_expiry_timer->restart(max(1, (m_preloaded_responses.first()->expiry_time - now).to_milliseconds()));
+}
+
+// NOTE: A preloaded response can only stand in for a request from the same page that would have gone out exactly the
+//       same way. Since the request headers include cookies, the Origin and Referer headers, and the Accept header for
+//       the destination, this also keeps responses from being reused across documents, credentials or CORS modes.
+Optional<size_t> ResourceLoader::find_preloaded_response(LoadRequest const& request) const
+{
+    for (size_t i = 0; i < m_preloaded_responses.size(); ++i) {
+        auto const& preloaded_request = m_preloaded_responses[i]->request;
+        if (preloaded_request.page() == request.page() && preloaded_request == request)
+            return i;
+    }
+    return {};
+}
+
+// NOTE: Expired preloads are dropped before looking for a match, so that a preload is either handed out here or not at all.
+RefPtr<ResourceLoader::PreloadedResponse> ResourceLoader::take_preloaded_response(LoadRequest const& request)
+{
+    if (m_preloaded_responses.is_empty() || !can_be_preloaded(request))
+        return nullptr;
+
+    expire_preloaded_responses();
+    auto index = find_preloaded_response(request);
+    if (!index.has_value())
+        return nullptr;
+
+    dbgln_if(SPAM_DEBUG, "ResourceLoader: Using preloaded response for \"{}\"", request.url());
+    return m_preloaded_responses.take(*index);
+}
+
+void ResourceLoader::use_preloaded_response(NonnullRefPtr<PreloadedResponse> response, SuccessCallback success_callback, ErrorCallback error_callback)
+{
+    if (!response->finished) {
+        response->success_callback = move(success_callback);
+        response->error_callback = move(error_callback);
+        return;
+    }
+
+    // NOTE: Callers expect to be called back asynchronously, just like for a network response.
+    Platform::EventLoopPlugin::the().deferred_invoke([response = move(response), success_callback = move(success_callback), error_callback = move(error_callback)] {
+        if (response->success) {
+            success_callback(response->payload, response->response_headers, response->status_code);
+            return;
+        }
+        if (error_callback)
+            error_callback(response->error, response->status_code, response->payload, response->response_headers);
+    });
+}
+
+// NOTE: Preloads are always buffered, so an unbuffered load that finds one gets the whole body as a single chunk.
+void ResourceLoader::use_preloaded_response_unbuffered(NonnullRefPtr<PreloadedResponse> response, OnHeadersReceived on_headers_received, OnDataReceived on_data_received, OnComplete on_complete)
+{
+    struct UnbufferedCallbacks : public RefCounted<UnbufferedCallbacks> {
+        OnHeadersReceived on_headers_received;
+        OnDataReceived on_data_received;
+        OnComplete on_complete;
+    };
+    auto callbacks = make_ref_counted<UnbufferedCallbacks>();
+    callbacks->on_headers_received = move(on_headers_received);
+    callbacks->on_data_received = move(on_data_received);
+    callbacks->on_complete = move(on_complete);
+
+    SuccessCallback success_callback = [callbacks](auto data, auto& response_headers, auto status_code) {
+        callbacks->on_headers_received(response_headers, status_code);
+        callbacks->on_data_received(data);
+        callbacks->on_complete(true, {});
+    };
+    ErrorCallback error_callback = [callbacks](auto& error, auto status_code, auto payload, auto& response_headers) {
+        // NOTE: HTTP error responses are still responses as far as unbuffered loads are concerned.
+        if (status_code.has_value()) {
+            callbacks->on_headers_received(response_headers, status_code);
+            callbacks->on_data_received(payload);
+            callbacks->on_complete(true, {});
+            return;
+        }
+        callbacks->on_complete(false, error.view());
+    };
+
+    use_preloaded_response(move(response), move(success_callback), move(error_callback));
+}
+
 void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_headers_received, OnDataReceived on_data_received, OnComplete on_complete)
 {
     auto const& url = request.url();
@@ -471,6 +639,11 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_
         return;
     }
 
+    if (auto preloaded_response = take_preloaded_response(request)) {
+        use_preloaded_response_unbuffered(preloaded_response.release_nonnull(), move(on_headers_received), move(on_data_received), move(on_complete));
+        return;
+    }
+
     if (!url.scheme().is_one_of("http"sv, "https"sv, "gemini"sv)) {
         // FIXME: Non-network requests from fetch should not go through this path.
         on_complete(false, "Cannot establish connection non-network scheme"sv);
@@ -566,6 +739,7 @@ void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
     s_resource_cache.clear();
+    m_preloaded_responses.clear();
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
@@ -17,6 +17,7 @@
 #include <LibURL/URL.h>
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Platform/Timer.h>
 
 namespace Web {
 
@@ -84,6 +85,14 @@ public:
 
     void load_unbuffered(LoadRequest&, OnHeadersReceived, OnDataReceived, OnComplete);
 
+    // Starts fetching the given GET request ahead of time. The response is handed to the first load() from the same
+    // page of an identical request (URL, method, body and all headers), which then does not have to wait for a network
+    // request of its own. Preloads that nobody picks up expire after a while.
+    void preload(LoadRequest&);
+
+    Duration preloaded_response_lifetime() const { return m_preloaded_response_lifetime; }
+    void set_preloaded_response_lifetime(Duration lifetime) { m_preloaded_response_lifetime = lifetime; }
+
     ResourceLoaderConnector& connector() { return *m_connector; }
 
     void prefetch_dns(URL::URL const&);
@@ -110,9 +119,34 @@ private:
     void handle_network_response_headers(LoadRequest const&, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const&);
     void finish_network_request(NonnullRefPtr<ResourceLoaderConnectorRequest> const&);
 
+    struct PreloadedResponse : public RefCounted<PreloadedResponse> {
+        LoadRequest request;
+        MonotonicTime expiry_time { MonotonicTime::now_coarse() };
+
+        bool finished { false };
+        bool success { false };
+        ByteBuffer payload;
+        HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> response_headers;
+        Optional<u32> status_code;
+        ByteString error;
+
+        // Set when a load() for this response arrives before the preload has finished.
+        SuccessCallback success_callback;
+        ErrorCallback error_callback;
+    };
+    void expire_preloaded_responses();
+    Optional<size_t> find_preloaded_response(LoadRequest const&) const;
+    RefPtr<PreloadedResponse> take_preloaded_response(LoadRequest const&);
+    void use_preloaded_response(NonnullRefPtr<PreloadedResponse>, SuccessCallback, ErrorCallback);
+    void use_preloaded_response_unbuffered(NonnullRefPtr<PreloadedResponse>, OnHeadersReceived, OnDataReceived, OnComplete);
+
     int m_pending_loads { 0 };
 
     HashTable<NonnullRefPtr<ResourceLoaderConnectorRequest>> m_active_requests;
+    // Ordered from least to most recently used.
+    Vector<NonnullRefPtr<PreloadedResponse>> m_preloaded_responses;
+    RefPtr<Platform::Timer> m_preload_expiry_timer;
+    Duration m_preloaded_response_lifetime { Duration::from_seconds(30) };
     NonnullRefPtr<ResourceLoaderConnector> m_connector;
     String m_user_agent;
     String m_platform;
@@ -244,6 +244,9 @@ struct PaintOptions {
     };
 
     PaintOverlay paint_overlay { PaintOverlay::Yes };
+
+    // If set, only this part of the target is repainted, and the rest of it is assumed to be up to date.
+    Optional<DevicePixelRect> damage_rect {};
 };
 
 class PageClient : public JS::Cell {
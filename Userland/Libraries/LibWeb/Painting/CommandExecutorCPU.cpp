@@ -4,8 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NeverDestroyed.h>
+#include <AK/TypeCasts.h>
+#include <LibCore/System.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
+#include <LibGfx/Font/ScaledFont.h>
 #include <LibGfx/StylePainter.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/CSS/ComputedValues.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/CommandExecutorCPU.h>
@@ -25,34 +32,165 @@ CommandExecutorCPU::CommandExecutorCPU(Gfx::Bitmap& bitmap, bool enable_affine_c
         .scaling_mode = {} });
 }
 
+void CommandExecutorCPU::restrict_to_rect(Gfx::IntRect const& rect)
+{
+    VERIFY(stacking_contexts.size() == 1);
+    painter().restrict_clip_origin(rect);
+}
+
+// Fonts cache their scaled variants, glyph IDs and glyph bitmaps without any locking, and are reference counted
+// non-atomically, so executors painting tiles on several threads can't use them the way the painter does. Instead, the
+// scaled fonts are looked up (and glyph IDs cached) up front on the thread that owns the fonts, and each painting thread
+// rasterizes glyphs into a TileGlyphCache of its own. While painting, fonts are only ever referred to by reference.
+class TileFonts {
+public:
+    explicit TileFonts(CommandList const& command_list)
+    {
+        command_list.for_each_command([&](Command const& command) {
+            if (command.has<DrawGlyphRun>()) {
+                auto const& draw_glyph_run = command.get<DrawGlyphRun>();
+                for (auto const& glyph_or_emoji : draw_glyph_run.glyph_run->glyphs()) {
+                    glyph_or_emoji.visit([&](auto const& glyph) {
+                        auto const& font = add_scaled_font(*glyph.font, draw_glyph_run.scale);
+                        if constexpr (IsSame<RemoveCVReference<decltype(glyph)>, Gfx::DrawGlyph>)
+                            cache_glyph_id(font, glyph.code_point);
+                    });
+                }
+            } else if (command.has<PaintTextShadow>()) {
+                for (auto const& glyph_or_emoji : command.get<PaintTextShadow>().glyph_run) {
+                    if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
+                        auto const& glyph = glyph_or_emoji.get<Gfx::DrawGlyph>();
+                        cache_glyph_id(*glyph.font, glyph.code_point);
+                    }
+                }
+            } else if (command.has<DrawText>()) {
+                // NOTE: The painter's text layout measures spaces and ellipses as well as the text itself.
+                auto const& draw_text = command.get<DrawText>();
+                auto const& font = draw_text.font.has_value() ? **draw_text.font : Gfx::FontDatabase::default_font();
+                cache_glyph_id(font, ' ');
+                cache_glyph_id(font, '.');
+                for (auto code_point : Utf8View { draw_text.raw_text })
+                    cache_glyph_id(font, code_point);
+            }
+        });
+    }
+
+    Gfx::Font const& scaled_font(Gfx::Font const& font, double scale) const
+    {
+        return *m_scaled_fonts.find(&font)->value.find(scale)->value;
+    }
+
+private:
+    Gfx::Font const& add_scaled_font(Gfx::Font const& font, double scale)
+    {
+        auto& scaled_fonts = m_scaled_fonts.ensure(&font);
+        return *scaled_fonts.ensure(scale, [&] { return font.with_size(font.point_size() * static_cast<float>(scale)); });
+    }
+
+    static void cache_glyph_id(Gfx::Font const& font, u32 code_point)
+    {
+        if (is<Gfx::ScaledFont>(font))
+            (void)static_cast<Gfx::ScaledFont const&>(font).glyph_id_for_code_point(code_point);
+    }
+
+    HashMap<Gfx::Font const*, HashMap<double, NonnullRefPtr<Gfx::Font const>>> m_scaled_fonts;
+};
+
+// The glyph bitmaps rasterized by one of the threads painting tiles. It may only be used (and destroyed) on that thread.
+class TileGlyphCache {
+public:
+    Gfx::Bitmap const* glyph_bitmap(Gfx::ScaledFont const& font, u32 glyph_id, Gfx::GlyphSubpixelOffset subpixel_offset)
+    {
+        auto& glyph_bitmaps = m_glyph_bitmaps.ensure(&font);
+        return glyph_bitmaps.ensure({ glyph_id, subpixel_offset }, [&] { return font.rasterize_glyph_uncached(glyph_id, subpixel_offset); }).ptr();
+    }
+
+private:
+    HashMap<Gfx::ScaledFont const*, HashMap<Gfx::GlyphIndexWithSubpixelOffset, RefPtr<Gfx::Bitmap>>> m_glyph_bitmaps;
+};
+
+void CommandExecutorCPU::restrict_to_tile(Gfx::IntRect const& tile_rect, TileFonts const& tile_fonts, Threading::Mutex& draw_text_mutex)
+{
+    restrict_to_rect(tile_rect);
+    m_tile_fonts = &tile_fonts;
+    m_draw_text_mutex = &draw_text_mutex;
+}
+
+void CommandExecutorCPU::draw_glyph(Gfx::Painter& painter, Gfx::FloatPoint point, u32 code_point, Gfx::Font const& font, Color color)
+{
+    if (!m_tile_glyph_cache || !is<Gfx::ScaledFont>(font)) {
+        painter.draw_glyph(point, code_point, font, color);
+        return;
+    }
+
+    // NOTE: This is Painter::draw_glyph(), but with the glyph bitmap coming from this thread's cache.
+    auto const& scaled_font = static_cast<Gfx::ScaledFont const&>(font);
+    auto glyph_id = scaled_font.glyph_id_for_code_point(code_point);
+    auto glyph_metrics = scaled_font.glyph_metrics(glyph_id);
+    auto top_left = point + Gfx::FloatPoint(glyph_metrics.left_side_bearing, 0);
+    auto glyph_position = Gfx::GlyphRasterPosition::get_nearest_fit_for(top_left);
+    auto const* glyph_bitmap = m_tile_glyph_cache->glyph_bitmap(scaled_font, glyph_id, glyph_position.subpixel_offset);
+    if (!glyph_bitmap)
+        return;
+
+    if (scaled_font.has_color_bitmaps()) {
+        float scaled_width = glyph_metrics.advance_width;
+        float ratio = static_cast<float>(glyph_bitmap->height()) / static_cast<float>(glyph_bitmap->width());
+        float scaled_height = scaled_width * ratio;
+
+        Gfx::FloatRect rect(point.x(), point.y(), scaled_width, scaled_height);
+        painter.draw_scaled_bitmap(rect.to_rounded<int>(), *glyph_bitmap, glyph_bitmap->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    } else if (color.alpha() != 255) {
+        painter.blit_filtered(glyph_position.blit_position, *glyph_bitmap, glyph_bitmap->rect(), [color](Color pixel) -> Color {
+            return pixel.multiply(color);
+        });
+    } else {
+        painter.blit_filtered(glyph_position.blit_position, *glyph_bitmap, glyph_bitmap->rect(), [color](Color pixel) -> Color {
+            return color.with_alpha(pixel.alpha());
+        });
+    }
+}
+
 CommandResult CommandExecutorCPU::draw_glyph_run(DrawGlyphRun const& command)
 {
     auto& painter = this->painter();
-    auto const& glyphs = command.glyph_run->glyphs();
-    for (auto& glyph_or_emoji : glyphs) {
-        auto transformed_glyph = glyph_or_emoji;
-        transformed_glyph.visit([&](auto& glyph) {
-            glyph.position = glyph.position.scaled(command.scale).translated(command.translation);
-            glyph.font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+    // NOTE: Glyphs are only looked at by reference, since copying them would change the (non-atomic) reference counts of
+    //       their fonts, which executors painting other tiles may be using at the same time.
+    for (auto const& glyph_or_emoji : command.glyph_run->glyphs()) {
+        glyph_or_emoji.visit([&](auto const& glyph) {
+            auto position = glyph.position.scaled(command.scale).translated(command.translation);
+            RefPtr<Gfx::Font const> scaled_font;
+            if (!m_tile_fonts)
+                scaled_font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+            auto const& font = m_tile_fonts ? m_tile_fonts->scaled_font(*glyph.font, command.scale) : *scaled_font;
+
+            if constexpr (IsSame<RemoveCVReference<decltype(glyph)>, Gfx::DrawGlyph>)
+                draw_glyph(painter, position, glyph.code_point, font, command.color);
+            else
+                painter.draw_emoji(position.template to_type<int>(), *glyph.emoji, font);
         });
-        if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
-            auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
-            painter.draw_glyph(glyph.position, glyph.code_point, *glyph.font, command.color);
-        } else {
-            auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
-            painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *emoji.font);
-        }
     }
     return CommandResult::Continue;
 }
 
 CommandResult CommandExecutorCPU::draw_text(DrawText const& command)
 {
-    auto& painter = this->painter();
-    if (command.font.has_value()) {
-        painter.draw_text(command.rect, command.raw_text, *command.font, command.alignment, command.color, command.elision, command.wrapping);
+    auto paint = [&] {
+        auto& painter = this->painter();
+        if (command.font.has_value()) {
+            painter.draw_text(command.rect, command.raw_text, *command.font, command.alignment, command.color, command.elision, command.wrapping);
+        } else {
+            painter.draw_text(command.rect, command.raw_text, command.alignment, command.color, command.elision, command.wrapping);
+        }
+    };
+
+    // NOTE: The painter lays out and rasterizes the text with the caches of the fonts themselves, which is only safe for
+    //       one tile at a time. Their glyph IDs are cached up front by TileFonts, which is all other tiles look at.
+    if (m_draw_text_mutex) {
+        Threading::MutexLocker locker(*m_draw_text_mutex);
+        paint();
     } else {
-        painter.draw_text(command.rect, command.raw_text, command.alignment, command.color, command.elision, command.wrapping);
+        paint();
     }
     return CommandResult::Continue;
 }
@@ -292,7 +430,7 @@ CommandResult CommandExecutorCPU::paint_text_shadow(PaintTextShadow const& comma
     for (auto const& glyph_or_emoji : command.glyph_run) {
         if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
             auto const& glyph = glyph_or_emoji.get<Gfx::DrawGlyph>();
-            shadow_painter.draw_glyph(glyph.position, glyph.code_point, *glyph.font, command.color);
+            draw_glyph(shadow_painter, glyph.position, glyph.code_point, *glyph.font, command.color);
         } else {
             auto const& emoji = glyph_or_emoji.get<Gfx::DrawEmoji>();
             shadow_painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *emoji.font);
@@ -490,4 +628,109 @@ bool CommandExecutorCPU::would_be_fully_clipped_by_painter(Gfx::IntRect rect) co
     return !painter().clip_rect().intersects(rect.translated(painter().translation()));
 }
 
+// NOTE: Tiles are square so that a large element (like a gradient background) spreads over several of them in both directions.
+static constexpr int painting_tile_size = 512;
+
+static Threading::ThreadPool<Function<void()>>& painting_thread_pool()
+{
+    static NeverDestroyed<Threading::ThreadPool<Function<void()>>> thread_pool(
+        [](Function<void()> work) { work(); },
+        max(Core::System::hardware_concurrency(), 2u) - 1);
+    return *thread_pool;
+}
+
+void execute_command_list_in_rect(CommandList& command_list, Gfx::Bitmap& bitmap, Gfx::IntRect const& rect)
+{
+    CommandExecutorCPU executor(bitmap);
+    if (!command_list.can_be_executed_in_tiles()) {
+        command_list.execute(executor);
+        return;
+    }
+
+    auto damage_rect = rect.intersected(bitmap.rect());
+    if (damage_rect.is_empty())
+        return;
+    executor.restrict_to_rect(damage_rect);
+    command_list.execute(executor, command_list.commands_affecting_rect(damage_rect));
+}
+
+void execute_command_list_in_tiles(CommandList& command_list, Gfx::Bitmap& bitmap, Optional<Gfx::IntRect> const& damage_rect)
+{
+    auto thread_count = Core::System::hardware_concurrency();
+    if (thread_count < 2 || !command_list.can_be_executed_in_tiles()) {
+        if (damage_rect.has_value()) {
+            execute_command_list_in_rect(command_list, bitmap, *damage_rect);
+            return;
+        }
+        CommandExecutorCPU executor(bitmap);
+        command_list.execute(executor);
+        return;
+    }
+
+    auto painted_rect = damage_rect.value_or(bitmap.rect()).intersected(bitmap.rect());
+    if (painted_rect.is_empty())
+        return;
+
+    command_list.prepare_for_concurrent_execution();
+    TileFonts tile_fonts(command_list);
+    Threading::Mutex draw_text_mutex;
+
+    struct Tile {
+        Gfx::IntRect rect;
+        OwnPtr<CommandExecutorCPU> executor;
+    };
+
+    // NOTE: The executors are created and destroyed on this thread, since their painters hold a (non-atomic) reference to the bitmap.
+    Vector<Tile> tiles;
+    for (int y = 0; y < bitmap.height(); y += painting_tile_size) {
+        for (int x = 0; x < bitmap.width(); x += painting_tile_size) {
+            auto rect = Gfx::IntRect { x, y, painting_tile_size, painting_tile_size }.intersected(painted_rect);
+            if (rect.is_empty())
+                continue;
+            auto executor = make<CommandExecutorCPU>(bitmap);
+            executor->restrict_to_tile(rect, tile_fonts, draw_text_mutex);
+            tiles.append({ rect, move(executor) });
+        }
+    }
+
+    Atomic<size_t> next_tile_index { 0 };
+    auto paint_tiles = [&] {
+        TileGlyphCache glyph_cache;
+        for (;;) {
+            auto tile_index = next_tile_index.fetch_add(1);
+            if (tile_index >= tiles.size())
+                return;
+            auto& tile = tiles[tile_index];
+            tile.executor->set_tile_glyph_cache(glyph_cache);
+            auto command_indices = command_list.commands_affecting_rect(tile.rect);
+            command_list.execute(*tile.executor, command_indices);
+        }
+    };
+
+    if (tiles.is_empty())
+        return;
+
+    // NOTE: There is no point in waking up more helpers than there are tiles left after this thread takes one.
+    auto helper_count = min(static_cast<size_t>(thread_count - 1), tiles.size() - 1);
+    Threading::Mutex finished_helpers_mutex;
+    Threading::ConditionVariable all_helpers_finished { finished_helpers_mutex };
+    size_t finished_helper_count = 0;
+
+    for (size_t i = 0; i < helper_count; ++i) {
+        painting_thread_pool().submit([&] {
+            paint_tiles();
+            Threading::MutexLocker locker(finished_helpers_mutex);
+            if (++finished_helper_count == helper_count)
+                all_helpers_finished.signal();
+        });
+    }
+
+    // This thread paints tiles as well instead of just waiting around.
+    paint_tiles();
+
+    Threading::MutexLocker locker(finished_helpers_mutex);
+    while (finished_helper_count < helper_count)
+        all_helpers_finished.wait();
+}
+
 }
@@ -7,11 +7,15 @@
 #pragma once
 
 #include <AK/MaybeOwned.h>
+#include <LibThreading/Forward.h>
 #include <LibWeb/Painting/AffineCommandExecutorCPU.h>
 #include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
+class TileFonts;
+class TileGlyphCache;
+
 class CommandExecutorCPU : public CommandExecutor {
 public:
     CommandResult draw_glyph_run(DrawGlyphRun const&) override;
@@ -56,14 +60,27 @@ public:
 
     CommandExecutorCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false);
 
+    // Confines all painting to the given rect of the target bitmap, leaving the rest of it untouched.
+    void restrict_to_rect(Gfx::IntRect const&);
+
+    // Confines all painting to the given tile of the target bitmap, so that several executors can paint into it at once.
+    // Text is painted with the fonts and glyph caches given here instead of the ones the painter would use, see TileFonts.
+    void restrict_to_tile(Gfx::IntRect const& tile_rect, TileFonts const&, Threading::Mutex& draw_text_mutex);
+    void set_tile_glyph_cache(TileGlyphCache& glyph_cache) { m_tile_glyph_cache = &glyph_cache; }
+
     CommandExecutor& nested_executor() override
     {
         return *m_affine_command_executor;
     }
 
 private:
+    void draw_glyph(Gfx::Painter&, Gfx::FloatPoint, u32 code_point, Gfx::Font const&, Color);
+
     Gfx::Bitmap& m_target_bitmap;
     bool m_enable_affine_command_executor { false };
+    TileFonts const* m_tile_fonts { nullptr };
+    TileGlyphCache* m_tile_glyph_cache { nullptr };
+    Threading::Mutex* m_draw_text_mutex { nullptr };
 
     Vector<RefPtr<BorderRadiusCornerClipper>> m_corner_clippers_stack;
 
@@ -82,4 +99,12 @@ private:
     Optional<AffineCommandExecutorCPU> m_affine_command_executor;
 };
 
+// Repaints only the given rect of the bitmap, assuming the rest of it already shows the result of the command list.
+// Falls back to repainting the whole bitmap when the command list can't be painted in parts.
+void execute_command_list_in_rect(CommandList&, Gfx::Bitmap&, Gfx::IntRect const&);
+
+// Paints the command list into the bitmap (or only the given rect of it) by splitting it into tiles, which are painted
+// on several threads at once. Falls back to a single CommandExecutorCPU when the command list can't be painted in tiles.
+void execute_command_list_in_tiles(CommandList&, Gfx::Bitmap&, Optional<Gfx::IntRect> const& damage_rect = {});
+
 }
@@ -110,17 +110,32 @@ void CommandList::execute(CommandExecutor& executor)
         executor.update_immutable_bitmap_texture_cache(immutable_bitmaps);
     }
 
+    execute_commands(executor, m_commands.size(), [](size_t position) { return position; });
+}
+
+void CommandList::execute(CommandExecutor& executor, ReadonlySpan<u32> command_indices)
+{
+    // NOTE: Partial execution is only used by the CPU executor, which doesn't need any of the texture preparation above.
+    VERIFY(!executor.needs_prepare_glyphs_texture());
+    VERIFY(!executor.needs_update_immutable_bitmap_texture_cache());
+
+    executor.prepare_to_execute(m_corner_clip_max_depth);
+    execute_commands(executor, command_indices.size(), [&](size_t position) { return command_indices[position]; });
+}
+
+template<typename CommandIndexAt>
+void CommandList::execute_commands(CommandExecutor& executor, size_t command_count, CommandIndexAt command_index_at)
+{
     HashTable<u32> skipped_sample_corner_commands;
-    size_t next_command_index = 0;
+    size_t next_position = 0;
     Vector<CommandExecutor&, 16> executor_stack;
     CommandExecutor* current_executor = &executor;
-    while (next_command_index < m_commands.size()) {
-        if (m_commands[next_command_index].skip) {
-            next_command_index++;
+    while (next_position < command_count) {
+        auto& command_list_item = m_commands[static_cast<size_t>(command_index_at(next_position++))];
+        if (command_list_item.skip)
             continue;
-        }
 
-        auto& command = m_commands[next_command_index++].command;
+        auto& command = command_list_item.command;
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || current_executor->would_be_fully_clipped_by_painter(*bounding_rect))) {
             if (command.has<SampleUnderCorners>()) {
@@ -188,14 +203,15 @@ void CommandList::execute(CommandExecutor& executor)
             current_executor = &executor_stack.take_last();
         } else if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < m_commands.size()) {
-                if (m_commands[next_command_index].command.has<PushStackingContext>()) {
+            while (next_position < command_count) {
+                auto const& next_command = m_commands[static_cast<size_t>(command_index_at(next_position))].command;
+                if (next_command.has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (m_commands[next_command_index].command.has<PopStackingContext>()) {
+                } else if (next_command.has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
-                next_command_index++;
+                next_position++;
 
                 if (stacking_context_nesting_level == 0)
                     break;
@@ -204,4 +220,125 @@ void CommandList::execute(CommandExecutor& executor)
     }
 }
 
+Vector<u32> CommandList::commands_affecting_rect(Gfx::IntRect const& rect) const
+{
+    Vector<u32> command_indices;
+    command_indices.ensure_capacity(m_commands.size());
+
+    // NOTE: Bounding rects are in the coordinate space of the current stacking context. As long as that is only translated
+    //       relative to the device, we keep track of the offset and cull commands (and whole stacking contexts) against
+    //       the rect. Inside anything more complicated, the offset is unknown and culling is left to the executor.
+    struct StackingContext {
+        Optional<Gfx::IntPoint> device_offset;
+        // Whether this or an enclosing stacking context paints into a layer of its own, which fixed position descendants
+        // are positioned relative to, instead of the device.
+        bool is_in_layer { false };
+    };
+    Vector<StackingContext, 16> stacking_contexts;
+    stacking_contexts.append({ Gfx::IntPoint {}, false });
+
+    // NOTE: Destinations of layers are rounded, and so may be off by a pixel compared to their contents.
+    auto rect_with_rounding_slop = rect.inflated(2, 2);
+
+    for (u32 command_index = 0; command_index < m_commands.size(); ++command_index) {
+        auto const& command_list_item = m_commands[command_index];
+        if (command_list_item.skip)
+            continue;
+
+        auto const& command = command_list_item.command;
+        auto const& current = stacking_contexts.last();
+
+        if (command.has<PushStackingContext>()) {
+            auto const& push = command.get<PushStackingContext>();
+            auto affine_transform = Gfx::extract_2d_affine_transform(push.transform.matrix);
+
+            Optional<Gfx::IntPoint> base_offset = current.device_offset;
+            if (push.is_fixed_position)
+                base_offset = current.is_in_layer ? Optional<Gfx::IntPoint> {} : Gfx::IntPoint {};
+
+            // NOTE: These mirror the ways CommandExecutorCPU::push_stacking_context() positions the stacking context.
+            StackingContext stacking_context { {}, true };
+            Optional<Gfx::IntRect> layer_destination;
+            if (push.mask.has_value()) {
+                layer_destination = push.source_paintable_rect.translated(push.post_transform_translation);
+                if (push.mask->mask_bitmap->size() == push.source_paintable_rect.size() && base_offset.has_value())
+                    stacking_context.device_offset = *base_offset + push.post_transform_translation;
+            } else if (affine_transform.is_identity_or_translation()) {
+                auto translation = affine_transform.translation().to_rounded<int>() + push.post_transform_translation;
+                if (base_offset.has_value())
+                    stacking_context.device_offset = *base_offset + translation;
+                if (push.opacity == 1.0f)
+                    stacking_context.is_in_layer = current.is_in_layer;
+                else
+                    layer_destination = push.source_paintable_rect.translated(translation);
+            } else {
+                auto source_rect = push.source_paintable_rect.to_type<float>().translated(-push.transform.origin);
+                auto transformed_rect = affine_transform.map(source_rect).translated(push.transform.origin);
+                layer_destination = Gfx::enclosing_int_rect(transformed_rect).translated(push.post_transform_translation);
+            }
+
+            // A stacking context painted into a layer can't affect anything outside of its destination, so we skip all of it
+            // (and don't have the executor create a layer at all) when that is outside of the rect.
+            if (layer_destination.has_value() && base_offset.has_value() && !layer_destination->translated(*base_offset).intersects(rect_with_rounding_slop)) {
+                command_index = index_of_matching_pop_stacking_context(command_index);
+                continue;
+            }
+
+            stacking_contexts.append(stacking_context);
+        } else if (command.has<PopStackingContext>()) {
+            stacking_contexts.take_last();
+        } else if (current.device_offset.has_value() && !command.has<SampleUnderCorners>() && !command.has<BlitCornerClipping>()) {
+            auto bounding_rect = command_bounding_rectangle(command);
+            if (bounding_rect.has_value() && !bounding_rect->translated(*current.device_offset).intersects(rect))
+                continue;
+        }
+
+        command_indices.unchecked_append(command_index);
+    }
+    return command_indices;
+}
+
+u32 CommandList::index_of_matching_pop_stacking_context(u32 push_stacking_context_index) const
+{
+    size_t stacking_context_nesting_level = 0;
+    for (u32 command_index = push_stacking_context_index; command_index < m_commands.size(); ++command_index) {
+        auto const& command_list_item = m_commands[command_index];
+        if (command_list_item.skip)
+            continue;
+        if (command_list_item.command.has<PushStackingContext>()) {
+            stacking_context_nesting_level++;
+        } else if (command_list_item.command.has<PopStackingContext>()) {
+            if (--stacking_context_nesting_level == 0)
+                return command_index;
+        }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool CommandList::can_be_executed_in_tiles() const
+{
+    for (size_t command_index = 0; command_index < m_commands.size(); ++command_index) {
+        auto const& command_list_item = m_commands[command_index];
+        // Backdrop filters (like blur) sample pixels outside of their own region, so they would see the edges of a tile.
+        if (!command_list_item.skip && command_list_item.command.has<ApplyBackdropFilter>())
+            return false;
+    }
+    return true;
+}
+
+void CommandList::prepare_for_concurrent_execution()
+{
+    for (auto const& command_list_item : m_commands) {
+        command_list_item.command.visit(
+            [](auto const& command) {
+                if constexpr (requires { command.path.bounding_box(); })
+                    (void)command.path.bounding_box();
+                if constexpr (requires { command.clip_paths; }) {
+                    for (auto const& clip_path : command.clip_paths)
+                        (void)clip_path.bounding_box();
+                }
+            });
+    }
+}
+
 }
@@ -95,10 +95,39 @@ public:
     void mark_unnecessary_commands();
     void execute(CommandExecutor&);
 
+    // Executes only the given commands, in the given order. The indices are expected to come from commands_affecting_rect().
+    void execute(CommandExecutor&, ReadonlySpan<u32> command_indices);
+
+    // Returns the indices of the commands that may paint into the given device rect. Commands that change the executor's state
+    // (clip rects, stacking contexts, corner clipping) are included, since later commands depend on them, unless they are
+    // part of a stacking context that doesn't reach into the rect at all.
+    [[nodiscard]] Vector<u32> commands_affecting_rect(Gfx::IntRect const&) const;
+
+    // Whether the result of executing this list can be split into independently painted regions of the target.
+    [[nodiscard]] bool can_be_executed_in_tiles() const;
+
+    // Computes lazily cached data (like the line segments of paths) up front, so the commands can be read from several threads.
+    void prepare_for_concurrent_execution();
+
+    template<typename Callback>
+    void for_each_command(Callback callback) const
+    {
+        for (size_t command_index = 0; command_index < m_commands.size(); ++command_index) {
+            auto const& command_list_item = m_commands[command_index];
+            if (!command_list_item.skip)
+                callback(command_list_item.command);
+        }
+    }
+
     size_t corner_clip_max_depth() const { return m_corner_clip_max_depth; }
     void set_corner_clip_max_depth(size_t depth) { m_corner_clip_max_depth = depth; }
 
 private:
+    template<typename CommandIndexAt>
+    void execute_commands(CommandExecutor&, size_t command_count, CommandIndexAt);
+
+    u32 index_of_matching_pop_stacking_context(u32 push_stacking_context_index) const;
+
     struct CommandListItem {
         Optional<i32> scroll_frame_id;
         Command command;
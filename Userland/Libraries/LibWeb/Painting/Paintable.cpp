@@ -128,26 +128,40 @@ void Paintable::invalidate_stacking_context()
 }
 
 void Paintable::set_needs_display() const
+{
+    if (auto navigable = this->navigable())
+        navigable->set_needs_display(*this);
+}
+
+Optional<CSSPixelRect> Paintable::absolute_damage_rect() const
 {
     auto* containing_block = this->containing_block();
     if (!containing_block)
-        return;
-    auto navigable = this->navigable();
-    if (!navigable)
-        return;
+        return CSSPixelRect {};
+    if (!containing_block->is_painted_at_absolute_rect())
+        return {};
+
+    // NOTE: Content scrolled inside the containing block is painted somewhere within (and clipped to) the block itself.
+    if (!containing_block->scroll_offset().is_zero())
+        return containing_block->absolute_damage_rect();
 
+    CSSPixelRect rect;
     if (is<Painting::InlinePaintable>(*this)) {
         auto const& fragments = static_cast<Painting::InlinePaintable const*>(this)->fragments();
         for (auto const& fragment : fragments)
-            navigable->set_needs_display(fragment.absolute_rect());
+            rect = rect.united(fragment.absolute_paint_rect());
+    }
+
+    if (is<Painting::PaintableWithLines>(*containing_block)) {
+        static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
+            rect = rect.united(fragment.absolute_paint_rect());
+            return IterationDecision::Continue;
+        });
     }
 
-    if (!is<Painting::PaintableWithLines>(*containing_block))
-        return;
-    static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        navigable->set_needs_display(fragment.absolute_rect());
-        return IterationDecision::Continue;
-    });
+    if (auto scroll_offset = containing_block->enclosing_scroll_frame_offset(); scroll_offset.has_value())
+        rect.translate_by(scroll_offset.value());
+    return rect;
 }
 
 CSSPixelPoint Paintable::box_type_agnostic_position() const
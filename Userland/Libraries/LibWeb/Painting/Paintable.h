@@ -173,7 +173,11 @@ public:
 
     JS::GCPtr<HTML::Navigable> navigable() const;
 
-    virtual void set_needs_display() const;
+    void set_needs_display() const;
+
+    // The rect (in document coordinates) that needs to be repainted when this paintable changes,
+    // or an empty Optional if that can't be determined and the whole viewport has to be repainted.
+    [[nodiscard]] virtual Optional<CSSPixelRect> absolute_damage_rect() const;
 
     PaintableBox* containing_block() const
     {
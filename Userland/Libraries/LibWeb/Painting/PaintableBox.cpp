@@ -867,10 +867,76 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
     return TraversalDecision::Continue;
 }
 
-void PaintableBox::set_needs_display() const
+bool PaintableBox::is_painted_at_absolute_rect() const
 {
-    if (auto navigable = this->navigable())
-        navigable->set_needs_display(absolute_rect());
+    if (!combined_css_transform().is_identity())
+        return false;
+    for (auto const* box = this; box; box = box->containing_block()) {
+        if (!box->computed_values().transformations().is_empty())
+            return false;
+        if (box->is_fixed_position() || box->computed_values().position() == CSS::Positioning::Sticky)
+            return false;
+    }
+    return true;
+}
+
+Optional<CSSPixelRect> PaintableBox::absolute_damage_rect() const
+{
+    // NOTE: The inspector overlay paints margin boxes and a size label, which may be anywhere around the box.
+    if (document().inspected_layout_node() == &layout_node())
+        return {};
+
+    // NOTE: The backgrounds of the root and body elements are propagated to the whole canvas.
+    if (auto const* dom_node = this->dom_node(); dom_node && (dom_node == document().html_element() || dom_node == document().body()))
+        return {};
+
+    auto rect = own_absolute_damage_rect();
+    if (!rect.has_value())
+        return {};
+
+    // NOTE: Changing the opacity, z-index or transform of a stacking context changes how everything that is painted as
+    //       part of it gets composited, so its whole ink overflow is damaged. We check both whether the box had a stacking
+    //       context when it was last painted, and whether it establishes one now.
+    if (stacking_context() || layout_node().establishes_stacking_context()) {
+        auto decision = for_each_in_subtree_of_type<PaintableBox>([&](PaintableBox const& descendant) {
+            auto descendant_rect = descendant.own_absolute_damage_rect();
+            if (!descendant_rect.has_value()) {
+                rect = {};
+                return TraversalDecision::Break;
+            }
+            rect = rect->united(*descendant_rect);
+            return TraversalDecision::Continue;
+        });
+        if (decision == TraversalDecision::Break)
+            return {};
+    }
+    return rect;
+}
+
+Optional<CSSPixelRect> PaintableBox::own_absolute_damage_rect() const
+{
+    if (!is_painted_at_absolute_rect())
+        return {};
+
+    // NOTE: We don't use the cached paint rect here, since shadows may have changed since it was computed.
+    auto rect = compute_absolute_paint_rect();
+
+    if (auto const& outline_data = this->outline_data(); outline_data.has_value()) {
+        auto outline_width = max(max(outline_data->top.width, outline_data->right.width), max(outline_data->bottom.width, outline_data->left.width));
+        auto inflate = outline_width + max(outline_offset(), 0);
+        rect.inflate(inflate, inflate, inflate, inflate);
+    }
+
+    if (is<PaintableWithLines>(*this)) {
+        static_cast<PaintableWithLines const&>(*this).for_each_fragment([&](auto& fragment) {
+            rect = rect.united(fragment.absolute_paint_rect());
+            return IterationDecision::Continue;
+        });
+    }
+
+    if (auto scroll_offset = enclosing_scroll_frame_offset(); scroll_offset.has_value())
+        rect.translate_by(scroll_offset.value());
+    return rect;
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
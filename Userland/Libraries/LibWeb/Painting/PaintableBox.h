@@ -125,7 +125,11 @@ public:
     DOM::Node const* dom_node() const { return layout_box().dom_node(); }
     DOM::Node* dom_node() { return layout_box().dom_node(); }
 
-    virtual void set_needs_display() const override;
+    virtual Optional<CSSPixelRect> absolute_damage_rect() const override;
+
+    // Whether this box ends up painted at its absolute rect (offset by any scrolling), as opposed to somewhere
+    // that depends on CSS transforms or on the position of the viewport.
+    [[nodiscard]] bool is_painted_at_absolute_rect() const;
 
     virtual void apply_scroll_offset(PaintContext&, PaintPhase) const override;
     virtual void reset_scroll_offset(PaintContext&, PaintPhase) const override;
@@ -224,6 +228,9 @@ private:
     [[nodiscard]] Optional<CSSPixelRect> scroll_thumb_rect(ScrollDirection) const;
     [[nodiscard]] bool is_scrollable(ScrollDirection) const;
 
+    // Like absolute_damage_rect(), but only for what this box paints itself, and not for the rest of its stacking context.
+    [[nodiscard]] Optional<CSSPixelRect> own_absolute_damage_rect() const;
+
     Optional<OverflowData> m_overflow_data;
 
     CSSPixelPoint m_offset;
@@ -32,6 +32,49 @@ CSSPixelRect const PaintableFragment::absolute_rect() const
     return rect;
 }
 
+CSSPixelRect PaintableFragment::absolute_paint_rect() const
+{
+    auto rect = absolute_rect();
+
+    // NOTE: Glyphs (e.g italic ones) may be painted beyond the advance and line height of the fragment,
+    //       so we include the rects that the painter is going to draw them into.
+    Gfx::FloatPoint baseline_start { rect.x().to_float(), (rect.y() + baseline()).to_float() };
+    Gfx::FloatRect ink_rect;
+    for (auto const& glyph_or_emoji : glyph_run().glyphs()) {
+        auto glyph_rect = glyph_or_emoji.visit(
+            [&](Gfx::DrawGlyph const& draw_glyph) {
+                auto position = draw_glyph.position.translated(baseline_start);
+                auto glyph = draw_glyph.font->glyph(draw_glyph.code_point);
+                if (glyph.is_glyph_bitmap())
+                    return Gfx::FloatRect { position.translated(glyph.left_bearing(), 0), glyph.glyph_bitmap().size().to_type<float>() };
+                if (glyph.is_color_bitmap()) {
+                    auto height = glyph.advance() * static_cast<float>(glyph.bitmap()->height()) / static_cast<float>(glyph.bitmap()->width());
+                    return Gfx::FloatRect { position, { glyph.advance(), height } };
+                }
+                return Gfx::FloatRect { position.translated(glyph.left_bearing(), 0), glyph.bitmap()->size().to_type<float>() };
+            },
+            [&](Gfx::DrawEmoji const& draw_emoji) {
+                auto size = static_cast<float>(draw_emoji.font->pixel_size_rounded_up());
+                return Gfx::FloatRect { draw_emoji.position.translated(baseline_start), { size * draw_emoji.emoji->width() / draw_emoji.emoji->height(), size } };
+            });
+        ink_rect = ink_rect.united(glyph_rect);
+    }
+    if (!ink_rect.is_empty()) {
+        auto left = CSSPixels::floored_value_for(ink_rect.left());
+        auto top = CSSPixels::floored_value_for(ink_rect.top());
+        auto right = CSSPixels::floored_value_for(ink_rect.right()) + 1;
+        auto bottom = CSSPixels::floored_value_for(ink_rect.bottom()) + 1;
+        rect = rect.united({ left, top, right - left, bottom - top });
+    }
+
+    for (auto const& shadow : shadows()) {
+        auto inflate = shadow.spread_distance + shadow.blur_radius;
+        auto shadow_rect = rect.inflated(inflate, inflate, inflate, inflate).translated(shadow.offset_x, shadow.offset_y);
+        rect = rect.united(shadow_rect);
+    }
+    return rect;
+}
+
 int PaintableFragment::text_index_at(CSSPixels x) const
 {
     if (!is<TextPaintable>(paintable()))
@@ -38,6 +38,9 @@ public:
 
     CSSPixelRect const absolute_rect() const;
 
+    // The absolute rect including anything painted outside of it, like text shadows and glyph overhang.
+    CSSPixelRect absolute_paint_rect() const;
+
     Gfx::GlyphRun const& glyph_run() const { return *m_glyph_run; }
 
     CSSPixelRect selection_rect(Gfx::Font const&) const;
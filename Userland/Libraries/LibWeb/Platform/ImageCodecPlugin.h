@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
@@ -22,7 +24,12 @@ struct Frame {
 struct DecodedImage {
     bool is_animated { false };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
     Vector<Frame> frames;
+
+    // Set for animations that only come with their first few frames, see ImageCodecPlugin::request_animation_frames().
+    // The decoder keeps its state for the animation around until whoever receives the image calls stop_animation_decode().
+    Optional<i64> image_id;
 };
 
 class ImageCodecPlugin {
@@ -33,6 +40,21 @@ public:
     virtual ~ImageCodecPlugin();
 
     virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+
+    // Progressive decoding, for images whose data is still arriving. Whenever the decoder manages to make something of
+    // the data it has so far, on_partial_image is called with a bitmap of the full size of the image. Once all of the
+    // data has been appended, finishing the decode works just like decode_image(). Returns an empty Optional if
+    // progressive decoding isn't available, in which case the caller should collect the data and use decode_image().
+    // The MIME type, if known, helps to pick a decoder before the data that identifies the format has arrived.
+    virtual Optional<i64> start_progressive_decode(Optional<ByteString> mime_type, ESCAPING Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) = 0;
+    virtual void append_progressive_decode_data(i64 decode_id, ReadonlyBytes) = 0;
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> finish_progressive_decode(i64 decode_id, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    virtual void cancel_progressive_decode(i64 decode_id) = 0;
+
+    // Decodes `count` more frames of an animation (wrapping around at its end), keeping the decoder state alive in
+    // between requests. Only the callback of the most recent request for an image is kept.
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 count, ESCAPING Function<void(u32 start_frame_index, Vector<Frame>&)>) = 0;
+    virtual void stop_animation_decode(i64 image_id) = 0;
 };
 
 }
@@ -18,6 +18,13 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
 {
 }
 
+// Animations with more frames than this are not decoded up front. Instead, the client asks for the frames it needs.
+static constexpr u32 max_frames_to_decode_up_front = 8;
+
+// While the data of an image is arriving, we decode what we have whenever it has grown by at least this much, or by a
+// quarter, whichever is more. The latter keeps the total amount of work proportional to the size of the image.
+static constexpr size_t min_growth_between_partial_decodes = 16 * KiB;
+
 void ConnectionFromClient::die()
 {
     for (auto& [_, job] : m_pending_jobs) {
@@ -25,14 +32,27 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, session] : m_animation_sessions) {
+        if (session->running_job)
+            session->running_job->cancel();
+    }
+    m_animation_sessions.clear();
+
+    for (auto& [_, session] : m_progressive_decode_sessions) {
+        if (session->running_job)
+            session->running_job->cancel();
+    }
+    m_progressive_decode_sessions.clear();
+
     Threading::quit_background_thread();
     Core::EventLoop::current().quit(0);
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, size_t start_frame_index, size_t count, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
-        auto frame_or_error = decoder.frame(i, ideal_size);
+    for (size_t i = 0; i < count; ++i) {
+        // NOTE: Requests for animation frames may wrap around to the start of the animation.
+        auto frame_or_error = decoder.frame((start_frame_index + i) % decoder.frame_count(), ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append(Gfx::ShareableBitmap {});
             durations.append(0);
@@ -70,7 +90,15 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), result.bitmaps, result.durations);
+    result.frame_count = decoder->frame_count();
+
+    auto frames_to_decode = decoder->frame_count();
+    if (result.is_animated && frames_to_decode > max_frames_to_decode_up_front) {
+        frames_to_decode = max_frames_to_decode_up_front;
+        result.decoder = decoder;
+    }
+
+    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), 0, frames_to_decode, result.bitmaps, result.durations);
 
     if (result.bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
@@ -81,11 +109,14 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
 NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
+        [encoded_buffer, ideal_size, mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
             return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
         },
-        [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
+        [strong_this = NonnullRefPtr(*this), image_id, encoded_buffer, ideal_size](DecodeResult result) -> ErrorOr<void> {
+            if (result.decoder) {
+                strong_this->m_animation_sessions.set(image_id, make<AnimationSession>(encoded_buffer, result.decoder.release_nonnull(), ideal_size, nullptr, OptionalNone {}));
+            }
+            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.frame_count, result.bitmaps, result.durations, result.scale);
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
@@ -116,6 +147,183 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
         job.value()->cancel();
     }
+    if (auto session = m_progressive_decode_sessions.take(image_id); session.has_value()) {
+        if (session.value()->running_job)
+            session.value()->running_job->cancel();
+    }
+    stop_animation_decode(image_id);
+}
+
+Messages::ImageDecoderServer::StartProgressiveDecodeResponse ConnectionFromClient::start_progressive_decode(Optional<ByteString> const& mime_type)
+{
+    auto image_id = m_next_image_id++;
+
+    auto session = make<ProgressiveDecodeSession>();
+    session->mime_type = mime_type;
+    m_progressive_decode_sessions.set(image_id, move(session));
+
+    return image_id;
+}
+
+void ConnectionFromClient::append_progressive_decode_data(i64 image_id, Core::AnonymousBuffer const& data)
+{
+    auto session = m_progressive_decode_sessions.get(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Data appended to unknown progressive decode {}", image_id);
+        return;
+    }
+
+    if (!data.is_valid())
+        return;
+
+    if (auto result = session.value()->encoded_data.try_append(data.data<u8>(), data.size()); result.is_error()) {
+        // NOTE: The client will learn about this when it finishes the decode.
+        dbgln("Could not append to the data of progressive decode {}: {}", image_id, result.error());
+        cancel_decoding(image_id);
+        return;
+    }
+
+    start_partial_decode_job_if_worthwhile(image_id);
+}
+
+void ConnectionFromClient::start_partial_decode_job_if_worthwhile(i64 image_id)
+{
+    auto& session = *m_progressive_decode_sessions.get(image_id).value();
+    if (session.running_job)
+        return;
+
+    auto growth = session.encoded_data.size() - session.encoded_size_at_last_partial_decode;
+    if (growth < max(min_growth_between_partial_decodes, session.encoded_size_at_last_partial_decode / 4))
+        return;
+
+    // NOTE: More data keeps arriving while we decode, so the job gets a copy of what we have so far.
+    auto encoded_data_or_error = ByteBuffer::copy(session.encoded_data);
+    if (encoded_data_or_error.is_error())
+        return;
+    session.encoded_size_at_last_partial_decode = session.encoded_data.size();
+
+    session.running_job = PartialDecodeJob::construct(
+        [encoded_data = encoded_data_or_error.release_value(), mime_type = session.mime_type](auto&) -> ErrorOr<Gfx::ShareableBitmap> {
+            auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, mime_type));
+            if (!decoder)
+                return Error::from_string_literal("Could not find suitable image decoder plugin for data");
+            auto frame = TRY(decoder->partial_frame());
+            return frame.image->to_shareable_bitmap();
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Gfx::ShareableBitmap bitmap) -> ErrorOr<void> {
+            auto session = strong_this->m_progressive_decode_sessions.get(image_id);
+            if (!session.has_value())
+                return {};
+            session.value()->running_job = nullptr;
+
+            strong_this->async_did_decode_partial_image(image_id, bitmap);
+            strong_this->start_partial_decode_job_if_worthwhile(image_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // NOTE: This is expected while there isn't enough data to show anything yet.
+            dbgln_if(IMAGE_DECODER_DEBUG, "Partial decode of image {} failed: {}", image_id, error);
+            auto session = strong_this->m_progressive_decode_sessions.get(image_id);
+            if (!session.has_value())
+                return;
+            session.value()->running_job = nullptr;
+            strong_this->start_partial_decode_job_if_worthwhile(image_id);
+        });
+}
+
+void ConnectionFromClient::finish_progressive_decode(i64 image_id, Optional<Gfx::IntSize> const& ideal_size)
+{
+    auto session = m_progressive_decode_sessions.take(image_id);
+    if (!session.has_value()) {
+        async_did_fail_to_decode_image(image_id, "Unknown progressive decode"_string);
+        return;
+    }
+    if (session.value()->running_job)
+        session.value()->running_job->cancel();
+
+    auto const& encoded_data = session.value()->encoded_data;
+    if (encoded_data.is_empty()) {
+        async_did_fail_to_decode_image(image_id, "No encoded data"_string);
+        return;
+    }
+
+    auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(encoded_data.size());
+    if (encoded_buffer_or_error.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Could not allocate encoded buffer: {}", encoded_buffer_or_error.error())));
+        return;
+    }
+    auto encoded_buffer = encoded_buffer_or_error.release_value();
+    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
+
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), ideal_size, move(session.value()->mime_type)));
+}
+
+void ConnectionFromClient::request_animation_frames(i64 image_id, u32 start_frame_index, u32 count)
+{
+    // NOTE: The client waits for a reply to every request, so requests we can't do anything with get one without frames.
+    auto session = m_animation_sessions.get(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Frames requested for unknown animation {}", image_id);
+        async_did_decode_animation_frames(image_id, start_frame_index, {}, {});
+        return;
+    }
+
+    count = min(count, max_frames_to_decode_up_front);
+    if (count == 0 || start_frame_index >= session.value()->decoder->frame_count()) {
+        async_did_decode_animation_frames(image_id, start_frame_index, {}, {});
+        return;
+    }
+
+    // NOTE: The decoder can only work on one request at a time. If the client has moved on while we were busy,
+    //       we only care about the most recent request.
+    session.value()->queued_request = AnimationFrameRequest { start_frame_index, count };
+    if (!session.value()->running_job)
+        start_next_animation_frame_job(image_id);
+}
+
+void ConnectionFromClient::start_next_animation_frame_job(i64 image_id)
+{
+    auto& session = *m_animation_sessions.get(image_id).value();
+    auto request = session.queued_request.release_value();
+
+    session.running_job = FrameJob::construct(
+        [encoded_buffer = session.encoded_buffer, decoder = session.decoder, ideal_size = session.ideal_size, request](auto&) -> ErrorOr<AnimationFrames> {
+            AnimationFrames frames;
+            frames.start_frame_index = request.start_frame_index;
+            decode_image_to_bitmaps_and_durations_with_decoder(*decoder, ideal_size, request.start_frame_index, request.count, frames.bitmaps, frames.durations);
+            return frames;
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](AnimationFrames frames) -> ErrorOr<void> {
+            auto session = strong_this->m_animation_sessions.get(image_id);
+            if (!session.has_value())
+                return {};
+            session.value()->running_job = nullptr;
+
+            strong_this->async_did_decode_animation_frames(image_id, frames.start_frame_index, frames.bitmaps, frames.durations);
+
+            if (session.value()->queued_request.has_value())
+                strong_this->start_next_animation_frame_job(image_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, request](Error error) -> void {
+            dbgln_if(IMAGE_DECODER_DEBUG, "Decoding frames of animation {} failed: {}", image_id, error);
+            auto session = strong_this->m_animation_sessions.get(image_id);
+            if (!session.has_value())
+                return;
+            session.value()->running_job = nullptr;
+
+            strong_this->async_did_decode_animation_frames(image_id, request.start_frame_index, {}, {});
+            if (session.value()->queued_request.has_value())
+                strong_this->start_next_animation_frame_job(image_id);
+        });
+}
+
+void ConnectionFromClient::stop_animation_decode(i64 image_id)
+{
+    if (auto session = m_animation_sessions.take(image_id); session.has_value()) {
+        if (session.value()->running_job)
+            session.value()->running_job->cancel();
+    }
 }
 
 }
@@ -10,6 +10,7 @@
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
 
@@ -27,23 +28,68 @@ public:
     struct DecodeResult {
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
         Vector<Gfx::ShareableBitmap> bitmaps;
         Vector<u32> durations;
+
+        // Only set for animations that are too long to be decoded up front. The decoder is kept around so that the
+        // client can ask for the remaining frames as it needs them.
+        RefPtr<Gfx::ImageDecoder> decoder;
+    };
+
+    struct AnimationFrames {
+        u32 start_frame_index { 0 };
+        Vector<Gfx::ShareableBitmap> bitmaps;
+        Vector<u32> durations;
     };
 
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using FrameJob = Threading::BackgroundAction<AnimationFrames>;
+    using PartialDecodeJob = Threading::BackgroundAction<Gfx::ShareableBitmap>;
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::StartProgressiveDecodeResponse start_progressive_decode(Optional<ByteString> const& mime_type) override;
+    virtual void append_progressive_decode_data(i64 image_id, Core::AnonymousBuffer const&) override;
+    virtual void finish_progressive_decode(i64 image_id, Optional<Gfx::IntSize> const& ideal_size) override;
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 count) override;
+    virtual void stop_animation_decode(i64 image_id) override;
 
     NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    void start_next_animation_frame_job(i64 image_id);
+    void start_partial_decode_job_if_worthwhile(i64 image_id);
+
+    struct AnimationFrameRequest {
+        u32 start_frame_index { 0 };
+        u32 count { 0 };
+    };
+
+    // The decoder state of an animated image whose frames are decoded on demand.
+    struct AnimationSession {
+        // NOTE: The decoder refers to the encoded data, so it has to stay alive for as long as the decoder does.
+        Core::AnonymousBuffer encoded_buffer;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+        RefPtr<FrameJob> running_job;
+        Optional<AnimationFrameRequest> queued_request;
+    };
+
+    // The data of an image that is still arriving, see start_progressive_decode().
+    struct ProgressiveDecodeSession {
+        ByteBuffer encoded_data;
+        Optional<ByteString> mime_type;
+        size_t encoded_size_at_last_partial_decode { 0 };
+        RefPtr<PartialDecodeJob> running_job;
+    };
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullOwnPtr<AnimationSession>> m_animation_sessions;
+    HashMap<i64, NonnullOwnPtr<ProgressiveDecodeSession>> m_progressive_decode_sessions;
 };
 
 }
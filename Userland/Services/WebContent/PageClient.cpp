@@ -38,6 +38,7 @@ namespace WebContent {
 
 static bool s_use_gpu_painter = false;
 static bool s_use_experimental_cpu_transform_support = false;
+static bool s_use_parallel_cpu_painting = false;
 
 JS_DEFINE_ALLOCATOR(PageClient);
 
@@ -51,6 +52,11 @@ void PageClient::set_use_experimental_cpu_transform_support()
     s_use_experimental_cpu_transform_support = true;
 }
 
+void PageClient::set_use_parallel_cpu_painting()
+{
+    s_use_parallel_cpu_painting = true;
+}
+
 JS::NonnullGCPtr<PageClient> PageClient::create(JS::VM& vm, PageHost& page_host, u64 id)
 {
     return vm.heap().allocate_without_realm<PageClient>(page_host, id);
@@ -105,6 +111,7 @@ void PageClient::add_backing_store(i32 front_bitmap_id, Gfx::ShareableBitmap con
     m_backing_stores.back_bitmap_id = back_bitmap_id;
     m_backing_stores.front_bitmap = *const_cast<Gfx::ShareableBitmap&>(front_bitmap).bitmap();
     m_backing_stores.back_bitmap = *const_cast<Gfx::ShareableBitmap&>(back_bitmap).bitmap();
+    m_backing_stores.previous_frame_damage_rect = {};
 }
 
 void PageClient::visit_edges(JS::Cell::Visitor& visitor)
@@ -191,9 +198,21 @@ void PageClient::paint_next_frame()
 
     auto& back_bitmap = *m_backing_stores.back_bitmap;
     auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-    paint(viewport_rect, back_bitmap);
+
+    Optional<Web::DevicePixelRect> frame_damage_rect;
+    if (auto damage_rect = page().top_level_traversable()->take_damage_rect(); damage_rect.has_value()) {
+        // NOTE: Inflate the damage a little bit to account for anti-aliasing and rounding to device pixels.
+        frame_damage_rect = page().enclosing_device_rect(*damage_rect).inflated(2, 2);
+    }
+
+    // The back bitmap was last painted two frames ago, so it's missing both the damage of this frame and of the previous one.
+    Web::PaintOptions paint_options;
+    if (frame_damage_rect.has_value() && m_backing_stores.previous_frame_damage_rect.has_value())
+        paint_options.damage_rect = frame_damage_rect->united(*m_backing_stores.previous_frame_damage_rect);
+    paint(viewport_rect, back_bitmap, paint_options);
 
     auto& backing_stores = m_backing_stores;
+    backing_stores.previous_frame_damage_rect = frame_damage_rect;
     swap(backing_stores.front_bitmap, backing_stores.back_bitmap);
     swap(backing_stores.front_bitmap_id, backing_stores.back_bitmap_id);
 
@@ -227,6 +246,11 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
             has_warned_about_configuration = true;
         }
 #endif
+    } else if (s_use_parallel_cpu_painting && !s_use_experimental_cpu_transform_support) {
+        auto damage_rect = paint_options.damage_rect.map([](auto const& rect) { return rect.template to_type<int>(); });
+        Web::Painting::execute_command_list_in_tiles(painting_commands, target, damage_rect);
+    } else if (paint_options.damage_rect.has_value() && !s_use_experimental_cpu_transform_support) {
+        Web::Painting::execute_command_list_in_rect(painting_commands, target, paint_options.damage_rect->to_type<int>());
     } else {
         Web::Painting::CommandExecutorCPU painting_command_executor(target, s_use_experimental_cpu_transform_support);
         painting_commands.execute(painting_command_executor);
@@ -31,6 +31,7 @@ public:
 
     static void set_use_gpu_painter();
     static void set_use_experimental_cpu_transform_support();
+    static void set_use_parallel_cpu_painting();
 
     virtual void schedule_repaint() override;
     virtual bool is_ready_to_paint() const override;
@@ -193,6 +194,9 @@ private:
         i32 back_bitmap_id { -1 };
         RefPtr<Gfx::Bitmap> front_bitmap;
         RefPtr<Gfx::Bitmap> back_bitmap;
+
+        // The damage of the last painted frame, or an empty Optional if the back bitmap can't be partially repainted.
+        Optional<Web::DevicePixelRect> previous_frame_damage_rect;
     };
     BackingStores m_backing_stores;
 
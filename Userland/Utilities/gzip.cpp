@@ -20,14 +20,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Compress using this many threads", "jobs", 'j', "N");
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (thread_count == 0) {
+        warnln("The number of jobs must be at least 1");
+        return 1;
+    }
+
     auto program_name = LexicalPath::basename(arguments.strings[0]);
 
     // NOTE: If the user run this program via the /bin/zcat or /bin/gunzip symlink,
@@ -71,8 +78,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         // Buffer reads, which yields a significant performance improvement.
         NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(move(input_file), 1 * MiB));
 
+        Compress::ParallelGzipCompressor* parallel_compressor = nullptr;
+
         if (decompress) {
             input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
+        } else if (thread_count > 1) {
+            auto compressor = TRY(Compress::ParallelGzipCompressor::create(output_stream.release_nonnull(), thread_count));
+            parallel_compressor = compressor.ptr();
+            output_stream = move(compressor);
         } else {
             output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
         }
@@ -84,6 +97,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(output_stream->write_until_depleted(span));
         }
 
+        if (parallel_compressor)
+            TRY(parallel_compressor->finish());
+
         if (!keep_input_files)
             TRY(Core::System::unlink(input_filename));
     }
@@ -17,6 +17,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
@@ -527,9 +528,13 @@ private:
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed prot_exec"));
 
     bool gc_on_every_allocation = false;
+    bool generational_gc = false;
+    bool parallel_gc = false;
+    bool dump_property_lookup_cache_statistics = false;
+    bool enable_jit = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
@@ -545,6 +550,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(generational_gc, "Collect the young generation separately", "generational-gc", {});
+    args_parser.add_option(parallel_gc, "Mark live cells on multiple threads", "parallel-gc", {});
+    args_parser.add_option(dump_property_lookup_cache_statistics, "Dump property lookup cache statistics on exit (requires PROPERTY_LOOKUP_CACHE_DEBUG)", "dump-property-lookup-cache-statistics", {});
+    args_parser.add_option(enable_jit, "Compile hot bytecode to native code", "jit", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -552,6 +561,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (enable_jit)
+        JS::JIT::g_jit_enabled = true;
+
     bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
@@ -591,6 +603,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_generational_collection_enabled(generational_gc);
+        g_vm->heap().set_parallel_marking_enabled(parallel_gc);
 
         auto& global_environment = realm.global_environment();
 
@@ -808,6 +822,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_generational_collection_enabled(generational_gc);
+        g_vm->heap().set_parallel_marking_enabled(parallel_gc);
 
         StringBuilder builder;
         StringView source_name;
@@ -840,7 +856,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
+        bool did_run = TRY(parse_and_run(realm, builder.string_view(), source_name));
+
+        if (dump_property_lookup_cache_statistics)
+            JS::Bytecode::dump_property_lookup_cache_statistics();
+
+        if (!did_run)
             return 1;
     }
 